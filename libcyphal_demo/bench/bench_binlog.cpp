@@ -0,0 +1,90 @@
+// This software is distributed under the terms of the MIT License.
+// Copyright (C) OpenCyphal Development Team  <opencyphal.org>
+// Copyright Amazon.com Inc. or its affiliates.
+// SPDX-License-Identifier: MIT
+
+/// Measures per-call cost of logging a typical transient error line (two arguments) via the asynchronous
+/// binary log, and compares it against a direct `fprintf`. The deferred formatting cost (paid at idle) is reported
+/// separately.
+/// Both write to `/dev/null`, so the terminal speed doesn't affect the results.
+
+#include "platform/binlog.hpp"
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+
+// NOLINTBEGIN(cppcoreguidelines-avoid-magic-numbers, readability-magic-numbers)
+
+namespace
+{
+
+constexpr std::uint64_t Iterations  = 5000000;
+constexpr std::size_t   LogCapacity = 4096;
+
+constexpr const char* Format = "Failed to push frame to media (mediaIdx=%u): %s\n";
+
+std::array<BinlogRecord, LogCapacity> s_log_records{};
+
+template <typename Action>
+double measure(Action&& action)
+{
+    const auto started = std::chrono::steady_clock::now();
+    for (std::uint64_t i = 0; i < Iterations; ++i)
+    {
+        action(i);
+    }
+    const auto elapsed = std::chrono::steady_clock::now() - started;
+    return static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count()) /
+           static_cast<double>(Iterations);
+}
+
+}  // namespace
+
+int main()
+{
+    std::FILE* const sink = std::fopen("/dev/null", "w");
+    if (sink == nullptr)
+    {
+        (void) std::fprintf(stderr, "Failed to open /dev/null.\n");
+        return 1;
+    }
+
+    const double direct = measure([sink](const std::uint64_t i) {
+        //
+        (void) std::fprintf(sink, Format, static_cast<unsigned>(i & 3U), "CapacityError");
+    });
+    (void) std::printf("fprintf              : %6.2f ns/call\n", direct);
+
+    // The ring is drained between bursts (outside of the measured time), so that no record is dropped.
+    platform::BinLog         log{s_log_records, sink};
+    std::chrono::nanoseconds push_time{0};
+    std::chrono::nanoseconds drain_time{0};
+    constexpr std::uint64_t  Bursts = Iterations / LogCapacity;
+    for (std::uint64_t burst = 0; burst < Bursts; ++burst)
+    {
+        const auto push_started = std::chrono::steady_clock::now();
+        for (std::size_t i = 0; i < LogCapacity; ++i)
+        {
+            (void) log(Format, static_cast<unsigned>(i & 3U), "CapacityError");
+        }
+        const auto drain_started = std::chrono::steady_clock::now();
+        (void) log.drain();
+        const auto drain_finished = std::chrono::steady_clock::now();
+
+        push_time += std::chrono::duration_cast<std::chrono::nanoseconds>(drain_started - push_started);
+        drain_time += std::chrono::duration_cast<std::chrono::nanoseconds>(drain_finished - drain_started);
+    }
+    const auto records = static_cast<double>(Bursts * LogCapacity);
+
+    (void) std::printf("BinLog call          : %6.2f ns/call (%llu records dropped)\n",
+                       static_cast<double>(push_time.count()) / records,
+                       static_cast<unsigned long long>(log.getDropped()));  // NOLINT
+    (void) std::printf("BinLog drain         : %6.2f ns/record\n", static_cast<double>(drain_time.count()) / records);
+
+    (void) std::fclose(sink);
+    return 0;
+}
+
+// NOLINTEND(cppcoreguidelines-avoid-magic-numbers, readability-magic-numbers)
@@ -0,0 +1,506 @@
+// This software is distributed under the terms of the MIT License.
+// Copyright (C) OpenCyphal Development Team  <opencyphal.org>
+// Copyright Amazon.com Inc. or its affiliates.
+// SPDX-License-Identifier: MIT
+
+/// Evaluates CAN bus traffic scenarios on the bus simulator (see `CanBusSimulator`) in virtual time,
+/// so a few seconds of the bus are simulated in a fraction of that.
+///
+/// Each scenario is a set of flows (periodic or saturating transfers of a node at a priority),
+/// which are split into Cyphal/CAN frames (with tail bytes, transfer CRC and padding) and pushed to the bus.
+/// For every scenario the benchmark prints the bus load, the average frame length (and share of stuff bits),
+/// and the frame latency distribution (from push to the end of the frame on the bus) per Cyphal priority.
+/// To evaluate another scenario just add it to the table below.
+///
+/// Then the same simulator is run in real time (see `SimulatedCanBus`), with two libcyphal nodes attached to it
+/// via `SimulatedCanMedia` and sharing one epoll executor: one node publishes messages at a fixed rate, and the other
+/// one subscribes to them. Besides the bus stats, the message latency from `publish` to the subscriber callback
+/// is printed, so the executor and the stack overhead could be seen on top of the simulated bus timing.
+
+#include "bench_common.hpp"
+#include "platform/block_memory_resource.hpp"
+#include "platform/can_bus_simulator.hpp"
+#include "platform/linux/can/simulated_can_media.hpp"
+#include "platform/linux/epoll_single_threaded_executor.hpp"
+
+#include <canard.h>
+#include <cetl/pf17/cetlpf.hpp>
+#include <libcyphal/presentation/presentation.hpp>
+#include <libcyphal/presentation/publisher.hpp>
+#include <libcyphal/presentation/subscriber.hpp>
+#include <libcyphal/transport/can/can_transport.hpp>
+#include <libcyphal/transport/can/can_transport_impl.hpp>
+#include <libcyphal/types.hpp>
+
+#include <uavcan/primitive/array/Natural8_1_0.hpp>
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <ctime>
+#include <memory>
+#include <utility>
+
+// NOLINTBEGIN(cppcoreguidelines-avoid-magic-numbers, readability-magic-numbers)
+
+namespace
+{
+
+using Simulator = platform::CanBusSimulator;
+
+constexpr std::uint64_t DurationNs = 5000000000ULL;  // 5 s of the bus time
+constexpr std::size_t   MaxFlows   = 16;
+
+constexpr std::uint64_t MediaDurationNs      = 1000000000ULL;  // 1 s of the real time
+constexpr std::uint64_t MediaIdleNs          = 200000000ULL;   // 0.2 s without deliveries ends the scenario
+constexpr std::size_t   MediaMaxMessages     = 1000;
+constexpr std::uint16_t MediaSubjectId       = 1000;
+constexpr std::size_t   MediaTxQueueCapacity = 256;
+
+constexpr std::array<const char*, Simulator::Priorities> PriorityNames{
+    {"exceptional", "immediate", "fast", "high", "nominal", "low", "slow", "optional"}};
+
+/// A subject published by a node; zero period means "as fast as the node TX queue allows".
+struct Flow final
+{
+    std::uint8_t  node_id;
+    std::uint8_t  priority;
+    std::uint16_t subject_id;
+    std::uint32_t period_us;
+    std::uint16_t transfer_size;
+};
+
+struct Scenario final
+{
+    const char*                name;
+    Simulator::Config          config;
+    std::size_t                mtu;
+    std::size_t                nodes;
+    std::size_t                flows_count;
+    std::array<Flow, MaxFlows> flows;
+};
+
+/// A servo network: the controller commands 4 servos at 500 Hz, servos report their state at 500 Hz,
+/// everybody sends heartbeats, and a low-priority file transfer saturates the rest of the bus.
+constexpr std::array<Flow, MaxFlows> ServoNetwork{{
+    {1, 2, 100, 2000, 16},     // setpoints
+    {1, 3, 101, 10000, 4},     // readiness
+    {2, 3, 200, 2000, 7},      // servo feedback
+    {3, 3, 201, 2000, 7},      //
+    {4, 3, 202, 2000, 7},      //
+    {5, 3, 203, 2000, 7},      //
+    {1, 4, 7509, 1000000, 7},  // heartbeats
+    {2, 4, 7509, 1000000, 7},  //
+    {3, 4, 7509, 1000000, 7},  //
+    {4, 4, 7509, 1000000, 7},  //
+    {5, 4, 7509, 1000000, 7},  //
+    {6, 4, 7509, 1000000, 7},  //
+    {6, 6, 300, 0, 100},       // file transfer
+}};
+
+constexpr std::array<Scenario, 4> Scenarios{{
+    {"servo network, classic 1 Mbit/s", {1000000, 0}, 8, 6, 13, ServoNetwork},
+    {"servo network, classic 500 kbit/s (overload)", {500000, 0}, 8, 6, 13, ServoNetwork},
+    {"servo network, FD 1 Mbit/s (no BRS)", {1000000, 0}, 64, 6, 13, ServoNetwork},
+    {"servo network, FD 1/5 Mbit/s", {1000000, 5000000}, 64, 6, 13, ServoNetwork},
+}};
+
+/// Real-time scenario: node 1 publishes messages of the given size at the given rate, and node 2 receives them.
+struct MediaScenario final
+{
+    const char*       name;
+    Simulator::Config config;
+    std::size_t       mtu;
+    std::size_t       payload;
+    std::uint32_t     rate_hz;
+};
+
+constexpr std::array<MediaScenario, 2> MediaScenarios{{
+    {"media, classic 1 Mbit/s, 64 bytes at 500 Hz (real time)", {1000000, 0}, CANARD_MTU_CAN_CLASSIC, 64, 500},
+    {"media, FD 1/5 Mbit/s, 256 bytes at 500 Hz (real time)", {1000000, 5000000}, CANARD_MTU_CAN_FD, 256, 500},
+}};
+
+std::uint8_t paddedSize(const std::size_t size)
+{
+    constexpr std::array<std::uint8_t, 15> Sizes{{0, 1, 2, 3, 4, 5, 6, 7, 8, 12, 16, 20, 24, 32, 48}};
+    for (const auto padded : Sizes)
+    {
+        if (size <= padded)
+        {
+            return padded;
+        }
+    }
+    return 64;
+}
+
+/// Splits transfers of a flow into frames, the same way libcanard does (see `canardTxPush`).
+///
+class Publisher final
+{
+public:
+    Publisher() = default;
+
+    Publisher(const Flow& flow, const std::size_t mtu)
+        : flow_{flow}
+        , mtu_{mtu}
+    {
+        const std::size_t per_frame = mtu - 1U;
+        frames_per_transfer_ =
+            (flow.transfer_size <= per_frame) ? 1U : ((flow.transfer_size + 2U + per_frame - 1U) / per_frame);
+        can_id_ = (static_cast<std::uint32_t>(flow.priority) << 26U) | (3U << 21U) |
+                  (static_cast<std::uint32_t>(flow.subject_id) << 8U) | flow.node_id;
+    }
+
+    std::size_t framesPerTransfer() const noexcept
+    {
+        return frames_per_transfer_;
+    }
+
+    bool isSaturating() const noexcept
+    {
+        return flow_.period_us == 0;
+    }
+
+    /// @return `false` if the node TX queue can't take the whole transfer (then nothing is pushed).
+    ///
+    bool publish(Simulator& simulator, const std::size_t node, const std::uint64_t now_ns)
+    {
+        if (simulator.txFree(node) < frames_per_transfer_)
+        {
+            return false;
+        }
+        std::size_t remaining = flow_.transfer_size + ((frames_per_transfer_ > 1) ? 2U : 0U);
+        bool        toggle    = true;
+        for (std::size_t index = 0; index < frames_per_transfer_; ++index)
+        {
+            const std::size_t chunk = (remaining < (mtu_ - 1U)) ? remaining : (mtu_ - 1U);
+            remaining -= chunk;
+
+            Simulator::Frame frame{};
+            frame.can_id = can_id_;
+            frame.is_fd  = mtu_ > 8U;
+            frame.size   = frame.is_fd ? paddedSize(chunk + 1U) : static_cast<std::uint8_t>(chunk + 1U);
+            for (std::size_t offset = 0; offset < (frame.size - 1U); ++offset)
+            {
+                frame.data[offset] = (offset < chunk) ? nextByte() : 0U;  // NOLINT(*-constant-array-index)
+            }
+            frame.data[frame.size - 1U] = static_cast<std::uint8_t>(  // NOLINT(*-constant-array-index)
+                ((index == 0) ? 0x80U : 0U) | ((index == (frames_per_transfer_ - 1U)) ? 0x40U : 0U) |
+                (toggle ? 0x20U : 0U) | (transfer_id_ & 0x1FU));
+            toggle = !toggle;
+            (void) simulator.push(node, now_ns, frame);
+        }
+        ++transfer_id_;
+        return true;
+    }
+
+private:
+    /// Pseudo-random payload, so that bit stuffing is realistic.
+    std::uint8_t nextByte() noexcept
+    {
+        rng_ ^= rng_ << 13U;
+        rng_ ^= rng_ >> 7U;
+        rng_ ^= rng_ << 17U;
+        return static_cast<std::uint8_t>(rng_);
+    }
+
+    Flow          flow_{};
+    std::size_t   mtu_{8};
+    std::size_t   frames_per_transfer_{1};
+    std::uint32_t can_id_{0};
+    std::uint32_t transfer_id_{0};
+    std::uint64_t rng_{0x9E3779B97F4A7C15ULL};
+
+};  // Publisher
+
+/// Prints the bus load, frames stats, and the frame latency distribution per priority.
+///
+void printBusStats(const char* const   name,
+                   const Simulator&    simulator,
+                   const std::uint64_t now_ns,
+                   const std::uint64_t dropped_transfers)
+{
+    const Simulator::Stats& stats  = simulator.stats();
+    const double            frames = (stats.frames > 0) ? static_cast<double>(stats.frames) : 1.0;
+    const double            bits   = (stats.bits > 0) ? static_cast<double>(stats.bits) : 1.0;
+    // NOLINTBEGIN(google-runtime-int)
+    (void) std::printf("\n%s\n", name);
+    (void) std::printf("  bus load %5.1f%%, %llu frames, %.1f bits/frame (%.1f%% stuff bits), %llu dropped transfers\n",
+                       simulator.busLoad(now_ns) * 100.0,
+                       static_cast<unsigned long long>(stats.frames),
+                       static_cast<double>(stats.bits) / frames,
+                       100.0 * static_cast<double>(stats.stuff_bits) / bits,
+                       static_cast<unsigned long long>(dropped_transfers));
+    (void) std::printf("  %-12s %9s %9s %9s %9s %9s %9s  (latency, us)\n",
+                       "priority",
+                       "frames",
+                       "mean",
+                       "p50",
+                       "p99",
+                       "p99.9",
+                       "max");
+    for (std::size_t priority = 0; priority < Simulator::Priorities; ++priority)
+    {
+        const Simulator::Histogram& latency = stats.latency_ns[priority];  // NOLINT(*-constant-array-index)
+        if (latency.count() == 0)
+        {
+            continue;
+        }
+        (void) std::printf("  %-12s %9llu %9.1f %9.1f %9.1f %9.1f %9.1f\n",
+                           PriorityNames[priority],  // NOLINT(*-constant-array-index)
+                           static_cast<unsigned long long>(latency.count()),
+                           static_cast<double>(latency.mean()) / 1e3,
+                           static_cast<double>(latency.quantile(0.5)) / 1e3,
+                           static_cast<double>(latency.quantile(0.99)) / 1e3,
+                           static_cast<double>(latency.quantile(0.999)) / 1e3,
+                           static_cast<double>(latency.max()) / 1e3);
+    }
+    // NOLINTEND(google-runtime-int)
+}
+
+void runScenario(const Scenario& scenario)
+{
+    auto simulator = std::make_unique<Simulator>(scenario.config);
+    for (std::size_t node = 0; node < scenario.nodes; ++node)
+    {
+        (void) simulator->attach();
+    }
+
+    std::array<Publisher, MaxFlows>     publishers{};
+    std::array<std::uint64_t, MaxFlows> next_ns{};
+    for (std::size_t index = 0; index < scenario.flows_count; ++index)
+    {
+        const Flow& flow  = scenario.flows[index];                   // NOLINT(*-constant-array-index)
+        publishers[index] = Publisher{flow, scenario.mtu};          // NOLINT(*-constant-array-index)
+        next_ns[index]    = (flow.node_id * 37000ULL) % 1000000ULL;  // NOLINT(*-constant-array-index)
+    }
+
+    std::uint64_t dropped_transfers = 0;
+    std::uint64_t now_ns            = 0;
+    while (now_ns < DurationNs)
+    {
+        // Publish whatever is due by now, and top up the saturating flows.
+        std::uint64_t next_publish_ns = Simulator::Never;
+        for (std::size_t index = 0; index < scenario.flows_count; ++index)
+        {
+            const Flow&       flow      = scenario.flows[index];  // NOLINT(*-constant-array-index)
+            Publisher&        publisher = publishers[index];      // NOLINT(*-constant-array-index)
+            const std::size_t node      = flow.node_id - 1U;
+            if (publisher.isSaturating())
+            {
+                while (publisher.publish(*simulator, node, now_ns))
+                {
+                }
+                continue;
+            }
+            std::uint64_t& due_ns = next_ns[index];  // NOLINT(*-constant-array-index)
+            if (due_ns <= now_ns)
+            {
+                dropped_transfers += publisher.publish(*simulator, node, now_ns) ? 0U : 1U;
+                due_ns += flow.period_us * 1000ULL;
+            }
+            next_publish_ns = (due_ns < next_publish_ns) ? due_ns : next_publish_ns;
+        }
+
+        const std::uint64_t next_event_ns = simulator->nextEventNs();
+        now_ns = (next_event_ns < next_publish_ns) ? next_event_ns : next_publish_ns;
+        simulator->advance(now_ns);
+
+        // Receivers are not modelled here.
+        Simulator::Frame frame{};
+        std::uint64_t    timestamp_ns = 0;
+        for (std::size_t node = 0; node < scenario.nodes; ++node)
+        {
+            while (simulator->pop(node, frame, timestamp_ns))
+            {
+            }
+        }
+    }
+
+    printBusStats(scenario.name, *simulator, now_ns, dropped_transfers);
+}
+
+// MARK: - Real time
+
+using Message    = uavcan::primitive::array::Natural8_1_0;
+using Publisher  = libcyphal::presentation::Publisher<Message>;
+using Subscriber = libcyphal::presentation::Subscriber<Message>;
+
+using bench::Header;
+using bench::monotonicNs;
+using bench::spin;
+
+std::uint64_t toNs(const libcyphal::TimePoint time_point)
+{
+    return static_cast<std::uint64_t>(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(time_point.time_since_epoch()).count());
+}
+
+/// The CAN node stack (without the application layer) attached to the simulated bus.
+///
+class MediaNode final
+{
+public:
+    MediaNode(platform::Linux::EpollSingleThreadedExecutor& executor,
+              platform::Linux::SimulatedCanBus&             bus,
+              const std::size_t                             mtu,
+              const std::uint16_t                           node_id)
+        : media_block_mr_{*cetl::pmr::new_delete_resource()}
+    {
+        const int bus_node = bus.attach();
+        if (bus_node < 0)
+        {
+            return;
+        }
+        media_.emplace(executor, bus, static_cast<std::size_t>(bus_node), media_block_mr_, mtu);
+        media_ifaces_[0] = &(media_.value());
+
+        auto maybe_transport = libcyphal::transport::can::makeTransport({*cetl::pmr::new_delete_resource()},
+                                                                        executor,
+                                                                        {media_ifaces_.data(), media_ifaces_.size()},
+                                                                        MediaTxQueueCapacity);
+        if (cetl::get_if<libcyphal::transport::FactoryFailure>(&maybe_transport) != nullptr)
+        {
+            return;
+        }
+        transport_ = cetl::get<libcyphal::UniquePtr<libcyphal::transport::can::ICanTransport>>(  //
+            std::move(maybe_transport));
+        (void) transport_->setLocalNodeId(node_id);
+
+        const std::size_t transport_mtu = transport_->getProtocolParams().mtu_bytes;
+        media_block_mr_.setup(MediaTxQueueCapacity * transport_mtu, transport_mtu, 1);
+
+        presentation_.emplace(*cetl::pmr::new_delete_resource(), executor, *transport_);
+    }
+
+    bool isReady() const noexcept
+    {
+        return presentation_.has_value();
+    }
+
+    libcyphal::presentation::Presentation& presentation()
+    {
+        return presentation_.value();
+    }
+
+private:
+    platform::BlockMemoryResource                                  media_block_mr_;
+    cetl::optional<platform::Linux::SimulatedCanMedia>             media_;
+    std::array<libcyphal::transport::can::IMedia*, 1>              media_ifaces_{};
+    libcyphal::UniquePtr<libcyphal::transport::can::ICanTransport> transport_;
+    cetl::optional<libcyphal::presentation::Presentation>          presentation_;
+
+};  // MediaNode
+
+bool runMediaScenario(const MediaScenario& scenario)
+{
+    platform::Linux::EpollSingleThreadedExecutor executor;
+    auto                                         simulator = std::make_unique<Simulator>(scenario.config);
+    platform::Linux::SimulatedCanBus             bus{executor, *simulator};
+
+    MediaNode publisher_node{executor, bus, scenario.mtu, 1};
+    MediaNode subscriber_node{executor, bus, scenario.mtu, 2};
+    if (!publisher_node.isReady() || !subscriber_node.isReady())
+    {
+        return false;
+    }
+
+    std::array<std::uint64_t, MediaMaxMessages> latencies_ns{};
+    std::size_t                                 delivered = 0;
+
+    auto maybe_sub = subscriber_node.presentation().makeSubscriber<Message>(MediaSubjectId);
+    auto maybe_pub = publisher_node.presentation().makePublisher<Message>(MediaSubjectId);
+    if (!cetl::holds_alternative<Subscriber>(maybe_sub) || !cetl::holds_alternative<Publisher>(maybe_pub))
+    {
+        return false;
+    }
+    auto subscriber = cetl::get<Subscriber>(std::move(maybe_sub));
+    auto publisher  = cetl::get<Publisher>(std::move(maybe_pub));
+    subscriber.setOnReceiveCallback([&latencies_ns, &delivered](const auto& arg) {
+        //
+        const std::uint64_t received_ns = monotonicNs();
+        Header              header{};
+        if ((arg.message.value.size() < sizeof(header)) || (delivered >= latencies_ns.size()))
+        {
+            return;
+        }
+        (void) std::memcpy(&header, arg.message.value.data(), sizeof(header));
+        latencies_ns[delivered++] = received_ns - header.sent_ns;  // NOLINT(*-constant-array-index)
+    });
+
+    Message message{Message::allocator_type{&publisher_node.presentation().memory()}};
+    message.value.resize(scenario.payload);
+
+    const std::uint64_t period_ns = 1000000000ULL / scenario.rate_hz;
+    const std::uint64_t messages  = std::min<std::uint64_t>(MediaDurationNs / period_ns, latencies_ns.size());
+    std::uint64_t       failures  = 0;
+    std::uint64_t       next_ns   = monotonicNs();
+    simulator->resetStats(toNs(executor.now()));
+    for (std::uint32_t seq = 0; seq < messages; ++seq)
+    {
+        for (std::uint64_t now = monotonicNs(); now < next_ns; now = monotonicNs())
+        {
+            spin(executor, next_ns - now);
+        }
+        next_ns += period_ns;
+
+        const Header header{monotonicNs(), seq};
+        (void) std::memcpy(message.value.data(), &header, sizeof(header));
+        failures += publisher.publish(executor.now() + std::chrono::seconds{1}, message).has_value() ? 1U : 0U;
+        spin(executor, 0);
+    }
+    std::uint64_t last_progress_ns = monotonicNs();
+    std::size_t   last_delivered   = delivered;
+    for (std::uint64_t now = last_progress_ns; (now - last_progress_ns) < MediaIdleNs; now = monotonicNs())
+    {
+        spin(executor, 10000000ULL);
+        if (delivered != last_delivered)
+        {
+            last_delivered   = delivered;
+            last_progress_ns = monotonicNs();
+        }
+    }
+
+    printBusStats(scenario.name, *simulator, toNs(executor.now()), failures);
+    const bench::Latencies latencies = bench::computeLatencies(latencies_ns.data(), delivered);
+    // NOLINTBEGIN(google-runtime-int)
+    (void) std::printf("  %llu of %llu messages delivered",
+                       static_cast<unsigned long long>(delivered),
+                       static_cast<unsigned long long>(messages));
+    if (delivered > 0)
+    {
+        (void) std::printf(", publish to receive latency p50 %.1f, p99 %.1f, max %.1f us",
+                           static_cast<double>(latencies.p50_ns) / 1e3,
+                           static_cast<double>(latencies.p99_ns) / 1e3,
+                           static_cast<double>(latencies.max_ns) / 1e3);
+    }
+    (void) std::printf("\n");
+    // NOLINTEND(google-runtime-int)
+    return delivered > 0;
+}
+
+}  // namespace
+
+int main()
+{
+    for (const auto& scenario : Scenarios)
+    {
+        runScenario(scenario);
+    }
+    int failed_scenarios = 0;
+    for (const auto& scenario : MediaScenarios)
+    {
+        if (!runMediaScenario(scenario))
+        {
+            (void) std::fprintf(stderr, "Scenario failed: %s\n", scenario.name);
+            ++failed_scenarios;
+        }
+    }
+    return (failed_scenarios == 0) ? 0 : 1;
+}
+
+// NOLINTEND(cppcoreguidelines-avoid-magic-numbers, readability-magic-numbers)
@@ -0,0 +1,282 @@
+// This software is distributed under the terms of the MIT License.
+// Copyright (C) OpenCyphal Development Team  <opencyphal.org>
+// Copyright Amazon.com Inc. or its affiliates.
+// SPDX-License-Identifier: MIT
+
+/// Measures multi-node CAN throughput and latency of the full libcyphal CAN stack over the unprivileged
+/// socket pair bus (see `SocketpairCanBus`), so unlike `vcan` it runs anywhere (f.e. on CI runners).
+///
+/// All nodes live in this process and share one epoll executor (together with the bus relay), so the run is
+/// reproducible. Node 0 publishes a fixed number of messages, and all other nodes subscribe to them.
+/// The benchmark sweeps number of nodes, payload size and rate, and prints one JSON object per line:
+///
+///   {"nodes":4,"payload":64,"rate_hz":1000,"sent":2000,"delivered":6000,"publish_failures":0,"bus_dropped":0,
+///    "throughput_msg_s":999.9,"latency_us":{"p50":..,"p99":..,"p999":..,"max":..},"cpu_us_per_msg":..}
+///
+/// Latency is from right before `publish` to the subscriber callback. Rate zero means "as fast as possible".
+
+#include "bench_common.hpp"
+#include "platform/block_memory_resource.hpp"
+#include "platform/linux/can/socketpair_can_media.hpp"
+#include "platform/linux/epoll_single_threaded_executor.hpp"
+
+#include <cetl/pf17/cetlpf.hpp>
+#include <libcyphal/presentation/presentation.hpp>
+#include <libcyphal/presentation/publisher.hpp>
+#include <libcyphal/presentation/subscriber.hpp>
+#include <libcyphal/transport/can/can_transport.hpp>
+#include <libcyphal/transport/can/can_transport_impl.hpp>
+#include <libcyphal/types.hpp>
+
+#include <uavcan/primitive/array/Natural8_1_0.hpp>
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <ctime>
+#include <utility>
+
+// NOLINTBEGIN(cppcoreguidelines-avoid-magic-numbers, readability-magic-numbers)
+
+namespace
+{
+
+using Message    = uavcan::primitive::array::Natural8_1_0;
+using Publisher  = libcyphal::presentation::Publisher<Message>;
+using Subscriber = libcyphal::presentation::Subscriber<Message>;
+
+using bench::clockNs;
+using bench::Header;
+using bench::monotonicNs;
+using bench::spin;
+
+constexpr std::size_t   MaxNodes        = 4;
+constexpr std::size_t   Messages        = 2000;
+constexpr std::uint16_t SubjectId       = 1000;
+constexpr std::size_t   TxQueueCapacity = 256;
+constexpr std::uint64_t IdleNs          = 200000000ULL;  // 0.2 s without deliveries ends the point
+
+constexpr std::array<std::size_t, 2>   NodeCounts{{2, 4}};
+constexpr std::array<std::size_t, 3>   Payloads{{16, 64, 256}};
+constexpr std::array<std::uint32_t, 2> Rates{{1000, 0}};
+
+std::array<std::uint64_t, Messages * (MaxNodes - 1)> s_latencies{};
+
+/// The CAN node stack (without the application layer) attached to the socket pair bus.
+///
+class BenchNode final
+{
+public:
+    BenchNode(platform::Linux::EpollSingleThreadedExecutor& executor,
+              platform::Linux::SocketpairCanBus&            bus,
+              const std::uint16_t                           node_id)
+        : media_block_mr_{*cetl::pmr::new_delete_resource()}
+    {
+        auto maybe_media = platform::Linux::SocketpairCanMedia::make(executor, bus.attach(), media_block_mr_);
+        if (auto* const media_ptr = cetl::get_if<platform::Linux::SocketpairCanMedia>(&maybe_media))
+        {
+            media_.emplace(std::move(*media_ptr));
+        }
+        else
+        {
+            return;
+        }
+        media_ifaces_[0] = &(media_.value());
+
+        auto maybe_transport = libcyphal::transport::can::makeTransport({*cetl::pmr::new_delete_resource()},
+                                                                        executor,
+                                                                        {media_ifaces_.data(), media_ifaces_.size()},
+                                                                        TxQueueCapacity);
+        if (cetl::get_if<libcyphal::transport::FactoryFailure>(&maybe_transport) != nullptr)
+        {
+            return;
+        }
+        transport_ = cetl::get<libcyphal::UniquePtr<libcyphal::transport::can::ICanTransport>>(  //
+            std::move(maybe_transport));
+        (void) transport_->setLocalNodeId(node_id);
+
+        const std::size_t mtu = transport_->getProtocolParams().mtu_bytes;
+        media_block_mr_.setup(TxQueueCapacity * mtu, mtu, 1);
+
+        presentation_.emplace(*cetl::pmr::new_delete_resource(), executor, *transport_);
+    }
+
+    bool isReady() const noexcept
+    {
+        return presentation_.has_value();
+    }
+
+    libcyphal::presentation::Presentation& presentation()
+    {
+        return presentation_.value();
+    }
+
+private:
+    platform::BlockMemoryResource                                  media_block_mr_;
+    cetl::optional<platform::Linux::SocketpairCanMedia>            media_;
+    std::array<libcyphal::transport::can::IMedia*, 1>              media_ifaces_{};
+    libcyphal::UniquePtr<libcyphal::transport::can::ICanTransport> transport_;
+    cetl::optional<libcyphal::presentation::Presentation>          presentation_;
+
+};  // BenchNode
+
+struct Point final
+{
+    std::size_t   nodes;
+    std::size_t   payload;
+    std::uint32_t rate_hz;
+};
+
+struct Result final
+{
+    std::uint64_t sent;
+    std::uint64_t delivered;
+    std::uint64_t failures;
+    std::uint64_t bus_dropped;
+    std::uint64_t cpu_ns;
+    std::uint64_t first_ns;
+    std::uint64_t last_ns;
+};
+
+bool runPoint(const Point& point, Result& result)
+{
+    platform::Linux::EpollSingleThreadedExecutor executor;
+    platform::Linux::SocketpairCanBus            bus{executor};
+
+    std::array<cetl::optional<BenchNode>, MaxNodes>  nodes{};
+    std::array<cetl::optional<Subscriber>, MaxNodes> subscribers{};
+    for (std::size_t index = 0; index < point.nodes; ++index)
+    {
+        auto& node = nodes[index];  // NOLINT(*-constant-array-index)
+        node.emplace(executor, bus, static_cast<std::uint16_t>(index + 1));
+        if (!node->isReady())
+        {
+            return false;
+        }
+        if (index == 0)
+        {
+            continue;  // The publisher.
+        }
+        auto maybe_sub = node->presentation().makeSubscriber<Message>(SubjectId);
+        if (!cetl::holds_alternative<Subscriber>(maybe_sub))
+        {
+            return false;
+        }
+        auto& subscriber = subscribers[index];  // NOLINT(*-constant-array-index)
+        subscriber.emplace(cetl::get<Subscriber>(std::move(maybe_sub)));
+        subscriber->setOnReceiveCallback([&result](const auto& arg) {
+            //
+            const std::uint64_t received_ns = monotonicNs();
+            Header              header{};
+            if ((arg.message.value.size() < sizeof(header)) || (result.delivered >= s_latencies.size()))
+            {
+                return;
+            }
+            (void) std::memcpy(&header, arg.message.value.data(), sizeof(header));
+            s_latencies[result.delivered++] = received_ns - header.sent_ns;  // NOLINT(*-constant-array-index)
+            result.first_ns                 = (result.first_ns == 0) ? received_ns : result.first_ns;
+            result.last_ns                  = received_ns;
+        });
+    }
+
+    auto maybe_pub = nodes[0]->presentation().makePublisher<Message>(SubjectId);
+    if (!cetl::holds_alternative<Publisher>(maybe_pub))
+    {
+        return false;
+    }
+    auto    publisher = cetl::get<Publisher>(std::move(maybe_pub));
+    Message message{Message::allocator_type{&nodes[0]->presentation().memory()}};
+    message.value.resize(point.payload);
+
+    const std::uint64_t period_ns   = (point.rate_hz > 0) ? (1000000000ULL / point.rate_hz) : 0;
+    const std::uint64_t cpu_started = clockNs(CLOCK_PROCESS_CPUTIME_ID);
+    std::uint64_t       next_ns     = monotonicNs();
+    for (std::uint32_t seq = 0; seq < Messages; ++seq)
+    {
+        for (std::uint64_t now = monotonicNs(); now < next_ns; now = monotonicNs())
+        {
+            spin(executor, next_ns - now);
+        }
+        next_ns += period_ns;
+
+        const Header header{monotonicNs(), seq};
+        (void) std::memcpy(message.value.data(), &header, sizeof(header));
+        if (publisher.publish(executor.now() + std::chrono::seconds{1}, message).has_value())
+        {
+            ++result.failures;
+        }
+        ++result.sent;
+        spin(executor, 0);
+    }
+    std::uint64_t last_progress_ns = monotonicNs();
+    std::uint64_t last_delivered   = result.delivered;
+    for (std::uint64_t now = last_progress_ns; (now - last_progress_ns) < IdleNs; now = monotonicNs())
+    {
+        spin(executor, 10000000ULL);
+        if (result.delivered != last_delivered)
+        {
+            last_delivered   = result.delivered;
+            last_progress_ns = monotonicNs();
+        }
+    }
+    result.cpu_ns      = clockNs(CLOCK_PROCESS_CPUTIME_ID) - cpu_started;
+    result.bus_dropped = bus.droppedFrames();
+    return true;
+}
+
+void printPoint(const Point& point, const Result& result)
+{
+    const bench::Latencies latencies = bench::computeLatencies(s_latencies.data(), result.delivered);
+
+    const std::uint64_t span_ns = result.last_ns - result.first_ns;
+    const double        per_sub = static_cast<double>(result.delivered) / static_cast<double>(point.nodes - 1);
+    const double        msg_s   = (span_ns > 0) ? (per_sub * 1e9 / static_cast<double>(span_ns)) : 0.0;
+    const double        cpu_us  = (result.sent > 0) ? (static_cast<double>(result.cpu_ns) / 1e3 / result.sent) : 0.0;
+
+    // NOLINTBEGIN(google-runtime-int)
+    (void) std::printf("{\"nodes\":%zu,\"payload\":%zu,\"rate_hz\":%u,\"sent\":%llu,\"delivered\":%llu,"
+                       "\"publish_failures\":%llu,\"bus_dropped\":%llu,\"throughput_msg_s\":%.1f,",
+                       point.nodes,
+                       point.payload,
+                       point.rate_hz,
+                       static_cast<unsigned long long>(result.sent),
+                       static_cast<unsigned long long>(result.delivered),
+                       static_cast<unsigned long long>(result.failures),
+                       static_cast<unsigned long long>(result.bus_dropped),
+                       msg_s);
+    // NOLINTEND(google-runtime-int)
+    bench::printLatencies(stdout, latencies);
+    (void) std::printf(",\"cpu_us_per_msg\":%.2f}\n", cpu_us);
+    (void) std::fflush(stdout);
+}
+
+}  // namespace
+
+int main()
+{
+    int failed_points = 0;
+    for (const auto nodes : NodeCounts)
+    {
+        for (const auto rate_hz : Rates)
+        {
+            for (const auto payload : Payloads)
+            {
+                const Point point{nodes, payload, rate_hz};
+                Result      result{};
+                if (!runPoint(point, result))
+                {
+                    (void) std::fprintf(stderr, "Point failed (nodes=%zu, payload=%zu).\n", nodes, payload);
+                    ++failed_points;
+                    continue;
+                }
+                printPoint(point, result);
+            }
+        }
+    }
+    return (failed_points == 0) ? 0 : 1;
+}
+
+// NOLINTEND(cppcoreguidelines-avoid-magic-numbers, readability-magic-numbers)
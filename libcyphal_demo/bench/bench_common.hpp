@@ -0,0 +1,102 @@
+// This software is distributed under the terms of the MIT License.
+// Copyright (C) OpenCyphal Development Team  <opencyphal.org>
+// Copyright Amazon.com Inc. or its affiliates.
+// SPDX-License-Identifier: MIT
+
+#ifndef BENCH_COMMON_HPP_INCLUDED
+#define BENCH_COMMON_HPP_INCLUDED
+
+#include "platform/linux/epoll_single_threaded_executor.hpp"
+
+#include <cetl/pf17/cetlpf.hpp>
+#include <libcyphal/types.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <ctime>
+
+// NOLINTBEGIN(cppcoreguidelines-avoid-magic-numbers, readability-magic-numbers)
+
+/// Scaffolding shared by the benchmarks which run the libcyphal stack on the epoll executor.
+///
+namespace bench
+{
+
+/// Prefix of each benchmark message payload.
+struct Header final
+{
+    std::uint64_t sent_ns;
+    std::uint32_t seq;
+};
+
+/// Latency distribution of the delivered messages.
+struct Latencies final
+{
+    std::uint64_t p50_ns;
+    std::uint64_t p99_ns;
+    std::uint64_t p999_ns;
+    std::uint64_t max_ns;
+};
+
+inline std::uint64_t clockNs(const clockid_t clock_id)
+{
+    timespec ts{};
+    (void) ::clock_gettime(clock_id, &ts);
+    return (static_cast<std::uint64_t>(ts.tv_sec) * 1000000000ULL) + static_cast<std::uint64_t>(ts.tv_nsec);
+}
+
+inline std::uint64_t monotonicNs()
+{
+    return clockNs(CLOCK_MONOTONIC);
+}
+
+/// Executes due callbacks, and then waits for I/O (or the next callback) for up to the given timeout.
+///
+inline void spin(platform::Linux::EpollSingleThreadedExecutor& executor, const std::uint64_t timeout_ns)
+{
+    const auto          spin_result = executor.spinOnce();
+    libcyphal::Duration timeout = std::chrono::duration_cast<libcyphal::Duration>(std::chrono::nanoseconds{timeout_ns});
+    if (spin_result.next_exec_time.has_value())
+    {
+        timeout = std::min(timeout, spin_result.next_exec_time.value() - executor.now());
+    }
+    (void) executor.pollAwaitableResourcesFor(cetl::make_optional(timeout));
+}
+
+/// Sorts the given latencies in place, and picks the percentiles; all zeros if there are none.
+///
+inline Latencies computeLatencies(std::uint64_t* const latencies_ns, const std::size_t count)
+{
+    if (count == 0)
+    {
+        return {};
+    }
+    // NOLINTBEGIN(*-pointer-arithmetic)
+    std::sort(latencies_ns, latencies_ns + count);
+    const auto percentile = [latencies_ns, count](const double q) {
+        return latencies_ns[static_cast<std::size_t>(q * static_cast<double>(count - 1))];
+    };
+    return {percentile(0.5), percentile(0.99), percentile(0.999), latencies_ns[count - 1]};
+    // NOLINTEND(*-pointer-arithmetic)
+}
+
+/// Prints the `"latency_us":{"p50":..,"p99":..,"p999":..,"max":..}` member of a JSON object (without separators).
+///
+inline void printLatencies(std::FILE* const out, const Latencies& latencies)
+{
+    (void) std::fprintf(out,
+                        "\"latency_us\":{\"p50\":%.1f,\"p99\":%.1f,\"p999\":%.1f,\"max\":%.1f}",
+                        static_cast<double>(latencies.p50_ns) / 1e3,
+                        static_cast<double>(latencies.p99_ns) / 1e3,
+                        static_cast<double>(latencies.p999_ns) / 1e3,
+                        static_cast<double>(latencies.max_ns) / 1e3);
+}
+
+}  // namespace bench
+
+// NOLINTEND(cppcoreguidelines-avoid-magic-numbers, readability-magic-numbers)
+
+#endif  // BENCH_COMMON_HPP_INCLUDED
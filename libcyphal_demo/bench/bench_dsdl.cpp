@@ -0,0 +1,264 @@
+// This software is distributed under the terms of the MIT License.
+// Copyright (C) OpenCyphal Development Team  <opencyphal.org>
+// Copyright Amazon.com Inc. or its affiliates.
+// SPDX-License-Identifier: MIT
+
+/// Measures the Nunavut-generated C++ (de)serialization of the types which the demos exchange most often:
+/// heartbeats, register access (string and array values), node info, UDRAL servo setpoint and readiness,
+/// and file reads.
+///
+/// Every type is serialized and deserialized in a loop, and one JSON object per type is printed:
+///
+///   {"lang":"c++","type":"uavcan.node.Heartbeat.1.0","bytes":7,
+///    "serialize":{"ns":..,"ns_per_byte":..},"deserialize":{"ns":..,"ns_per_byte":..}}
+///
+/// The same format is printed by the C counterpart (see `libudpard_demo/bench/bench_dsdl.c`), so the generated code
+/// of both languages could be compared directly. Every deserialization goes into a fresh object (as it happens
+/// for every received transfer), so the times include allocation of the variable-length arrays from O(1) heap.
+
+#include "platform/o1_heap_memory_resource.hpp"
+
+#include <cetl/pf17/cetlpf.hpp>
+
+#include <reg/udral/physics/dynamics/translation/Linear_0_1.hpp>
+#include <reg/udral/service/common/Readiness_0_1.hpp>
+#include <uavcan/_register/Access_1_0.hpp>
+#include <uavcan/file/Read_1_1.hpp>
+#include <uavcan/node/GetInfo_1_0.hpp>
+#include <uavcan/node/Health_1_0.hpp>
+#include <uavcan/node/Heartbeat_1_0.hpp>
+#include <uavcan/node/Mode_1_0.hpp>
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iterator>
+#include <limits>
+
+// NOLINTBEGIN(cppcoreguidelines-avoid-magic-numbers, readability-magic-numbers)
+
+namespace
+{
+
+using Clock = std::chrono::steady_clock;
+
+constexpr std::size_t BufferSize  = 1024;
+constexpr std::size_t Repetitions = 5;
+constexpr auto        MinBatch    = std::chrono::milliseconds{10};
+
+/// Keeps the compiler from discarding the (de)serialization results.
+template <typename T>
+inline void doNotOptimize(const T& value)
+{
+    asm volatile("" : : "g"(&value) : "memory");  // NOLINT(hicpp-no-assembler)
+}
+
+/// Runs the action in batches which take at least `MinBatch` each, and returns the best time of one action.
+///
+template <typename Action>
+double measureNs(Action&& action)
+{
+    std::size_t batch = 1;
+    for (;;)
+    {
+        const auto started = Clock::now();
+        for (std::size_t i = 0; i < batch; ++i)
+        {
+            action();
+        }
+        if ((Clock::now() - started) >= MinBatch)
+        {
+            break;
+        }
+        batch *= 2;
+    }
+
+    double best_ns = std::numeric_limits<double>::max();
+    for (std::size_t repetition = 0; repetition < Repetitions; ++repetition)
+    {
+        const auto started = Clock::now();
+        for (std::size_t i = 0; i < batch; ++i)
+        {
+            action();
+        }
+        const auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - started);
+        best_ns            = std::min(best_ns, static_cast<double>(elapsed.count()) / static_cast<double>(batch));
+    }
+    return best_ns;
+}
+
+class Bench final
+{
+public:
+    explicit Bench(cetl::pmr::memory_resource& memory)
+        : memory_{memory}
+    {
+    }
+
+    template <typename T>
+    typename T::allocator_type alloc() const
+    {
+        return typename T::allocator_type{&memory_};
+    }
+
+    template <typename T>
+    void run(const char* const type_name, const T& message)
+    {
+        static_assert(T::_traits_::SerializationBufferSizeBytes <= BufferSize, "Enlarge the buffer.");
+
+        const auto size_result = serialize(message, {buffer_.data(), buffer_.size()});
+        if (!size_result)
+        {
+            std::fprintf(stderr, "Failed to serialize %s\n", type_name);
+            std::exit(1);
+        }
+        const std::size_t size = size_result.value();
+
+        const double serialize_ns = measureNs([this, &message] {
+            //
+            const auto result = serialize(message, {buffer_.data(), buffer_.size()});
+            doNotOptimize(result);
+            doNotOptimize(buffer_);
+        });
+        const double deserialize_ns = measureNs([this, size] {
+            //
+            T          out{alloc<T>()};
+            const auto result = deserialize(out, {buffer_.data(), size});
+            doNotOptimize(result);
+            doNotOptimize(out);
+        });
+
+        const double bytes = static_cast<double>(std::max<std::size_t>(size, 1U));
+        std::printf("{\"lang\":\"c++\",\"type\":\"%s\",\"bytes\":%zu,"
+                    "\"serialize\":{\"ns\":%.1f,\"ns_per_byte\":%.2f},"
+                    "\"deserialize\":{\"ns\":%.1f,\"ns_per_byte\":%.2f}}\n",
+                    type_name,
+                    size,
+                    serialize_ns,
+                    serialize_ns / bytes,
+                    deserialize_ns,
+                    deserialize_ns / bytes);
+        (void) std::fflush(stdout);
+    }
+
+private:
+    cetl::pmr::memory_resource&          memory_;
+    std::array<std::uint8_t, BufferSize> buffer_{};
+
+};  // Bench
+
+template <typename Container>
+void fillText(Container& container, const char* const text)
+{
+    const std::size_t length = std::strlen(text);
+    std::copy(text, text + length, std::back_inserter(container));
+}
+
+}  // namespace
+
+int main()
+{
+    static std::array<cetl::byte, 64UL * 1024UL> heap_arena{};
+    platform::O1HeapMemoryResource              heap{heap_arena};
+    Bench                                       bench{heap};
+
+    {
+        uavcan::node::Heartbeat_1_0 message{bench.alloc<uavcan::node::Heartbeat_1_0>()};
+        message.uptime                      = 123456;
+        message.health.value                = uavcan::node::Health_1_0::NOMINAL;
+        message.mode.value                  = uavcan::node::Mode_1_0::OPERATIONAL;
+        message.vendor_specific_status_code = 0x5A;
+        bench.run("uavcan.node.Heartbeat.1.0", message);
+    }
+    {
+        using Request = uavcan::_register::Access_1_0::Request;
+        Request message{bench.alloc<Request>()};
+        fillText(message.name.name, "uavcan.node.description");
+        fillText(message.value.set_string().value, "Servo of the left aileron, installed in the wing bay.");
+        bench.run("uavcan.register.Access.1.0.Request/string", message);
+    }
+    {
+        using Response = uavcan::_register::Access_1_0::Response;
+        Response message{bench.alloc<Response>()};
+        message.timestamp.microsecond = 123456789;
+        fillText(message.value.set_string().value, "Servo of the left aileron, installed in the wing bay.");
+        bench.run("uavcan.register.Access.1.0.Response/string", message);
+    }
+    {
+        using Response = uavcan::_register::Access_1_0::Response;
+        Response message{bench.alloc<Response>()};
+        auto&    values = message.value.set_natural16().value;
+        for (std::uint16_t i = 0; i < 64; ++i)
+        {
+            values.push_back(static_cast<std::uint16_t>(i * 1000U));
+        }
+        bench.run("uavcan.register.Access.1.0.Response/natural16[64]", message);
+    }
+    {
+        using Response = uavcan::_register::Access_1_0::Response;
+        Response message{bench.alloc<Response>()};
+        auto&    values = message.value.set_real32().value;
+        for (std::size_t i = 0; i < 64; ++i)
+        {
+            values.push_back(static_cast<float>(i) * 0.25F);
+        }
+        bench.run("uavcan.register.Access.1.0.Response/real32[64]", message);
+    }
+    {
+        using Response = uavcan::node::GetInfo_1_0::Response;
+        Response message{bench.alloc<Response>()};
+        message.protocol_version.major   = 1;
+        message.software_version.major   = 1;
+        message.software_vcs_revision_id = 0x0123456789ABCDEFULL;
+        std::fill(message.unique_id.begin(), message.unique_id.end(), 0xA5);
+        fillText(message.name, "org.opencyphal.demos.libcyphal");
+        message.software_image_crc.push_back(0xFEDCBA9876543210ULL);
+        bench.run("uavcan.node.GetInfo.1.0.Response", message);
+    }
+    {
+        using Message = reg::udral::physics::dynamics::translation::Linear_0_1;
+        Message message{bench.alloc<Message>()};
+        message.kinematic.position.meter                           = 0.125F;
+        message.kinematic.velocity.meter_per_second                = 1.5F;
+        message.kinematic.acceleration.meter_per_second_per_second = -9.81F;
+        message.force.newton                                       = 42.0F;
+        bench.run("reg.udral.physics.dynamics.translation.Linear.0.1", message);
+    }
+    {
+        using Message = reg::udral::service::common::Readiness_0_1;
+        Message message{bench.alloc<Message>()};
+        message.value = Message::ENGAGED;
+        bench.run("reg.udral.service.common.Readiness.0.1", message);
+    }
+    {
+        using Request = uavcan::file::Read_1_1::Request;
+        Request message{bench.alloc<Request>()};
+        message.offset = 65536;
+        fillText(message.path.path, "firmware/org.opencyphal.demos.libcyphal.bin");
+        bench.run("uavcan.file.Read.1.1.Request", message);
+    }
+    {
+        using Response = uavcan::file::Read_1_1::Response;
+        Response message{bench.alloc<Response>()};
+        for (std::size_t i = 0; i < 256; ++i)
+        {
+            message.data.value.push_back(static_cast<std::uint8_t>(i));
+        }
+        bench.run("uavcan.file.Read.1.1.Response/256", message);
+    }
+
+    const auto diagnostics = heap.queryDiagnostics();
+    if (diagnostics.allocated != 0)
+    {
+        std::fprintf(stderr, "Leaked %zu bytes\n", diagnostics.allocated);
+        return 1;
+    }
+    return 0;
+}
+
+// NOLINTEND(cppcoreguidelines-avoid-magic-numbers, readability-magic-numbers)
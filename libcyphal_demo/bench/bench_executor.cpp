@@ -0,0 +1,376 @@
+// This software is distributed under the terms of the MIT License.
+// Copyright (C) OpenCyphal Development Team  <opencyphal.org>
+// Copyright Amazon.com Inc. or its affiliates.
+// SPDX-License-Identifier: MIT
+
+/// Microbenchmarks of `EpollSingleThreadedExecutor`, to see how its costs scale with the number of callbacks (N)
+/// and file descriptors (M), and to catch regressions. One JSON object per point is printed:
+///
+///   {"case":"register_remove","callbacks":64,"ns":..}     - register a callback and drop it, with N already in
+///   {"case":"reschedule","callbacks":64,"ns":..}          - move a scheduled callback to another time
+///   {"case":"spin_once_idle","callbacks":64,"ns":..}      - `spinOnce` with N registered but not scheduled callbacks
+///   {"case":"spin_once_pending","callbacks":64,"ns":..}   - `spinOnce` with N callbacks scheduled in the future
+///   {"case":"spin_once_due","callbacks":64,"ns_per_callback":..} - `spinOnce` executing N due (empty) callbacks
+///   {"case":"poll_drain","fds":64,"ready":17,"polls":2,"ns":..}  - poll and spin until all ready fds are handled
+///   {"case":"poll_wakeup","fds":64,"samples":1998,"latency_ns":{"p50":..,"p99":..,"max":..}}
+///                                                        - from `write` in another thread to the callback execution;
+///                                                          coalesced wakeups give fewer samples than the signals
+///
+/// The callbacks are not wrapped into the accounting slots (the time accounting and the hardware events counting stay
+/// disabled as by default in the demo), so the results show the bare executor costs.
+/// A poll takes at most `MaxEpollEvents` ready fds, so draining K ready fds takes `ceil(K / MaxEpollEvents)` polls.
+
+#include "platform/linux/epoll_single_threaded_executor.hpp"
+#include "platform/posix/posix_executor_extension.hpp"
+
+#include <cetl/pf17/cetlpf.hpp>
+#include <cetl/rtti.hpp>
+#include <libcyphal/executor.hpp>
+#include <libcyphal/types.hpp>
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <sys/eventfd.h>
+#include <thread>
+#include <unistd.h>
+#include <utility>
+#include <vector>
+
+// NOLINTBEGIN(cppcoreguidelines-avoid-magic-numbers, readability-magic-numbers)
+
+namespace
+{
+
+using Executor = platform::Linux::EpollSingleThreadedExecutor;
+using Callback = libcyphal::IExecutor::Callback;
+using Clock    = std::chrono::steady_clock;
+
+constexpr std::array<std::size_t, 7> CallbackCounts{{1, 16, 64, 65, 256, 1024, 4096}};
+constexpr std::array<std::size_t, 5> FdCounts{{1, 16, 64, 256, 512}};
+constexpr std::array<std::size_t, 5> ReadyCounts{{1, 16, 17, 64, 512}};
+
+constexpr std::size_t Operations       = 100000;
+constexpr std::size_t SpinRepetitions  = 1000;
+constexpr std::size_t DrainRepetitions = 1000;
+constexpr std::size_t WakeupSamples    = 2000;
+
+std::uint64_t nowNs()
+{
+    return static_cast<std::uint64_t>(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now().time_since_epoch()).count());
+}
+
+/// Registers N callbacks which do nothing.
+///
+std::vector<Callback::Any> registerCallbacks(Executor& executor, const std::size_t count)
+{
+    std::vector<Callback::Any> callbacks;
+    callbacks.reserve(count);
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        callbacks.push_back(executor.registerCallback([](const Callback::Arg&) {}));
+    }
+    return callbacks;
+}
+
+void benchRegisterRemove(const std::size_t count)
+{
+    Executor   executor;
+    const auto callbacks = registerCallbacks(executor, count);
+
+    const std::uint64_t started = nowNs();
+    for (std::size_t i = 0; i < Operations; ++i)
+    {
+        auto callback = executor.registerCallback([](const Callback::Arg&) {});
+        callback.reset();
+    }
+    const double ns = static_cast<double>(nowNs() - started) / static_cast<double>(Operations);
+    std::printf("{\"case\":\"register_remove\",\"callbacks\":%zu,\"ns\":%.1f}\n", count, ns);
+}
+
+void benchReschedule(const std::size_t count)
+{
+    Executor   executor;
+    auto       callbacks = registerCallbacks(executor, count);
+    const auto base      = executor.now() + std::chrono::hours{1};
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        (void) callbacks[i].schedule(Callback::Schedule::Once{base + std::chrono::microseconds(i)});
+    }
+
+    // Every callback jumps over a pseudo-random distance, so it lands at a different position in the queue.
+    std::uint32_t       lcg     = 1;
+    const std::uint64_t started = nowNs();
+    for (std::size_t i = 0; i < Operations; ++i)
+    {
+        lcg = (lcg * 1664525U) + 1013904223U;
+        const std::chrono::microseconds offset(lcg % (count * 2U));
+        (void) callbacks[i % count].schedule(Callback::Schedule::Once{base + offset});
+    }
+    const double ns = static_cast<double>(nowNs() - started) / static_cast<double>(Operations);
+    std::printf("{\"case\":\"reschedule\",\"callbacks\":%zu,\"ns\":%.1f}\n", count, ns);
+}
+
+void benchSpinOnce(const std::size_t count)
+{
+    Executor executor;
+    auto     callbacks = registerCallbacks(executor, count);
+
+    std::uint64_t started = nowNs();
+    for (std::size_t i = 0; i < Operations; ++i)
+    {
+        (void) executor.spinOnce();
+    }
+    double ns = static_cast<double>(nowNs() - started) / static_cast<double>(Operations);
+    std::printf("{\"case\":\"spin_once_idle\",\"callbacks\":%zu,\"ns\":%.1f}\n", count, ns);
+
+    const auto future = executor.now() + std::chrono::hours{1};
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        (void) callbacks[i].schedule(Callback::Schedule::Once{future + std::chrono::microseconds(i)});
+    }
+    started = nowNs();
+    for (std::size_t i = 0; i < Operations; ++i)
+    {
+        (void) executor.spinOnce();
+    }
+    ns = static_cast<double>(nowNs() - started) / static_cast<double>(Operations);
+    std::printf("{\"case\":\"spin_once_pending\",\"callbacks\":%zu,\"ns\":%.1f}\n", count, ns);
+
+    // Only the `spinOnce` is timed; the scheduling is measured by the `reschedule` case.
+    std::uint64_t spin_ns = 0;
+    for (std::size_t repetition = 0; repetition < SpinRepetitions; ++repetition)
+    {
+        const auto past = executor.now();
+        for (auto& callback : callbacks)
+        {
+            (void) callback.schedule(Callback::Schedule::Once{past});
+        }
+        started = nowNs();
+        (void) executor.spinOnce();
+        spin_ns += nowNs() - started;
+    }
+    ns = static_cast<double>(spin_ns) / static_cast<double>(SpinRepetitions * count);
+    std::printf("{\"case\":\"spin_once_due\",\"callbacks\":%zu,\"ns_per_callback\":%.1f}\n", count, ns);
+}
+
+/// Owns M eventfds, each with an awaitable callback which drains it.
+///
+class EventFds final
+{
+public:
+    EventFds(Executor& executor, const std::size_t count)
+    {
+        auto* const posix_executor_ext = cetl::rtti_cast<platform::posix::IPosixExecutorExtension*>(&executor);
+        using ReadableTrigger          = platform::posix::IPosixExecutorExtension::Trigger::Readable;
+
+        fds_.reserve(count);
+        callbacks_.reserve(count);
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            const int fd = ::eventfd(0, EFD_NONBLOCK);
+            if (fd < 0)
+            {
+                std::perror("eventfd");
+                break;
+            }
+            fds_.push_back(fd);
+            callbacks_.push_back(posix_executor_ext->registerAwaitableCallback(
+                [this, fd](const Callback::Arg&) {
+                    //
+                    std::uint64_t value = 0;
+                    (void) ::read(fd, &value, sizeof(value));
+                    ++handled_;
+                    const std::uint64_t sent_ns = sent_ns_.load(std::memory_order_acquire);
+                    if (sent_ns != 0)
+                    {
+                        last_latency_ns_ = nowNs() - sent_ns;
+                    }
+                },
+                ReadableTrigger{fd}));
+        }
+    }
+
+    ~EventFds()
+    {
+        callbacks_.clear();
+        for (const int fd : fds_)
+        {
+            (void) ::close(fd);
+        }
+    }
+
+    EventFds(const EventFds&)                = delete;
+    EventFds(EventFds&&) noexcept            = delete;
+    EventFds& operator=(const EventFds&)     = delete;
+    EventFds& operator=(EventFds&&) noexcept = delete;
+
+    std::size_t size() const noexcept
+    {
+        return fds_.size();
+    }
+
+    void signal(const std::size_t index, const bool stamp = false)
+    {
+        if (stamp)
+        {
+            sent_ns_.store(nowNs(), std::memory_order_release);
+        }
+        const std::uint64_t value = 1;
+        (void) ::write(fds_[index], &value, sizeof(value));
+    }
+
+    std::size_t handled() const noexcept
+    {
+        return handled_;
+    }
+
+    std::uint64_t takeLatencyNs() noexcept
+    {
+        return std::exchange(last_latency_ns_, 0);
+    }
+
+private:
+    std::vector<int>           fds_;
+    std::vector<Callback::Any> callbacks_;
+    std::size_t                handled_{0};
+    std::atomic<std::uint64_t> sent_ns_{0};
+    std::uint64_t              last_latency_ns_{0};
+
+};  // EventFds
+
+void benchPollDrain(const std::size_t fd_count, const std::size_t ready_count)
+{
+    Executor executor;
+    EventFds fds{executor, fd_count};
+    if (fds.size() < fd_count)
+    {
+        return;
+    }
+
+    std::uint64_t total_ns    = 0;
+    std::uint64_t total_polls = 0;
+    for (std::size_t repetition = 0; repetition < DrainRepetitions; ++repetition)
+    {
+        // The ready fds are spread over all registered ones.
+        for (std::size_t i = 0; i < ready_count; ++i)
+        {
+            fds.signal((i * fd_count) / ready_count);
+        }
+        const std::size_t   expected = fds.handled() + ready_count;
+        const std::uint64_t started  = nowNs();
+        while (fds.handled() < expected)
+        {
+            (void) executor.pollAwaitableResourcesFor(cetl::make_optional(libcyphal::Duration::zero()));
+            (void) executor.spinOnce();
+            ++total_polls;
+        }
+        total_ns += nowNs() - started;
+    }
+    std::printf("{\"case\":\"poll_drain\",\"fds\":%zu,\"ready\":%zu,\"polls\":%.1f,\"ns\":%.1f}\n",
+                fd_count,
+                ready_count,
+                static_cast<double>(total_polls) / static_cast<double>(DrainRepetitions),
+                static_cast<double>(total_ns) / static_cast<double>(DrainRepetitions));
+}
+
+void benchPollWakeup(const std::size_t fd_count)
+{
+    Executor executor;
+    EventFds fds{executor, fd_count};
+    if (fds.size() < fd_count)
+    {
+        return;
+    }
+
+    std::atomic<bool> done{false};
+    std::atomic<bool> is_signalled_all{false};
+    std::thread       signaller{[&fds, &done, &is_signalled_all, fd_count] {
+        for (std::size_t i = 0; (i < WakeupSamples) && !done.load(); ++i)
+        {
+            std::this_thread::sleep_for(std::chrono::microseconds{200});
+            fds.signal(i % fd_count, true);
+        }
+        is_signalled_all = true;
+    }};
+
+    // The eventfd wakeups may coalesce (certainly so with a single fd), so fewer samples than signals are expected;
+    // the polling ends once the signaller has finished and a poll has timed out with nothing ready.
+    std::vector<std::uint64_t> latencies;
+    latencies.reserve(WakeupSamples);
+    while (true)
+    {
+        const bool        is_last_poll   = is_signalled_all.load();
+        const std::size_t handled_before = fds.handled();
+        const auto        poll_failure   = executor.pollAwaitableResourcesFor(cetl::make_optional(
+            std::chrono::duration_cast<libcyphal::Duration>(std::chrono::milliseconds{100})));
+        if (poll_failure)
+        {
+            break;
+        }
+        (void) executor.spinOnce();
+        if (const std::uint64_t latency_ns = fds.takeLatencyNs())
+        {
+            latencies.push_back(latency_ns);
+        }
+        if (is_last_poll && (fds.handled() == handled_before))
+        {
+            break;
+        }
+    }
+    done = true;
+    signaller.join();
+    if (latencies.empty())
+    {
+        return;
+    }
+
+    std::sort(latencies.begin(), latencies.end());
+    const auto quantile = [&latencies](const double q) {
+        const auto rank = static_cast<std::size_t>(q * static_cast<double>(latencies.size() - 1));
+        return latencies[rank];
+    };
+    std::printf("{\"case\":\"poll_wakeup\",\"fds\":%zu,\"samples\":%zu,"
+                "\"latency_ns\":{\"p50\":%llu,\"p99\":%llu,\"max\":%llu}}\n",
+                fd_count,
+                latencies.size(),
+                static_cast<unsigned long long>(quantile(0.5)),   // NOLINT(google-runtime-int)
+                static_cast<unsigned long long>(quantile(0.99)),  // NOLINT(google-runtime-int)
+                static_cast<unsigned long long>(latencies.back()));
+}
+
+}  // namespace
+
+int main()
+{
+    std::printf("{\"max_accounted_callbacks\":%zu,\"max_epoll_events\":%d}\n",
+                Executor::MaxAccountedCallbacks,
+                Executor::MaxEpollEvents);
+    for (const auto count : CallbackCounts)
+    {
+        benchRegisterRemove(count);
+        benchReschedule(count);
+        benchSpinOnce(count);
+        (void) std::fflush(stdout);
+    }
+    for (const auto fd_count : FdCounts)
+    {
+        for (const auto ready_count : ReadyCounts)
+        {
+            if (ready_count <= fd_count)
+            {
+                benchPollDrain(fd_count, ready_count);
+            }
+        }
+        benchPollWakeup(fd_count);
+        (void) std::fflush(stdout);
+    }
+    return 0;
+}
+
+// NOLINTEND(cppcoreguidelines-avoid-magic-numbers, readability-magic-numbers)
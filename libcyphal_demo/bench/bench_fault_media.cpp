@@ -0,0 +1,361 @@
+// This software is distributed under the terms of the MIT License.
+// Copyright (C) OpenCyphal Development Team  <opencyphal.org>
+// Copyright Amazon.com Inc. or its affiliates.
+// SPDX-License-Identifier: MIT
+
+/// Checks the fault-injecting CAN media decorator (see `FaultyCanMedia` and `FaultInjector`), and measures its cost.
+///
+/// Two socket pair media (see `SocketpairCanBus`) share one epoll executor, and both are decorated with the same
+/// injector (as in the demo). The sender pushes numbered frames at a fixed rate, and the receiver pops them from
+/// its pop callback. Each scenario enables one kind of fault at a time, so that the observed effect
+/// can be attributed to it and compared with the number of injected faults:
+///
+///   - loss and duplicate must be observed exactly as many times as injected;
+///   - reorder and delay are observed at most as many times (a frame held until the next one, which is also held,
+///     is released in order), and the delayed frames must not arrive earlier than the configured delay;
+///   - corrupt must be observed exactly as many times (each frame carries its sequence number and its complement);
+///   - TX-full is observed as the retries of the sender.
+///
+/// One JSON object per scenario is printed:
+///
+///   {"scenario":"delay","permille":100,"sent":2000,"delivered":2000,"injected":200,"observed":196,
+///    "tx_retries":0,"delay_us":{"min":..,"max":..},"cpu_ns_per_frame":..,"ok":true}
+///
+/// The exit code is non-zero if any scenario doesn't match its expectations.
+
+#include "bench_common.hpp"
+#include "platform/fault_injector.hpp"
+#include "platform/linux/can/faulty_can_media.hpp"
+#include "platform/linux/can/socketpair_can_media.hpp"
+#include "platform/linux/epoll_single_threaded_executor.hpp"
+
+#include <canard.h>
+#include <cetl/pf17/cetlpf.hpp>
+#include <libcyphal/transport/can/media.hpp>
+#include <libcyphal/transport/media_payload.hpp>
+#include <libcyphal/types.hpp>
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <ctime>
+
+// NOLINTBEGIN(cppcoreguidelines-avoid-magic-numbers, readability-magic-numbers)
+
+namespace
+{
+
+using platform::FaultInjector;
+using IMedia = libcyphal::transport::can::IMedia;
+
+using bench::clockNs;
+using bench::monotonicNs;
+using bench::spin;
+
+constexpr std::uint32_t Frames     = 2000;
+constexpr std::uint64_t PeriodNs   = 500000ULL;     // 2 kHz - only a few delayed frames are held at once
+constexpr std::uint64_t IdleNs     = 200000000ULL;  // 0.2 s without deliveries (after the delay) ends the scenario
+constexpr std::uint16_t Permille   = 100;
+constexpr std::uint16_t DelayMs    = 20;
+constexpr std::uint64_t DelayNs    = DelayMs * 1000000ULL;
+constexpr std::uint32_t FrameCanId = 0x107D5501UL;
+
+struct Scenario final
+{
+    const char*         name;
+    FaultInjector::Kind kind;  ///< `KindCount` means that the decorator passes everything through.
+};
+
+constexpr std::array<Scenario, 7> Scenarios{{
+    {"none", FaultInjector::KindCount},
+    {"loss", FaultInjector::Loss},
+    {"duplicate", FaultInjector::Duplicate},
+    {"reorder", FaultInjector::Reorder},
+    {"delay", FaultInjector::Delay},
+    {"corrupt", FaultInjector::Corrupt},
+    {"tx_full", FaultInjector::TxFull},
+}};
+
+/// Payload of each frame.
+struct Frame final
+{
+    std::uint32_t seq;
+    std::uint32_t seq_complement;
+};
+
+struct Result final
+{
+    std::uint64_t sent;
+    std::uint64_t delivered;
+    std::uint64_t tx_retries;
+    std::uint64_t lost;
+    std::uint64_t duplicated;
+    std::uint64_t reordered;
+    std::uint64_t delayed;
+    std::uint64_t corrupted;
+    std::uint64_t min_delay_ns;
+    std::uint64_t max_delay_ns;
+    std::uint64_t cpu_ns;
+    std::uint64_t injected;
+};
+
+std::array<std::uint64_t, Frames> s_sent_ns{};
+std::array<std::uint8_t, Frames>  s_received{};
+
+/// Accounts one popped frame.
+void onFrame(const cetl::span<const cetl::byte> payload, Result& result, std::uint32_t& max_seq)
+{
+    const std::uint64_t received_ns = monotonicNs();
+    Frame               frame{};
+    if (payload.size() < sizeof(frame))
+    {
+        ++result.corrupted;
+        return;
+    }
+    (void) std::memcpy(&frame, payload.data(), sizeof(frame));
+    if ((frame.seq_complement != ~frame.seq) || (frame.seq >= Frames))
+    {
+        ++result.corrupted;
+        return;
+    }
+    ++result.delivered;
+
+    auto& received = s_received[frame.seq];  // NOLINT(*-constant-array-index)
+    if (received > 0)
+    {
+        ++result.duplicated;
+    }
+    received = static_cast<std::uint8_t>(std::min(received + 1, 255));
+
+    if ((result.delivered > 1) && (frame.seq < max_seq))
+    {
+        ++result.reordered;
+    }
+    max_seq = std::max(max_seq, frame.seq);
+
+    const std::uint64_t latency_ns = received_ns - s_sent_ns[frame.seq];  // NOLINT(*-constant-array-index)
+    if (latency_ns >= (DelayNs / 2U))
+    {
+        ++result.delayed;
+        result.min_delay_ns = (result.min_delay_ns == 0) ? latency_ns : std::min(result.min_delay_ns, latency_ns);
+        result.max_delay_ns = std::max(result.max_delay_ns, latency_ns);
+    }
+}
+
+/// Pushes one frame, retrying while the (decorated) media rejects it as if it was full.
+bool pushFrame(platform::Linux::EpollSingleThreadedExecutor& executor,
+               IMedia&                                       media,
+               const std::uint32_t                           seq,
+               Result&                                       result)
+{
+    const Frame frame{seq, ~seq};
+    for (;;)
+    {
+        auto&       mr   = media.getTxMemoryResource();
+        auto* const data = static_cast<cetl::byte*>(mr.allocate(sizeof(frame)));
+        if (data == nullptr)
+        {
+            return false;
+        }
+        (void) std::memcpy(data, &frame, sizeof(frame));
+        libcyphal::transport::MediaPayload payload{sizeof(frame), data, sizeof(frame), &mr};
+
+        s_sent_ns[seq] = monotonicNs();  // NOLINT(*-constant-array-index)
+
+        const auto        push_result = media.push(executor.now() + std::chrono::seconds{1}, FrameCanId, payload);
+        const auto* const success     = cetl::get_if<IMedia::PushResult::Success>(&push_result);
+        if (success == nullptr)
+        {
+            return false;
+        }
+        if (success->is_accepted)
+        {
+            return true;
+        }
+        ++result.tx_retries;
+        spin(executor, 0);
+    }
+}
+
+bool runScenario(const Scenario& scenario, Result& result)
+{
+    s_received.fill(0);
+
+    FaultInjector::Params params{{}, DelayMs, 1};
+    if (scenario.kind != FaultInjector::KindCount)
+    {
+        params.permille[scenario.kind] = Permille;  // NOLINT(*-constant-array-index)
+    }
+    FaultInjector injector{params};
+
+    platform::Linux::EpollSingleThreadedExecutor executor;
+    platform::Linux::SocketpairCanBus            bus{executor};
+
+    auto& memory   = *cetl::pmr::new_delete_resource();
+    auto  maybe_tx = platform::Linux::SocketpairCanMedia::make(executor, bus.attach(), memory);
+    auto  maybe_rx = platform::Linux::SocketpairCanMedia::make(executor, bus.attach(), memory);
+
+    auto* const tx_inner = cetl::get_if<platform::Linux::SocketpairCanMedia>(&maybe_tx);
+    auto* const rx_inner = cetl::get_if<platform::Linux::SocketpairCanMedia>(&maybe_rx);
+    if ((tx_inner == nullptr) || (rx_inner == nullptr))
+    {
+        return false;
+    }
+    platform::Linux::FaultyCanMedia tx_faulty{*tx_inner, executor, injector};
+    platform::Linux::FaultyCanMedia rx_faulty{*rx_inner, executor, injector};
+    IMedia&                         tx = tx_faulty;
+    IMedia&                         rx = rx_faulty;
+
+    std::uint32_t max_seq     = 0;
+    auto          rx_callback = rx.registerPopCallback([&](const auto&) {
+        //
+        std::array<cetl::byte, CANARD_MTU_MAX> buffer{};
+        const auto                             pop_result = rx.pop({buffer.data(), buffer.size()});
+        const auto* const                      success    = cetl::get_if<IMedia::PopResult::Success>(&pop_result);
+        if ((success != nullptr) && success->has_value())
+        {
+            onFrame({buffer.data(), std::min(success->value().payload_size, buffer.size())}, result, max_seq);
+        }
+    });
+    if (!rx_callback.has_value())
+    {
+        return false;
+    }
+
+    const std::uint64_t cpu_started = clockNs(CLOCK_PROCESS_CPUTIME_ID);
+    std::uint64_t       next_ns     = monotonicNs();
+    for (std::uint32_t seq = 0; seq < Frames; ++seq)
+    {
+        for (std::uint64_t now = monotonicNs(); now < next_ns; now = monotonicNs())
+        {
+            spin(executor, next_ns - now);
+        }
+        next_ns += PeriodNs;
+
+        if (!pushFrame(executor, tx, seq, result))
+        {
+            return false;
+        }
+        ++result.sent;
+        spin(executor, 0);
+    }
+    std::uint64_t last_progress_ns = monotonicNs();
+    std::uint64_t last_delivered   = result.delivered;
+    const auto    idle_ns          = IdleNs + DelayNs;
+    for (std::uint64_t now = last_progress_ns; (now - last_progress_ns) < idle_ns; now = monotonicNs())
+    {
+        spin(executor, 10000000ULL);
+        if (result.delivered != last_delivered)
+        {
+            last_delivered   = result.delivered;
+            last_progress_ns = monotonicNs();
+        }
+    }
+    result.cpu_ns = clockNs(CLOCK_PROCESS_CPUTIME_ID) - cpu_started;
+
+    for (const auto received : s_received)
+    {
+        result.lost += (received == 0) ? 1U : 0U;
+    }
+    result.injected = (scenario.kind != FaultInjector::KindCount) ? injector.injectedCounts()[scenario.kind] : 0U;
+    return true;
+}
+
+/// Gets the number of the observed faults of the scenario kind.
+std::uint64_t observed(const Scenario& scenario, const Result& result)
+{
+    switch (scenario.kind)
+    {
+    case FaultInjector::Loss:
+        return result.lost;
+    case FaultInjector::Duplicate:
+        return result.duplicated;
+    case FaultInjector::Reorder:
+        return result.reordered;
+    case FaultInjector::Delay:
+        return result.delayed;
+    case FaultInjector::Corrupt:
+        return result.corrupted;
+    case FaultInjector::TxFull:
+        return result.tx_retries;
+    case FaultInjector::KindCount:
+        return result.lost + result.duplicated + result.reordered + result.delayed + result.corrupted;
+    }
+    return 0;
+}
+
+/// Checks the observed effect of the scenario against the injected faults (see the file header).
+bool isExpected(const Scenario& scenario, const Result& result)
+{
+    const std::uint64_t count = observed(scenario, result);
+    switch (scenario.kind)
+    {
+    case FaultInjector::KindCount:
+        return count == 0;
+    case FaultInjector::Reorder:
+        // The last frame, if held until the next one, is never released.
+        return (result.injected > 0) && (count <= result.injected) && (result.lost <= 1);
+    case FaultInjector::Delay:
+        return (result.injected > 0) && (count <= result.injected) && (result.lost == 0) &&
+               (result.min_delay_ns >= DelayNs);
+    case FaultInjector::Corrupt:
+        // A corrupted frame can't be attributed to its sequence number, so it's also counted as lost.
+        return (result.injected > 0) && (count == result.injected) && (result.lost == count);
+    case FaultInjector::Loss:
+    case FaultInjector::Duplicate:
+    case FaultInjector::TxFull:
+        return (result.injected > 0) && (count == result.injected);
+    }
+    return false;
+}
+
+void printScenario(const Scenario& scenario, const Result& result, const bool ok)
+{
+    const double cpu_ns = (result.sent > 0) ? (static_cast<double>(result.cpu_ns) / static_cast<double>(result.sent))
+                                            : 0.0;
+
+    // NOLINTBEGIN(google-runtime-int)
+    (void) std::printf("{\"scenario\":\"%s\",\"permille\":%u,\"sent\":%llu,\"delivered\":%llu,\"injected\":%llu,"
+                       "\"observed\":%llu,\"tx_retries\":%llu,\"delay_us\":{\"min\":%.1f,\"max\":%.1f},"
+                       "\"cpu_ns_per_frame\":%.1f,\"ok\":%s}\n",
+                       scenario.name,
+                       (scenario.kind != FaultInjector::KindCount) ? Permille : 0U,
+                       static_cast<unsigned long long>(result.sent),
+                       static_cast<unsigned long long>(result.delivered),
+                       static_cast<unsigned long long>(result.injected),
+                       static_cast<unsigned long long>(observed(scenario, result)),
+                       static_cast<unsigned long long>(result.tx_retries),
+                       static_cast<double>(result.min_delay_ns) / 1e3,
+                       static_cast<double>(result.max_delay_ns) / 1e3,
+                       cpu_ns,
+                       ok ? "true" : "false");
+    // NOLINTEND(google-runtime-int)
+    (void) std::fflush(stdout);
+}
+
+}  // namespace
+
+int main()
+{
+    int failed_scenarios = 0;
+    for (const auto& scenario : Scenarios)
+    {
+        Result result{};
+        if (!runScenario(scenario, result))
+        {
+            (void) std::fprintf(stderr, "Scenario '%s' failed to run.\n", scenario.name);
+            ++failed_scenarios;
+            continue;
+        }
+        const bool ok = isExpected(scenario, result);
+        printScenario(scenario, result, ok);
+        failed_scenarios += ok ? 0 : 1;
+    }
+    return (failed_scenarios == 0) ? 0 : 1;
+}
+
+// NOLINTEND(cppcoreguidelines-avoid-magic-numbers, readability-magic-numbers)
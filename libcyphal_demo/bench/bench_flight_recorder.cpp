@@ -0,0 +1,60 @@
+// This software is distributed under the terms of the MIT License.
+// Copyright (C) OpenCyphal Development Team  <opencyphal.org>
+// Copyright Amazon.com Inc. or its affiliates.
+// SPDX-License-Identifier: MIT
+
+/// Measures per-event cost of the flight recorder (the same ring capacity as the demo uses),
+/// and the time of a full ring dump to a file.
+
+#include "platform/flight_recorder.hpp"
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <unistd.h>
+
+// NOLINTBEGIN(cppcoreguidelines-avoid-magic-numbers, readability-magic-numbers)
+
+namespace
+{
+
+constexpr std::uint64_t Iterations = 10000000;
+constexpr std::size_t   Capacity   = 1024;
+
+std::array<platform::FlightRecorder::Event, Capacity> s_events{};
+
+}  // namespace
+
+int main()
+{
+    platform::FlightRecorder recorder{s_events};
+
+    const auto started = std::chrono::steady_clock::now();
+    for (std::uint64_t i = 0; i < Iterations; ++i)
+    {
+        recorder.record(platform::FlightRecorder::EventType::CanTx, 3, static_cast<std::uint32_t>(i), 8);
+    }
+    const auto elapsed = std::chrono::steady_clock::now() - started;
+    (void) std::printf("record          : %6.2f ns/event\n",
+                       static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count()) /
+                           static_cast<double>(Iterations));
+
+    char path[64];  // NOLINT
+    (void) std::snprintf(path, sizeof(path), "/tmp/bench_flight_recorder.%d.txt", static_cast<int>(::getpid()));
+
+    const auto dump_started = std::chrono::steady_clock::now();
+    const int  err          = recorder.dumpTo(path);
+    const auto dump_elapsed = std::chrono::duration_cast<std::chrono::microseconds>(  //
+        std::chrono::steady_clock::now() - dump_started);
+    (void) ::unlink(path);
+    if (err != 0)
+    {
+        (void) std::fprintf(stderr, "Failed to dump (err=%d).\n", err);
+        return 1;
+    }
+    (void) std::printf("dump (%zu events): %6.2f ms\n", Capacity, static_cast<double>(dump_elapsed.count()) / 1000.0);
+    return 0;
+}
+
+// NOLINTEND(cppcoreguidelines-avoid-magic-numbers, readability-magic-numbers)
@@ -0,0 +1,333 @@
+// This software is distributed under the terms of the MIT License.
+// Copyright (C) OpenCyphal Development Team  <opencyphal.org>
+// Copyright Amazon.com Inc. or its affiliates.
+// SPDX-License-Identifier: MIT
+
+/// Compares CPU cost and loop lateness of different builds of the demo node under the same recorded traffic.
+///
+/// Usage: bench_replay <capture_file> <speed> <iface> <demo_binary>...
+///
+/// The capture is taken by a node with the `demo.capture.file` register set (see `capture.h`), and replayed
+/// with `CaptureReplayer` at the given speed (see `capture_replay` tool). The iface is a local IPv4 address
+/// (then the nodes run Cyphal/UDP) or a SocketCAN interface name (then the nodes run Cyphal/CAN).
+/// Each binary is started in its own temporary root directory with the statistics page enabled (via environment),
+/// and measured while the capture is being replayed into it. One JSON object per binary is printed:
+///
+///   {"binary":"build-a/demo","records":12000,"replay_ms":1000.2,"replay_max_lag_us":35,"cpu_ms":41.3,
+///    "cpu_us_per_record":3.44,"loop_iterations":10150,"ctx_switches":10180,
+///    "lateness_us":{"p50":3,"p99":17,"max":240},"max_rss_kb":5120}
+///
+/// The lateness percentiles come from sampling the `loop.last_lateness_us` counter every millisecond
+/// (so they are approximate), and the maximum is `loop.worst_lateness_us` if it has grown during the replay.
+
+#include "platform/linux/capture_replayer.hpp"
+#include "platform/posix/shm_stats_page.hpp"
+
+#include "udp.h"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fcntl.h>
+#include <ftw.h>
+#include <signal.h>
+#include <string>
+#include <sys/mman.h>
+#include <sys/wait.h>
+#include <thread>
+#include <unistd.h>
+
+// NOLINTBEGIN(cppcoreguidelines-avoid-magic-numbers, readability-magic-numbers)
+
+namespace
+{
+
+using platform::Linux::CaptureReplayer;
+using platform::posix::ShmStatsPageReader;
+
+constexpr unsigned StartupTimeoutMs = 5000;
+constexpr unsigned WarmupMs         = 1000;
+constexpr unsigned SamplePeriodUs   = 1000;
+constexpr unsigned LatenessBuckets  = 32;  // log2 of microseconds
+
+/// Counters of the node process taken from `/proc/<pid>/...`.
+struct ProcSample
+{
+    std::uint64_t cpu_ns;
+    std::uint64_t ctx_switches;
+    std::uint64_t max_rss_kb;
+};
+
+struct RunResult
+{
+    CaptureReplayer::Stats replay;
+    std::uint64_t          cpu_ns;
+    std::uint64_t          ctx_switches;
+    std::uint64_t          max_rss_kb;
+    std::uint64_t          loop_iterations;
+    std::uint64_t          lateness_p50_us;
+    std::uint64_t          lateness_p99_us;
+    std::uint64_t          lateness_max_us;
+};
+
+ProcSample sampleProc(const pid_t pid)
+{
+    ProcSample sample{};
+    char       path[64];
+    // The on-CPU time in nanoseconds is the first field (much finer than the clock ticks of `/proc/<pid>/stat`).
+    (void) std::snprintf(path, sizeof(path), "/proc/%d/schedstat", static_cast<int>(pid));
+    if (std::FILE* const file = std::fopen(path, "r"))
+    {
+        unsigned long long cpu_ns = 0;  // NOLINT(google-runtime-int)
+        if (std::fscanf(file, "%llu", &cpu_ns) == 1)
+        {
+            sample.cpu_ns = cpu_ns;
+        }
+        (void) std::fclose(file);
+    }
+    (void) std::snprintf(path, sizeof(path), "/proc/%d/status", static_cast<int>(pid));
+    if (std::FILE* const file = std::fopen(path, "r"))
+    {
+        std::array<char, 256> line{};
+        while (std::fgets(line.data(), static_cast<int>(line.size()), file) != nullptr)
+        {
+            unsigned long value = 0;  // NOLINT(google-runtime-int)
+            if ((std::sscanf(line.data(), "voluntary_ctxt_switches: %lu", &value) == 1) ||
+                (std::sscanf(line.data(), "nonvoluntary_ctxt_switches: %lu", &value) == 1))
+            {
+                sample.ctx_switches += value;
+            }
+            else if (std::sscanf(line.data(), "VmHWM: %lu", &value) == 1)
+            {
+                sample.max_rss_kb = value;
+            }
+        }
+        (void) std::fclose(file);
+    }
+    return sample;
+}
+
+bool readCounter(const ShmStatsPageReader& reader, const char* const name, std::uint64_t& out_value)
+{
+    ShmStatsPageReader::Snapshot snapshot{};
+    if (!reader.read(snapshot))
+    {
+        return false;
+    }
+    for (std::size_t i = 0; i < snapshot.counters_count; ++i)
+    {
+        if (std::strcmp(snapshot.names[i].data(), name) == 0)  // NOLINT(*-constant-array-index)
+        {
+            out_value = snapshot.values[i];  // NOLINT(*-constant-array-index)
+            return true;
+        }
+    }
+    return false;
+}
+
+std::uint64_t quantile(const std::array<std::uint64_t, LatenessBuckets>& histogram, const double q)
+{
+    std::uint64_t total = 0;
+    for (const auto count : histogram)
+    {
+        total += count;
+    }
+    if (total == 0)
+    {
+        return 0;
+    }
+    const auto    rank = std::min(static_cast<std::uint64_t>(q * static_cast<double>(total)), total - 1U);
+    std::uint64_t seen = 0;
+    for (std::size_t bucket = 0; bucket < histogram.size(); ++bucket)
+    {
+        seen += histogram[bucket];  // NOLINT(*-constant-array-index)
+        if (seen > rank)
+        {
+            return (bucket == 0) ? 0 : (1ULL << bucket);  // The upper bound of the bucket.
+        }
+    }
+    return 0;
+}
+
+int removeEntry(const char* const path, const struct stat*, const int, struct FTW*)
+{
+    return ::remove(path);
+}
+
+pid_t startNode(const char* const binary, const char* const root, const char* const iface, const char* const shm)
+{
+    const pid_t child = ::fork();
+    if (child != 0)
+    {
+        return child;
+    }
+    const bool is_udp = ::udpParseIfaceAddress(iface) != 0;
+    (void) ::setenv("CYPHAL__UDP__IFACE", is_udp ? iface : "", 1);
+    (void) ::setenv("CYPHAL__CAN__IFACE", is_udp ? "" : iface, 1);
+    (void) ::setenv("CYPHAL__DEMO__STATS__SHM", shm, 1);
+    (void) ::unsetenv("CYPHAL__DEMO__CAPTURE__FILE");
+
+    const std::string log_path = std::string{root} + "/node.log";
+    const int         log_fd   = ::open(log_path.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);  // NOLINT
+    if (log_fd >= 0)
+    {
+        (void) ::dup2(log_fd, STDOUT_FILENO);
+        (void) ::dup2(log_fd, STDERR_FILENO);
+        (void) ::close(log_fd);
+    }
+    (void) ::execl(binary, binary, root, static_cast<char*>(nullptr));  // NOLINT(*-vararg)
+    ::_exit(127);
+}
+
+bool runBinary(const char* const capture_file,
+               const double      speed,
+               const char* const iface,
+               const char* const binary,
+               RunResult&        result)
+{
+    char root[] = "/tmp/bench_replay.XXXXXX";
+    if (::mkdtemp(root) == nullptr)
+    {
+        return false;
+    }
+    char shm[64];
+    (void) std::snprintf(shm, sizeof(shm), "/bench_replay.%d", static_cast<int>(::getpid()));
+
+    CaptureReplayer replayer;
+    const bool      is_udp = ::udpParseIfaceAddress(iface) != 0;
+    const int       err    = is_udp ? replayer.setUdpIface(::udpParseIfaceAddress(iface))
+                                    : replayer.addCanIface(iface, true);
+
+    bool        ok    = (err == 0);
+    const pid_t child = ok ? startNode(binary, root, iface, shm) : -1;
+    ok                = ok && (child > 0);
+
+    // Wait for the node to publish its statistics page, then let it settle (f.e. finish the PnP allocation).
+    ShmStatsPageReader reader;
+    std::uint64_t      iterations_before = 0;
+    bool               is_open           = false;
+    bool               is_up             = false;
+    for (unsigned waited_ms = 0; ok && !is_up && (waited_ms < StartupTimeoutMs); waited_ms += 10)
+    {
+        (void) ::usleep(10000);
+        is_open = is_open || (reader.open(shm) == 0);
+        is_up   = is_open && readCounter(reader, "loop.iterations", iterations_before);
+    }
+    ok = ok && is_up;
+    if (ok)
+    {
+        (void) ::usleep(WarmupMs * 1000U);
+    }
+
+    if (ok)
+    {
+        std::uint64_t worst_before = 0;
+        (void) readCounter(reader, "loop.worst_lateness_us", worst_before);
+        (void) readCounter(reader, "loop.iterations", iterations_before);
+        const ProcSample before = sampleProc(child);
+
+        // Sample the loop lateness while the capture is being replayed.
+        std::atomic<bool>                          done{false};
+        std::array<std::uint64_t, LatenessBuckets> histogram{};
+        std::thread                                sampler{[&] {
+            while (!done.load(std::memory_order_relaxed))
+            {
+                std::uint64_t lateness_us = 0;
+                if (readCounter(reader, "loop.last_lateness_us", lateness_us))
+                {
+                    std::size_t bucket = 0;
+                    while (((lateness_us >> bucket) > 1U) && (bucket < (LatenessBuckets - 1U)))
+                    {
+                        ++bucket;
+                    }
+                    ++histogram[bucket];  // NOLINT(*-constant-array-index)
+                }
+                (void) ::usleep(SamplePeriodUs);
+            }
+        }};
+        ok = (replayer.replay(capture_file, speed, result.replay) == 0);
+        done.store(true, std::memory_order_relaxed);
+        sampler.join();
+
+        const ProcSample after       = sampleProc(child);
+        std::uint64_t    iterations  = 0;
+        std::uint64_t    worst_after = 0;
+        (void) readCounter(reader, "loop.iterations", iterations);
+        (void) readCounter(reader, "loop.worst_lateness_us", worst_after);
+
+        result.cpu_ns          = after.cpu_ns - before.cpu_ns;
+        result.ctx_switches    = after.ctx_switches - before.ctx_switches;
+        result.max_rss_kb      = after.max_rss_kb;
+        result.loop_iterations = iterations - iterations_before;
+        result.lateness_p50_us = quantile(histogram, 0.5);
+        result.lateness_p99_us = quantile(histogram, 0.99);
+        result.lateness_max_us = (worst_after > worst_before) ? worst_after : quantile(histogram, 1.0);
+    }
+
+    if (child > 0)
+    {
+        (void) ::kill(child, SIGTERM);
+        (void) ::waitpid(child, nullptr, 0);
+    }
+    (void) ::shm_unlink(shm);
+    (void) ::nftw(root, &removeEntry, 16, FTW_DEPTH | FTW_PHYS);  // NOLINT(*-signed-bitwise)
+    return ok;
+}
+
+}  // namespace
+
+int main(const int argc, char* const argv[])
+{
+    if (argc < 5)
+    {
+        (void) std::fprintf(stderr,
+                            "Usage: %s <capture_file> <speed> <iface> <demo_binary>...\n",
+                            argv[0]);  // NOLINT(*-pointer-arithmetic)
+        return 1;
+    }
+    const char* const capture_file = argv[1];                        // NOLINT(*-pointer-arithmetic)
+    const double      speed        = std::strtod(argv[2], nullptr);  // NOLINT(*-pointer-arithmetic)
+    const char* const iface        = argv[3];                        // NOLINT(*-pointer-arithmetic)
+
+    int failed_runs = 0;
+    for (int i = 4; i < argc; ++i)
+    {
+        const char* const binary = argv[i];  // NOLINT(*-pointer-arithmetic)
+        RunResult         result{};
+        if (!runBinary(capture_file, speed, iface, binary, result))
+        {
+            (void) std::fprintf(stderr, "Run failed (binary=%s).\n", binary);
+            ++failed_runs;
+            continue;
+        }
+        const std::uint64_t records = result.replay.udp_datagrams + result.replay.can_frames;
+        // NOLINTBEGIN(google-runtime-int)
+        (void) std::printf("{\"binary\":\"%s\",\"records\":%llu,\"replay_ms\":%.1f,\"replay_max_lag_us\":%llu,"
+                           "\"cpu_ms\":%.1f,\"cpu_us_per_record\":%.2f,\"loop_iterations\":%llu,\"ctx_switches\":%llu,"
+                           "\"lateness_us\":{\"p50\":%llu,\"p99\":%llu,\"max\":%llu},\"max_rss_kb\":%llu}\n",
+                           binary,
+                           static_cast<unsigned long long>(records),
+                           static_cast<double>(result.replay.elapsed_us) / 1e3,
+                           static_cast<unsigned long long>(result.replay.max_lag_us),
+                           static_cast<double>(result.cpu_ns) / 1e6,
+                           (records > 0) ? (static_cast<double>(result.cpu_ns) / 1e3 / static_cast<double>(records))
+                                         : 0.0,
+                           static_cast<unsigned long long>(result.loop_iterations),
+                           static_cast<unsigned long long>(result.ctx_switches),
+                           static_cast<unsigned long long>(result.lateness_p50_us),
+                           static_cast<unsigned long long>(result.lateness_p99_us),
+                           static_cast<unsigned long long>(result.lateness_max_us),
+                           static_cast<unsigned long long>(result.max_rss_kb));
+        // NOLINTEND(google-runtime-int)
+        (void) std::fflush(stdout);
+    }
+    return (failed_runs == 0) ? 0 : 1;
+}
+
+// NOLINTEND(cppcoreguidelines-avoid-magic-numbers, readability-magic-numbers)
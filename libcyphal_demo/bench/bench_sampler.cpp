@@ -0,0 +1,113 @@
+// This software is distributed under the terms of the MIT License.
+// Copyright (C) OpenCyphal Development Team  <opencyphal.org>
+// Copyright Amazon.com Inc. or its affiliates.
+// SPDX-License-Identifier: MIT
+
+/// Measures the overhead of the sampling profiler at 1 kHz (the rate the demo uses) on a CPU-bound workload:
+/// the workload CPU time with and without the profiler running (best of several runs), and the cost per sample.
+
+#include "platform/sampling_profiler.hpp"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <ctime>
+
+// NOLINTBEGIN(cppcoreguidelines-avoid-magic-numbers, readability-magic-numbers)
+
+namespace
+{
+
+constexpr std::uint32_t RateHz    = 1000;
+constexpr std::uint64_t WorkItems = 200000000;
+constexpr int           Runs      = 5;
+
+std::array<SamplerStack, 8192> s_stacks{};
+
+volatile std::uint64_t s_seed = 1;  // Prevents the workload from being folded at compile time.
+
+double cpuTimeSec()
+{
+    timespec ts{};
+    (void) ::clock_gettime(CLOCK_PROCESS_CPUTIME_ID, &ts);
+    return static_cast<double>(ts.tv_sec) + (static_cast<double>(ts.tv_nsec) * 1e-9);
+}
+
+/// FNV-1a over a counter - just to keep the CPU busy in a few nested frames.
+__attribute__((noinline)) std::uint64_t hashRange(const std::uint64_t from, const std::uint64_t to)
+{
+    std::uint64_t hash = 0xcbf29ce484222325ULL;
+    for (std::uint64_t i = from; i < to; ++i)
+    {
+        hash = (hash ^ i) * 0x100000001b3ULL;
+    }
+    return hash;
+}
+
+__attribute__((noinline)) std::uint64_t workload()
+{
+    const std::uint64_t seed = s_seed;
+    std::uint64_t       hash = 0;
+    for (std::uint64_t chunk = seed; chunk < (WorkItems + seed); chunk += 1000)
+    {
+        hash += hashRange(chunk, chunk + 1000);
+    }
+    return hash;
+}
+
+double measure(std::uint64_t& sink)
+{
+    const double started = cpuTimeSec();
+    sink += workload();
+    return cpuTimeSec() - started;
+}
+
+}  // namespace
+
+int main()
+{
+    platform::SamplingProfiler profiler{s_stacks};
+
+    std::uint64_t sink     = 0;
+    double        best_off = 1e9;
+    double        best_on  = 1e9;
+    std::size_t   samples  = 0;
+    for (int run = 0; run < Runs; ++run)
+    {
+        const double off = measure(sink);
+        best_off         = (off < best_off) ? off : best_off;
+
+        if (profiler.start(RateHz) != 0)
+        {
+            (void) std::fprintf(stderr, "Failed to start the profiler.\n");
+            return 1;
+        }
+        const double on = measure(sink);
+        if (profiler.stopAndWrite("/dev/null") != 0)
+        {
+            (void) std::fprintf(stderr, "Failed to write the profile.\n");
+            return 1;
+        }
+        if (on < best_on)
+        {
+            best_on = on;
+            samples = profiler.samples();
+        }
+    }
+
+    const double overhead = best_on - best_off;
+    (void) std::printf("workload (off)  : %8.3f ms\n", best_off * 1e3);
+    (void) std::printf("workload (on)   : %8.3f ms\n", best_on * 1e3);
+    (void) std::printf("samples         : %8zu (effective rate %.0f Hz of requested %u Hz)\n",
+                       samples,
+                       static_cast<double>(samples) / best_on,
+                       RateHz);
+    (void) std::printf("overhead        : %8.3f %%\n", (overhead / best_off) * 1e2);
+    (void) std::printf("per sample      : %8.3f us\n",
+                       (samples > 0) ? ((overhead / static_cast<double>(samples)) * 1e6) : 0.0);
+    (void) std::printf("(sink=%llx)\n", static_cast<unsigned long long>(sink));  // NOLINT(google-runtime-int)
+    return 0;
+}
+
+// NOLINTEND(cppcoreguidelines-avoid-magic-numbers, readability-magic-numbers)
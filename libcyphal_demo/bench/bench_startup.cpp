@@ -0,0 +1,222 @@
+// This software is distributed under the terms of the MIT License.
+// Copyright (C) OpenCyphal Development Team  <opencyphal.org>
+// Copyright Amazon.com Inc. or its affiliates.
+// SPDX-License-Identifier: MIT
+
+/// Checks the time-to-first-heartbeat of the demo node against a budget.
+///
+/// Usage: bench_startup <demo_binary> <budget_ms> [<iface> [<runs>]]
+///
+/// The node is started several times (3 by default) on the given iface (`127.0.0.1` by default; a local IPv4
+/// address selects Cyphal/UDP, anything else is a SocketCAN interface name), each time in a fresh temporary root
+/// directory, and stopped as soon as it has printed its startup profile. The budget is passed to the node via
+/// environment (see `demo.startup.budget_ms` register), so the node itself exits with a dedicated code when it's
+/// exceeded. One JSON object per run is printed:
+///
+///   {"run":0,"ttfh_us":10450,"budget_ms":200,"ok":true}
+///
+/// The exit code is non-zero if any run has exceeded the budget (or hasn't published a heartbeat at all),
+/// so the tool could be used as a regression check in CI.
+
+#include "udp.h"
+
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <ftw.h>
+#include <poll.h>
+#include <signal.h>
+#include <string>
+#include <sys/wait.h>
+#include <time.h>
+#include <unistd.h>
+
+// NOLINTBEGIN(cppcoreguidelines-avoid-magic-numbers, readability-magic-numbers)
+
+namespace
+{
+
+constexpr unsigned StartupTimeoutMs             = 5000;
+constexpr unsigned ExitTimeoutMs                = 3000;
+constexpr int      StartupBudgetExceededCode    = 7;  // See `ExitCode::StartupBudgetExceeded` of the demo.
+constexpr char     TimeToFirstHeartbeatPrefix[] = "time_to_first_heartbeat=";
+
+struct RunResult
+{
+    bool          has_heartbeat;
+    std::uint64_t ttfh_us;
+    bool          is_budget_exceeded;
+};
+
+std::uint64_t monotonicMs()
+{
+    struct timespec ts{};
+    (void) ::clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (static_cast<std::uint64_t>(ts.tv_sec) * 1000U) + (static_cast<std::uint64_t>(ts.tv_nsec) / 1000000U);
+}
+
+int removeEntry(const char* const path, const struct stat*, const int, struct FTW*)
+{
+    return ::remove(path);
+}
+
+pid_t startNode(const char* const binary,
+                const char* const root,
+                const char* const iface,
+                const char* const budget_ms,
+                const int         output_fd)
+{
+    const pid_t child = ::fork();
+    if (child != 0)
+    {
+        return child;
+    }
+    const bool is_udp = ::udpParseIfaceAddress(iface) != 0;
+    (void) ::setenv("CYPHAL__UDP__IFACE", is_udp ? iface : "", 1);
+    (void) ::setenv("CYPHAL__CAN__IFACE", is_udp ? "" : iface, 1);
+    (void) ::setenv("CYPHAL__DEMO__STARTUP__BUDGET_MS", budget_ms, 1);
+    (void) ::unsetenv("CYPHAL__DEMO__CAPTURE__FILE");
+    (void) ::unsetenv("CYPHAL__DEMO__STATS__SHM");
+
+    (void) ::dup2(output_fd, STDOUT_FILENO);
+    (void) ::dup2(output_fd, STDERR_FILENO);
+    (void) ::close(output_fd);
+    (void) ::execl(binary, binary, root, static_cast<char*>(nullptr));  // NOLINT(*-vararg)
+    ::_exit(127);
+}
+
+/// Reads the node output until the time-to-first-heartbeat line, the end of the output, or the timeout.
+///
+bool readTimeToFirstHeartbeat(const int fd, std::uint64_t& out_ttfh_us)
+{
+    std::string   output;
+    const auto    deadline_ms = monotonicMs() + StartupTimeoutMs;
+    std::uint64_t now_ms      = monotonicMs();
+    while (now_ms < deadline_ms)
+    {
+        struct pollfd pfd{fd, POLLIN, 0};
+        const int     poll_result = ::poll(&pfd, 1, static_cast<int>(deadline_ms - now_ms));
+        if ((poll_result < 0) && (errno != EINTR))
+        {
+            return false;
+        }
+        if (poll_result > 0)
+        {
+            char          chunk[512];
+            const ssize_t size = ::read(fd, chunk, sizeof(chunk));
+            if (size <= 0)
+            {
+                return false;  // The node has exited (or closed its output).
+            }
+            output.append(chunk, static_cast<std::size_t>(size));
+
+            const std::size_t prefix_at = output.find(TimeToFirstHeartbeatPrefix);
+            if ((prefix_at != std::string::npos) && (output.find('\n', prefix_at) != std::string::npos))
+            {
+                out_ttfh_us = std::strtoull(&output[prefix_at + sizeof(TimeToFirstHeartbeatPrefix) - 1U], nullptr, 10);
+                return true;
+            }
+        }
+        now_ms = monotonicMs();
+    }
+    return false;
+}
+
+/// Gives the node some time to exit by itself, then stops it. Gets its exit code (or -1 if it was stopped).
+///
+int stopNode(const pid_t child, const unsigned exit_timeout_ms)
+{
+    int        status      = 0;
+    const auto deadline_ms = monotonicMs() + exit_timeout_ms;
+    while (::waitpid(child, &status, WNOHANG) == 0)
+    {
+        if (monotonicMs() >= deadline_ms)
+        {
+            (void) ::kill(child, SIGTERM);
+            (void) ::waitpid(child, &status, 0);
+            return -1;
+        }
+        (void) ::usleep(10000);
+    }
+    return WIFEXITED(status) ? WEXITSTATUS(status) : -1;  // NOLINT(*-signed-bitwise)
+}
+
+bool runNode(const char* const binary, const char* const iface, const char* const budget_ms, RunResult& result)
+{
+    char root[] = "/tmp/bench_startup.XXXXXX";
+    if (::mkdtemp(root) == nullptr)
+    {
+        return false;
+    }
+    int fds[2]{-1, -1};
+    if (::pipe(fds) != 0)
+    {
+        (void) ::rmdir(root);
+        return false;
+    }
+    const pid_t child = startNode(binary, root, iface, budget_ms, fds[1]);
+    (void) ::close(fds[1]);
+    if (child < 0)
+    {
+        (void) ::close(fds[0]);
+        (void) ::rmdir(root);
+        return false;
+    }
+
+    result.has_heartbeat = readTimeToFirstHeartbeat(fds[0], result.ttfh_us);
+    (void) ::close(fds[0]);
+
+    // Over the budget, the node is expected to exit by itself (with a dedicated code); otherwise it's just stopped.
+    const std::uint64_t budget_us      = std::strtoull(budget_ms, nullptr, 10) * 1000U;
+    const bool          is_over_budget = result.has_heartbeat && (result.ttfh_us > budget_us);
+    const int           exit_code      = stopNode(child, is_over_budget ? ExitTimeoutMs : 0U);
+    result.is_budget_exceeded          = is_over_budget || (exit_code == StartupBudgetExceededCode);
+
+    (void) ::nftw(root, &removeEntry, 16, FTW_DEPTH | FTW_PHYS);  // NOLINT(*-signed-bitwise)
+    return true;
+}
+
+}  // namespace
+
+int main(const int argc, char* const argv[])
+{
+    if (argc < 3)
+    {
+        (void) std::fprintf(stderr,
+                            "Usage: %s <demo_binary> <budget_ms> [<iface> [<runs>]]\n",
+                            argv[0]);  // NOLINT(*-pointer-arithmetic)
+        return 1;
+    }
+    const char* const binary    = argv[1];                                              // NOLINT(*-pointer-arithmetic)
+    const char* const budget_ms = argv[2];                                              // NOLINT(*-pointer-arithmetic)
+    const char* const iface     = (argc > 3) ? argv[3] : "127.0.0.1";                   // NOLINT(*-pointer-arithmetic)
+    const long        runs      = (argc > 4) ? std::strtol(argv[4], nullptr, 10) : 3;  // NOLINT
+
+    int failed_runs = 0;
+    for (long run = 0; run < runs; ++run)  // NOLINT(google-runtime-int)
+    {
+        RunResult result{};
+        if (!runNode(binary, iface, budget_ms, result))
+        {
+            (void) std::fprintf(stderr, "Run failed (binary=%s, errno=%d).\n", binary, errno);
+            ++failed_runs;
+            continue;
+        }
+        const bool ok = result.has_heartbeat && !result.is_budget_exceeded;
+        // NOLINTBEGIN(google-runtime-int)
+        (void) std::printf("{\"run\":%ld,\"ttfh_us\":%lld,\"budget_ms\":%s,\"ok\":%s}\n",
+                           run,
+                           result.has_heartbeat ? static_cast<long long>(result.ttfh_us) : -1LL,
+                           budget_ms,
+                           ok ? "true" : "false");
+        // NOLINTEND(google-runtime-int)
+        (void) std::fflush(stdout);
+        failed_runs += ok ? 0 : 1;
+    }
+    return (failed_runs == 0) ? 0 : 1;
+}
+
+// NOLINTEND(cppcoreguidelines-avoid-magic-numbers, readability-magic-numbers)
@@ -0,0 +1,95 @@
+// This software is distributed under the terms of the MIT License.
+// Copyright (C) OpenCyphal Development Team  <opencyphal.org>
+// Copyright Amazon.com Inc. or its affiliates.
+// SPDX-License-Identifier: MIT
+
+/// Measures cost of a single statistics page update (the same batch of counters as the demo main loop publishes),
+/// both without and with a concurrent reader polling the page.
+
+#include "platform/posix/shm_stats_page.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <thread>
+#include <unistd.h>
+
+// NOLINTBEGIN(cppcoreguidelines-avoid-magic-numbers, readability-magic-numbers)
+
+namespace
+{
+
+constexpr std::size_t   CountersPerUpdate = 9;
+constexpr std::uint64_t Iterations        = 10000000;
+
+double measureUpdate(platform::posix::ShmStatsPageWriter& writer)
+{
+    const auto started = std::chrono::steady_clock::now();
+    for (std::uint64_t i = 0; i < Iterations; ++i)
+    {
+        writer.update([i](platform::posix::ShmStatsPageWriter& page) {
+            //
+            for (std::size_t index = 0; index < CountersPerUpdate; ++index)
+            {
+                page.set(index, i + index);
+            }
+        });
+    }
+    const auto elapsed = std::chrono::steady_clock::now() - started;
+    return static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count()) /
+           static_cast<double>(Iterations);
+}
+
+}  // namespace
+
+int main()
+{
+    char shm_name[64];  // NOLINT
+    (void) std::snprintf(shm_name, sizeof(shm_name), "/bench_stats_page.%d", static_cast<int>(::getpid()));
+
+    platform::posix::ShmStatsPageWriter writer;
+    if (const int err = writer.open(shm_name))
+    {
+        (void) std::fprintf(stderr, "Failed to open stats page (err=%d).\n", err);
+        return 1;
+    }
+    for (std::size_t index = 0; index < CountersPerUpdate; ++index)
+    {
+        char name[32];  // NOLINT
+        (void) std::snprintf(name, sizeof(name), "counter.%zu", index);
+        (void) writer.addCounter(name);
+    }
+
+    (void) std::printf("update (%zu counters), no reader   : %6.2f ns\n", CountersPerUpdate, measureUpdate(writer));
+
+    platform::posix::ShmStatsPageReader reader;
+    if (const int err = reader.open(shm_name))
+    {
+        (void) std::fprintf(stderr, "Failed to open stats page for reading (err=%d).\n", err);
+        return 1;
+    }
+    std::atomic<bool>          stop{false};
+    std::atomic<std::uint64_t> snapshots{0};
+    std::thread                reader_thread{[&] {
+        platform::posix::ShmStatsPageReader::Snapshot snapshot{};
+        while (!stop.load(std::memory_order_relaxed))
+        {
+            if (reader.read(snapshot))
+            {
+                snapshots.fetch_add(1, std::memory_order_relaxed);
+            }
+        }
+    }};
+    const double with_reader = measureUpdate(writer);
+    stop.store(true);
+    reader_thread.join();
+
+    (void) std::printf("update (%zu counters), busy reader : %6.2f ns (%llu consistent snapshots)\n",
+                       CountersPerUpdate,
+                       with_reader,
+                       static_cast<unsigned long long>(snapshots.load()));  // NOLINT
+    return 0;
+}
+
+// NOLINTEND(cppcoreguidelines-avoid-magic-numbers, readability-magic-numbers)
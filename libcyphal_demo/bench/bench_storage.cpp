@@ -0,0 +1,258 @@
+// This software is distributed under the terms of the MIT License.
+// Copyright (C) OpenCyphal Development Team  <opencyphal.org>
+// Copyright Amazon.com Inc. or its affiliates.
+// SPDX-License-Identifier: MIT
+
+/// Measures how the boot-up `load` and the shutdown `save` of the persistent registers scale with the number
+/// of registers, along with the latency of a single key access, for the file-per-key `platform::storage::KeyValue`
+/// of this demo. For every register count one JSON object is printed:
+///
+///   {"backend":"libcyphal.KeyValue","registers":1000,"populate_us":..,"save_us":..,"load_us":..,
+///    "get_ns":{"p50":..,"p99":..,"max":..},"put_ns":{"p50":..,"p99":..,"max":..}}
+///
+/// The format is the same as of the C counterparts (see `libudpard_demo/bench/bench_storage.c`), which cover
+/// the `storage.c` of the LibUDPard demo and the `shared/register` module of the LibCanard demos.
+///
+/// Every register is a persistent `natural16[1]`, routed to the registry the same way as `Natural16Param` of
+/// the application does it. A single key get is the storage read plus the deserialization (as `load` does it
+/// per register), and a single key put is the serialization plus the storage write (as `save` does it).
+///
+/// The storage lives in a fresh temporary directory per register count. Note that `KeyValue` limits the file paths
+/// to 64 characters, so the parent directory (the argument, default is `/tmp`) should have a short path.
+/// The file system cache is warm, so the results show the CPU and syscall cost rather than the media latency.
+
+#include "platform/storage.hpp"
+
+#include <cetl/pf17/cetlpf.hpp>
+#include <libcyphal/application/registry/register.hpp>
+#include <libcyphal/application/registry/registry_impl.hpp>
+#include <libcyphal/platform/storage.hpp>
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <ftw.h>
+#include <random>
+#include <string>
+#include <unistd.h>
+#include <vector>
+
+// NOLINTBEGIN(cppcoreguidelines-avoid-magic-numbers, readability-magic-numbers)
+
+namespace
+{
+
+using Clock    = std::chrono::steady_clock;
+using Value    = libcyphal::application::registry::IRegister::Value;
+using Register = libcyphal::application::registry::Register<sizeof(void*) * 12>;
+
+constexpr std::size_t                Samples        = 1000;
+constexpr std::array<std::size_t, 4> RegisterCounts = {10, 100, 1000, 10000};
+
+std::int64_t elapsedNs(const Clock::time_point started)
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - started).count();
+}
+
+void printQuantiles(const char* const name, std::vector<std::int64_t>& samples)
+{
+    std::sort(samples.begin(), samples.end());
+    std::printf("\"%s\":{\"p50\":%lld,\"p99\":%lld,\"max\":%lld}",
+                name,
+                static_cast<long long>(samples[samples.size() / 2]),
+                static_cast<long long>(samples[(samples.size() * 99) / 100]),
+                static_cast<long long>(samples.back()));
+}
+
+int removeEntry(const char* const path, const struct stat* const, const int, struct FTW* const)
+{
+    return std::remove(path);
+}
+
+/// Holds the registry with its registers and their values, which is what the application does with its `Regs`.
+///
+class Bench final
+{
+public:
+    explicit Bench(const char* const root_path)
+        : storage_{root_path}
+        , registry_{memory_}
+    {
+    }
+
+    void populate(const std::size_t count)
+    {
+        names_.reserve(count);
+        values_.reserve(count);
+        registers_.reserve(count);
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            std::array<char, 32> name{};
+            (void) std::snprintf(name.data(), name.size(), "bench.reg.%05zu", i);
+            names_.emplace_back(name.data());
+            values_.push_back(static_cast<std::uint16_t>(i));
+            registers_.emplace_back(registry_.route(
+                names_.back().c_str(),
+                [this, i] { return makeValue(values_[i]); },
+                [this, i](const auto& value) -> cetl::optional<libcyphal::application::registry::SetError> {
+                    //
+                    if (value.is_natural16() && !value.get_natural16().value.empty())
+                    {
+                        values_[i] = value.get_natural16().value.front();
+                        return cetl::nullopt;
+                    }
+                    return libcyphal::application::registry::SetError::Semantics;
+                },
+                {true}));
+        }
+    }
+
+    void saveAll()
+    {
+        (void) save(storage_, registry_);
+    }
+
+    void loadAll()
+    {
+        (void) load(storage_, registry_);
+    }
+
+    void get(const std::size_t index)
+    {
+        std::array<std::uint8_t, Value::_traits_::SerializationBufferSizeBytes> buffer{};
+
+        const auto result = storage_.get(names_[index].c_str(), buffer);
+        if (const auto* const size = cetl::get_if<std::size_t>(&result))
+        {
+            Value value{Value::allocator_type{&memory_}};
+            (void) deserialize(value, {buffer.data(), *size});
+        }
+    }
+
+    void put(const std::size_t index)
+    {
+        std::array<std::uint8_t, Value::_traits_::SerializationBufferSizeBytes> buffer{};
+
+        const Value value       = makeValue(values_[index]);
+        const auto  size_result = serialize(value, {buffer.data(), buffer.size()});
+        if (size_result)
+        {
+            (void) storage_.put(names_[index].c_str(), {buffer.data(), size_result.value()});
+        }
+    }
+
+    /// The values are restored from the storage, so they should be the same as populated.
+    ///
+    std::size_t countRestored() const
+    {
+        std::size_t restored = 0;
+        for (std::size_t i = 0; i < values_.size(); ++i)
+        {
+            restored += (values_[i] == static_cast<std::uint16_t>(i)) ? 1U : 0U;
+        }
+        return restored;
+    }
+
+    void scramble()
+    {
+        std::fill(values_.begin(), values_.end(), UINT16_MAX);
+    }
+
+private:
+    Value makeValue(const std::uint16_t uint16) const
+    {
+        Value value{Value::allocator_type{&memory_}};
+        value.set_natural16().value.push_back(uint16);
+        return value;
+    }
+
+    cetl::pmr::memory_resource&                memory_{*cetl::pmr::new_delete_resource()};
+    platform::storage::KeyValue                storage_;
+    libcyphal::application::registry::Registry registry_;
+    std::vector<std::string>                   names_;
+    std::vector<std::uint16_t>                 values_;
+    std::vector<Register>                      registers_;
+
+};  // Bench
+
+void runPoint(const char* const root_path, const std::size_t count)
+{
+    Bench bench{root_path};
+
+    auto started = Clock::now();
+    bench.populate(count);
+    const auto populate_ns = elapsedNs(started);
+
+    // The files are created here, as at the very first shutdown.
+    started = Clock::now();
+    bench.saveAll();
+    const auto save_ns = elapsedNs(started);
+
+    bench.scramble();
+    started = Clock::now();
+    bench.loadAll();
+    const auto load_ns = elapsedNs(started);
+    if (bench.countRestored() != count)
+    {
+        std::fprintf(stderr, "Loaded %zu registers out of %zu\n", bench.countRestored(), count);
+    }
+
+    std::mt19937_64                            random{count};
+    std::uniform_int_distribution<std::size_t> index_distribution{0, count - 1};
+    std::vector<std::int64_t>                  get_samples(Samples);
+    std::vector<std::int64_t>                  put_samples(Samples);
+    for (auto& sample : get_samples)
+    {
+        const std::size_t index = index_distribution(random);
+        started                 = Clock::now();
+        bench.get(index);
+        sample = elapsedNs(started);
+    }
+    for (auto& sample : put_samples)
+    {
+        const std::size_t index = index_distribution(random);
+        started                 = Clock::now();
+        bench.put(index);
+        sample = elapsedNs(started);
+    }
+
+    std::printf("{\"backend\":\"libcyphal.KeyValue\",\"registers\":%zu,\"populate_us\":%lld,\"save_us\":%lld,"
+                "\"load_us\":%lld,",
+                count,
+                static_cast<long long>(populate_ns / 1000),
+                static_cast<long long>(save_ns / 1000),
+                static_cast<long long>(load_ns / 1000));
+    printQuantiles("get_ns", get_samples);
+    std::printf(",");
+    printQuantiles("put_ns", put_samples);
+    std::printf("}\n");
+    (void) std::fflush(stdout);
+}
+
+}  // namespace
+
+int main(const int argc, const char* const argv[])
+{
+    const std::string parent = (argc > 1) ? argv[1] : "/tmp";
+    for (const std::size_t count : RegisterCounts)
+    {
+        std::string root = parent + "/bench_kv_XXXXXX";
+        if (::mkdtemp(&root[0]) == nullptr)
+        {
+            std::perror("Failed to create the storage directory");
+            return 1;
+        }
+        runPoint(root.c_str(), count);
+        if (::nftw(root.c_str(), &removeEntry, 16, FTW_DEPTH | FTW_PHYS) != 0)
+        {
+            std::perror("Failed to remove the storage directory");
+        }
+    }
+    return 0;
+}
+
+// NOLINTEND(cppcoreguidelines-avoid-magic-numbers, readability-magic-numbers)
@@ -0,0 +1,113 @@
+// This software is distributed under the terms of the MIT License.
+// Copyright (C) OpenCyphal Development Team  <opencyphal.org>
+// Copyright Amazon.com Inc. or its affiliates.
+// SPDX-License-Identifier: MIT
+
+/// Measures the cost per call of the TSC clock against `clock_gettime(CLOCK_MONOTONIC)` and `steady_clock`,
+/// then checks the TSC clock over several resync periods: it must never go backwards, and must stay close
+/// to `CLOCK_MONOTONIC`. Exits with a non-zero code if the check fails (so it could be used as a smoke test).
+
+#include "platform/linux/tsc_clock.hpp"
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <ctime>
+
+// NOLINTBEGIN(cppcoreguidelines-avoid-magic-numbers, readability-magic-numbers)
+
+namespace
+{
+
+constexpr int           Calls         = 10000000;
+constexpr std::uint64_t CheckNs       = 3500000000ULL;  // 3.5 resync periods
+constexpr std::int64_t  MaxOffsetNs   = 50000;          // 50 us
+constexpr int           CheckEveryNth = 1000;
+
+std::uint64_t monotonicNs()
+{
+    timespec ts{};
+    (void) ::clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (static_cast<std::uint64_t>(ts.tv_sec) * 1000000000ULL) + static_cast<std::uint64_t>(ts.tv_nsec);
+}
+
+template <typename Now>
+double nsPerCall(const char* const name, std::uint64_t& sink, Now&& now)
+{
+    const std::uint64_t started = monotonicNs();
+    for (int i = 0; i < Calls; ++i)
+    {
+        sink += now();
+    }
+    const double per_call = static_cast<double>(monotonicNs() - started) / Calls;
+    (void) std::printf("%-24s: %7.2f ns/call\n", name, per_call);
+    return per_call;
+}
+
+}  // namespace
+
+int main()
+{
+    platform::Linux::TscClock tsc_clock;
+    if (!tsc_clock.calibrate())
+    {
+        (void) std::printf("Invariant TSC is not supported - nothing to measure.\n");
+        return 0;
+    }
+    (void) std::printf("TSC rate                : %7.4f ns/tick (%.1f MHz)\n",
+                       tsc_clock.nsPerTick(),
+                       1e3 / tsc_clock.nsPerTick());
+
+    std::uint64_t sink = 0;
+    const double  mono = nsPerCall("clock_gettime(MONOTONIC)", sink, [] { return monotonicNs(); });
+    (void) nsPerCall("steady_clock::now", sink, [] {
+        return static_cast<std::uint64_t>(std::chrono::steady_clock::now().time_since_epoch().count());
+    });
+    const double tsc = nsPerCall("TscClock::nowNs", sink, [&tsc_clock] { return tsc_clock.nowNs(); });
+    (void) std::printf("savings                 : %7.2f ns/call (%.1fx)\n", mono - tsc, mono / tsc);
+
+    // Monotonicity and drift check (spans a few resyncs).
+    std::uint64_t       backwards  = 0;
+    std::int64_t        max_offset = 0;
+    std::uint64_t       previous   = tsc_clock.nowNs();
+    const std::uint64_t started    = monotonicNs();
+    for (std::uint64_t iteration = 0;; ++iteration)
+    {
+        const std::uint64_t now = tsc_clock.nowNs();
+        backwards += (now < previous) ? 1 : 0;
+        previous = now;
+        if ((iteration % CheckEveryNth) == 0)
+        {
+            // The offset is how far the clock is out of the window between two `CLOCK_MONOTONIC` reads around it,
+            // so that a preemption in between doesn't count as an error.
+            const std::uint64_t mono_before = monotonicNs();
+            const std::uint64_t tsc_now     = tsc_clock.nowNs();
+            const std::uint64_t mono_after  = monotonicNs();
+            std::int64_t        offset      = 0;
+            if (tsc_now < mono_before)
+            {
+                offset = static_cast<std::int64_t>(mono_before - tsc_now);
+            }
+            if (tsc_now > mono_after)
+            {
+                offset = static_cast<std::int64_t>(tsc_now - mono_after);
+            }
+            max_offset = (offset > max_offset) ? offset : max_offset;
+            if ((mono_after - started) > CheckNs)
+            {
+                break;
+            }
+        }
+    }
+    // NOLINTBEGIN(google-runtime-int)
+    (void) std::printf("backward steps          : %7llu\n", static_cast<unsigned long long>(backwards));
+    (void) std::printf("max offset vs mono      : %7lld ns\n", static_cast<long long>(max_offset));
+    (void) std::printf("(sink=%llx)\n", static_cast<unsigned long long>(sink));
+    // NOLINTEND(google-runtime-int)
+
+    const bool is_ok = (backwards == 0) && (max_offset <= MaxOffsetNs);
+    (void) std::printf("%s\n", is_ok ? "PASS" : "FAIL");
+    return is_ok ? 0 : 1;
+}
+
+// NOLINTEND(cppcoreguidelines-avoid-magic-numbers, readability-magic-numbers)
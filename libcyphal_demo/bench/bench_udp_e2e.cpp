@@ -0,0 +1,384 @@
+// This software is distributed under the terms of the MIT License.
+// Copyright (C) OpenCyphal Development Team  <opencyphal.org>
+// Copyright Amazon.com Inc. or its affiliates.
+// SPDX-License-Identifier: MIT
+
+/// Measures end-to-end latency, throughput and CPU cost of the libcyphal UDP stack (transport message sessions,
+/// `UdpMediaCollection` and the epoll executor) between a publisher and a subscriber process on loopback.
+/// The payload is raw bytes (no DSDL type), so that the transfers could be larger than any standard message,
+/// and span multiple UDP frames.
+///
+/// The benchmark sweeps payload size, publication rate and redundancy (number of media). For each point it forks
+/// the subscriber process, publishes a fixed number of messages (each carrying its sequence number and send time),
+/// and prints one JSON object per line (to stdout, and appended to the optional file given as the first argument):
+///
+///   {"payload":256,"rate_hz":1000,"redundancy":1,"sent":3000,"received":3000,"publish_failures":0,
+///    "throughput_msg_s":999.8,"throughput_mbit_s":2.05,"latency_us":{"p50":..,"p99":..,"p999":..,"max":..},
+///    "cpu_us_per_msg":{"pub":..,"sub":..}}
+///
+/// Latency is from right before `publish` to the subscriber callback (both processes use `CLOCK_MONOTONIC`).
+/// Rate zero means "as fast as possible" (then losses are expected once socket buffers overflow).
+/// A point fails if none of its messages could be published.
+
+#include "bench_common.hpp"
+#include "platform/block_memory_resource.hpp"
+#include "platform/fault_injector.hpp"
+#include "platform/flight_recorder.hpp"
+#include "platform/linux/epoll_single_threaded_executor.hpp"
+#include "platform/posix/udp/udp_media.hpp"
+#include "platform/tx_timestamp_tap.hpp"
+
+#include <cetl/pf17/cetlpf.hpp>
+#include <libcyphal/transport/msg_sessions.hpp>
+#include <libcyphal/transport/types.hpp>
+#include <libcyphal/transport/udp/udp_transport.hpp>
+#include <libcyphal/transport/udp/udp_transport_impl.hpp>
+#include <libcyphal/types.hpp>
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <ctime>
+#include <sys/wait.h>
+#include <unistd.h>
+#include <utility>
+
+// NOLINTBEGIN(cppcoreguidelines-avoid-magic-numbers, readability-magic-numbers)
+
+namespace
+{
+
+using TxSession     = libcyphal::UniquePtr<libcyphal::transport::IMessageTxSession>;
+using RxSession     = libcyphal::UniquePtr<libcyphal::transport::IMessageRxSession>;
+using RxCallbackArg = libcyphal::transport::IMessageRxSession::OnReceiveCallback::Arg;
+
+using bench::clockNs;
+using bench::Header;
+using bench::monotonicNs;
+
+constexpr std::size_t   Messages          = 3000;
+constexpr std::uint16_t SubjectId         = 1000;
+constexpr std::uint16_t PublisherNodeId   = 10;
+constexpr std::uint16_t SubscriberNodeId  = 11;
+constexpr std::size_t   TxQueueCapacity   = 64;
+constexpr std::uint64_t SubscriberIdleNs  = 500000000ULL;   // 0.5 s after the last message
+constexpr std::uint64_t SubscriberLimitNs = 30000000000ULL;  // 30 s in total
+constexpr std::uint64_t DrainNs           = 200000000ULL;   // 0.2 s to flush the TX queues
+
+constexpr std::array<std::size_t, 4>   Payloads{{16, 256, 1024, 2048}};  // 2048 is a multi-frame transfer
+constexpr std::size_t                  MaxPayload = 2048;
+constexpr std::array<std::uint32_t, 3> Rates{{1000, 10000, 0}};
+constexpr std::array<const char*, 2>   Ifaces{{"127.0.0.1", "127.0.0.1 127.0.0.2"}};
+
+struct Point final
+{
+    std::size_t   payload;
+    std::uint32_t rate_hz;
+    std::size_t   redundancy;
+};
+
+/// Results of one side (process) of a benchmark point.
+struct SideResult final
+{
+    std::uint64_t    messages;  ///< Published or received.
+    std::uint64_t    failures;  ///< Failed publications, or malformed messages.
+    std::uint64_t    cpu_ns;
+    std::uint64_t    first_ns;
+    std::uint64_t    last_ns;
+    bench::Latencies latencies;
+};
+
+std::array<std::uint64_t, Messages>               s_latencies{};
+std::array<cetl::byte, MaxPayload>                s_payload{};
+std::array<platform::FlightRecorder::Event, 1024> s_flight_recorder_events{};
+constexpr platform::FaultInjector::Params         NoFaults{{}, 0, 1};
+
+/// The complete UDP node stack of one process (without the application layer).
+///
+class BenchNode final
+{
+public:
+    explicit BenchNode(const char* const ifaces, const std::uint16_t node_id)
+        : media_block_mr_{*cetl::pmr::new_delete_resource()}
+        , flight_recorder_{s_flight_recorder_events}
+        , fault_injector_{NoFaults}
+        , media_{*cetl::pmr::new_delete_resource(),
+                 executor_,
+                 media_block_mr_,
+                 flight_recorder_,
+                 fault_injector_,
+                 tx_tap_}
+    {
+        media_.parse(ifaces);
+        auto maybe_transport = libcyphal::transport::udp::makeTransport({*cetl::pmr::new_delete_resource()},
+                                                                        executor_,
+                                                                        media_.span(),
+                                                                        TxQueueCapacity);
+        if (cetl::get_if<libcyphal::transport::FactoryFailure>(&maybe_transport) != nullptr)
+        {
+            return;
+        }
+        transport_ = cetl::get<libcyphal::UniquePtr<libcyphal::transport::udp::IUdpTransport>>(  //
+            std::move(maybe_transport));
+        (void) transport_->setLocalNodeId(node_id);
+
+        const std::size_t mtu = transport_->getProtocolParams().mtu_bytes;
+        media_block_mr_.setup(media_.count() * TxQueueCapacity * mtu, mtu, 1);
+    }
+
+    bool isReady() const noexcept
+    {
+        return transport_ != nullptr;
+    }
+
+    libcyphal::transport::udp::IUdpTransport& transport()
+    {
+        return *transport_;
+    }
+
+    libcyphal::TimePoint now() const noexcept
+    {
+        return executor_.now();
+    }
+
+    /// Executes due callbacks, and then waits for I/O (or the next callback) for up to the given timeout.
+    ///
+    void spin(const std::uint64_t timeout_ns)
+    {
+        bench::spin(executor_, timeout_ns);
+    }
+
+private:
+    platform::Linux::EpollSingleThreadedExecutor                   executor_;
+    platform::BlockMemoryResource                                  media_block_mr_;
+    platform::FlightRecorder                                       flight_recorder_;
+    platform::FaultInjector                                        fault_injector_;
+    platform::TxTimestampTap                                       tx_tap_;
+    platform::posix::UdpMediaCollection                            media_;
+    libcyphal::UniquePtr<libcyphal::transport::udp::IUdpTransport> transport_;
+
+};  // BenchNode
+
+/// Runs the subscriber side of a point; signals readiness to the given pipe once subscribed.
+///
+SideResult runSubscriber(const Point& point, const int ready_fd)
+{
+    SideResult result{};
+    BenchNode  node{Ifaces[point.redundancy - 1], SubscriberNodeId};  // NOLINT(*-constant-array-index)
+    if (!node.isReady())
+    {
+        return result;
+    }
+    auto maybe_session = node.transport().makeMessageRxSession({MaxPayload, SubjectId});
+    if (!cetl::holds_alternative<RxSession>(maybe_session))
+    {
+        return result;
+    }
+    auto session = cetl::get<RxSession>(std::move(maybe_session));
+    session->setOnReceiveCallback([&result](const RxCallbackArg& arg) {
+        //
+        const std::uint64_t                    received_ns = monotonicNs();
+        std::array<cetl::byte, sizeof(Header)> buffer{};
+        if ((arg.transfer.payload.size() < buffer.size()) || (result.messages >= Messages))
+        {
+            ++result.failures;
+            return;
+        }
+        (void) arg.transfer.payload.copy(0, buffer.data(), buffer.size());
+        Header header{};
+        (void) std::memcpy(&header, buffer.data(), sizeof(header));
+        s_latencies[result.messages++] = received_ns - header.sent_ns;  // NOLINT(*-constant-array-index)
+        result.first_ns                = (result.first_ns == 0) ? received_ns : result.first_ns;
+        result.last_ns                 = received_ns;
+    });
+
+    const char ready = 'R';
+    (void) ::write(ready_fd, &ready, 1);
+
+    const std::uint64_t cpu_started = clockNs(CLOCK_PROCESS_CPUTIME_ID);
+    const std::uint64_t started     = monotonicNs();
+    while (result.messages < Messages)
+    {
+        const std::uint64_t now        = monotonicNs();
+        const bool          is_idle    = (result.last_ns > 0) && ((now - result.last_ns) > SubscriberIdleNs);
+        const bool          is_timeout = (now - started) > SubscriberLimitNs;
+        if (is_idle || is_timeout)
+        {
+            break;
+        }
+        node.spin(50000000ULL);
+    }
+    result.cpu_ns = clockNs(CLOCK_PROCESS_CPUTIME_ID) - cpu_started;
+
+    result.latencies = bench::computeLatencies(s_latencies.data(), result.messages);
+    return result;
+}
+
+SideResult runPublisher(const Point& point)
+{
+    SideResult result{};
+    BenchNode  node{Ifaces[point.redundancy - 1], PublisherNodeId};  // NOLINT(*-constant-array-index)
+    if (!node.isReady())
+    {
+        return result;
+    }
+    auto maybe_session = node.transport().makeMessageTxSession({SubjectId});
+    if (!cetl::holds_alternative<TxSession>(maybe_session))
+    {
+        return result;
+    }
+    auto session = cetl::get<TxSession>(std::move(maybe_session));
+
+    const cetl::span<const cetl::byte>                payload{s_payload.data(), point.payload};
+    const std::array<cetl::span<const cetl::byte>, 1> fragments{{payload}};
+
+    const std::uint64_t period_ns   = (point.rate_hz > 0) ? (1000000000ULL / point.rate_hz) : 0;
+    const std::uint64_t cpu_started = clockNs(CLOCK_PROCESS_CPUTIME_ID);
+    std::uint64_t       next_ns     = monotonicNs();
+    result.first_ns                 = next_ns;
+    for (std::uint32_t seq = 0; seq < Messages; ++seq)
+    {
+        for (std::uint64_t now = monotonicNs(); now < next_ns; now = monotonicNs())
+        {
+            node.spin(next_ns - now);
+        }
+        next_ns += period_ns;
+
+        const Header header{monotonicNs(), seq};
+        (void) std::memcpy(s_payload.data(), &header, sizeof(header));
+        const libcyphal::transport::TransferTxMetadata metadata{{seq, libcyphal::transport::Priority::Nominal},
+                                                                node.now() + std::chrono::seconds{1}};
+        if (session->send(metadata, fragments).has_value())
+        {
+            ++result.failures;
+        }
+        ++result.messages;
+        node.spin(0);
+    }
+    result.last_ns = monotonicNs();
+    for (std::uint64_t now = result.last_ns; (now - result.last_ns) < DrainNs; now = monotonicNs())
+    {
+        node.spin(DrainNs - (now - result.last_ns));
+    }
+    result.cpu_ns = clockNs(CLOCK_PROCESS_CPUTIME_ID) - cpu_started;
+    return result;
+}
+
+/// Runs one point: the subscriber in a child process, and the publisher in this one.
+///
+bool runPoint(const Point& point, SideResult& pub, SideResult& sub)
+{
+    std::array<int, 2> ready_pipe{};
+    std::array<int, 2> result_pipe{};
+    if ((::pipe(ready_pipe.data()) != 0) || (::pipe(result_pipe.data()) != 0))
+    {
+        return false;
+    }
+    const pid_t child = ::fork();
+    if (child < 0)
+    {
+        return false;
+    }
+    if (child == 0)
+    {
+        const SideResult result = runSubscriber(point, ready_pipe[1]);
+        (void) ::write(result_pipe[1], &result, sizeof(result));
+        ::_exit(0);
+    }
+    (void) ::close(ready_pipe[1]);
+    (void) ::close(result_pipe[1]);
+
+    char       ready    = 0;
+    const bool is_ready = (::read(ready_pipe[0], &ready, 1) == 1);
+    if (is_ready)
+    {
+        pub = runPublisher(point);
+    }
+    const bool has_result = (::read(result_pipe[0], &sub, sizeof(sub)) == static_cast<ssize_t>(sizeof(sub)));
+    (void) ::waitpid(child, nullptr, 0);
+    (void) ::close(ready_pipe[0]);
+    (void) ::close(result_pipe[0]);
+    return is_ready && has_result;
+}
+
+void printPoint(std::FILE* const out, const Point& point, const SideResult& pub, const SideResult& sub)
+{
+    const double span_sec = (sub.last_ns > sub.first_ns) ? (static_cast<double>(sub.last_ns - sub.first_ns) / 1e9)
+                                                         : 0.0;
+    const double msg_s    = (span_sec > 0) ? (static_cast<double>(sub.messages - 1) / span_sec) : 0.0;
+    const auto   per_msg  = [](const SideResult& side) {
+        return (side.messages > 0) ? (static_cast<double>(side.cpu_ns) / 1e3 / static_cast<double>(side.messages))
+                                      : 0.0;
+    };
+    (void) std::fprintf(out,
+                        "{\"payload\":%zu,\"rate_hz\":%u,\"redundancy\":%zu,\"sent\":%llu,\"received\":%llu,"
+                        "\"publish_failures\":%llu,\"throughput_msg_s\":%.1f,\"throughput_mbit_s\":%.3f,",
+                        point.payload,
+                        point.rate_hz,
+                        point.redundancy,
+                        static_cast<unsigned long long>(pub.messages),  // NOLINT(google-runtime-int)
+                        static_cast<unsigned long long>(sub.messages),  // NOLINT(google-runtime-int)
+                        static_cast<unsigned long long>(pub.failures),  // NOLINT(google-runtime-int)
+                        msg_s,
+                        msg_s * static_cast<double>(point.payload) * 8.0 / 1e6);
+    bench::printLatencies(out, sub.latencies);
+    (void) std::fprintf(out, ",\"cpu_us_per_msg\":{\"pub\":%.2f,\"sub\":%.2f}}\n", per_msg(pub), per_msg(sub));
+    (void) std::fflush(out);
+}
+
+}  // namespace
+
+int main(const int argc, char* const argv[])
+{
+    std::FILE* const file = (argc > 1) ? std::fopen(argv[1], "a") : nullptr;  // NOLINT(*-pointer-arithmetic)
+
+    int failed_points = 0;
+    for (std::size_t redundancy = 1; redundancy <= Ifaces.size(); ++redundancy)
+    {
+        for (const auto rate_hz : Rates)
+        {
+            for (const auto payload : Payloads)
+            {
+                const Point point{payload, rate_hz, redundancy};
+                SideResult  pub{};
+                SideResult  sub{};
+                if (!runPoint(point, pub, sub))
+                {
+                    (void) std::fprintf(stderr,
+                                        "Point failed (payload=%zu, rate=%u, redundancy=%zu).\n",
+                                        payload,
+                                        rate_hz,
+                                        redundancy);
+                    ++failed_points;
+                    continue;
+                }
+                if (pub.failures == pub.messages)
+                {
+                    // Not recorded - its (zero) throughput and latencies would skew the tracked results.
+                    (void) std::fprintf(stderr,
+                                        "Point published nothing (payload=%zu, rate=%u, redundancy=%zu).\n",
+                                        payload,
+                                        rate_hz,
+                                        redundancy);
+                    ++failed_points;
+                    continue;
+                }
+                printPoint(stdout, point, pub, sub);
+                if (file != nullptr)
+                {
+                    printPoint(file, point, pub, sub);
+                }
+            }
+        }
+    }
+    if (file != nullptr)
+    {
+        (void) std::fclose(file);
+    }
+    return (failed_points == 0) ? 0 : 1;
+}
+
+// NOLINTEND(cppcoreguidelines-avoid-magic-numbers, readability-magic-numbers)
@@ -15,6 +15,7 @@
 #include <array>
 #include <cstddef>
 #include <cstdint>
+#include <cstdio>
 #include <cstdlib>
 #include <iostream>
 #include <random>
@@ -26,18 +27,33 @@ namespace
 constexpr std::size_t HeapSize = 16ULL * 1024ULL;
 alignas(O1HEAP_ALIGNMENT) std::array<cetl::byte, HeapSize> s_heap_arena{};
 
+constexpr std::size_t                 LogCapacity = 256;
+std::array<BinlogRecord, LogCapacity> s_log_records{};
+
+constexpr std::size_t                                               FlightRecorderCapacity = 1024;
+std::array<platform::FlightRecorder::Event, FlightRecorderCapacity> s_flight_recorder_events{};
+
+constexpr std::size_t                     SamplerCapacity = 8192;
+std::array<SamplerStack, SamplerCapacity> s_sampler_stacks{};
+
 }  // namespace
 
-Application::Application(const char* const root_path)
-    : o1_heap_mr_{s_heap_arena}
+Application::Application(const char* const root_path, StartupProfiler& startup_profiler)
+    : log_{s_log_records, stderr}
+    , flight_recorder_{s_flight_recorder_events}
+    , sampling_profiler_{s_sampler_stacks}
+    , o1_heap_mr_{s_heap_arena}
+    , o1_heap_phase_{startup_profiler, "app.o1heap"}
+    , media_block_mr_{*cetl::pmr::new_delete_resource()}
     , storage_{root_path}
     , registry_{o1_heap_mr_}
-    , media_block_mr_{*cetl::pmr::new_delete_resource()}
-    , regs_{o1_heap_mr_, registry_, media_block_mr_}
+    , regs_{o1_heap_mr_, registry_, media_block_mr_, startup_profiler}
+    , registry_phase_{startup_profiler, "app.registry_routing"}
 {
     cetl::pmr::set_default_resource(&o1_heap_mr_);
 
     load(storage_, registry_);
+    startup_profiler.mark("app.storage_load");
 
     // Maybe override some of the registry values with environment variables.
     //
@@ -55,6 +71,18 @@ Application::Application(const char* const root_path)
     {
         node_params.id.value()[0] = static_cast<std::uint16_t>(std::stoul(node_id_str));
     }
+    if (const auto* const capture_file_str = std::getenv("CYPHAL__DEMO__CAPTURE__FILE"))
+    {
+        getCaptureParams().file.value() = capture_file_str;
+    }
+    if (const auto* const shm_name_str = std::getenv("CYPHAL__DEMO__STATS__SHM"))
+    {
+        getStatsParams().shm_name.value() = shm_name_str;
+    }
+    if (const auto* const budget_ms_str = std::getenv("CYPHAL__DEMO__STARTUP__BUDGET_MS"))
+    {
+        getStartupParams().budget_ms.value()[0] = static_cast<std::uint16_t>(std::stoul(budget_ms_str));
+    }
 }
 
 Application::~Application()
@@ -136,3 +164,22 @@ Application::Regs::Value Application::Regs::getSysInfoMemGeneral() const
 
     return value;
 }
+
+/// Returns offsets (in microseconds since `main` entry) of the startup phases ends.
+///
+/// See printout of the `StartupProfiler` for the phase names; the last one is the first heartbeat (if any yet).
+///
+Application::Regs::Value Application::Regs::getSysInfoStartup() const
+{
+    Value value{{&o1_heap_mr_}};
+    auto& uint64s = value.set_natural64();
+
+    const std::size_t count = startup_profiler_.count();
+    uint64s.value.reserve(count);
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        uint64s.value.push_back(static_cast<std::uint64_t>(startup_profiler_.offsetOf(i).count()));
+    }
+
+    return value;
+}
@@ -7,11 +7,15 @@
 #ifndef APPLICATION_HPP
 #define APPLICATION_HPP
 
+#include "platform/binlog.hpp"
 #include "platform/block_memory_resource.hpp"
+#include "platform/flight_recorder.hpp"
 #include "platform/linux/epoll_single_threaded_executor.hpp"
 #include "platform/o1_heap_memory_resource.hpp"
+#include "platform/sampling_profiler.hpp"
 #include "platform/storage.hpp"
 #include "platform/string.hpp"
+#include "startup_profiler.hpp"
 
 #include <cetl/pf17/cetlpf.hpp>
 #include <libcyphal/application/registry/register.hpp>
@@ -34,6 +38,7 @@ public:
     // Defines max length of various strings.
     static constexpr std::size_t MaxIfaceLen = 64;
     static constexpr std::size_t MaxNodeDesc = 50;
+    static constexpr std::size_t MaxPathLen  = 128;
 
     struct Regs
     {
@@ -154,14 +159,70 @@ public:
 
         };  // Natural16Param
 
+        /// Defines general purpose uint64 array parameter exposed as mutable register.
+        ///
+        template <std::size_t N>
+        struct Natural64Param
+        {
+            Natural64Param(const libcyphal::application::registry::IRegister::Name     name,
+                           libcyphal::application::registry::Registry&                 registry,
+                           const std::array<std::uint64_t, N>                          initial_value,
+                           const libcyphal::application::registry::IRegister::Options& options = {})
+                : value_{initial_value}
+                , memory_{registry.memory()}
+                , register_{registry.route(
+                      name,
+                      [this] { return makeNatural64Value(); },
+                      [this](const auto& value) -> cetl::optional<libcyphal::application::registry::SetError> {
+                          //
+                          if (value.is_natural64())
+                          {
+                              const auto&       uint64s = value.get_natural64().value;
+                              const std::size_t count   = std::min(uint64s.size(), value_.size());
+                              for (std::size_t i = 0; i < count; ++i)
+                              {
+                                  value_[i] = uint64s[i];  // NOLINT
+                              }
+                              return cetl::nullopt;
+                          }
+                          return libcyphal::application::registry::SetError::Semantics;
+                      },
+                      options)}
+            {
+            }
+
+            CETL_NODISCARD std::array<std::uint64_t, N>& value()
+            {
+                return value_;
+            }
+
+        private:
+            CETL_NODISCARD Value makeNatural64Value() const
+            {
+                const Value::allocator_type allocator{&memory_};
+                Value                       value{allocator};
+                auto&                       uint64s = value.set_natural64();
+                std::copy(value_.cbegin(), value_.cend(), std::back_inserter(uint64s.value));
+                return value;
+            }
+
+            std::array<std::uint64_t, N> value_;
+            cetl::pmr::memory_resource&  memory_;
+            Register<RegisterFootprint>  register_;
+
+        };  // Natural64Param
+
         Regs(platform::O1HeapMemoryResource&             o1_heap_mr,
              libcyphal::application::registry::Registry& registry,
-             platform::BlockMemoryResource&              media_block_mr)
+             platform::BlockMemoryResource&              media_block_mr,
+             const StartupProfiler&                      startup_profiler)
             : o1_heap_mr_{o1_heap_mr}
             , registry_{registry}
             , media_block_mr_{media_block_mr}
+            , startup_profiler_{startup_profiler}
             , sys_info_mem_block_{registry.route("sys.info.mem.blk", [this] { return getSysInfoMemBlock(); })}
             , sys_info_mem_general_{registry.route("sys.info.mem.gen", [this] { return getSysInfoMemGeneral(); })}
+            , sys_info_startup_{registry.route("sys.info.startup", [this] { return getSysInfoStartup(); })}
         {
         }
 
@@ -170,19 +231,37 @@ public:
 
         Value getSysInfoMemBlock() const;
         Value getSysInfoMemGeneral() const;
+        Value getSysInfoStartup() const;
 
         platform::O1HeapMemoryResource&             o1_heap_mr_;
         libcyphal::application::registry::Registry& registry_;
         platform::BlockMemoryResource&              media_block_mr_;
+        const StartupProfiler&                      startup_profiler_;
 
         // clang-format off
-        StringParam<MaxIfaceLen>    can_iface_   {  "uavcan.can.iface",         registry_,  {"vcan0"},      {true}};
-        StringParam<MaxNodeDesc>    node_desc_   {  "uavcan.node.description",  registry_,  {NODE_NAME},    {true}};
-        Natural16Param<1>           node_id_     {  "uavcan.node.id",           registry_,  {65535U},       {true}};
-        StringParam<MaxIfaceLen>    udp_iface_   {  "uavcan.udp.iface",         registry_,  {"127.0.0.1"},  {true}};
-        Natural16Param<2>           demo_u16s_   {  "demo.u16s",                registry_,  {0U, 0U},       {false}};
+        StringParam<MaxIfaceLen>    can_iface_   {  "uavcan.can.iface",         registry_,  {"vcan0"},         {true}};
+        StringParam<MaxNodeDesc>    node_desc_   {  "uavcan.node.description",  registry_,  {NODE_NAME},       {true}};
+        Natural16Param<1>           node_id_     {  "uavcan.node.id",           registry_,  {65535U},          {true}};
+        StringParam<MaxIfaceLen>    udp_iface_   {  "uavcan.udp.iface",         registry_,  {"127.0.0.1"},     {true}};
+        Natural16Param<2>           demo_u16s_   {  "demo.u16s",                registry_,  {0U, 0U},          {false}};
+        StringParam<MaxIfaceLen>    stats_shm_   {  "demo.stats.shm",           registry_,  {""},              {true}};
+        Natural16Param<3>           hlth_late_   {  "demo.health.lateness_ms",  registry_,  {10U, 50U, 200U},  {true}};
+        Natural16Param<3>           hlth_media_  {  "demo.health.media_err",    registry_,  {1U, 10U, 100U},   {true}};
+        Natural16Param<3>           hlth_tx_     {  "demo.health.tx_overflow",  registry_,  {1U, 10U, 100U},   {true}};
+        Natural16Param<3>           hlth_rx_     {  "demo.health.rx_drop",      registry_,  {1U, 10U, 100U},   {true}};
+        Natural16Param<1>           start_bdgt_  {  "demo.startup.budget_ms",   registry_,  {0U},              {true}};
+        Natural16Param<1>           tx_q_cap_    {  "demo.tx.queue.capacity",   registry_,  {16U},             {true}};
+        Natural16Param<6>           flt_prob_    {  "demo.fault.permille",      registry_,  {},                {true}};
+        Natural16Param<1>           flt_delay_   {  "demo.fault.delay_ms",      registry_,  {0U},              {true}};
+        Natural64Param<1>           flt_seed_    {  "demo.fault.seed",          registry_,  {1U},              {true}};
+        Natural16Param<1>           tsync_mode_  {  "demo.time_sync.mode",      registry_,  {0U},              {true}};
+        Natural16Param<1>           perf_cnt_    {  "demo.perf.counters",       registry_,  {0U},              {true}};
+        Natural16Param<1>           perf_cbs_    {  "demo.perf.callbacks",      registry_,  {0U},              {true}};
+        Natural16Param<1>           clock_tsc_   {  "demo.clock.tsc",           registry_,  {1U},              {true}};
+        StringParam<MaxPathLen>     capture_     {  "demo.capture.file",        registry_,  {""},              {true}};
         Register<RegisterFootprint> sys_info_mem_block_;
         Register<RegisterFootprint> sys_info_mem_general_;
+        Register<RegisterFootprint> sys_info_startup_;
         // clang-format on
 
     };  // Regs
@@ -191,6 +270,8 @@ public:
     {
         Regs::StringParam<MaxIfaceLen>& udp_iface;
         Regs::StringParam<MaxIfaceLen>& can_iface;
+        /// Capacity of TX queue (in frames) per each media; it also determines size of the media block memory pool.
+        Regs::Natural16Param<1>&        tx_queue_capacity;
     };
 
     struct NodeParams
@@ -199,7 +280,78 @@ public:
         Regs::StringParam<MaxNodeDesc>& description;
     };
 
-    explicit Application(const char* const root_path);
+    struct StatsParams
+    {
+        /// Name of the POSIX shared memory object for the statistics page. Empty means disabled.
+        Regs::StringParam<MaxIfaceLen>& shm_name;
+    };
+
+    /// Thresholds of the heartbeat health evaluation (see `HealthEvaluator`).
+    ///
+    /// Each register is an array of three thresholds - for ADVISORY, CAUTION and WARNING health levels
+    /// respectively; zero threshold disables the corresponding level. Thresholds of error counters are applied
+    /// to number of errors per heartbeat period.
+    ///
+    struct HealthParams
+    {
+        Regs::Natural16Param<3>& lateness_ms;
+        Regs::Natural16Param<3>& media_errors;
+        Regs::Natural16Param<3>& tx_overflows;
+        Regs::Natural16Param<3>& rx_drops;
+    };
+
+    /// Fault injection into all media (see `FaultInjector`). Applied on the next start of the node.
+    ///
+    /// Probabilities are in per-mille, in order of `FaultInjector::Kind` - loss, duplication, reordering, delay,
+    /// corruption and TX buffer full. All zeros (the default) disable the fault injection entirely.
+    ///
+    struct FaultParams
+    {
+        Regs::Natural16Param<6>& permille;
+        Regs::Natural16Param<1>& delay_ms;
+        Regs::Natural64Param<1>& seed;
+    };
+
+    struct TimeSyncParams
+    {
+        enum Mode : std::uint16_t
+        {
+            ModeNone   = 0,
+            ModeMaster = 1,
+            ModeSlave  = 2,
+        };
+
+        /// Role of the node in `uavcan.time.Synchronization` (see `Mode`).
+        Regs::Natural16Param<1>& mode;
+    };
+
+    struct PerfParams
+    {
+        /// Non-zero enables the hardware performance counters (see `PerfCounters`) on the next start of the node.
+        Regs::Natural16Param<1>& counters;
+        /// Non-zero enables the executor callbacks time accounting (see `EpollSingleThreadedExecutor`).
+        Regs::Natural16Param<1>& callbacks;
+    };
+
+    struct ClockParams
+    {
+        /// Non-zero selects the invariant TSC as the executor clock source (see `TscClock`) if the CPU supports it.
+        Regs::Natural16Param<1>& tsc;
+    };
+
+    struct CaptureParams
+    {
+        /// Path of the file to capture the received frames and datagrams into (see `capture.h`). Empty means disabled.
+        Regs::StringParam<MaxPathLen>& file;
+    };
+
+    struct StartupParams
+    {
+        /// Time-to-first-heartbeat budget in milliseconds. Zero means no budget.
+        Regs::Natural16Param<1>& budget_ms;
+    };
+
+    Application(const char* const root_path, StartupProfiler& startup_profiler);
     ~Application();
 
     Application(const Application&)            = delete;
@@ -227,9 +379,30 @@ public:
         return registry_;
     }
 
+    /// Gets the asynchronous log for hot paths. It's drained by the main loop when idle.
+    ///
+    CETL_NODISCARD platform::BinLog& log() noexcept
+    {
+        return log_;
+    }
+
+    /// Gets the always-on recorder of the recent node events (see `FlightRecorder` for how to dump it).
+    ///
+    CETL_NODISCARD platform::FlightRecorder& flightRecorder() noexcept
+    {
+        return flight_recorder_;
+    }
+
+    /// Gets the on-demand sampling CPU profiler (see `SamplingProfiler` for how to start and stop it).
+    ///
+    CETL_NODISCARD platform::SamplingProfiler& samplingProfiler() noexcept
+    {
+        return sampling_profiler_;
+    }
+
     CETL_NODISCARD IfaceParams getIfaceParams() noexcept
     {
-        return {regs_.udp_iface_, regs_.can_iface_};
+        return {regs_.udp_iface_, regs_.can_iface_, regs_.tx_q_cap_};
     }
 
     CETL_NODISCARD NodeParams getNodeParams() noexcept
@@ -237,6 +410,46 @@ public:
         return {regs_.node_id_, regs_.node_desc_};
     }
 
+    CETL_NODISCARD StatsParams getStatsParams() noexcept
+    {
+        return {regs_.stats_shm_};
+    }
+
+    CETL_NODISCARD HealthParams getHealthParams() noexcept
+    {
+        return {regs_.hlth_late_, regs_.hlth_media_, regs_.hlth_tx_, regs_.hlth_rx_};
+    }
+
+    CETL_NODISCARD FaultParams getFaultParams() noexcept
+    {
+        return {regs_.flt_prob_, regs_.flt_delay_, regs_.flt_seed_};
+    }
+
+    CETL_NODISCARD TimeSyncParams getTimeSyncParams() noexcept
+    {
+        return {regs_.tsync_mode_};
+    }
+
+    CETL_NODISCARD PerfParams getPerfParams() noexcept
+    {
+        return {regs_.perf_cnt_, regs_.perf_cbs_};
+    }
+
+    CETL_NODISCARD ClockParams getClockParams() noexcept
+    {
+        return {regs_.clock_tsc_};
+    }
+
+    CETL_NODISCARD CaptureParams getCaptureParams() noexcept
+    {
+        return {regs_.capture_};
+    }
+
+    CETL_NODISCARD StartupParams getStartupParams() noexcept
+    {
+        return {regs_.start_bdgt_};
+    }
+
     /// Returns the 128-bit unique-ID of the local node. This value is used in `uavcan.node.GetInfo.Response`.
     ///
     using UniqueId = std::array<std::uint8_t, 16>;  // NOLINT
@@ -245,12 +458,17 @@ public:
 private:
     // MARK: Data members:
 
+    platform::BinLog                             log_;
+    platform::FlightRecorder                     flight_recorder_;
+    platform::SamplingProfiler                   sampling_profiler_;
     platform::Linux::EpollSingleThreadedExecutor executor_;
     platform::O1HeapMemoryResource               o1_heap_mr_;
+    StartupProfiler::Mark                        o1_heap_phase_;
     platform::BlockMemoryResource                media_block_mr_;
     platform::storage::KeyValue                  storage_;
     libcyphal::application::registry::Registry   registry_;
     Regs                                         regs_;
+    StartupProfiler::Mark                        registry_phase_;
 
 };  // Application
 
@@ -0,0 +1,70 @@
+// This software is distributed under the terms of the MIT License.
+// Copyright (C) OpenCyphal Development Team  <opencyphal.org>
+// Copyright Amazon.com Inc. or its affiliates.
+// SPDX-License-Identifier: MIT
+
+/// Replays a capture of the received traffic (see `demo.capture.file` register) into the network.
+///
+/// Usage: capture_replay <capture_file> [speed] [iface...]
+///
+/// The speed is a scale of the capture time: 1 (default) is the original speed, 10 is ten times faster,
+/// and 0 means as fast as possible. An interface is either a local IPv4 address to send the UDP datagrams from,
+/// or a SocketCAN interface name (f.e. "vcan0") - CAN interfaces are matched in the given order to the captured buses
+/// sorted by their interface index.
+/// Without interfaces the datagrams are sent from the loopback.
+
+#include "platform/linux/capture_replayer.hpp"
+
+#include "udp.h"
+
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+
+// NOLINTBEGIN(cppcoreguidelines-avoid-magic-numbers, readability-magic-numbers)
+
+int main(const int argc, char* const argv[])
+{
+    if (argc < 2)
+    {
+        std::cerr << "Usage: " << argv[0] << " <capture_file> [speed] [iface...]\n";  // NOLINT
+        return 1;
+    }
+    const char* const capture_file = argv[1];                                           // NOLINT
+    const double      speed        = (argc > 2) ? std::strtod(argv[2], nullptr) : 1.0;  // NOLINT
+
+    platform::Linux::CaptureReplayer replayer;
+    for (int i = 3; i < argc; ++i)
+    {
+        const char* const   iface         = argv[i];  // NOLINT
+        const std::uint32_t iface_address = ::udpParseIfaceAddress(iface);
+        const int           err           = (iface_address != 0) ? replayer.setUdpIface(iface_address)
+                                                                 : replayer.addCanIface(iface, true);
+        if (err < 0)
+        {
+            std::cerr << "❌ Failed to open '" << iface << "': " << std::strerror(-err) << "\n";
+            return 2;
+        }
+    }
+    if ((argc <= 3) && (replayer.setUdpIface(::udpParseIfaceAddress("127.0.0.1")) < 0))
+    {
+        std::cerr << "❌ Failed to open the loopback iface.\n";
+        return 2;
+    }
+
+    platform::Linux::CaptureReplayer::Stats stats{};
+    if (const int err = replayer.replay(capture_file, speed, stats))
+    {
+        std::cerr << "❌ Failed to replay '" << capture_file << "': " << std::strerror(-err) << "\n";
+        return 3;
+    }
+    std::cout << "udp_datagrams=" << stats.udp_datagrams << "\n"
+              << "can_frames=" << stats.can_frames << "\n"
+              << "skipped=" << stats.skipped << "\n"
+              << "send_errors=" << stats.send_errors << "\n"
+              << "max_lag=" << stats.max_lag_us << "us\n"
+              << "elapsed=" << stats.elapsed_us << "us\n";
+    return 0;
+}
+
+// NOLINTEND(cppcoreguidelines-avoid-magic-numbers, readability-magic-numbers)
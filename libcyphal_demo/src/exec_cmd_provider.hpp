@@ -7,6 +7,8 @@
 #ifndef COMMAND_PROVIDER_HPP_INCLUDED
 #define COMMAND_PROVIDER_HPP_INCLUDED
 
+#include "port_stats.h"
+
 #include "libcyphal/application/node.hpp"
 #include "libcyphal/presentation/presentation.hpp"
 #include "libcyphal/presentation/server.hpp"
@@ -17,6 +19,7 @@
 #include <uavcan/node/ExecuteCommand_1_3.hpp>
 
 #include <chrono>
+#include <cstdint>
 #include <utility>
 
 /// Defines 'ExecuteCommand' provider component for the application node.
@@ -52,10 +55,13 @@ public:
     ///
     /// @param node The application layer node instance. In use to access heartbeat producer.
     /// @param presentation The presentation layer instance. In use to create 'ExecuteCommand' service server.
+    /// @param args Extra arguments (if any), forwarded to the constructor of the derived class (after the server).
     /// @return The ExecuteCommand provider instance or a failure.
     ///
-    static auto make(libcyphal::application::Node& node, libcyphal::presentation::Presentation& presentation)
-        -> libcyphal::Expected<Derived, libcyphal::presentation::Presentation::MakeFailure>
+    template <typename... Args>
+    static auto make(libcyphal::application::Node&          node,
+                     libcyphal::presentation::Presentation& presentation,
+                     Args&&... args) -> libcyphal::Expected<Derived, libcyphal::presentation::Presentation::MakeFailure>
     {
         auto maybe_srv = presentation.makeServer<Service>();
         if (auto* const failure = cetl::get_if<libcyphal::presentation::Presentation::MakeFailure>(&maybe_srv))
@@ -63,13 +69,14 @@ public:
             return std::move(*failure);
         }
 
-        return Derived{node, presentation, cetl::get<Server>(std::move(maybe_srv))};
+        return Derived{node, presentation, cetl::get<Server>(std::move(maybe_srv)), std::forward<Args>(args)...};
     }
 
     ExecCmdProvider(ExecCmdProvider&& other) noexcept
         : alloc_{other.alloc_}
         , server_{std::move(other.server_)}
         , response_timeout_{other.response_timeout_}
+        , stats_{other.stats_}
     {
         // We have to set up request callback again (b/c it captures its own `this` pointer),
         setupOnRequestCallback();
@@ -90,6 +97,13 @@ public:
         response_timeout_ = timeout;
     }
 
+    /// Gets transfer statistics of the 'ExecuteCommand' server - requests received, and responses failed to be sent.
+    ///
+    const PortStats& portStats() const noexcept
+    {
+        return stats_;
+    }
+
     /// Handles incoming command requests.
     ///
     /// This method is called by the service server when a new request is received.
@@ -117,6 +131,7 @@ protected:
         , server_{std::move(server)}
         , response_timeout_{std::chrono::seconds{1}}
     {
+        ::portStatsInit(&stats_);
         setupOnRequestCallback();
     }
 
@@ -125,15 +140,23 @@ private:
     {
         server_.setOnRequestCallback([this](const auto& arg, auto continuation) {
             //
+            const auto now = arg.approx_now.time_since_epoch();
+            ::portStatsOnTransfer(&stats_,
+                                  static_cast<std::uint64_t>(
+                                      std::chrono::duration_cast<std::chrono::microseconds>(now).count()));
+
             Response response{alloc_};
             if (!onCommand(arg.request.command, makeStringView(arg.request.parameter), response))
             {
                 response.status = Response::STATUS_BAD_COMMAND;
             }
 
-            // There is nothing we can do about possible continuation failures - we just ignore them.
+            // There is nothing we can do about possible continuation failures - we just count them.
             // TODO: Introduce error handler at the node level.
-            (void) continuation(arg.approx_now + response_timeout_, response);
+            if (continuation(arg.approx_now + response_timeout_, response).has_value())
+            {
+                ::portStatsOnDrop(&stats_);
+            }
         });
     }
 
@@ -151,6 +174,7 @@ private:
     Response::allocator_type alloc_;
     Server                   server_;
     libcyphal::Duration      response_timeout_;
+    PortStats                stats_{};
 
 };  // ExecCmdProvider
 
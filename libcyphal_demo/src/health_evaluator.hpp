@@ -0,0 +1,150 @@
+// This software is distributed under the terms of the MIT License.
+// Copyright (C) OpenCyphal Development Team  <opencyphal.org>
+// Copyright Amazon.com Inc. or its affiliates.
+// SPDX-License-Identifier: MIT
+
+#ifndef HEALTH_EVALUATOR_HPP_INCLUDED
+#define HEALTH_EVALUATOR_HPP_INCLUDED
+
+#include "application.hpp"
+#include "platform/binlog.hpp"
+
+#include <libcyphal/types.hpp>
+
+#include <uavcan/node/Health_1_0.hpp>
+#include <uavcan/node/Heartbeat_1_0.hpp>
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+
+/// Evaluates the node health from runtime metrics, so that an overloaded or degraded node
+/// is visible network-wide (in its heartbeat) without any extra traffic.
+///
+/// Each metric is scored against its thresholds (see `Application::HealthParams`), and the worst score
+/// becomes the heartbeat health. The vendor-specific status code is a bit mask of metrics which are
+/// above their ADVISORY threshold (see `StatusBit`), so that the cause is visible as well.
+///
+/// Lateness is the worst one observed during the heartbeat period; error counters are cumulative totals,
+/// and the evaluator scores their increments since the previous heartbeat.
+///
+class HealthEvaluator final
+{
+public:
+    /// Defines bits of the heartbeat vendor-specific status code.
+    ///
+    enum StatusBit : std::uint8_t
+    {
+        StatusBitLateness    = 1U << 0U,
+        StatusBitMediaErrors = 1U << 1U,
+        StatusBitTxOverflows = 1U << 2U,
+        StatusBitRxDrops     = 1U << 3U,
+        StatusBitOutOfMemory = 1U << 4U,
+
+    };  // StatusBit
+
+    struct Totals
+    {
+        std::uint64_t media_errors;
+        std::uint64_t tx_overflows;
+        std::uint64_t rx_drops;
+        std::uint64_t oom_count;
+    };
+
+    HealthEvaluator(const Application::HealthParams& params, platform::BinLog& log)
+        : params_{params}
+        , log_{log}
+    {
+    }
+
+    /// Accumulates the worst callback lateness of the current heartbeat period. Called on each executor spin.
+    ///
+    void observeLateness(const libcyphal::Duration lateness) noexcept
+    {
+        period_worst_lateness_ = std::max(period_worst_lateness_, lateness);
+    }
+
+    /// Evaluates health for the just passed heartbeat period, and updates the heartbeat message accordingly.
+    ///
+    void evaluate(const Totals& totals, uavcan::node::Heartbeat_1_0& heartbeat)
+    {
+        using Health = uavcan::node::Health_1_0;
+
+        const auto lateness_ms = std::chrono::duration_cast<std::chrono::milliseconds>(period_worst_lateness_).count();
+
+        std::uint8_t health = Health::NOMINAL;
+        std::uint8_t status = 0;
+        score(static_cast<std::uint64_t>(std::max<std::int64_t>(lateness_ms, 0)),
+              params_.lateness_ms.value(),
+              StatusBitLateness,
+              health,
+              status);
+        score(totals.media_errors - prev_totals_.media_errors,
+              params_.media_errors.value(),
+              StatusBitMediaErrors,
+              health,
+              status);
+        score(totals.tx_overflows - prev_totals_.tx_overflows,
+              params_.tx_overflows.value(),
+              StatusBitTxOverflows,
+              health,
+              status);
+        score(totals.rx_drops - prev_totals_.rx_drops, params_.rx_drops.value(), StatusBitRxDrops, health, status);
+
+        // Any OOM is sticky - memory pools are sized statically, so it means a misconfiguration.
+        if (totals.oom_count > 0)
+        {
+            health = std::max<std::uint8_t>(health, Health::CAUTION);
+            status = static_cast<std::uint8_t>(status | StatusBitOutOfMemory);
+        }
+
+        if ((health != heartbeat.health.value) || (status != heartbeat.vendor_specific_status_code))
+        {
+            log_("🩺 Health %u -> %u (status=0x%x, lateness=%lldms).\n",
+                 heartbeat.health.value,
+                 health,
+                 status,
+                 lateness_ms);
+        }
+        heartbeat.health.value                = health;
+        heartbeat.vendor_specific_status_code = status;
+
+        prev_totals_           = totals;
+        period_worst_lateness_ = libcyphal::Duration::zero();
+    }
+
+private:
+    static void score(const std::uint64_t                 value,
+                      const std::array<std::uint16_t, 3>& thresholds,
+                      const StatusBit                     status_bit,
+                      std::uint8_t&                       inout_health,
+                      std::uint8_t&                       inout_status)
+    {
+        // Thresholds are for ADVISORY, CAUTION and WARNING levels; zero disables the level.
+        std::uint8_t level = uavcan::node::Health_1_0::NOMINAL;
+        for (std::size_t i = 0; i < thresholds.size(); ++i)
+        {
+            if ((thresholds[i] > 0) && (value >= thresholds[i]))  // NOLINT
+            {
+                level = static_cast<std::uint8_t>(uavcan::node::Health_1_0::ADVISORY + i);
+            }
+        }
+        if (level != uavcan::node::Health_1_0::NOMINAL)
+        {
+            inout_health = std::max(inout_health, level);
+            inout_status = static_cast<std::uint8_t>(inout_status | status_bit);
+        }
+    }
+
+    // MARK: Data members:
+
+    Application::HealthParams params_;
+    platform::BinLog&         log_;
+    libcyphal::Duration       period_worst_lateness_{};
+    Totals                    prev_totals_{};
+
+};  // HealthEvaluator
+
+#endif  // HEALTH_EVALUATOR_HPP_INCLUDED
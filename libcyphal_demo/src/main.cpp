@@ -5,7 +5,17 @@
 // Author: Sergei Shirokov <sergei.shirokov@zubax.com>
 
 #include "application.hpp"
+#include "capture.h"
 #include "exec_cmd_provider.hpp"
+#include "health_evaluator.hpp"
+#include "platform/fault_injector.hpp"
+#include "platform/linux/perf_counters.hpp"
+#include "platform/posix/shm_stats_page.hpp"
+#include "platform/tracer.hpp"
+#include "platform/tx_timestamp_tap.hpp"
+#include "port_stats.h"
+#include "startup_profiler.hpp"
+#include "time_sync.hpp"
 #include "transport_bag_can.hpp"
 #include "transport_bag_udp.hpp"
 
@@ -15,16 +25,21 @@
 #include <libcyphal/transport/transport.hpp>
 #include <libcyphal/types.hpp>
 
-#include <uavcan/node/Health_1_0.hpp>
+#include <uavcan/node/Heartbeat_1_0.hpp>
 #include <uavcan/node/Mode_1_0.hpp>
 
 #include <algorithm>
 #include <array>
+#include <chrono>
 #include <cstdint>
+#include <cstdio>
 #include <cstring>
+#include <dlfcn.h>
 #include <iomanip>
 #include <ios>
 #include <iostream>
+#include <iterator>
+#include <sstream>
 #include <unistd.h>  // execve
 #include <utility>
 
@@ -40,9 +55,11 @@ class AppExecCmdProvider final : public ExecCmdProvider<AppExecCmdProvider>
 public:
     AppExecCmdProvider(libcyphal::application::Node&                node,
                        const libcyphal::presentation::Presentation& presentation,
-                       Server&&                                     server)
+                       Server&&                                     server,
+                       platform::BinLog&                            log)
         : ExecCmdProvider{presentation, std::move(server)}
         , node_{node}
+        , log_{log}
     {
     }
 
@@ -56,6 +73,31 @@ public:
         return should_power_off_;
     }
 
+    /// Gets (and clears) the flight recorder dump request made by the `COMMAND_DUMP_FLIGHT_RECORDER` command.
+    ///
+    bool takeFlightRecorderDumpRequest() noexcept
+    {
+        return std::exchange(dump_flight_recorder_, false);
+    }
+
+    /// Gets (and clears) the profiler request made by the `COMMAND_PROFILER_START` (`true`)
+    /// or `COMMAND_PROFILER_STOP` (`false`) command.
+    ///
+    cetl::optional<bool> takeProfilerRequest() noexcept
+    {
+        return std::exchange(profiler_request_, cetl::nullopt);
+    }
+
+    /// Vendor-specific command which dumps the flight recorder (see `platform::FlightRecorder`) to a file.
+    ///
+    static constexpr Command COMMAND_DUMP_FLIGHT_RECORDER = 1000;
+
+    /// Vendor-specific commands which start and stop (writing the profile) the sampling CPU profiler
+    /// (see `platform::SamplingProfiler`).
+    ///
+    static constexpr Command COMMAND_PROFILER_START = 1001;
+    static constexpr Command COMMAND_PROFILER_STOP  = 1002;
+
 private:
     bool onCommand(const Request::_traits_::TypeOf::command command,
                    const cetl::string_view                  parameter,
@@ -67,33 +109,52 @@ private:
         {
         case Request::COMMAND_POWER_OFF:
             //
-            std::cout << "🛑 COMMAND_POWER_OFF\n";
+            log_("🛑 COMMAND_POWER_OFF\n");
             should_power_off_ = true;
             break;
 
         case Request::COMMAND_RESTART:
             //
-            std::cout << "♻️ COMMAND_RESTART\n";
+            log_("♻️ COMMAND_RESTART\n");
             restart_required_ = true;
             break;
 
         case Request::COMMAND_IDENTIFY:
             //
-            std::cout << "🔔 COMMAND_IDENTIFY\n";
+            log_("🔔 COMMAND_IDENTIFY\n");
             break;
 
         case Request::COMMAND_STORE_PERSISTENT_STATES:
             //
-            std::cout << "💾 COMMAND_STORE_PERSISTENT_STATES\n";
+            log_("💾 COMMAND_STORE_PERSISTENT_STATES\n");
             restart_required_ = true;
             break;
 
         case Request::COMMAND_BEGIN_SOFTWARE_UPDATE:
             //
-            std::cout << "🚧 COMMAND_BEGIN_SOFTWARE_UPDATE (file='" << parameter << "')\n";
+            // The parameter is not logged, b/c the deferred formatting needs strings of static storage duration.
+            log_("🚧 COMMAND_BEGIN_SOFTWARE_UPDATE (file name of %zu chars)\n", parameter.size());
             node_.heartbeatProducer().message().mode.value = uavcan::node::Mode_1_0::SOFTWARE_UPDATE;
             break;
 
+        case COMMAND_DUMP_FLIGHT_RECORDER:
+            //
+            log_("📼 COMMAND_DUMP_FLIGHT_RECORDER\n");
+            dump_flight_recorder_ = true;
+            break;
+
+        case COMMAND_PROFILER_START:
+            //
+            log_("🔥 COMMAND_PROFILER_START\n");
+            profiler_request_ = true;
+            break;
+
+        case COMMAND_PROFILER_STOP:
+            //
+            log_("🔥 COMMAND_PROFILER_STOP\n");
+            profiler_request_ = false;
+            break;
+
         default:
             return ExecCmdProvider::onCommand(command, parameter, response);
         }
@@ -101,11 +162,182 @@ private:
     }
 
     libcyphal::application::Node& node_;
+    platform::BinLog&             log_;
     bool                          should_power_off_{false};
     bool                          restart_required_{false};
+    bool                          dump_flight_recorder_{false};
+    cetl::optional<bool>          profiler_request_;
 
 };  // AppExecCmdProvider
 
+/// Publishes the main loop, memory, transport (TX queue depths and error totals) and per-port (transfers, drops
+/// and timeouts) statistics to the (optional) shared memory page.
+///
+class RunStatsPublisher final
+{
+public:
+    /// Only one of the transports is active, so the TX queues of both are published (in the order of CAN and UDP
+    /// media), and their error counters are summed up - the same way as the `sys.info.*` registers do.
+    ///
+    struct Sources
+    {
+        const TransportBagCan& can;
+        const TransportBagUdp& udp;
+        const PortStats&       heartbeat;  ///< Of the heartbeat publisher.
+        const PortStats&       exec_cmd;   ///< Of the execute command server.
+    };
+
+    struct Sample
+    {
+        std::uint64_t                              iterations;
+        libcyphal::Duration                        last_lateness;
+        libcyphal::Duration                        worst_lateness;
+        O1HeapDiagnostics                          gen_diag;
+        platform::BlockMemoryResource::Diagnostics blk_diag;
+    };
+
+    void open(const char* const shm_name, const Sources& sources)
+    {
+        if (*shm_name == '\0')
+        {
+            return;  // Disabled.
+        }
+
+        if (const int err = page_.open(shm_name))
+        {
+            std::cerr << "⚠️ Failed to open stats page '" << shm_name << "' (err=" << err << ").\n";
+            return;
+        }
+        std::cout << "Stats page: '" << shm_name << "'\n";
+
+        loop_iterations_     = page_.addCounter("loop.iterations");
+        loop_last_lateness_  = page_.addCounter("loop.last_lateness_us");
+        loop_worst_lateness_ = page_.addCounter("loop.worst_lateness_us");
+        gen_allocated_       = page_.addCounter("mem.gen.allocated");
+        gen_peak_allocated_  = page_.addCounter("mem.gen.peak_allocated");
+        gen_oom_count_       = page_.addCounter("mem.gen.oom_count");
+        blk_allocated_       = page_.addCounter("mem.blk.allocated");
+        blk_peak_allocated_  = page_.addCounter("mem.blk.peak_allocated");
+        blk_oom_count_       = page_.addCounter("mem.blk.oom_count");
+
+        sources_.emplace(sources);
+        tx_queues_count_ = std::min(sources.can.mediaCount() + sources.udp.mediaCount(), MaxTxQueues);
+        for (std::size_t i = 0; i < tx_queues_count_; ++i)
+        {
+            platform::posix::StatsPage::CounterName name{};
+            (void) std::snprintf(name.data(), name.size(), "tx.queue%zu.depth", i);
+            tx_queue_depth_[i] = page_.addCounter(name.data());  // NOLINT(*-constant-array-index)
+            (void) std::snprintf(name.data(), name.size(), "tx.queue%zu.peak", i);
+            tx_queue_peak_[i] = page_.addCounter(name.data());  // NOLINT(*-constant-array-index)
+        }
+        media_errors_ = page_.addCounter("transport.media_errors");
+        tx_overflows_ = page_.addCounter("transport.tx_overflows");
+        rx_drops_     = page_.addCounter("transport.rx_drops");
+        addPortCounters("port.pub.heartbeat", heartbeat_);
+        addPortCounters("port.srv.execute_command", exec_cmd_);
+    }
+
+    void publish(const Sample& sample) noexcept
+    {
+        page_.update([&](platform::posix::ShmStatsPageWriter& page) {
+            //
+            page.set(loop_iterations_, sample.iterations);
+            page.set(loop_last_lateness_, toMicroseconds(sample.last_lateness));
+            page.set(loop_worst_lateness_, toMicroseconds(sample.worst_lateness));
+            page.set(gen_allocated_, sample.gen_diag.allocated);
+            page.set(gen_peak_allocated_, sample.gen_diag.peak_allocated);
+            page.set(gen_oom_count_, sample.gen_diag.oom_count);
+            page.set(blk_allocated_, sample.blk_diag.allocated);
+            page.set(blk_peak_allocated_, sample.blk_diag.peak_allocated);
+            page.set(blk_oom_count_, sample.blk_diag.oom_count);
+            if (!sources_.has_value())
+            {
+                return;
+            }
+            const Sources& sources = sources_.value();
+            for (std::size_t i = 0; i < tx_queues_count_; ++i)
+            {
+                const std::size_t can_count = sources.can.mediaCount();
+                const auto        diag      = (i < can_count) ? sources.can.queryTxQueueDiagnostics(i)
+                                                              : sources.udp.queryTxQueueDiagnostics(i - can_count);
+                page.set(tx_queue_depth_[i], diag.allocated);      // NOLINT(*-constant-array-index)
+                page.set(tx_queue_peak_[i], diag.peak_allocated);  // NOLINT(*-constant-array-index)
+            }
+            const auto& can_errors = sources.can.transientErrorCounters();
+            const auto& udp_errors = sources.udp.transientErrorCounters();
+            page.set(media_errors_, can_errors.media_errors + udp_errors.media_errors);
+            page.set(tx_overflows_, can_errors.tx_overflows + udp_errors.tx_overflows);
+            page.set(rx_drops_, can_errors.rx_drops + udp_errors.rx_drops);
+            setPortCounters(page, heartbeat_, sources.heartbeat);
+            setPortCounters(page, exec_cmd_, sources.exec_cmd);
+        });
+    }
+
+    bool isEnabled() const noexcept
+    {
+        return page_.isOpen();
+    }
+
+private:
+    using CounterIndex = platform::posix::ShmStatsPageWriter::CounterIndex;
+
+    static constexpr std::size_t MaxTxQueues = platform::CommonHelpers::TransientErrorCounters::MaxMedia;
+
+    struct PortCounters
+    {
+        CounterIndex transfers{platform::posix::StatsPage::InvalidCounter};
+        CounterIndex drops{platform::posix::StatsPage::InvalidCounter};
+        CounterIndex timeouts{platform::posix::StatsPage::InvalidCounter};
+    };
+
+    void addPortCounters(const char* const prefix, PortCounters& counters) noexcept
+    {
+        platform::posix::StatsPage::CounterName name{};
+        (void) std::snprintf(name.data(), name.size(), "%s.transfers", prefix);
+        counters.transfers = page_.addCounter(name.data());
+        (void) std::snprintf(name.data(), name.size(), "%s.drops", prefix);
+        counters.drops = page_.addCounter(name.data());
+        (void) std::snprintf(name.data(), name.size(), "%s.timeouts", prefix);
+        counters.timeouts = page_.addCounter(name.data());
+    }
+
+    static void setPortCounters(platform::posix::ShmStatsPageWriter& page,
+                                const PortCounters&                  counters,
+                                const PortStats&                     stats) noexcept
+    {
+        page.set(counters.transfers, stats.transfers);
+        page.set(counters.drops, stats.drops);
+        page.set(counters.timeouts, stats.timeouts);
+    }
+
+    static std::uint64_t toMicroseconds(const libcyphal::Duration duration) noexcept
+    {
+        const auto us = std::chrono::duration_cast<std::chrono::microseconds>(duration).count();
+        return (us > 0) ? static_cast<std::uint64_t>(us) : 0U;
+    }
+
+    platform::posix::ShmStatsPageWriter   page_;
+    CounterIndex                          loop_iterations_{platform::posix::StatsPage::InvalidCounter};
+    CounterIndex                          loop_last_lateness_{platform::posix::StatsPage::InvalidCounter};
+    CounterIndex                          loop_worst_lateness_{platform::posix::StatsPage::InvalidCounter};
+    CounterIndex                          gen_allocated_{platform::posix::StatsPage::InvalidCounter};
+    CounterIndex                          gen_peak_allocated_{platform::posix::StatsPage::InvalidCounter};
+    CounterIndex                          gen_oom_count_{platform::posix::StatsPage::InvalidCounter};
+    CounterIndex                          blk_allocated_{platform::posix::StatsPage::InvalidCounter};
+    CounterIndex                          blk_peak_allocated_{platform::posix::StatsPage::InvalidCounter};
+    CounterIndex                          blk_oom_count_{platform::posix::StatsPage::InvalidCounter};
+    cetl::optional<Sources>               sources_;
+    std::size_t                           tx_queues_count_{0};
+    std::array<CounterIndex, MaxTxQueues> tx_queue_depth_{};
+    std::array<CounterIndex, MaxTxQueues> tx_queue_peak_{};
+    CounterIndex                          media_errors_{platform::posix::StatsPage::InvalidCounter};
+    CounterIndex                          tx_overflows_{platform::posix::StatsPage::InvalidCounter};
+    CounterIndex                          rx_drops_{platform::posix::StatsPage::InvalidCounter};
+    PortCounters                          heartbeat_;
+    PortCounters                          exec_cmd_;
+
+};  // RunStatsPublisher
+
 /// Defines various exit codes for the demo application.
 ///
 enum class ExitCode : std::uint8_t
@@ -116,6 +348,8 @@ enum class ExitCode : std::uint8_t
     RegistryCreationFailure        = 3,
     ExecCmdProviderCreationFailure = 4,
     RestartFailure                 = 5,
+    TimeSyncCreationFailure        = 6,
+    StartupBudgetExceeded          = 7,
 
 };  // ExitCode
 
@@ -127,34 +361,123 @@ void PrintUniqueIdTo(const std::array<std::uint8_t, 16>& unique_id, std::ostream
     }
 }
 
-libcyphal::Expected<bool, ExitCode> run_application(const char* const root_path)
+using TopCallbacks = std::array<platform::Linux::EpollSingleThreadedExecutor::CallbackStats, 8>;
+
+/// Gets the (mangled) name of the function which has registered a callback, or its address if unknown.
+///
+const char* CallbackOriginName(const void* const origin, std::array<char, 32>& buffer)
+{
+    Dl_info info{};
+    if ((::dladdr(origin, &info) != 0) && (info.dli_sname != nullptr))
+    {
+        return info.dli_sname;
+    }
+    (void) std::snprintf(buffer.data(), buffer.size(), "%p", origin);
+    return buffer.data();
+}
+
+/// Prints the top CPU time consumers among the executor callbacks (if their time is accounted), and the hardware
+/// events per call of each of them (if the perf counters are open). Each callback is identified by the (mangled)
+/// name of the function which has registered it, plus the file descriptor if it's an awaitable one.
+///
+void PrintTopCallbacksTo(const platform::Linux::EpollSingleThreadedExecutor& executor, std::ostream& os)
+{
+    TopCallbacks         top{};
+    const std::size_t    count = executor.getTopCallbacks(top);
+    std::array<char, 32> buffer{};
+
+    if (executor.isCallbackAccounting())
+    {
+        os << "Top callbacks (of " << count << ", unaccounted=" << executor.unaccountedCallbacks() << "):\n";
+        os << std::setfill(' ') << std::right << std::setw(12) << "cpu_us" << std::setw(12) << "wall_us"
+           << std::setw(12) << "max_wall_us" << std::setw(10) << "calls" << std::setw(5) << "fd" << "  origin\n";
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            const auto& stats = top[i];  // NOLINT(*-constant-array-index)
+            os << std::setw(12) << (stats.cpu_ns / 1000U) << std::setw(12) << (stats.wall_ns / 1000U)
+               << std::setw(12) << (stats.max_wall_ns / 1000U) << std::setw(10) << stats.calls << std::setw(5)
+               << stats.fd << "  " << CallbackOriginName(stats.origin, buffer) << "\n";
+        }
+    }
+    if (platform::Linux::PerfCounters::isOpen())
+    {
+        os << "Perf counters per callback (per call, fd in brackets):\n";
+        platform::Linux::PerfCounters::printHeaderTo(os, "origin");
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            const auto&        stats = top[i];  // NOLINT(*-constant-array-index)
+            std::ostringstream name;
+            name << "[" << stats.fd << "] " << CallbackOriginName(stats.origin, buffer);
+            platform::Linux::PerfCounters::printRowTo(os, name.str().c_str(), stats.perf);
+        }
+    }
+}
+
+libcyphal::Expected<bool, ExitCode> run_application(const char* const root_path, StartupProfiler& startup_profiler)
 {
     std::cout << "\n🟢 ***************** LibCyphal demo *******************\n";
     std::cout << "Root path : '" << root_path << "'\n";
 
-    Application application{root_path};
-    auto&       executor       = application.executor();
-    auto&       general_mr     = application.general_memory();
-    auto&       media_block_mr = application.media_block_memory();
+    Application application{root_path, startup_profiler};
+    auto&       executor        = application.executor();
+    auto&       general_mr      = application.general_memory();
+    auto&       media_block_mr  = application.media_block_memory();
+    auto&       log             = application.log();
+    auto&       flight_recorder = application.flightRecorder();
+    auto&       profiler        = application.samplingProfiler();
 
     auto node_params  = application.getNodeParams();
     auto iface_params = application.getIfaceParams();
+    auto stats_params = application.getStatsParams();
+    auto fault_params = application.getFaultParams();
+
+    // The executor clock source is selected before anything gets scheduled (see `demo.clock.tsc` register).
+    //
+    if (application.getClockParams().tsc.value()[0] != 0)
+    {
+        const bool is_tsc = executor.useTscClock();
+        std::cout << "Clock     : " << (is_tsc ? "TSC" : "CLOCK_MONOTONIC (no invariant TSC)") << "\n";
+    }
+
+    // Similarly, the callbacks are moved into the executor accounting slots only if they are registered while
+    // the hardware events counting (see `PerfCounters`) or the callbacks time accounting is enabled.
+    //
+    if (application.getPerfParams().counters.value()[0] != 0)
+    {
+        const int perf_err = platform::Linux::PerfCounters::open();
+        std::cout << "Perf cnt  : " << ((perf_err == 0) ? "enabled" : "unavailable") << " (err=" << perf_err << ")\n";
+    }
+    executor.setCallbackAccounting(application.getPerfParams().callbacks.value()[0] != 0);
 
     // 1. Create the transport layer object. First try CAN, then UDP.
+    //    If configured, all media are wrapped with fault-injecting decorators (see `demo.fault.*` registers).
+    //    The media also capture TX timestamps of the time synchronization messages (see `TimeSyncMaster`).
     //
-    TransportBagCan transport_bag_can{general_mr, executor, media_block_mr};
-    TransportBagUdp transport_bag_udp{general_mr, executor, media_block_mr};
+    platform::FaultInjector fault_injector{{fault_params.permille.value(),
+                                            fault_params.delay_ms.value()[0],
+                                            fault_params.seed.value()[0]}};
+    if (fault_injector.isEnabled())
+    {
+        std::cout << "⚠️ Fault injection is enabled (seed=" << fault_params.seed.value()[0] << ").\n";
+    }
+    platform::TxTimestampTap tx_tap;
+
+    TransportBagCan
+        transport_bag_can{general_mr, executor, media_block_mr, log, flight_recorder, fault_injector, tx_tap};
+    TransportBagUdp
+        transport_bag_udp{general_mr, executor, media_block_mr, log, flight_recorder, fault_injector, tx_tap};
     //
-    libcyphal::transport::ITransport* transport_iface = transport_bag_can.create(iface_params);
+    libcyphal::transport::ITransport* transport_iface = transport_bag_can.create(iface_params, startup_profiler);
     if (transport_iface == nullptr)
     {
-        transport_iface = transport_bag_udp.create(iface_params);
+        transport_iface = transport_bag_udp.create(iface_params, startup_profiler);
     }
     if (transport_iface == nullptr)
     {
         std::cerr << "❌ Failed to create any transport.\n";
         return ExitCode::TransportCreationFailure;
     }
+    startup_profiler.mark("transport");
 
     // 2. Create the presentation layer object.
     //
@@ -166,6 +489,7 @@ libcyphal::Expected<bool, ExitCode> run_application(const char* const root_path)
     PrintUniqueIdTo(unique_id, std::cout);
     std::cout << "\n";
     libcyphal::presentation::Presentation presentation{general_mr, executor, *transport_iface};
+    startup_profiler.mark("presentation");
 
     // 3. Create the node object with name.
     //
@@ -178,6 +502,7 @@ libcyphal::Expected<bool, ExitCode> run_application(const char* const root_path)
         ;
     }
     auto node = cetl::get<libcyphal::application::Node>(std::move(maybe_node));
+    startup_profiler.mark("node");
 
     // 4. Populate the node info.
     //
@@ -190,16 +515,97 @@ libcyphal::Expected<bool, ExitCode> run_application(const char* const root_path)
         .setSoftwareVcsRevisionId(VCS_REVISION_ID)
         .setUniqueId(unique_id);
     //
-    // Update node's health according to states of memory resources.
-    node.heartbeatProducer().setUpdateCallback([&](const auto& arg) {
+    // Update node's health according to runtime metrics (executor lateness, transport errors and memory).
+    HealthEvaluator health_evaluator{application.getHealthParams(), log};
+    const auto      collect_health_totals = [&]() -> HealthEvaluator::Totals {
+        //
+        const auto& can_errors = transport_bag_can.transientErrorCounters();
+        const auto& udp_errors = transport_bag_udp.transientErrorCounters();
+        return {can_errors.media_errors + udp_errors.media_errors,
+                can_errors.tx_overflows + udp_errors.tx_overflows,
+                can_errors.rx_drops + udp_errors.rx_drops,
+                general_mr.queryDiagnostics().oom_count + media_block_mr.queryDiagnostics().oom_count};
+    };
+    //
+    // Time synchronization master (if any, see step 7) publishes on the heartbeat update as well.
+    cetl::optional<TimeSyncMaster> time_sync_master;
+    //
+    // Heartbeat publications are tracked for the per-port statistics (see step 10).
+    // The heartbeat producer publishes right after the update callback and doesn't expose the outcome, so the
+    // accounting is deferred to a one-shot callback which runs after the publication. Failed TX pushes are reported
+    // synchronously (per media) to the transient error handler, so if every media has reported one since the update,
+    // the heartbeat is counted as dropped.
+    PortStats heartbeat_stats{};
+    portStatsInit(&heartbeat_stats);
+    const auto collect_tx_overflows = [&] {
+        //
+        return transport_bag_can.transientErrorCounters().tx_overflows +
+               transport_bag_udp.transientErrorCounters().tx_overflows;
+    };
+    std::uint64_t heartbeat_update_at_us = 0;
+    std::uint64_t heartbeat_tx_overflows = 0;
+    //
+    auto heartbeat_accounting = executor.registerCallback([&](const auto&) {
         //
-        const auto gen_diag = general_mr.queryDiagnostics();
-        const auto blk_diag = media_block_mr.queryDiagnostics();
-        if ((gen_diag.oom_count > 0) || (blk_diag.oom_count > 0))
+        const std::uint64_t failed_media = collect_tx_overflows() - heartbeat_tx_overflows;
+        if (failed_media < (transport_bag_can.mediaCount() + transport_bag_udp.mediaCount()))
+        {
+            portStatsOnTransfer(&heartbeat_stats, heartbeat_update_at_us);
+        }
+        else
         {
-            arg.message.health.value = uavcan::node::Health_1_0::CAUTION;
+            portStatsOnDrop(&heartbeat_stats);
         }
     });
+    //
+    // The very first heartbeat also completes the startup profiling. If it comes later than the budget (if any),
+    // the node exits with a dedicated code, so that a regression could be caught (see `bench_startup`).
+    const auto startup_budget_ms          = application.getStartupParams().budget_ms.value()[0];
+    bool       is_first_heartbeat         = true;
+    bool       is_startup_budget_exceeded = false;
+    const auto on_heartbeat_update = [&](uavcan::node::Heartbeat_1_0& heartbeat) {
+        //
+        PLATFORM_TRACE_INSTANT("publish.heartbeat", heartbeat.uptime);
+        PLATFORM_PERF_SCOPE("heartbeat.update");
+        health_evaluator.evaluate(collect_health_totals(), heartbeat);
+
+        heartbeat_update_at_us = static_cast<std::uint64_t>(
+            std::chrono::duration_cast<std::chrono::microseconds>(executor.now().time_since_epoch()).count());
+
+        // Heartbeat is a convenient 1Hz tick to summarize transient error storms (if any).
+        transport_bag_can.summarizeTransientErrors();
+        transport_bag_udp.summarizeTransientErrors();
+
+        // ... and to publish the time synchronization (which is also expected at 1Hz).
+        if (time_sync_master)
+        {
+            time_sync_master->publish();
+        }
+
+        // Only the TX failures of the heartbeat itself should be seen by the accounting (see above).
+        heartbeat_tx_overflows = collect_tx_overflows();
+        (void) heartbeat_accounting.schedule(libcyphal::IExecutor::Callback::Schedule::Once{executor.now()});
+
+        if (is_first_heartbeat)
+        {
+            is_first_heartbeat = false;
+            startup_profiler.mark("first_heartbeat");
+            startup_profiler.account("udp.multicast_joins", transport_bag_udp.multicastJoinsTime());
+            startup_profiler.printTo(std::cout);
+
+            const auto ttfh = startup_profiler.total();
+            std::cout << "  time_to_first_heartbeat=" << ttfh.count() << "us" << std::endl;  // NOLINT
+            if ((startup_budget_ms > 0) && (ttfh > std::chrono::milliseconds{startup_budget_ms}))
+            {
+                std::cerr << "❌ Time to first heartbeat exceeds the budget (" << startup_budget_ms << "ms).\n";
+                is_startup_budget_exceeded = true;
+            }
+        }
+    };
+    node.heartbeatProducer().setUpdateCallback([&on_heartbeat_update](const auto& arg) {
+        //
+        on_heartbeat_update(arg.message);
+    });
 
     // 5. Bring up registry provider.
     //
@@ -208,38 +614,332 @@ libcyphal::Expected<bool, ExitCode> run_application(const char* const root_path)
         std::cerr << "❌ Failed to create registry provider.\n";
         return ExitCode::RegistryCreationFailure;
     }
+    startup_profiler.mark("registry_provider");
 
     // 6. Bring up the command execution provider.
     //
-    auto maybe_exec_cmd_provider = AppExecCmdProvider::make(node, presentation);
+    auto maybe_exec_cmd_provider = AppExecCmdProvider::make(node, presentation, log);
     if (const auto* failure = cetl::get_if<libcyphal::application::Node::MakeFailure>(&maybe_exec_cmd_provider))
     {
         std::cerr << "❌ Failed to create exec cmd provider.\n";
         return ExitCode::ExecCmdProviderCreationFailure;
     }
     auto exec_cmd_provider = cetl::get<AppExecCmdProvider>(std::move(maybe_exec_cmd_provider));
+    startup_profiler.mark("exec_cmd_provider");
+
+    // 7. Bring up the time synchronization master or slave (see `demo.time_sync.mode` register).
+    //
+    using TimeSyncMode = Application::TimeSyncParams::Mode;
+    //
+    const auto                    time_sync_mode   = application.getTimeSyncParams().mode.value()[0];
+    bool                          time_sync_failed = false;
+    cetl::optional<TimeSyncSlave> time_sync_slave;
+    if (time_sync_mode == TimeSyncMode::ModeMaster)
+    {
+        auto maybe_master = TimeSyncMaster::make(presentation, executor, tx_tap);
+        time_sync_failed  = !cetl::holds_alternative<TimeSyncMaster>(maybe_master);
+        if (!time_sync_failed)
+        {
+            time_sync_master.emplace(cetl::get<TimeSyncMaster>(std::move(maybe_master)));
+        }
+    }
+    else if (time_sync_mode == TimeSyncMode::ModeSlave)
+    {
+        auto maybe_slave =
+            TimeSyncSlave::make(presentation, transport_iface->getProtocolParams().transfer_id_modulo);
+        time_sync_failed = !cetl::holds_alternative<TimeSyncSlave>(maybe_slave);
+        if (!time_sync_failed)
+        {
+            time_sync_slave.emplace(cetl::get<TimeSyncSlave>(std::move(maybe_slave)));
+        }
+    }
+    if (time_sync_failed)
+    {
+        std::cerr << "❌ Failed to create time synchronization " << time_sync_mode << ".\n";
+        return ExitCode::TimeSyncCreationFailure;
+    }
+    startup_profiler.mark("time_sync");
+    //
+    // The slave metrics are [samples, offset_us, drift_ppb, last_error_us, max_abs_error_us, convergence_time_us,
+    // master_node_id] (see `TimeSyncSlave::Metrics`), and the master one is the number of published messages.
+    const auto time_sync_register = application.registry().route("sys.info.time_sync", [&] {
+        //
+        Application::Regs::Value value{{&general_mr}};
+        auto&                    int64s = value.set_integer64();
+        if (time_sync_slave)
+        {
+            const auto metrics = time_sync_slave->getMetrics();
+            int64s.value.push_back(static_cast<std::int64_t>(metrics.samples));
+            int64s.value.push_back(metrics.offset_us);
+            int64s.value.push_back(metrics.drift_ppb);
+            int64s.value.push_back(metrics.last_error_us);
+            int64s.value.push_back(metrics.max_abs_error_us);
+            int64s.value.push_back(metrics.convergence_time_us);
+            int64s.value.push_back(metrics.master_node_id);
+        }
+        if (time_sync_master)
+        {
+            int64s.value.push_back(static_cast<std::int64_t>(time_sync_master->published()));
+        }
+        return value;
+    });
+
+    // 8. Expose TX queue high-water marks of all media (to tune `demo.tx.queue.capacity` from field data).
+    //
+    const auto tx_queue_hwm_register = application.registry().route("sys.info.tx.queue_hwm", [&] {
+        //
+        Application::Regs::Value value{{&general_mr}};
+        auto&                    uint64s = value.set_natural64();
+        for (std::size_t i = 0; i < transport_bag_can.mediaCount(); ++i)
+        {
+            uint64s.value.push_back(transport_bag_can.queryTxQueueDiagnostics(i).peak_allocated);
+        }
+        for (std::size_t i = 0; i < transport_bag_udp.mediaCount(); ++i)
+        {
+            uint64s.value.push_back(transport_bag_udp.queryTxQueueDiagnostics(i).peak_allocated);
+        }
+        return value;
+    });
+
+    // 9. Expose transient error counters. The first three are totals grouped by effect (media errors, TX overflows,
+    //    RX drops), followed by totals per error kind and media index (see `CommonHelpers::{Can,Udp}::ErrorKind`),
+    //    including the unknown media column (see `TransientErrorCounters::UnknownMedia`).
+    //    Only one of the transports is active, so their counters are just summed up.
+    //
+    const auto transient_errors_register = application.registry().route("sys.info.transient_errors", [&] {
+        //
+        using Counters = platform::CommonHelpers::TransientErrorCounters;
+
+        const auto& can_errors = transport_bag_can.transientErrorCounters();
+        const auto& udp_errors = transport_bag_udp.transientErrorCounters();
+
+        Application::Regs::Value value{{&general_mr}};
+        auto&                    uint64s = value.set_natural64();
+        uint64s.value.reserve(3 + (Counters::MaxKinds * Counters::MediaColumns));  // NOLINT
+        uint64s.value.push_back(can_errors.media_errors + udp_errors.media_errors);
+        uint64s.value.push_back(can_errors.tx_overflows + udp_errors.tx_overflows);
+        uint64s.value.push_back(can_errors.rx_drops + udp_errors.rx_drops);
+        for (std::size_t kind = 0; kind < Counters::MaxKinds; ++kind)
+        {
+            for (std::size_t media = 0; media < Counters::MediaColumns; ++media)
+            {
+                uint64s.value.push_back(can_errors.per_kind_totals[kind][media] +  // NOLINT
+                                        udp_errors.per_kind_totals[kind][media]);  // NOLINT
+            }
+        }
+        return value;
+    });
+
+    // 10. Expose per-port transfer statistics: transfers, drops, timeouts, mean interval, jitter and max interval
+    //     (all intervals are in microseconds; see `shared/port_stats/port_stats.h`).
+    //
+    const auto make_port_stats_value = [&general_mr](const PortStats& stats) {
+        //
+        Application::Regs::Value value{{&general_mr}};
+        auto&                    uint64s = value.set_natural64();
+        uint64s.value.resize(PORT_STATS_EXPORT_SIZE);
+        portStatsExport(&stats, uint64s.value.data());
+        return value;
+    };
+    const auto heartbeat_stats_register = application.registry().route("sys.info.port.pub.heartbeat", [&] {
+        //
+        return make_port_stats_value(heartbeat_stats);
+    });
+    const auto exec_cmd_stats_register = application.registry().route("sys.info.port.srv.execute_command", [&] {
+        //
+        return make_port_stats_value(exec_cmd_provider.portStats());
+    });
+
+    // 11. Expose counters of the injected faults (in order of `FaultInjector::Kind`).
+    //
+    const auto faults_register = application.registry().route("sys.info.faults", [&] {
+        //
+        Application::Regs::Value value{{&general_mr}};
+        auto&                    uint64s = value.set_natural64();
+        const auto&              counts  = fault_injector.injectedCounts();
+        std::copy(counts.cbegin(), counts.cend(), std::back_inserter(uint64s.value));
+        return value;
+    });
+
+    // 12. The flight recorder is dumped on `SIGUSR1`, on crash, or on the `COMMAND_DUMP_FLIGHT_RECORDER` command.
+    //
+    std::array<char, 256> flight_recorder_path{};
+    (void) std::snprintf(flight_recorder_path.data(), flight_recorder_path.size(), "%s/flight_recorder.txt", root_path);
+    platform::FlightRecorder::installSignalHandlers(flight_recorder, flight_recorder_path.data());
+    std::cout << "Flight rec: '" << flight_recorder_path.data() << "'\n";
+
+    // 13. Optionally expose run statistics via shared memory page (see `stats_reader` tool).
+    //
+    RunStatsPublisher run_stats;
+    run_stats.open(stats_params.shm_name.value().c_str(),
+                   {transport_bag_can, transport_bag_udp, heartbeat_stats, exec_cmd_provider.portStats()});
+
+    // 14. The sampling profiler is toggled by `SIGUSR2`, or by the `COMMAND_PROFILER_START/STOP` commands.
+    //     On stop, the folded stacks are written to the `profile.folded` file (see `flamegraph.pl`).
+    //
+    constexpr std::uint32_t ProfilerRateHz = 1000;
+    std::array<char, 256>   profile_path{};
+    (void) std::snprintf(profile_path.data(), profile_path.size(), "%s/profile.folded", root_path);
+    platform::SamplingProfiler::installSignalHandler();
+    const auto toggle_profiler = [&](const bool start) {
+        //
+        if (start == profiler.isRunning())
+        {
+            return;
+        }
+        if (start)
+        {
+            const auto result = profiler.start(ProfilerRateHz);
+            std::cout << "🔥 Profiler start @" << ProfilerRateHz << "Hz: " << ((result == 0) ? "ok" : "failed")
+                      << " (" << result << ")\n";
+            return;
+        }
+        const auto result = profiler.stopAndWrite(profile_path.data());
+        std::cout << "🔥 Profiler stop: " << profiler.samples() << " samples (" << profiler.dropped()
+                  << " dropped) -> '" << profile_path.data() << "'" << ((result == 0) ? "" : " (failed)") << "\n";
+    };
+
+    // 15. Expose the top CPU time consumers among the executor callbacks (if accounted, see above),
+    //     as [fd, calls, wall_us, cpu_us, max_wall_us] per callback (fd is -1 for non-awaitable ones).
+    //     See `PrintTopCallbacksTo` for their origins.
+    //
+    const auto callbacks_register = application.registry().route("sys.info.callbacks", [&] {
+        //
+        TopCallbacks      top{};
+        const std::size_t count = executor.getTopCallbacks(top);
+
+        Application::Regs::Value value{{&general_mr}};
+        auto&                    int64s = value.set_integer64();
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            const auto& stats = top[i];  // NOLINT(*-constant-array-index)
+            int64s.value.push_back(stats.fd);
+            int64s.value.push_back(static_cast<std::int64_t>(stats.calls));
+            int64s.value.push_back(static_cast<std::int64_t>(stats.wall_ns / 1000U));
+            int64s.value.push_back(static_cast<std::int64_t>(stats.cpu_ns / 1000U));
+            int64s.value.push_back(static_cast<std::int64_t>(stats.max_wall_ns / 1000U));
+        }
+        return value;
+    });
+
+    // 16. Optionally capture all received frames and datagrams (see `demo.capture.file` register),
+    //     so that the traffic could be replayed later into another node (see `capture_replay` tool).
+    //
+    const auto& capture_file = application.getCaptureParams().file.value();
+    if (!capture_file.empty())
+    {
+        const int capture_err = ::captureStart(capture_file.c_str());
+        std::cout << "Capture   : '" << capture_file.c_str() << "'" << ((capture_err != 0) ? " (failed)" : "") << "\n";
+    }
 
     // Main loop.
     //
-    libcyphal::Duration worst_lateness{0};
+    constexpr std::size_t LogDrainBatch    = 32;
+    constexpr auto        LogDrainMinSlack = 2ms;
+    std::uint64_t         iterations{0};
+    libcyphal::Duration   worst_lateness{0};
     std::cout << "-----------\nRunning..." << std::endl;  // NOLINT
     //
-    while (!exec_cmd_provider.should_break())
+    while (!exec_cmd_provider.should_break() && !is_startup_budget_exceeded)
     {
         const auto spin_result = executor.spinOnce();
         worst_lateness         = std::max(worst_lateness, spin_result.worst_lateness);
+        health_evaluator.observeLateness(spin_result.worst_lateness);
+
+        ++iterations;
+        const auto lateness_us = std::chrono::duration_cast<std::chrono::microseconds>(spin_result.worst_lateness);
+        flight_recorder.record(platform::FlightRecorder::EventType::LoopWakeup,
+                               -1,
+                               static_cast<std::uint32_t>(iterations),
+                               static_cast<std::uint32_t>(lateness_us.count()));
+
+        // Both flags have to be taken (cleared), hence no short-circuit evaluation here.
+        const bool cmd_dump_request = exec_cmd_provider.takeFlightRecorderDumpRequest();
+        if (platform::FlightRecorder::takeDumpRequest() || cmd_dump_request)
+        {
+            const char* const dump_path = platform::FlightRecorder::dumpInstalled();
+            std::cout << "📼 Flight recorder dump: '" << ((dump_path != nullptr) ? dump_path : "(failed)") << "'\n";
+        }
+        if (platform::SamplingProfiler::takeToggleRequest())
+        {
+            toggle_profiler(!profiler.isRunning());
+        }
+        if (const auto profiler_request = exec_cmd_provider.takeProfilerRequest())
+        {
+            toggle_profiler(profiler_request.value());
+        }
+        if (run_stats.isEnabled())
+        {
+            run_stats.publish({iterations,
+                               spin_result.worst_lateness,
+                               worst_lateness,
+                               general_mr.queryDiagnostics(),
+                               media_block_mr.queryDiagnostics()});
+        }
 
         libcyphal::Duration timeout{1s};  // awake at least once per second
         if (spin_result.next_exec_time.has_value())
         {
             timeout = std::min(timeout, spin_result.next_exec_time.value() - executor.now());
         }
+
+        // We are about to become idle, so it's the time to flush the (hot path) log records accumulated so far.
+        // The output may block on a slow terminal or pipe, so only a bounded batch is written, and only if there is
+        // enough slack before the next deadline; the rest waits for the next idle iteration.
+        if (timeout >= LogDrainMinSlack)
+        {
+            (void) log.drain(LogDrainBatch);
+        }
+
         (void) executor.pollAwaitableResourcesFor(cetl::make_optional(timeout));
     }
+    (void) log.drain();
+    toggle_profiler(false);
+    if (::captureIsActive())
+    {
+        ::captureStop();
+        std::cout << "Captured  : " << ::captureGetRecordCount() << " records\n";
+    }
     //
+#if PLATFORM_TRACING
+    std::array<char, 256> trace_path{};
+    (void) std::snprintf(trace_path.data(), trace_path.size(), "%s/trace.json", root_path);
+    const int trace_err = platform::Tracer::exportChromeJson(trace_path.data());
+    std::cout << "Trace: '" << trace_path.data() << "'" << ((trace_err != 0) ? " (failed)" : "") << "\n";
+#endif
     std::cout << "🏁 Done.\n-----------\nRun Stats:\n";
     std::cout << "  worst_callback_lateness=" << worst_lateness.count() << "us\n";
+    std::cout << "  log_dropped=" << log.getDropped() << "\n";
+    if (time_sync_slave)
+    {
+        const auto metrics = time_sync_slave->getMetrics();
+        std::cout << "  time_sync.samples=" << metrics.samples << "\n";
+        std::cout << "  time_sync.offset=" << metrics.offset_us << "us\n";
+        std::cout << "  time_sync.drift=" << metrics.drift_ppb << "ppb\n";
+        std::cout << "  time_sync.max_abs_error=" << metrics.max_abs_error_us << "us\n";
+        std::cout << "  time_sync.convergence_time=" << metrics.convergence_time_us << "us\n";
+    }
+    PrintTopCallbacksTo(executor, std::cout);
+    if (platform::Linux::PerfCounters::isOpen())
+    {
+        platform::Linux::PerfCounters::printTo(std::cout);
+        platform::Linux::PerfCounters::close();
+    }
+    for (std::size_t i = 0; i < transport_bag_can.mediaCount(); ++i)
+    {
+        std::cout << "  can[" << i << "].tx_queue_hwm=" << transport_bag_can.queryTxQueueDiagnostics(i).peak_allocated
+                  << "\n";
+    }
+    for (std::size_t i = 0; i < transport_bag_udp.mediaCount(); ++i)
+    {
+        std::cout << "  udp[" << i << "].tx_queue_hwm=" << transport_bag_udp.queryTxQueueDiagnostics(i).peak_allocated
+                  << "\n";
+    }
 
+    if (is_startup_budget_exceeded)
+    {
+        return ExitCode::StartupBudgetExceeded;
+    }
     return !exec_cmd_provider.should_power_off();
 }
 
@@ -247,13 +947,16 @@ libcyphal::Expected<bool, ExitCode> run_application(const char* const root_path)
 
 int main(const int argc, char* const argv[])
 {
+    // Startup phases are profiled since this very moment (see `sys.info.startup` register).
+    StartupProfiler startup_profiler;
+
     const char* root_path = "/tmp/" NODE_NAME;  // NOLINT
     if (argc > 1)
     {
         root_path = argv[1];  // NOLINT
     }
 
-    const auto result = run_application(root_path);
+    const auto result = run_application(root_path, startup_profiler);
     if (const auto* const err = cetl::get_if<ExitCode>(&result))
     {
         return static_cast<int>(*err);
@@ -0,0 +1,103 @@
+// This software is distributed under the terms of the MIT License.
+// Copyright (C) OpenCyphal Development Team  <opencyphal.org>
+// Copyright Amazon.com Inc. or its affiliates.
+// SPDX-License-Identifier: MIT
+
+#ifndef PLATFORM_BINLOG_HPP_INCLUDED
+#define PLATFORM_BINLOG_HPP_INCLUDED
+
+#include "binlog.h"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <type_traits>
+
+namespace platform
+{
+
+/// Wraps the shared asynchronous binary log (see `shared/binlog/binlog.h`) for C++ call sites.
+///
+/// Logging only captures the format string pointer and raw argument values into a lock-free ring;
+/// formatting and output are deferred until `drain`, which the application calls when idle.
+/// Hence the format string and string arguments must be string literals (or otherwise have static storage).
+///
+class BinLog final
+{
+public:
+    template <std::size_t Capacity>
+    BinLog(std::array<BinlogRecord, Capacity>& storage, std::FILE* const sink)
+    {
+        static_assert((Capacity >= 2) && ((Capacity & (Capacity - 1)) == 0), "Capacity must be a power of two.");
+        (void) ::binlogInit(&log_, storage.data(), Capacity, sink);
+    }
+
+    ~BinLog() = default;
+
+    BinLog(const BinLog&)                = delete;
+    BinLog(BinLog&&) noexcept            = delete;
+    BinLog& operator=(const BinLog&)     = delete;
+    BinLog& operator=(BinLog&&) noexcept = delete;
+
+    /// Appends a record to the log. Never blocks; returns `false` if the record has been dropped.
+    ///
+    template <typename... Args>
+    bool operator()(const char* const format, const Args... args) noexcept
+    {
+        static_assert(sizeof...(Args) <= BINLOG_MAX_ARGS, "Too many arguments.");
+
+        const std::array<BinlogArg, sizeof...(Args)> captured{{makeArg(args)...}};
+        return ::binlogPush(&log_, format, captured.size(), captured.data());
+    }
+
+    /// Formats and writes up to `max_records` pending records to the sink. Called when the application is idle;
+    /// the main loop limits the batch, b/c the sink may block.
+    ///
+    std::size_t drain(const std::size_t max_records = SIZE_MAX) noexcept
+    {
+        return ::binlogDrain(&log_, max_records);
+    }
+
+    std::uint64_t getDropped() const noexcept
+    {
+        return ::binlogGetDropped(&log_);
+    }
+
+private:
+    template <typename T, std::enable_if_t<std::is_integral<T>::value && std::is_signed<T>::value, bool> = true>
+    static BinlogArg makeArg(const T value) noexcept
+    {
+        return ::binlogArgI(value);
+    }
+
+    template <typename T, std::enable_if_t<std::is_integral<T>::value && !std::is_signed<T>::value, bool> = true>
+    static BinlogArg makeArg(const T value) noexcept
+    {
+        return ::binlogArgU(value);
+    }
+
+    template <typename T, std::enable_if_t<std::is_enum<T>::value, bool> = true>
+    static BinlogArg makeArg(const T value) noexcept
+    {
+        return makeArg(static_cast<std::underlying_type_t<T>>(value));
+    }
+
+    template <typename T, std::enable_if_t<std::is_floating_point<T>::value, bool> = true>
+    static BinlogArg makeArg(const T value) noexcept
+    {
+        return ::binlogArgF(static_cast<double>(value));
+    }
+
+    static BinlogArg makeArg(const void* const value) noexcept
+    {
+        return ::binlogArgP(value);
+    }
+
+    ::Binlog log_{};
+
+};  // BinLog
+
+}  // namespace platform
+
+#endif  // PLATFORM_BINLOG_HPP_INCLUDED
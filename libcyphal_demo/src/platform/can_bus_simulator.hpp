@@ -0,0 +1,597 @@
+// This software is distributed under the terms of the MIT License.
+// Copyright (C) OpenCyphal Development Team  <opencyphal.org>
+// Copyright Amazon.com Inc. or its affiliates.
+// SPDX-License-Identifier: MIT
+
+#ifndef PLATFORM_CAN_BUS_SIMULATOR_HPP_INCLUDED
+#define PLATFORM_CAN_BUS_SIMULATOR_HPP_INCLUDED
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+namespace platform
+{
+
+/// Implements a discrete-event model of a CAN (2.0B or FD) bus with extended (29-bit) identifiers.
+///
+/// Unlike `vcan` (which forwards frames instantly), the simulator accounts for the physical layer:
+/// - arbitration - when the bus becomes idle, the lowest CAN ID among the frames pending at all nodes wins;
+/// - frame length - all fields of the frame format, with the exact number of dynamic stuff bits for the actual
+///   identifier and data (including CRC-15 of classic frames), the fixed stuff bits of FD frames and interframe space;
+/// - bit rates - the nominal one, and the FD data phase one (bit rate switch) if configured.
+///
+/// Time is just a number of nanoseconds, so the model could be driven either by a real clock
+/// (see `SimulatedCanMedia`), or by a virtual one (f.e. to evaluate a traffic scenario faster than real time).
+/// Every controller is ideal: it offers its lowest CAN ID pending frame to arbitration (FIFO among equal IDs),
+/// receives all frames of the other nodes (acceptance filtering is up to the user), and there are no errors.
+///
+/// Statistics include latency (from `push` to the end of the frame on the bus) distribution per Cyphal priority
+/// (three most significant bits of the CAN ID), and the bus load.
+///
+/// Not thread-safe, and doesn't allocate (hence rather large - better to have it static).
+///
+class CanBusSimulator final
+{
+public:
+    static constexpr std::size_t   MaxNodes        = 16;
+    static constexpr std::size_t   TxQueueCapacity = 32;
+    static constexpr std::size_t   RxQueueCapacity = 128;
+    static constexpr std::size_t   MaxFrameSize    = 64;
+    static constexpr std::size_t   Priorities      = 8;
+    static constexpr std::uint64_t Never           = ~0ULL;
+
+    struct Config final
+    {
+        std::uint32_t nominal_bitrate;  ///< Bit rate of the arbitration phase (and the whole classic frame), bit/s.
+        std::uint32_t data_bitrate;     ///< Bit rate of the FD data phase; zero means no bit rate switching.
+    };
+
+    struct Frame final
+    {
+        std::uint32_t                          can_id;
+        bool                                   is_fd;
+        std::uint8_t                           size;
+        std::array<std::uint8_t, MaxFrameSize> data;
+    };
+
+    /// Length of a frame on the bus, including stuff bits and the interframe space.
+    ///
+    struct FrameBits final
+    {
+        std::uint32_t nominal;  ///< Bits at the nominal bit rate.
+        std::uint32_t data;     ///< Bits at the data bit rate (FD frames with bit rate switching only).
+        std::uint32_t stuff;    ///< Stuff bits (both dynamic and fixed) among all of the above.
+    };
+
+    /// Log-linear histogram (16 sub-buckets per power of two, so within ~6% precision) of nanosecond values.
+    ///
+    class Histogram final
+    {
+    public:
+        void add(const std::uint64_t value) noexcept
+        {
+            ++buckets_[indexOf(value)];  // NOLINT(*-constant-array-index)
+            ++count_;
+            sum_ += value;
+            max_ = (value > max_) ? value : max_;
+        }
+
+        std::uint64_t count() const noexcept
+        {
+            return count_;
+        }
+
+        std::uint64_t max() const noexcept
+        {
+            return max_;
+        }
+
+        std::uint64_t mean() const noexcept
+        {
+            return (count_ > 0) ? (sum_ / count_) : 0;
+        }
+
+        /// Gets the upper bound of the bucket where the given quantile (0..1) falls.
+        ///
+        std::uint64_t quantile(const double q) const noexcept
+        {
+            const auto    target = static_cast<std::uint64_t>(q * static_cast<double>(count_));
+            std::uint64_t seen   = 0;
+            for (std::size_t index = 0; index < Buckets; ++index)
+            {
+                seen += buckets_[index];  // NOLINT(*-constant-array-index)
+                if ((seen > target) || (seen == count_))
+                {
+                    const std::uint64_t bound = upperBoundOf(index);
+                    return (bound < max_) ? bound : max_;
+                }
+            }
+            return max_;
+        }
+
+    private:
+        static constexpr unsigned    SubBits = 4;
+        static constexpr std::size_t Subs    = 1U << SubBits;
+        static constexpr std::size_t Buckets = ((64 - SubBits) * Subs) + Subs;
+
+        static std::size_t indexOf(const std::uint64_t value) noexcept
+        {
+            if (value < Subs)
+            {
+                return static_cast<std::size_t>(value);
+            }
+            const auto exponent = static_cast<unsigned>(63 - __builtin_clzll(value));
+            const auto sub      = static_cast<std::size_t>((value >> (exponent - SubBits)) & (Subs - 1));
+            return ((exponent - SubBits + 1) * Subs) + sub;
+        }
+
+        static std::uint64_t upperBoundOf(const std::size_t index) noexcept
+        {
+            if (index < Subs)
+            {
+                return index;
+            }
+            const unsigned      shift = static_cast<unsigned>(index / Subs) - 1U;
+            const std::uint64_t lower = static_cast<std::uint64_t>(Subs + (index % Subs)) << shift;
+            return lower + ((1ULL << shift) - 1U);
+        }
+
+        std::array<std::uint32_t, Buckets> buckets_{};
+        std::uint64_t                      count_{0};
+        std::uint64_t                      sum_{0};
+        std::uint64_t                      max_{0};
+
+    };  // Histogram
+
+    struct Stats final
+    {
+        std::array<Histogram, Priorities> latency_ns;  ///< From `push` to the end of the frame, per priority.
+        std::uint64_t                     frames;
+        std::uint64_t                     bits;
+        std::uint64_t                     stuff_bits;
+        std::uint64_t                     busy_ns;      ///< Total duration of the transmitted frames.
+        std::uint64_t                     since_ns;     ///< Start of the statistics period (see `resetStats`).
+        std::uint64_t                     rx_overruns;  ///< Frames lost because of full receiver queues.
+    };
+
+    explicit CanBusSimulator(const Config& config) noexcept
+        : config_{config}
+    {
+    }
+
+    CanBusSimulator(const CanBusSimulator&)                = delete;
+    CanBusSimulator(CanBusSimulator&&) noexcept            = delete;
+    CanBusSimulator& operator=(const CanBusSimulator&)     = delete;
+    CanBusSimulator& operator=(CanBusSimulator&&) noexcept = delete;
+
+    ~CanBusSimulator() = default;
+
+    /// Attaches a new node to the bus.
+    ///
+    /// @return Index of the node, or -1 if there are already `MaxNodes` nodes.
+    ///
+    int attach() noexcept
+    {
+        if (nodes_count_ >= MaxNodes)
+        {
+            return -1;
+        }
+        return static_cast<int>(nodes_count_++);
+    }
+
+    /// Queues a frame for transmission by the given node at the given time (not before the last `advance`).
+    ///
+    /// An FD frame is padded with zeros up to the nearest valid data length; a classic one is truncated to 8 bytes.
+    ///
+    /// @return `false` if the node TX queue is full.
+    ///
+    bool push(const std::size_t node, const std::uint64_t now_ns, const Frame& frame) noexcept
+    {
+        if (node >= nodes_count_)
+        {
+            return false;
+        }
+        Node& tx_node = nodes_[node];  // NOLINT(*-constant-array-index)
+        if (tx_node.tx_count >= TxQueueCapacity)
+        {
+            return false;
+        }
+        TxEntry& entry    = tx_node.tx_queue[tx_node.tx_count++];  // NOLINT(*-constant-array-index)
+        entry.frame       = frame;
+        entry.frame.size  = frame.is_fd ? paddedFdSize(frame.size) : ((frame.size > 8U) ? std::uint8_t{8} : frame.size);
+        const auto offset = static_cast<std::size_t>(frame.size);
+        if (offset < entry.frame.size)
+        {
+            (void) std::memset(&entry.frame.data[offset], 0, entry.frame.size - offset);
+        }
+        entry.bits        = frameBits(entry.frame, config_.data_bitrate > 0);
+        entry.enqueued_ns = now_ns;
+        return true;
+    }
+
+    std::size_t txFree(const std::size_t node) const noexcept
+    {
+        return TxQueueCapacity - nodes_[node].tx_count;  // NOLINT(*-constant-array-index)
+    }
+
+    /// Takes the next frame received by the given node (in the bus order).
+    ///
+    /// @param timestamp_ns The end of the frame on the bus.
+    /// @return `false` if there are no received frames.
+    ///
+    bool pop(const std::size_t node, Frame& frame, std::uint64_t& timestamp_ns) noexcept
+    {
+        Node& rx_node = nodes_[node];  // NOLINT(*-constant-array-index)
+        if (rx_node.rx_count == 0)
+        {
+            return false;
+        }
+        const RxEntry& entry = rx_node.rx_queue[rx_node.rx_head];  // NOLINT(*-constant-array-index)
+        frame                = entry.frame;
+        timestamp_ns         = entry.timestamp_ns;
+        rx_node.rx_head      = (rx_node.rx_head + 1) % RxQueueCapacity;
+        --rx_node.rx_count;
+        return true;
+    }
+
+    std::size_t rxPending(const std::size_t node) const noexcept
+    {
+        return nodes_[node].rx_count;  // NOLINT(*-constant-array-index)
+    }
+
+    /// Runs the bus up to the given time: completes the frames which end by then (delivering them to the receivers),
+    /// and arbitrates the next ones.
+    ///
+    void advance(const std::uint64_t now_ns) noexcept
+    {
+        while (true)
+        {
+            if (in_flight_.is_active)
+            {
+                if (in_flight_.end_ns > now_ns)
+                {
+                    return;
+                }
+                complete();
+            }
+            const std::uint64_t start_ns = nextStartNs();
+            if ((start_ns == Never) || (start_ns > now_ns))
+            {
+                return;
+            }
+            begin(start_ns);
+        }
+    }
+
+    /// Gets time of the next bus event (end of the current frame, or start of the next one), or `Never` if idle.
+    ///
+    std::uint64_t nextEventNs() const noexcept
+    {
+        return in_flight_.is_active ? in_flight_.end_ns : nextStartNs();
+    }
+
+    const Stats& stats() const noexcept
+    {
+        return stats_;
+    }
+
+    void resetStats(const std::uint64_t now_ns) noexcept
+    {
+        stats_          = Stats{};
+        stats_.since_ns = now_ns;
+    }
+
+    /// Gets the bus load (0..1) since the last `resetStats`.
+    ///
+    double busLoad(const std::uint64_t now_ns) const noexcept
+    {
+        return (now_ns > stats_.since_ns)
+                   ? (static_cast<double>(stats_.busy_ns) / static_cast<double>(now_ns - stats_.since_ns))
+                   : 0.0;
+    }
+
+    std::uint64_t frameDurationNs(const FrameBits& bits) const noexcept
+    {
+        return bitsToNs(bits.nominal, config_.nominal_bitrate) + bitsToNs(bits.data, config_.data_bitrate);
+    }
+
+    /// Computes length of the given frame (of its exact data length, so an FD one should be already padded).
+    ///
+    static FrameBits frameBits(const Frame& frame, const bool bit_rate_switch) noexcept
+    {
+        // Fields after CRC: CRC delimiter, ACK slot, ACK delimiter, end of frame, and intermission.
+        constexpr std::uint32_t TrailerBits = 1U + 1U + 1U + 7U + 3U;
+
+        BitStream stream;
+        stream.put(0U, 1U);                          // SOF
+        stream.put(frame.can_id >> 18U, 11U);        // Base ID
+        stream.put(3U, 2U);                          // SRR, IDE
+        stream.put(frame.can_id & 0x3FFFFU, 18U);    // Extended ID
+        stream.put(frame.is_fd ? 2U : 0U, 3U);       // RTR, r1, r0 -or- RRS, FDF, res
+        if (frame.is_fd)
+        {
+            stream.put(bit_rate_switch ? 1U : 0U, 1U);  // BRS
+        }
+        const std::uint32_t switch_at = stream.bits();  // The data phase starts after the BRS bit.
+        if (frame.is_fd)
+        {
+            stream.put(0U, 1U);  // ESI
+        }
+        stream.put(dlcOf(frame.size), 4U);
+        for (std::size_t index = 0; index < frame.size; ++index)
+        {
+            stream.put(frame.data[index], 8U);  // NOLINT(*-constant-array-index)
+        }
+
+        FrameBits result{};
+        if (frame.is_fd)
+        {
+            // Stuff count (3 bits of Gray code + parity) and CRC-17/21, with a fixed stuff bit before the count,
+            // and after every 4 bits of these.
+            const std::uint32_t crc_bits   = (frame.size > 16U) ? 21U : 17U;
+            const std::uint32_t fixed_bits = 1U + ((4U + crc_bits) / 4U);
+            const std::uint32_t tail_bits  = 4U + crc_bits + fixed_bits;
+            result.stuff                   = stream.stuffBits() + fixed_bits;
+            if (bit_rate_switch)
+            {
+                result.nominal = switch_at + TrailerBits;
+                result.data    = stream.bits() - switch_at + tail_bits;
+            }
+            else
+            {
+                result.nominal = stream.bits() + tail_bits + TrailerBits;
+            }
+        }
+        else
+        {
+            stream.put(stream.crc15(), 15U);
+            result.stuff   = stream.stuffBits();
+            result.nominal = stream.bits() + TrailerBits;
+        }
+        return result;
+    }
+
+private:
+    /// Accumulates the frame bits up to (including) CRC, with dynamic bit stuffing and CRC-15 (of the raw bits).
+    ///
+    class BitStream final
+    {
+    public:
+        void put(const std::uint32_t value, const unsigned width) noexcept
+        {
+            for (unsigned index = width; index > 0; --index)
+            {
+                putBit(((value >> (index - 1U)) & 1U) != 0);
+            }
+        }
+
+        std::uint32_t bits() const noexcept
+        {
+            return bits_;
+        }
+
+        std::uint32_t stuffBits() const noexcept
+        {
+            return stuff_bits_;
+        }
+
+        std::uint32_t crc15() const noexcept
+        {
+            return crc15_;
+        }
+
+    private:
+        static constexpr unsigned      StuffRun = 5;
+        static constexpr std::uint32_t Crc15    = 0x4599U;
+
+        void putBit(const bool bit) noexcept
+        {
+            const bool crc_msb = ((crc15_ >> 14U) & 1U) != 0;
+            crc15_             = ((crc15_ << 1U) ^ ((bit != crc_msb) ? Crc15 : 0U)) & 0x7FFFU;
+
+            ++bits_;
+            run_      = ((run_ > 0) && (bit == last_bit_)) ? (run_ + 1U) : 1U;
+            last_bit_ = bit;
+            if (run_ == StuffRun)
+            {
+                // The complement bit is inserted, and starts the next run.
+                ++bits_;
+                ++stuff_bits_;
+                last_bit_ = !bit;
+                run_      = 1;
+            }
+        }
+
+        std::uint32_t bits_{0};
+        std::uint32_t stuff_bits_{0};
+        std::uint32_t crc15_{0};
+        unsigned      run_{0};
+        bool          last_bit_{false};
+
+    };  // BitStream
+
+    struct TxEntry final
+    {
+        Frame         frame;
+        FrameBits     bits;
+        std::uint64_t enqueued_ns;
+    };
+
+    struct RxEntry final
+    {
+        Frame         frame;
+        std::uint64_t timestamp_ns;
+    };
+
+    struct Node final
+    {
+        std::array<TxEntry, TxQueueCapacity> tx_queue;
+        std::size_t                          tx_count;
+        std::array<RxEntry, RxQueueCapacity> rx_queue;
+        std::size_t                          rx_head;
+        std::size_t                          rx_count;
+    };
+
+    struct InFlight final
+    {
+        bool          is_active;
+        std::size_t   sender;
+        TxEntry       entry;
+        std::uint64_t start_ns;
+        std::uint64_t end_ns;
+    };
+
+    static std::uint8_t paddedFdSize(const std::uint8_t size) noexcept
+    {
+        constexpr std::array<std::uint8_t, 7> Sizes{{12, 16, 20, 24, 32, 48, 64}};
+        if (size <= 8U)
+        {
+            return size;
+        }
+        for (const auto padded : Sizes)
+        {
+            if (size <= padded)
+            {
+                return padded;
+            }
+        }
+        return static_cast<std::uint8_t>(MaxFrameSize);
+    }
+
+    static std::uint32_t dlcOf(const std::uint8_t size) noexcept
+    {
+        constexpr std::array<std::uint8_t, 7> Sizes{{12, 16, 20, 24, 32, 48, 64}};
+        if (size <= 8U)
+        {
+            return size;
+        }
+        std::uint32_t dlc = 9;
+        for (const auto padded : Sizes)
+        {
+            if (size <= padded)
+            {
+                break;
+            }
+            ++dlc;
+        }
+        return dlc;
+    }
+
+    static std::uint64_t bitsToNs(const std::uint32_t bits, const std::uint32_t bitrate) noexcept
+    {
+        constexpr std::uint64_t NsPerSecond = 1000000000ULL;
+        return (bitrate > 0) ? (((bits * NsPerSecond) + (bitrate / 2U)) / bitrate) : 0;
+    }
+
+    /// The bus starts a frame when it's idle, and there is at least one pending frame.
+    ///
+    std::uint64_t nextStartNs() const noexcept
+    {
+        std::uint64_t earliest_ns = Never;
+        for (std::size_t node = 0; node < nodes_count_; ++node)
+        {
+            const Node& tx_node = nodes_[node];  // NOLINT(*-constant-array-index)
+            for (std::size_t index = 0; index < tx_node.tx_count; ++index)
+            {
+                const std::uint64_t enqueued_ns = tx_node.tx_queue[index].enqueued_ns;  // NOLINT
+                earliest_ns                     = (enqueued_ns < earliest_ns) ? enqueued_ns : earliest_ns;
+            }
+        }
+        if (earliest_ns == Never)
+        {
+            return Never;
+        }
+        return (earliest_ns > bus_free_ns_) ? earliest_ns : bus_free_ns_;
+    }
+
+    /// Arbitrates among the frames pending by the given start time, and starts transmission of the winner.
+    ///
+    void begin(const std::uint64_t start_ns) noexcept
+    {
+        std::size_t   winner_node  = MaxNodes;
+        std::size_t   winner_index = 0;
+        std::uint32_t winner_id    = ~0U;
+        for (std::size_t node = 0; node < nodes_count_; ++node)
+        {
+            const Node& tx_node = nodes_[node];  // NOLINT(*-constant-array-index)
+            for (std::size_t index = 0; index < tx_node.tx_count; ++index)
+            {
+                const TxEntry& entry = tx_node.tx_queue[index];  // NOLINT(*-constant-array-index)
+                if ((entry.enqueued_ns <= start_ns) && (entry.frame.can_id < winner_id))
+                {
+                    winner_node  = node;
+                    winner_index = index;
+                    winner_id    = entry.frame.can_id;
+                }
+            }
+        }
+        if (winner_node == MaxNodes)
+        {
+            return;
+        }
+
+        Node& tx_node        = nodes_[winner_node];
+        in_flight_.entry     = tx_node.tx_queue[winner_index];  // NOLINT(*-constant-array-index)
+        in_flight_.sender    = winner_node;
+        in_flight_.start_ns  = start_ns;
+        in_flight_.end_ns    = start_ns + frameDurationNs(in_flight_.entry.bits);
+        in_flight_.is_active = true;
+
+        // Keep the FIFO order (frames of a multi-frame transfer share the same CAN ID).
+        --tx_node.tx_count;
+        for (std::size_t index = winner_index; index < tx_node.tx_count; ++index)
+        {
+            tx_node.tx_queue[index] = tx_node.tx_queue[index + 1];  // NOLINT(*-constant-array-index)
+        }
+    }
+
+    void complete() noexcept
+    {
+        constexpr unsigned PriorityShift = 26;
+
+        for (std::size_t node = 0; node < nodes_count_; ++node)
+        {
+            if (node == in_flight_.sender)
+            {
+                continue;
+            }
+            Node& rx_node = nodes_[node];  // NOLINT(*-constant-array-index)
+            if (rx_node.rx_count >= RxQueueCapacity)
+            {
+                ++stats_.rx_overruns;
+                continue;
+            }
+            RxEntry& rx_entry     = rx_node.rx_queue[(rx_node.rx_head + rx_node.rx_count) % RxQueueCapacity];  // NOLINT
+            rx_entry.frame        = in_flight_.entry.frame;
+            rx_entry.timestamp_ns = in_flight_.end_ns;
+            ++rx_node.rx_count;
+        }
+
+        const FrameBits&  bits     = in_flight_.entry.bits;
+        const std::size_t priority = (in_flight_.entry.frame.can_id >> PriorityShift) & (Priorities - 1U);
+        stats_.latency_ns[priority].add(in_flight_.end_ns - in_flight_.entry.enqueued_ns);  // NOLINT
+        ++stats_.frames;
+        stats_.bits += bits.nominal + bits.data;
+        stats_.stuff_bits += bits.stuff;
+        stats_.busy_ns += in_flight_.end_ns - in_flight_.start_ns;
+
+        bus_free_ns_         = in_flight_.end_ns;
+        in_flight_.is_active = false;
+    }
+
+    // MARK: Data members:
+
+    Config                     config_;
+    std::array<Node, MaxNodes> nodes_{};
+    std::size_t                nodes_count_{0};
+    InFlight                   in_flight_{};
+    std::uint64_t              bus_free_ns_{0};
+    Stats                      stats_{};
+
+};  // CanBusSimulator
+
+}  // namespace platform
+
+#endif  // PLATFORM_CAN_BUS_SIMULATOR_HPP_INCLUDED
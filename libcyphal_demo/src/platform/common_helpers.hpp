@@ -7,6 +7,8 @@
 #ifndef PLATFORM_COMMON_HELPERS_HPP_INCLUDED
 #define PLATFORM_COMMON_HELPERS_HPP_INCLUDED
 
+#include "binlog.hpp"
+
 #include <cetl/pf17/cetlpf.hpp>
 #include <cetl/visit_helpers.hpp>
 #include <libcyphal/errors.hpp>
@@ -14,6 +16,9 @@
 #include <libcyphal/transport/errors.hpp>
 #include <libcyphal/transport/udp/udp_transport.hpp>
 
+#include <array>
+#include <cstddef>
+#include <cstdint>
 #include <iostream>
 
 namespace platform
@@ -21,34 +26,125 @@ namespace platform
 
 struct CommonHelpers
 {
+    /// Counts transient errors reported by a transport, grouped by their effect, and by their kind and media.
+    ///
+    /// The per kind counters are used to aggregate error storms (f.e. when an interface flaps, there could be
+    /// a failure per each frame): only the first occurrence of a kind (per media) is reported in detail,
+    /// and the rest are only counted, and later summarized periodically by `summarize`.
+    /// Counting is O(1) per error, and doesn't allocate.
+    ///
+    struct TransientErrorCounters
+    {
+        /// Kinds are transport specific - see `Can::ErrorKind` and `Udp::ErrorKind`.
+        static constexpr std::size_t MaxKinds = 9;
+        static constexpr std::size_t MaxMedia = 3;
+
+        /// For the reports which don't carry a media index (f.e. filters configuration, which is common for all
+        /// media), and for the out of range indices. Counted in the extra (last) media column.
+        static constexpr std::size_t UnknownMedia = MaxMedia;
+        static constexpr std::size_t MediaColumns = MaxMedia + 1;
+
+        using KindDescriber = const char* (*)(std::size_t kind);
+        using PerKindMedia  = std::array<std::array<std::uint64_t, MediaColumns>, MaxKinds>;
+
+        /// Failures of media (sockets) operations.
+        std::uint64_t media_errors{0};
+        /// Frames which couldn't be queued for transmission (f.e. due to full TX queue or out of memory).
+        std::uint64_t tx_overflows{0};
+        /// Received frames which were dropped by the protocol layer (f.e. due to out of memory).
+        std::uint64_t rx_drops{0};
+        /// Total number of errors per kind and media index (see also `UnknownMedia`).
+        PerKindMedia per_kind_totals{};
+        /// Number of errors per kind and media index since the last summary.
+        PerKindMedia per_kind_pending{};
+
+        /// Counts the error, and returns `true` if it's the first one of its kind (for the media)
+        /// since the last summary, so it should be reported in detail.
+        ///
+        bool countKind(const std::size_t kind, const std::size_t media_index) noexcept
+        {
+            CETL_DEBUG_ASSERT(kind < MaxKinds, "");
+            const std::size_t media = (media_index < MaxMedia) ? media_index : UnknownMedia;
+
+            ++per_kind_totals[kind][media];               // NOLINT(*-constant-array-index)
+            return per_kind_pending[kind][media]++ == 0;  // NOLINT(*-constant-array-index)
+        }
+
+        /// Logs number of suppressed (not reported in detail) errors since the last summary, and restarts counting.
+        ///
+        void summarize(BinLog& log, const KindDescriber describe_kind) noexcept
+        {
+            for (std::size_t kind = 0; kind < MaxKinds; ++kind)
+            {
+                for (std::size_t media = 0; media < MediaColumns; ++media)
+                {
+                    auto& pending = per_kind_pending[kind][media];  // NOLINT(*-constant-array-index)
+                    if ((pending > 1) && (media == UnknownMedia))
+                    {
+                        log("⚠️ %s: %llu more error(s) suppressed.\n", describe_kind(kind), pending - 1);
+                    }
+                    else if (pending > 1)
+                    {
+                        log("⚠️ %s (mediaIdx=%zu): %llu more error(s) suppressed.\n",
+                            describe_kind(kind),
+                            media,
+                            pending - 1);
+                    }
+                    pending = 0;
+                }
+            }
+        }
+
+    };  // TransientErrorCounters
+
+    /// Defines limits of the TX queue capacity (per media) configurable via `demo.tx.queue.capacity` register.
+    ///
+    static constexpr std::size_t DefaultTxQueueCapacity = 16;
+    static constexpr std::size_t MaxTxQueueCapacity     = 1024;
+
+    /// Validates the requested TX queue capacity, and falls back to the default one if it's out of range.
+    ///
+    static std::size_t validateTxQueueCapacity(const std::size_t requested)
+    {
+        if ((requested == 0) || (requested > MaxTxQueueCapacity))
+        {
+            std::cerr << "⚠️ Invalid TX queue capacity " << requested << " (expected 1.." << MaxTxQueueCapacity
+                      << "), using " << DefaultTxQueueCapacity << ".\n";
+            return DefaultTxQueueCapacity;
+        }
+        return requested;
+    }
+
+    /// The descriptions are string literals, so they can be passed to the (deferred formatting) `BinLog` as is.
+    ///
     struct Printers
     {
-        static cetl::string_view describeError(const libcyphal::ArgumentError&)
+        static const char* describeError(const libcyphal::ArgumentError&)
         {
             return "ArgumentError";
         }
-        static cetl::string_view describeError(const libcyphal::MemoryError&)
+        static const char* describeError(const libcyphal::MemoryError&)
         {
             return "MemoryError";
         }
-        static cetl::string_view describeError(const libcyphal::transport::AnonymousError&)
+        static const char* describeError(const libcyphal::transport::AnonymousError&)
         {
             return "AnonymousError";
         }
-        static cetl::string_view describeError(const libcyphal::transport::CapacityError&)
+        static const char* describeError(const libcyphal::transport::CapacityError&)
         {
             return "CapacityError";
         }
-        static cetl::string_view describeError(const libcyphal::transport::AlreadyExistsError&)
+        static const char* describeError(const libcyphal::transport::AlreadyExistsError&)
         {
             return "AlreadyExistsError";
         }
-        static cetl::string_view describeError(const libcyphal::transport::PlatformError& error)
+        static const char* describeError(const libcyphal::transport::PlatformError& error)
         {
             return "PlatformError";
         }
 
-        static cetl::string_view describeAnyFailure(const libcyphal::transport::AnyFailure& failure)
+        static const char* describeAnyFailure(const libcyphal::transport::AnyFailure& failure)
         {
             return cetl::visit([](const auto& error) { return describeError(error); }, failure);
         }
@@ -56,41 +152,102 @@ struct CommonHelpers
 
     struct Can
     {
+        /// Kinds of transient errors (the same as the report types) - used to aggregate error storms.
+        ///
+        enum ErrorKind : std::size_t
+        {
+            CanardTxPush,
+            CanardRxAccept,
+            MediaPop,
+            ConfigureMedia,
+            MediaConfig,
+            MediaPush,
+            ErrorKindCount
+        };
+        static_assert(ErrorKindCount <= TransientErrorCounters::MaxKinds, "Increase `MaxKinds`.");
+
+        static const char* describeErrorKind(const std::size_t kind)
+        {
+            switch (kind)
+            {
+            case CanardTxPush:
+                return "CanardTxPush";
+            case CanardRxAccept:
+                return "CanardRxAccept";
+            case MediaPop:
+                return "MediaPop";
+            case ConfigureMedia:
+                return "ConfigureMedia";
+            case MediaConfig:
+                return "MediaConfig";
+            case MediaPush:
+                return "MediaPush";
+            default:
+                return "?";
+            }
+        }
+
         static cetl::optional<libcyphal::transport::AnyFailure> transientErrorReporter(
-            libcyphal::transport::can::ICanTransport::TransientErrorReport::Variant& report_var)
+            libcyphal::transport::can::ICanTransport::TransientErrorReport::Variant& report_var,
+            TransientErrorCounters&                                                  counters,
+            BinLog&                                                                  log)
         {
             using Report = libcyphal::transport::can::ICanTransport::TransientErrorReport;
 
             cetl::visit(  //
                 cetl::make_overloaded(
-                    [](const Report::CanardTxPush& report) {
-                        std::cerr << "Failed to push TX frame to canard "
-                                  << "(mediaIdx=" << static_cast<int>(report.media_index) << ").\n"
-                                  << Printers::describeAnyFailure(report.failure) << "\n";
+                    [&counters, &log](const Report::CanardTxPush& report) {
+                        ++counters.tx_overflows;
+                        if (counters.countKind(ErrorKind::CanardTxPush, report.media_index))
+                        {
+                            log("Failed to push TX frame to canard (mediaIdx=%u): %s\n",
+                                report.media_index,
+                                Printers::describeAnyFailure(report.failure));
+                        }
                     },
-                    [](const Report::CanardRxAccept& report) {
-                        std::cerr << "Failed to accept RX frame at canard "
-                                  << "(mediaIdx=" << static_cast<int>(report.media_index) << ").\n"
-                                  << Printers::describeAnyFailure(report.failure) << "\n";
+                    [&counters, &log](const Report::CanardRxAccept& report) {
+                        ++counters.rx_drops;
+                        if (counters.countKind(ErrorKind::CanardRxAccept, report.media_index))
+                        {
+                            log("Failed to accept RX frame at canard (mediaIdx=%u): %s\n",
+                                report.media_index,
+                                Printers::describeAnyFailure(report.failure));
+                        }
                     },
-                    [](const Report::MediaPop& report) {
-                        std::cerr << "Failed to pop frame from media "
-                                  << "(mediaIdx=" << static_cast<int>(report.media_index) << ").\n"
-                                  << Printers::describeAnyFailure(report.failure) << "\n";
+                    [&counters, &log](const Report::MediaPop& report) {
+                        ++counters.media_errors;
+                        if (counters.countKind(ErrorKind::MediaPop, report.media_index))
+                        {
+                            log("Failed to pop frame from media (mediaIdx=%u): %s\n",
+                                report.media_index,
+                                Printers::describeAnyFailure(report.failure));
+                        }
                     },
-                    [](const Report::ConfigureMedia& report) {
-                        std::cerr << "Failed to configure CAN.\n"
-                                  << Printers::describeAnyFailure(report.failure) << "\n";
+                    [&counters, &log](const Report::ConfigureMedia& report) {
+                        ++counters.media_errors;
+                        // Filters are configured for all media at once, so the report has no media index.
+                        if (counters.countKind(ErrorKind::ConfigureMedia, TransientErrorCounters::UnknownMedia))
+                        {
+                            log("Failed to configure CAN: %s\n", Printers::describeAnyFailure(report.failure));
+                        }
                     },
-                    [](const Report::MediaConfig& report) {
-                        std::cerr << "Failed to configure media "
-                                  << "(mediaIdx=" << static_cast<int>(report.media_index) << ").\n"
-                                  << Printers::describeAnyFailure(report.failure) << "\n";
+                    [&counters, &log](const Report::MediaConfig& report) {
+                        ++counters.media_errors;
+                        if (counters.countKind(ErrorKind::MediaConfig, report.media_index))
+                        {
+                            log("Failed to configure media (mediaIdx=%u): %s\n",
+                                report.media_index,
+                                Printers::describeAnyFailure(report.failure));
+                        }
                     },
-                    [](const Report::MediaPush& report) {
-                        std::cerr << "Failed to push frame to media "
-                                  << "(mediaIdx=" << static_cast<int>(report.media_index) << ").\n"
-                                  << Printers::describeAnyFailure(report.failure) << "\n";
+                    [&counters, &log](const Report::MediaPush& report) {
+                        ++counters.media_errors;
+                        if (counters.countKind(ErrorKind::MediaPush, report.media_index))
+                        {
+                            log("Failed to push frame to media (mediaIdx=%u): %s\n",
+                                report.media_index,
+                                Printers::describeAnyFailure(report.failure));
+                        }
                     }),
                 report_var);
 
@@ -101,56 +258,139 @@ struct CommonHelpers
 
     struct Udp
     {
+        /// Kinds of transient errors (the same as the report types) - used to aggregate error storms.
+        ///
+        enum ErrorKind : std::size_t
+        {
+            UdpardTxPublish,
+            UdpardTxRequest,
+            UdpardTxRespond,
+            UdpardRxMsgReceive,
+            UdpardRxSvcReceive,
+            MediaMakeRxSocket,
+            MediaMakeTxSocket,
+            MediaTxSocketSend,
+            MediaRxSocketReceive,
+            ErrorKindCount
+        };
+        static_assert(ErrorKindCount <= TransientErrorCounters::MaxKinds, "Increase `MaxKinds`.");
+
+        static const char* describeErrorKind(const std::size_t kind)
+        {
+            switch (kind)
+            {
+            case UdpardTxPublish:
+                return "UdpardTxPublish";
+            case UdpardTxRequest:
+                return "UdpardTxRequest";
+            case UdpardTxRespond:
+                return "UdpardTxRespond";
+            case UdpardRxMsgReceive:
+                return "UdpardRxMsgReceive";
+            case UdpardRxSvcReceive:
+                return "UdpardRxSvcReceive";
+            case MediaMakeRxSocket:
+                return "MediaMakeRxSocket";
+            case MediaMakeTxSocket:
+                return "MediaMakeTxSocket";
+            case MediaTxSocketSend:
+                return "MediaTxSocketSend";
+            case MediaRxSocketReceive:
+                return "MediaRxSocketReceive";
+            default:
+                return "?";
+            }
+        }
+
         static cetl::optional<libcyphal::transport::AnyFailure> transientErrorReporter(
-            libcyphal::transport::udp::IUdpTransport::TransientErrorReport::Variant& report_var)
+            libcyphal::transport::udp::IUdpTransport::TransientErrorReport::Variant& report_var,
+            TransientErrorCounters&                                                  counters,
+            BinLog&                                                                  log)
         {
             using Report = libcyphal::transport::udp::IUdpTransport::TransientErrorReport;
 
             cetl::visit(  //
                 cetl::make_overloaded(
-                    [](const Report::UdpardTxPublish& report) {
-                        std::cerr << "Failed to TX message frame to udpard "
-                                  << "(mediaIdx=" << static_cast<int>(report.media_index) << ").\n"
-                                  << Printers::describeAnyFailure(report.failure) << "\n";
+                    [&counters, &log](const Report::UdpardTxPublish& report) {
+                        ++counters.tx_overflows;
+                        if (counters.countKind(ErrorKind::UdpardTxPublish, report.media_index))
+                        {
+                            log("Failed to TX message frame to udpard (mediaIdx=%u): %s\n",
+                                report.media_index,
+                                Printers::describeAnyFailure(report.failure));
+                        }
                     },
-                    [](const Report::UdpardTxRequest& report) {
-                        std::cerr << "Failed to TX request frame to udpard "
-                                  << "(mediaIdx=" << static_cast<int>(report.media_index) << ").\n"
-                                  << Printers::describeAnyFailure(report.failure) << "\n";
+                    [&counters, &log](const Report::UdpardTxRequest& report) {
+                        ++counters.tx_overflows;
+                        if (counters.countKind(ErrorKind::UdpardTxRequest, report.media_index))
+                        {
+                            log("Failed to TX request frame to udpard (mediaIdx=%u): %s\n",
+                                report.media_index,
+                                Printers::describeAnyFailure(report.failure));
+                        }
                     },
-                    [](const Report::UdpardTxRespond& report) {
-                        std::cerr << "Failed to TX response frame to udpard "
-                                  << "(mediaIdx=" << static_cast<int>(report.media_index) << ").\n"
-                                  << Printers::describeAnyFailure(report.failure) << "\n";
+                    [&counters, &log](const Report::UdpardTxRespond& report) {
+                        ++counters.tx_overflows;
+                        if (counters.countKind(ErrorKind::UdpardTxRespond, report.media_index))
+                        {
+                            log("Failed to TX response frame to udpard (mediaIdx=%u): %s\n",
+                                report.media_index,
+                                Printers::describeAnyFailure(report.failure));
+                        }
                     },
-                    [](const Report::UdpardRxMsgReceive& report) {
-                        std::cerr << "Failed to accept RX message frame at udpard "
-                                  << Printers::describeAnyFailure(report.failure) << "\n";
+                    [&counters, &log](const Report::UdpardRxMsgReceive& report) {
+                        ++counters.rx_drops;
+                        // The report doesn't carry the media index (unlike the service one).
+                        if (counters.countKind(ErrorKind::UdpardRxMsgReceive, TransientErrorCounters::UnknownMedia))
+                        {
+                            log("Failed to accept RX message frame at udpard: %s\n",
+                                Printers::describeAnyFailure(report.failure));
+                        }
                     },
-                    [](const Report::UdpardRxSvcReceive& report) {
-                        std::cerr << "Failed to accept RX service frame at udpard "
-                                  << "(mediaIdx=" << static_cast<int>(report.media_index) << ").\n"
-                                  << Printers::describeAnyFailure(report.failure) << "\n";
+                    [&counters, &log](const Report::UdpardRxSvcReceive& report) {
+                        ++counters.rx_drops;
+                        if (counters.countKind(ErrorKind::UdpardRxSvcReceive, report.media_index))
+                        {
+                            log("Failed to accept RX service frame at udpard (mediaIdx=%u): %s\n",
+                                report.media_index,
+                                Printers::describeAnyFailure(report.failure));
+                        }
                     },
-                    [](const Report::MediaMakeRxSocket& report) {
-                        std::cerr << "Failed to make RX socket " << "(mediaIdx=" << static_cast<int>(report.media_index)
-                                  << ").\n"
-                                  << Printers::describeAnyFailure(report.failure) << "\n";
+                    [&counters, &log](const Report::MediaMakeRxSocket& report) {
+                        ++counters.media_errors;
+                        if (counters.countKind(ErrorKind::MediaMakeRxSocket, report.media_index))
+                        {
+                            log("Failed to make RX socket (mediaIdx=%u): %s\n",
+                                report.media_index,
+                                Printers::describeAnyFailure(report.failure));
+                        }
                     },
-                    [](const Report::MediaMakeTxSocket& report) {
-                        std::cerr << "Failed to make TX socket " << "(mediaIdx=" << static_cast<int>(report.media_index)
-                                  << ").\n"
-                                  << Printers::describeAnyFailure(report.failure) << "\n";
+                    [&counters, &log](const Report::MediaMakeTxSocket& report) {
+                        ++counters.media_errors;
+                        if (counters.countKind(ErrorKind::MediaMakeTxSocket, report.media_index))
+                        {
+                            log("Failed to make TX socket (mediaIdx=%u): %s\n",
+                                report.media_index,
+                                Printers::describeAnyFailure(report.failure));
+                        }
                     },
-                    [](const Report::MediaTxSocketSend& report) {
-                        std::cerr << "Failed to TX frame to socket "
-                                  << "(mediaIdx=" << static_cast<int>(report.media_index) << ").\n"
-                                  << Printers::describeAnyFailure(report.failure) << "\n";
+                    [&counters, &log](const Report::MediaTxSocketSend& report) {
+                        ++counters.media_errors;
+                        if (counters.countKind(ErrorKind::MediaTxSocketSend, report.media_index))
+                        {
+                            log("Failed to TX frame to socket (mediaIdx=%u): %s\n",
+                                report.media_index,
+                                Printers::describeAnyFailure(report.failure));
+                        }
                     },
-                    [](const Report::MediaRxSocketReceive& report) {
-                        std::cerr << "Failed to RX frame from socket "
-                                  << "(mediaIdx=" << static_cast<int>(report.media_index) << ").\n"
-                                  << Printers::describeAnyFailure(report.failure) << "\n";
+                    [&counters, &log](const Report::MediaRxSocketReceive& report) {
+                        ++counters.media_errors;
+                        if (counters.countKind(ErrorKind::MediaRxSocketReceive, report.media_index))
+                        {
+                            log("Failed to RX frame from socket (mediaIdx=%u): %s\n",
+                                report.media_index,
+                                Printers::describeAnyFailure(report.failure));
+                        }
                     }),
                 report_var);
 
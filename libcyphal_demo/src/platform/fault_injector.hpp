@@ -0,0 +1,218 @@
+// This software is distributed under the terms of the MIT License.
+// Copyright (C) OpenCyphal Development Team  <opencyphal.org>
+// Copyright Amazon.com Inc. or its affiliates.
+// SPDX-License-Identifier: MIT
+
+#ifndef PLATFORM_FAULT_INJECTOR_HPP_INCLUDED
+#define PLATFORM_FAULT_INJECTOR_HPP_INCLUDED
+
+#include <cetl/pf17/cetlpf.hpp>
+#include <libcyphal/types.hpp>
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+
+namespace platform
+{
+
+/// Implements a seeded fault model shared by the fault-injecting media decorators
+/// (see `Linux::FaultyCanMedia` and `posix::FaultyUdpMedia`).
+///
+/// Each kind of fault is injected with its own probability (in per-mille). The pseudo-random sequence is fully
+/// determined by the seed, so that the same traffic produces the same faults from run to run.
+///
+class FaultInjector final
+{
+public:
+    /// Kinds of the faults; the order is also the order of the probabilities and the injection counters.
+    ///
+    enum Kind : std::uint8_t
+    {
+        Loss,       ///< A frame is silently dropped (both on TX and RX).
+        Duplicate,  ///< A received frame is delivered twice.
+        Reorder,    ///< A received frame is delivered after the next one.
+        Delay,      ///< A received frame is delivered after the configured delay.
+        Corrupt,    ///< A random bit of a received frame payload is flipped.
+        TxFull,     ///< A frame is rejected by TX as if the socket buffer was full (so it will be retried later).
+
+        KindCount
+    };
+
+    struct Params final
+    {
+        std::array<std::uint16_t, KindCount> permille;
+        std::uint16_t                        delay_ms;
+        std::uint64_t                        seed;
+    };
+
+    explicit FaultInjector(const Params& params)
+        : params_{params}
+        , state_{params.seed}
+    {
+        // Xorshift state must never be zero.
+        if (state_ == 0)
+        {
+            state_ = DefaultSeed;
+        }
+    }
+
+    /// Fault-injecting decorators are installed only if at least one kind of fault is enabled.
+    ///
+    bool isEnabled() const noexcept
+    {
+        for (const auto permille : params_.permille)
+        {
+            if (permille > 0)
+            {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    /// Decides whether a fault of the given kind should be injected now, and counts it if so.
+    ///
+    bool inject(const Kind kind) noexcept
+    {
+        const std::uint16_t permille = params_.permille[kind];  // NOLINT(*-constant-array-index)
+        if ((permille == 0) || ((random() % PerMille) >= permille))
+        {
+            return false;
+        }
+        ++injected_[kind];  // NOLINT(*-constant-array-index)
+        return true;
+    }
+
+    /// Flips a random bit of the given payload, if any.
+    ///
+    void corrupt(const cetl::span<cetl::byte> payload) noexcept
+    {
+        if (!payload.empty())
+        {
+            const std::uint64_t bit = random() % (payload.size() * 8U);
+            payload[bit / 8U] ^= static_cast<cetl::byte>(1U << (bit % 8U));
+        }
+    }
+
+    libcyphal::Duration delay() const noexcept
+    {
+        return std::chrono::milliseconds{params_.delay_ms};
+    }
+
+    /// Gets total number of the injected faults per kind (see `Kind` for the order).
+    ///
+    const std::array<std::uint64_t, KindCount>& injectedCounts() const noexcept
+    {
+        return injected_;
+    }
+
+private:
+    static constexpr std::uint64_t PerMille    = 1000U;
+    static constexpr std::uint64_t DefaultSeed = 0x9E3779B97F4A7C15ULL;
+
+    /// Xorshift64* - it's cheap, has no hidden state, and produces the same sequence on any platform.
+    ///
+    std::uint64_t random() noexcept
+    {
+        state_ ^= state_ >> 12U;  // NOLINT(*-magic-numbers)
+        state_ ^= state_ << 25U;  // NOLINT(*-magic-numbers)
+        state_ ^= state_ >> 27U;  // NOLINT(*-magic-numbers)
+        return (state_ * 0x2545F4914F6CDD1DULL) >> 32U;  // NOLINT(*-magic-numbers)
+    }
+
+    // MARK: Data members:
+
+    Params                               params_;
+    std::uint64_t                        state_;
+    std::array<std::uint64_t, KindCount> injected_{};
+
+};  // FaultInjector
+
+/// Holds received frames which delivery is postponed by the fault injection (duplicates, reordered and delayed ones).
+///
+/// A held frame is released either when its release time has come, or (for the reordered ones) as soon as the next
+/// frame has been received. The frames are released from within the `pop`/`receive` calls of the decorated media,
+/// which are also triggered by a timer at `nextReleaseAt`, so a delay doesn't depend on other traffic on the media.
+///
+template <typename Frame, std::size_t Capacity>
+class FaultHoldQueue final
+{
+public:
+    /// @return `false` if the queue is full, so that the frame should be delivered immediately.
+    ///
+    bool hold(Frame&& frame, const libcyphal::TimePoint release_at, const bool after_next) noexcept
+    {
+        for (auto& slot : slots_)
+        {
+            if (!slot.frame.has_value())
+            {
+                slot.frame.emplace(std::move(frame));
+                slot.release_at = release_at;
+                slot.after_next = after_next;
+                return true;
+            }
+        }
+        return false;
+    }
+
+    /// Makes all frames held until the next received one due for release.
+    ///
+    void onNextFrame(const libcyphal::TimePoint now) noexcept
+    {
+        for (auto& slot : slots_)
+        {
+            if (slot.frame.has_value() && slot.after_next)
+            {
+                slot.release_at = now;
+                slot.after_next = false;
+            }
+        }
+    }
+
+    cetl::optional<Frame> takeDue(const libcyphal::TimePoint now) noexcept
+    {
+        for (auto& slot : slots_)
+        {
+            if (slot.frame.has_value() && !slot.after_next && (slot.release_at <= now))
+            {
+                cetl::optional<Frame> out{std::move(slot.frame)};
+                slot.frame.reset();
+                return out;
+            }
+        }
+        return cetl::nullopt;
+    }
+
+    /// Gets the earliest release time of the held frames (except the ones held until the next received frame).
+    ///
+    cetl::optional<libcyphal::TimePoint> nextReleaseAt() const noexcept
+    {
+        cetl::optional<libcyphal::TimePoint> earliest;
+        for (const auto& slot : slots_)
+        {
+            if (slot.frame.has_value() && !slot.after_next && (!earliest.has_value() || (slot.release_at < *earliest)))
+            {
+                earliest = slot.release_at;
+            }
+        }
+        return earliest;
+    }
+
+private:
+    struct Slot final
+    {
+        cetl::optional<Frame> frame;
+        libcyphal::TimePoint  release_at{};
+        bool                  after_next{false};
+    };
+
+    std::array<Slot, Capacity> slots_{};
+
+};  // FaultHoldQueue
+
+}  // namespace platform
+
+#endif  // PLATFORM_FAULT_INJECTOR_HPP_INCLUDED
@@ -0,0 +1,351 @@
+// This software is distributed under the terms of the MIT License.
+// Copyright (C) OpenCyphal Development Team  <opencyphal.org>
+// Copyright Amazon.com Inc. or its affiliates.
+// SPDX-License-Identifier: MIT
+
+#ifndef PLATFORM_FLIGHT_RECORDER_HPP_INCLUDED
+#define PLATFORM_FLIGHT_RECORDER_HPP_INCLUDED
+
+#include <array>
+#include <cerrno>
+#include <chrono>
+#include <csignal>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <fcntl.h>
+#include <unistd.h>
+
+namespace platform
+{
+
+/// Implements an always-on in-memory ring of the most recent node events (TX/RX frames, main loop wakeups and errors).
+///
+/// Recording an event is just a monotonic clock read and a store into a preallocated ring, so it's cheap enough
+/// to be done unconditionally on the hot paths. The ring is dumped to a text file on demand:
+/// - on `SIGUSR1` (the signal handler only raises a flag, and the main loop does the dump - see `takeDumpRequest`);
+/// - on a crash (`SIGSEGV`, `SIGBUS`, `SIGFPE`, `SIGILL` or `SIGABRT`) - directly from the signal handler.
+/// Hence, the dump is implemented using async-signal-safe functions only (`open`, `write` and `close`).
+///
+/// The recorder is not thread-safe - all events are expected to be recorded from the main loop thread.
+///
+class FlightRecorder final
+{
+public:
+    enum class EventType : std::uint8_t
+    {
+        CanTx,
+        CanRx,
+        UdpTx,
+        UdpRx,
+        LoopWakeup,
+        Error,
+    };
+
+    /// Meaning of the `id` and `size` fields depends on the event type:
+    /// - frames: CAN ID (or UDP destination port, zero for RX), and the payload size;
+    /// - main loop wakeups: the loop iteration (truncated), and the callbacks lateness in microseconds;
+    /// - errors: as for the frames (if known), plus the `errno` code.
+    ///
+    struct Event final
+    {
+        std::uint64_t timestamp_us;
+        std::uint32_t id;
+        std::uint32_t size;
+        std::int32_t  code;  ///< Error code (`errno`), or zero.
+        std::int16_t  fd;    ///< File descriptor of the socket, or -1.
+        EventType     type;
+    };
+
+    template <std::size_t Capacity>
+    explicit FlightRecorder(std::array<Event, Capacity>& storage)
+        : events_{storage.data()}
+        , mask_{Capacity - 1}
+    {
+        static_assert((Capacity >= 2) && ((Capacity & (Capacity - 1)) == 0), "Capacity must be a power of two.");
+    }
+
+    ~FlightRecorder()
+    {
+        if (globals().recorder == this)
+        {
+            globals().recorder = nullptr;
+        }
+    }
+
+    FlightRecorder(const FlightRecorder&)                = delete;
+    FlightRecorder(FlightRecorder&&) noexcept            = delete;
+    FlightRecorder& operator=(const FlightRecorder&)     = delete;
+    FlightRecorder& operator=(FlightRecorder&&) noexcept = delete;
+
+    void record(const EventType     type,
+                const int           fd,
+                const std::uint32_t id,
+                const std::uint32_t size,
+                const std::int32_t  code = 0) noexcept
+    {
+        const auto now = std::chrono::steady_clock::now().time_since_epoch();
+
+        Event& event       = events_[head_ & mask_];  // NOLINT(*-pointer-arithmetic)
+        event.timestamp_us = static_cast<std::uint64_t>(
+            std::chrono::duration_cast<std::chrono::microseconds>(now).count());
+        event.id           = id;
+        event.size         = size;
+        event.code         = code;
+        event.fd           = static_cast<std::int16_t>(fd);
+        event.type         = type;
+        ++head_;
+    }
+
+    /// Gets total number of events recorded so far (including the overwritten ones).
+    ///
+    std::uint64_t count() const noexcept
+    {
+        return head_;
+    }
+
+    /// Writes the recorded events (oldest first) as text to the given file. Async-signal-safe.
+    ///
+    /// @return Zero on success, or `errno` of the failed operation.
+    ///
+    int dumpTo(const char* const path) const noexcept
+    {
+        const int fd = ::open(path, O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);  // NOLINT
+        if (fd < 0)
+        {
+            return errno;
+        }
+
+        const std::uint64_t capacity = mask_ + 1;
+        const std::uint64_t head     = head_;
+        const std::uint64_t first    = (head > capacity) ? (head - capacity) : 0;
+
+        LineWriter out{fd};
+        out.put("# flight recorder: ").put(head - first).put(" of ").put(head).put(" events\n");
+        out.put("# seq time_us event fd id size code\n");
+        for (std::uint64_t seq = first; seq < head; ++seq)
+        {
+            const Event& event = events_[seq & mask_];  // NOLINT(*-pointer-arithmetic)
+            out.put(seq).put(' ').put(event.timestamp_us).put(' ').put(describe(event.type)).put(' ');
+            out.put(static_cast<std::int64_t>(event.fd)).put(' ').put(std::uint64_t{event.id}).put(' ');
+            out.put(std::uint64_t{event.size}).put(' ').put(static_cast<std::int64_t>(event.code)).put('\n');
+        }
+        const int err = out.flush();
+
+        (void) ::close(fd);
+        return err;
+    }
+
+    /// Installs the signal handlers which dump the recorder to the given file.
+    ///
+    /// Only one recorder could be installed at a time. The path is copied (and truncated if too long).
+    /// The crash handlers run on an alternate signal stack, so that the dump works on a stack overflow as well;
+    /// the alternate stack is per thread, so it's installed for the calling (expected to be the main) thread only.
+    ///
+    static void installSignalHandlers(FlightRecorder& recorder, const char* const path) noexcept
+    {
+        Globals& g = globals();
+        (void) std::strncpy(g.path.data(), path, g.path.size() - 1);
+        g.recorder = &recorder;
+
+        struct sigaction dump_request_action{};
+        dump_request_action.sa_handler = &onDumpRequestSignal;
+        (void) ::sigemptyset(&dump_request_action.sa_mask);
+        (void) ::sigaction(SIGUSR1, &dump_request_action, nullptr);
+
+        stack_t alt_stack{};
+        alt_stack.ss_sp    = g.alt_stack.data();
+        alt_stack.ss_size  = g.alt_stack.size();
+        alt_stack.ss_flags = 0;
+        (void) ::sigaltstack(&alt_stack, nullptr);
+
+        // Crash handlers are one-shot, so that re-raising the signal terminates the process as usual.
+        struct sigaction crash_action{};
+        crash_action.sa_handler = &onCrashSignal;
+        crash_action.sa_flags   = SA_RESETHAND | SA_ONSTACK;  // NOLINT(*-signed-bitwise)
+        (void) ::sigemptyset(&crash_action.sa_mask);
+        for (const int sig : {SIGSEGV, SIGBUS, SIGFPE, SIGILL, SIGABRT})
+        {
+            (void) ::sigaction(sig, &crash_action, nullptr);
+        }
+    }
+
+    /// Gets (and clears) the dump request flag raised by `SIGUSR1`. Expected to be polled by the main loop.
+    ///
+    static bool takeDumpRequest() noexcept
+    {
+        Globals& g = globals();
+        if (g.dump_requested == 0)
+        {
+            return false;
+        }
+        g.dump_requested = 0;
+        return true;
+    }
+
+    /// Dumps the installed recorder (if any) to the path given to `installSignalHandlers`.
+    ///
+    /// @return The dump file path, or `nullptr` if there is no recorder installed or the dump has failed.
+    ///
+    static const char* dumpInstalled() noexcept
+    {
+        const Globals& g = globals();
+        if ((g.recorder == nullptr) || (g.recorder->dumpTo(g.path.data()) != 0))
+        {
+            return nullptr;
+        }
+        return g.path.data();
+    }
+
+private:
+    static constexpr std::size_t MaxPathLen   = 256;
+    static constexpr std::size_t AltStackSize = 64UL * 1024UL;  // Well above `MINSIGSTKSZ` + the dump `LineWriter`.
+
+    struct Globals final
+    {
+        FlightRecorder*                  recorder{nullptr};
+        volatile std::sig_atomic_t       dump_requested{0};
+        std::array<char, MaxPathLen + 1> path{};
+        std::array<char, AltStackSize>   alt_stack{};
+    };
+
+    /// Accumulates text in a fixed buffer, and writes it out in chunks. Async-signal-safe.
+    ///
+    class LineWriter final
+    {
+    public:
+        explicit LineWriter(const int fd)
+            : fd_{fd}
+        {
+        }
+
+        LineWriter& put(const char ch) noexcept
+        {
+            if (used_ == buffer_.size())
+            {
+                (void) flush();
+            }
+            buffer_[used_++] = ch;  // NOLINT(*-constant-array-index)
+            return *this;
+        }
+
+        LineWriter& put(const char* str) noexcept
+        {
+            while (*str != '\0')
+            {
+                put(*str++);  // NOLINT(*-pointer-arithmetic)
+            }
+            return *this;
+        }
+
+        LineWriter& put(std::uint64_t value) noexcept
+        {
+            std::array<char, 20> digits{};  // NOLINT(*-magic-numbers) enough for 2^64
+            std::size_t          count = 0;
+            do
+            {
+                digits[count++] = static_cast<char>('0' + (value % 10U));  // NOLINT(*-constant-array-index)
+                value /= 10U;
+            } while (value > 0);
+            while (count > 0)
+            {
+                put(digits[--count]);  // NOLINT(*-constant-array-index)
+            }
+            return *this;
+        }
+
+        LineWriter& put(const std::int64_t value) noexcept
+        {
+            if (value < 0)
+            {
+                put('-');
+                return put(static_cast<std::uint64_t>(-(value + 1)) + 1U);
+            }
+            return put(static_cast<std::uint64_t>(value));
+        }
+
+        /// @return Zero on success, or `errno` of the failed write.
+        ///
+        int flush() noexcept
+        {
+            std::size_t offset = 0;
+            while (offset < used_)
+            {
+                const auto written = ::write(fd_, &buffer_[offset], used_ - offset);  // NOLINT
+                if (written < 0)
+                {
+                    if (errno == EINTR)
+                    {
+                        continue;
+                    }
+                    used_ = 0;
+                    return errno;
+                }
+                offset += static_cast<std::size_t>(written);
+            }
+            used_ = 0;
+            return 0;
+        }
+
+    private:
+        static constexpr std::size_t BufferSize = 4096;
+
+        int                          fd_;
+        std::size_t                  used_{0};
+        std::array<char, BufferSize> buffer_{};
+
+    };  // LineWriter
+
+    static Globals& globals() noexcept
+    {
+        static Globals instance;
+        return instance;
+    }
+
+    static const char* describe(const EventType type) noexcept
+    {
+        switch (type)
+        {
+        case EventType::CanTx:
+            return "can_tx";
+        case EventType::CanRx:
+            return "can_rx";
+        case EventType::UdpTx:
+            return "udp_tx";
+        case EventType::UdpRx:
+            return "udp_rx";
+        case EventType::LoopWakeup:
+            return "loop";
+        case EventType::Error:
+            return "error";
+        default:
+            return "?";
+        }
+    }
+
+    static void onDumpRequestSignal(const int) noexcept
+    {
+        globals().dump_requested = 1;
+    }
+
+    static void onCrashSignal(const int sig) noexcept
+    {
+        const int saved_errno = errno;
+        (void) dumpInstalled();
+        errno = saved_errno;
+
+        // The handler has been reset to the default one (see `SA_RESETHAND`), so this terminates the process.
+        (void) ::raise(sig);
+    }
+
+    // MARK: Data members:
+
+    Event*        events_;
+    std::size_t   mask_;
+    std::uint64_t head_{0};
+
+};  // FlightRecorder
+
+}  // namespace platform
+
+#endif  // PLATFORM_FLIGHT_RECORDER_HPP_INCLUDED
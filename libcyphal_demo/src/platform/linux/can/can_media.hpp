@@ -7,9 +7,17 @@
 #ifndef PLATFORM_LINUX_CAN_MEDIA_HPP_INCLUDED
 #define PLATFORM_LINUX_CAN_MEDIA_HPP_INCLUDED
 
+#include "faulty_can_media.hpp"
+#include "platform/fault_injector.hpp"
+#include "platform/flight_recorder.hpp"
+#include "platform/linux/perf_counters.hpp"
 #include "platform/posix/posix_executor_extension.hpp"
 #include "platform/posix/posix_platform_error.hpp"
+#include "platform/tracer.hpp"
+#include "platform/tracking_memory_resource.hpp"
+#include "platform/tx_timestamp_tap.hpp"
 #include "socketcan.h"
+#include "usdt.h"
 
 #include <canard.h>
 #include <cetl/pf17/cetlpf.hpp>
@@ -25,8 +33,10 @@
 #include <algorithm>
 #include <array>
 #include <cerrno>
+#include <chrono>
 #include <cstddef>
 #include <cstdint>
+#include <ctime>
 #include <iterator>
 #include <unistd.h>
 #include <utility>
@@ -44,7 +54,9 @@ public:
         cetl::pmr::memory_resource& general_mr,
         libcyphal::IExecutor&       executor,
         const cetl::string_view     iface_address_sv,
-        cetl::pmr::memory_resource& tx_mr)
+        cetl::pmr::memory_resource& tx_mr,
+        FlightRecorder&             flight_recorder,
+        TxTimestampTap&             tx_tap)
     {
         const IfaceAddrString iface_address{iface_address_sv};
 
@@ -61,22 +73,29 @@ public:
         if (socket_can_tx_fd < 0)
         {
             const int error_code = -socket_can_tx_fd;
-            (void) ::close(socket_can_rx_fd);
+            ::socketcanClose(socket_can_rx_fd);
             return libcyphal::transport::PlatformError{posix::PosixPlatformError{error_code}};
         }
 
-        return CanMedia{general_mr, executor, socket_can_rx_fd, socket_can_tx_fd, iface_address, tx_mr};
+        return CanMedia{general_mr,
+                        executor,
+                        socket_can_rx_fd,
+                        socket_can_tx_fd,
+                        iface_address,
+                        tx_mr,
+                        flight_recorder,
+                        tx_tap};
     }
 
     ~CanMedia()
     {
         if (socket_can_rx_fd_ >= 0)
         {
-            (void) ::close(socket_can_rx_fd_);
+            ::socketcanClose(socket_can_rx_fd_);
         }
         if (socket_can_tx_fd_ >= 0)
         {
-            (void) ::close(socket_can_tx_fd_);
+            ::socketcanClose(socket_can_tx_fd_);
         }
     }
 
@@ -90,6 +109,8 @@ public:
         , socket_can_tx_fd_{std::exchange(other.socket_can_tx_fd_, -1)}
         , iface_address_{other.iface_address_}
         , tx_mr_{other.tx_mr_}
+        , flight_recorder_{other.flight_recorder_}
+        , tx_tap_{other.tx_tap_}
     {
     }
     CanMedia* operator=(CanMedia&&) noexcept = delete;
@@ -98,12 +119,12 @@ public:
     {
         if (socket_can_rx_fd_ >= 0)
         {
-            (void) ::close(socket_can_rx_fd_);
+            ::socketcanClose(socket_can_rx_fd_);
             socket_can_rx_fd_ = -1;
         }
         if (socket_can_tx_fd_ >= 0)
         {
-            (void) ::close(socket_can_tx_fd_);
+            ::socketcanClose(socket_can_tx_fd_);
             socket_can_tx_fd_ = -1;
         }
 
@@ -135,13 +156,17 @@ private:
              const SocketCANFD           socket_can_rx_fd,
              const SocketCANFD           socket_can_tx_fd,
              const IfaceAddrString&      iface_address,
-             cetl::pmr::memory_resource& tx_mr)
+             cetl::pmr::memory_resource& tx_mr,
+             FlightRecorder&             flight_recorder,
+             TxTimestampTap&             tx_tap)
         : general_mr_{general_mr}
         , executor_{executor}
         , socket_can_rx_fd_{socket_can_rx_fd}
         , socket_can_tx_fd_{socket_can_tx_fd}
         , iface_address_{iface_address}
         , tx_mr_{tx_mr}
+        , flight_recorder_{flight_recorder}
+        , tx_tap_{tx_tap}
     {
     }
 
@@ -158,6 +183,27 @@ private:
         return posix_executor_ext->registerAwaitableCallback(std::move(function), trigger);
     }
 
+    /// Converts the kernel RX timestamp (which is in the realtime clock domain) to the executor time -
+    /// by subtracting its age from the current executor time. So it excludes the latency of the frame processing.
+    ///
+    libcyphal::TimePoint toExecutorTime(const CanardMicrosecond kernel_timestamp_us) const
+    {
+        const auto now = executor_.now();
+
+        timespec realtime{};
+        if ((kernel_timestamp_us == 0) || (::clock_gettime(CLOCK_REALTIME, &realtime) != 0))
+        {
+            return now;
+        }
+        const auto realtime_us = static_cast<CanardMicrosecond>((realtime.tv_sec * 1000000LL) +  // NOLINT
+                                                                (realtime.tv_nsec / 1000LL));    // NOLINT
+        if (realtime_us <= kernel_timestamp_us)
+        {
+            return now;
+        }
+        return now - std::chrono::microseconds{realtime_us - kernel_timestamp_us};
+    }
+
     // MARK: - IMedia
 
     std::size_t getMtu() const noexcept override
@@ -187,17 +233,34 @@ private:
                           const libcyphal::transport::can::CanId can_id,
                           libcyphal::transport::MediaPayload&    payload) noexcept override
     {
+        PLATFORM_TRACE_SCOPE("can.push", can_id);
+        PLATFORM_PERF_SCOPE("can.push");
+
         const CanardFrame  canard_frame{can_id,
                                         {payload.getSpan().size(), static_cast<const void*>(payload.getSpan().data())}};
         const std::int16_t result = ::socketcanPush(socket_can_tx_fd_, &canard_frame, 0);
+        USDT_PROBE4(can_media_push, socket_can_tx_fd_, can_id, canard_frame.payload.size, result);
         if (result < 0)
         {
+            flight_recorder_.record(FlightRecorder::EventType::Error, socket_can_tx_fd_, can_id, 0, -result);
             return libcyphal::transport::PlatformError{posix::PosixPlatformError{-result}};
         }
 
         const bool is_accepted = result > 0;
         if (is_accepted)
         {
+            flight_recorder_.record(FlightRecorder::EventType::CanTx,
+                                    socket_can_tx_fd_,
+                                    can_id,
+                                    static_cast<std::uint32_t>(canard_frame.payload.size));
+
+            // Cyphal/CAN message frames have the service flag (bit 25) cleared, and the subject-ID in bits 8..20.
+            if ((can_id & (1UL << 25U)) == 0)  // NOLINT(*-magic-numbers)
+            {
+                const auto subject_id = static_cast<libcyphal::transport::PortId>((can_id >> 8U) & 0x1FFFU);  // NOLINT
+                tx_tap_.onMessageTx(subject_id, executor_.now());
+            }
+
             // Payload is not needed anymore, so return memory asap.
             payload.reset();
         }
@@ -207,26 +270,42 @@ private:
 
     CETL_NODISCARD PopResult::Type pop(const cetl::span<cetl::byte> payload_buffer) noexcept override
     {
-        CanardFrame canard_frame{};
-        bool        is_loopback{false};
+        PLATFORM_TRACE_SCOPE("can.pop", socket_can_rx_fd_);
+        PLATFORM_PERF_SCOPE("can.pop");
+
+        CanardFrame       canard_frame{};
+        CanardMicrosecond kernel_timestamp_us{0};
+        bool              is_loopback{false};
 
         const std::int16_t result = ::socketcanPop(socket_can_rx_fd_,
                                                    &canard_frame,
-                                                   nullptr,
+                                                   &kernel_timestamp_us,
                                                    payload_buffer.size(),
                                                    payload_buffer.data(),
                                                    0,
                                                    &is_loopback);
         if (result < 0)
         {
+            flight_recorder_.record(FlightRecorder::EventType::Error, socket_can_rx_fd_, 0, 0, -result);
             return libcyphal::transport::PlatformError{posix::PosixPlatformError{-result}};
         }
         if (result == 0)
         {
             return cetl::nullopt;
         }
-
-        return PopResult::Metadata{executor_.now(), canard_frame.extended_can_id, canard_frame.payload.size};
+        USDT_PROBE4(can_media_pop,
+                    socket_can_rx_fd_,
+                    canard_frame.extended_can_id,
+                    canard_frame.payload.size,
+                    is_loopback);
+        flight_recorder_.record(FlightRecorder::EventType::CanRx,
+                                socket_can_rx_fd_,
+                                canard_frame.extended_can_id,
+                                static_cast<std::uint32_t>(canard_frame.payload.size));
+
+        return PopResult::Metadata{toExecutorTime(kernel_timestamp_us),
+                                   canard_frame.extended_can_id,
+                                   canard_frame.payload.size};
     }
 
     CETL_NODISCARD libcyphal::IExecutor::Callback::Any registerPushCallback(
@@ -256,6 +335,8 @@ private:
     SocketCANFD                 socket_can_tx_fd_;
     IfaceAddrString             iface_address_;
     cetl::pmr::memory_resource& tx_mr_;
+    FlightRecorder&             flight_recorder_;
+    TxTimestampTap&             tx_tap_;
 
 };  // CanMedia
 
@@ -265,11 +346,17 @@ struct CanMediaCollection
 {
     CanMediaCollection(cetl::pmr::memory_resource& general_mr,
                        libcyphal::IExecutor&       executor,
-                       cetl::pmr::memory_resource& tx_mr)
+                       cetl::pmr::memory_resource& tx_mr,
+                       FlightRecorder&             flight_recorder,
+                       FaultInjector&              fault_injector,
+                       TxTimestampTap&             tx_tap)
         : general_mr_{general_mr}
         , executor_{executor}
+        , flight_recorder_{flight_recorder}
+        , fault_injector_{fault_injector}
+        , tx_tap_{tx_tap}
         , media_array_{{cetl::nullopt, cetl::nullopt, cetl::nullopt}}
-        , tx_mr_{tx_mr}
+        , tx_mrs_{{{tx_mr}, {tx_mr}, {tx_mr}}}
     {
     }
 
@@ -278,8 +365,9 @@ struct CanMediaCollection
         // Reset the collection.
         for (std::size_t i = 0; i < MaxCanMedia; i++)
         {
-            media_array_[i].reset();     // NOLINT
-            media_ifaces_[i] = nullptr;  // NOLINT
+            faulty_media_array_[i].reset();  // NOLINT
+            media_array_[i].reset();         // NOLINT
+            media_ifaces_[i] = nullptr;      // NOLINT
         }
 
         // Split addresses by spaces.
@@ -292,11 +380,22 @@ struct CanMediaCollection
             const auto iface_address = iface_addresses.substr(curr, next - curr);
             if (!iface_address.empty())
             {
-                auto maybe_media = CanMedia::make(general_mr_, executor_, iface_address, tx_mr_);
+                auto maybe_media = CanMedia::make(general_mr_,
+                                                  executor_,
+                                                  iface_address,
+                                                  tx_mrs_[index],  // NOLINT
+                                                  flight_recorder_,
+                                                  tx_tap_);
                 if (auto* const media_ptr = cetl::get_if<CanMedia>(&maybe_media))
                 {
                     media_array_[index].emplace(std::move(*media_ptr));     // NOLINT
                     media_ifaces_[index] = &(media_array_[index].value());  // NOLINT
+                    if (fault_injector_.isEnabled())
+                    {
+                        auto& faulty_media = faulty_media_array_[index];                          // NOLINT
+                        faulty_media.emplace(*media_ifaces_[index], executor_, fault_injector_);  // NOLINT
+                        media_ifaces_[index] = &(faulty_media.value());                           // NOLINT
+                    }
                     index++;
                 }
             }
@@ -318,14 +417,26 @@ struct CanMediaCollection
         });
     }
 
+    /// Gets TX memory diagnostics of the media at the given index. Number of allocated blocks is the depth
+    /// of the media TX queue, and the peak is its high-water mark.
+    ///
+    TrackingMemoryResource::Diagnostics queryTxDiagnostics(const std::size_t index) const
+    {
+        return tx_mrs_[index].queryDiagnostics();  // NOLINT
+    }
+
 private:
     static constexpr std::size_t MaxCanMedia = 3;
 
     cetl::pmr::memory_resource&                                 general_mr_;
     libcyphal::IExecutor&                                       executor_;
+    FlightRecorder&                                             flight_recorder_;
+    FaultInjector&                                              fault_injector_;
+    TxTimestampTap&                                             tx_tap_;
     std::array<cetl::optional<CanMedia>, MaxCanMedia>           media_array_;
+    std::array<cetl::optional<FaultyCanMedia>, MaxCanMedia>     faulty_media_array_;
     std::array<libcyphal::transport::can::IMedia*, MaxCanMedia> media_ifaces_{};
-    cetl::pmr::memory_resource&                                 tx_mr_;
+    std::array<TrackingMemoryResource, MaxCanMedia>             tx_mrs_;
 
 };  // CanMediaCollection
 
@@ -0,0 +1,212 @@
+// This software is distributed under the terms of the MIT License.
+// Copyright (C) OpenCyphal Development Team  <opencyphal.org>
+// Copyright Amazon.com Inc. or its affiliates.
+// SPDX-License-Identifier: MIT
+
+#ifndef PLATFORM_LINUX_FAULTY_CAN_MEDIA_HPP_INCLUDED
+#define PLATFORM_LINUX_FAULTY_CAN_MEDIA_HPP_INCLUDED
+
+#include "platform/fault_injector.hpp"
+
+#include <canard.h>
+#include <cetl/pf17/cetlpf.hpp>
+#include <cetl/pf20/cetlpf.hpp>
+#include <libcyphal/executor.hpp>
+#include <libcyphal/transport/can/media.hpp>
+#include <libcyphal/transport/errors.hpp>
+#include <libcyphal/transport/media_payload.hpp>
+#include <libcyphal/types.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <utility>
+
+namespace platform
+{
+// Can't use lowercased `linux` - gnuc++ defines it as macro.
+namespace Linux
+{
+
+/// Decorates a CAN media with the faults of the given injector.
+///
+/// Loss and TX-full are injected on `push`; all kinds except TX-full are injected on `pop`.
+/// Held frames are released by invoking the pop callback of the transport on a timer of their release time.
+/// Any `IMedia` could be decorated, so this is also usable with the test doubles of media.
+///
+class FaultyCanMedia final : public libcyphal::transport::can::IMedia
+{
+public:
+    FaultyCanMedia(libcyphal::transport::can::IMedia& inner, libcyphal::IExecutor& executor, FaultInjector& injector)
+        : inner_{inner}
+        , executor_{executor}
+        , injector_{injector}
+    {
+    }
+
+    ~FaultyCanMedia() = default;
+
+    FaultyCanMedia(const FaultyCanMedia&)                = delete;
+    FaultyCanMedia(FaultyCanMedia&&) noexcept            = delete;
+    FaultyCanMedia& operator=(const FaultyCanMedia&)     = delete;
+    FaultyCanMedia& operator=(FaultyCanMedia&&) noexcept = delete;
+
+private:
+    static constexpr std::size_t MaxHeldFrames = 8;
+
+    struct HeldFrame final
+    {
+        PopResult::Metadata                    metadata;
+        std::array<cetl::byte, CANARD_MTU_MAX> payload;
+    };
+
+    // MARK: - IMedia
+
+    std::size_t getMtu() const noexcept override
+    {
+        return inner_.getMtu();
+    }
+
+    cetl::optional<libcyphal::transport::MediaFailure> setFilters(
+        const libcyphal::transport::can::Filters filters) noexcept override
+    {
+        return inner_.setFilters(filters);
+    }
+
+    PushResult::Type push(const libcyphal::TimePoint             deadline,
+                          const libcyphal::transport::can::CanId can_id,
+                          libcyphal::transport::MediaPayload&    payload) noexcept override
+    {
+        if (injector_.inject(FaultInjector::TxFull))
+        {
+            return PushResult::Success{false};
+        }
+        if (injector_.inject(FaultInjector::Loss))
+        {
+            // Pretend that the frame has been sent.
+            payload.reset();
+            return PushResult::Success{true};
+        }
+        return inner_.push(deadline, can_id, payload);
+    }
+
+    CETL_NODISCARD PopResult::Type pop(const cetl::span<cetl::byte> payload_buffer) noexcept override
+    {
+        auto result = popWithFaults(payload_buffer);
+        scheduleRelease();
+        return result;
+    }
+
+    CETL_NODISCARD libcyphal::IExecutor::Callback::Any registerPushCallback(
+        libcyphal::IExecutor::Callback::Function&& function) override
+    {
+        return inner_.registerPushCallback(std::move(function));
+    }
+
+    CETL_NODISCARD libcyphal::IExecutor::Callback::Any registerPopCallback(
+        libcyphal::IExecutor::Callback::Function&& function) override
+    {
+        // The same transport handler pops both the received and the released (held) frames.
+        pop_function_     = std::move(function);
+        release_callback_ = executor_.registerCallback([this](const auto& arg) { pop_function_(arg); });
+        return inner_.registerPopCallback([this](const auto& arg) { pop_function_(arg); });
+    }
+
+    cetl::pmr::memory_resource& getTxMemoryResource() override
+    {
+        return inner_.getTxMemoryResource();
+    }
+
+    // MARK: Privates:
+
+    PopResult::Type popWithFaults(const cetl::span<cetl::byte> payload_buffer) noexcept
+    {
+        const auto now = executor_.now();
+        if (auto held = held_frames_.takeDue(now))
+        {
+            return release(*held, now, payload_buffer);
+        }
+
+        auto        result  = inner_.pop(payload_buffer);
+        auto* const success = cetl::get_if<PopResult::Success>(&result);
+        if ((success == nullptr) || !success->has_value())
+        {
+            return result;
+        }
+        held_frames_.onNextFrame(now);
+
+        const PopResult::Metadata&   metadata = success->value();
+        const cetl::span<cetl::byte> payload{payload_buffer.data(),
+                                             std::min(metadata.payload_size, payload_buffer.size())};
+        if (injector_.inject(FaultInjector::Loss))
+        {
+            return cetl::nullopt;
+        }
+        if (injector_.inject(FaultInjector::Corrupt))
+        {
+            injector_.corrupt(payload);
+        }
+
+        if (injector_.inject(FaultInjector::Duplicate))
+        {
+            (void) held_frames_.hold(makeHeldFrame(metadata, payload), now, false);
+        }
+        else if (injector_.inject(FaultInjector::Reorder))
+        {
+            if (held_frames_.hold(makeHeldFrame(metadata, payload), now, true))
+            {
+                return cetl::nullopt;
+            }
+        }
+        else if (injector_.inject(FaultInjector::Delay))
+        {
+            if (held_frames_.hold(makeHeldFrame(metadata, payload), now + injector_.delay(), false))
+            {
+                return cetl::nullopt;
+            }
+        }
+        return result;
+    }
+
+    void scheduleRelease()
+    {
+        const auto release_at = held_frames_.nextReleaseAt();
+        if (release_at.has_value() && release_callback_.has_value())
+        {
+            (void) release_callback_.schedule(libcyphal::IExecutor::Callback::Schedule::Once{*release_at});
+        }
+    }
+
+    static HeldFrame makeHeldFrame(const PopResult::Metadata& metadata, const cetl::span<const cetl::byte> payload)
+    {
+        HeldFrame held{metadata, {}};
+        held.metadata.payload_size = std::min(payload.size(), held.payload.size());
+        (void) std::copy_n(payload.begin(), held.metadata.payload_size, held.payload.begin());
+        return held;
+    }
+
+    static PopResult::Metadata release(HeldFrame&                   held,
+                                       const libcyphal::TimePoint   now,
+                                       const cetl::span<cetl::byte> payload_buffer)
+    {
+        held.metadata.timestamp    = now;
+        held.metadata.payload_size = std::min(held.metadata.payload_size, payload_buffer.size());
+        (void) std::copy_n(held.payload.cbegin(), held.metadata.payload_size, payload_buffer.begin());
+        return held.metadata;
+    }
+
+    // MARK: Data members:
+
+    libcyphal::transport::can::IMedia&       inner_;
+    libcyphal::IExecutor&                    executor_;
+    FaultInjector&                           injector_;
+    FaultHoldQueue<HeldFrame, MaxHeldFrames> held_frames_;
+    libcyphal::IExecutor::Callback::Function pop_function_;
+    libcyphal::IExecutor::Callback::Any      release_callback_;
+
+};  // FaultyCanMedia
+
+}  // namespace Linux
+}  // namespace platform
+
+#endif  // PLATFORM_LINUX_FAULTY_CAN_MEDIA_HPP_INCLUDED
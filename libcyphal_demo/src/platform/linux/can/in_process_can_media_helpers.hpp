@@ -0,0 +1,96 @@
+// This software is distributed under the terms of the MIT License.
+// Copyright (C) OpenCyphal Development Team  <opencyphal.org>
+// Copyright Amazon.com Inc. or its affiliates.
+// SPDX-License-Identifier: MIT
+
+#ifndef PLATFORM_LINUX_IN_PROCESS_CAN_MEDIA_HELPERS_HPP_INCLUDED
+#define PLATFORM_LINUX_IN_PROCESS_CAN_MEDIA_HELPERS_HPP_INCLUDED
+
+#include "platform/posix/posix_executor_extension.hpp"
+
+#include <cetl/pf17/cetlpf.hpp>
+#include <cetl/rtti.hpp>
+#include <libcyphal/executor.hpp>
+#include <libcyphal/transport/can/media.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+
+namespace platform
+{
+namespace Linux
+{
+
+/// Parts shared by the in-process CAN media (see `SocketpairCanMedia` and `SimulatedCanMedia`),
+/// which have no kernel CAN stack underneath.
+///
+struct InProcessCanMediaHelpers
+{
+    /// Acceptance filters applied in software (on pop).
+    ///
+    /// Zero filters means "accept nothing", and more filters than `MaxFilters` means "accept everything"
+    /// (the same way a hardware controller with not enough filter banks would degrade).
+    ///
+    class SoftwareFilters final
+    {
+    public:
+        static constexpr std::size_t MaxFilters = 32;
+
+        void set(const libcyphal::transport::can::Filters filters) noexcept
+        {
+            count_ = filters.size();
+            if (count_ <= MaxFilters)
+            {
+                std::copy(filters.begin(), filters.end(), filters_.begin());
+            }
+        }
+
+        bool isAccepted(const std::uint32_t can_id) const noexcept
+        {
+            if (count_ > MaxFilters)
+            {
+                return true;
+            }
+            for (std::size_t i = 0; i < count_; ++i)
+            {
+                const libcyphal::transport::can::Filter& filter = filters_[i];  // NOLINT(*-constant-array-index)
+                if ((can_id & filter.mask) == (filter.id & filter.mask))
+                {
+                    return true;
+                }
+            }
+            return false;
+        }
+
+    private:
+        std::array<libcyphal::transport::can::Filter, MaxFilters> filters_{};
+        std::size_t                                               count_{MaxFilters + 1};  // Accept everything.
+
+    };  // SoftwareFilters
+
+    /// Registers the callback to be called when the file descriptor is ready,
+    /// or returns an empty one if the executor is not a POSIX one.
+    ///
+    CETL_NODISCARD static libcyphal::IExecutor::Callback::Any registerAwaitableCallback(
+        libcyphal::IExecutor&                                   executor,
+        libcyphal::IExecutor::Callback::Function&&              function,
+        const posix::IPosixExecutorExtension::Trigger::Variant& trigger)
+    {
+        auto* const posix_executor_ext = cetl::rtti_cast<posix::IPosixExecutorExtension*>(&executor);
+        if (nullptr == posix_executor_ext)
+        {
+            return {};
+        }
+
+        return posix_executor_ext->registerAwaitableCallback(std::move(function), trigger);
+    }
+
+};  // InProcessCanMediaHelpers
+
+}  // namespace Linux
+}  // namespace platform
+
+#endif  // PLATFORM_LINUX_IN_PROCESS_CAN_MEDIA_HELPERS_HPP_INCLUDED
@@ -0,0 +1,344 @@
+// This software is distributed under the terms of the MIT License.
+// Copyright (C) OpenCyphal Development Team  <opencyphal.org>
+// Copyright Amazon.com Inc. or its affiliates.
+// SPDX-License-Identifier: MIT
+
+#ifndef PLATFORM_LINUX_SIMULATED_CAN_MEDIA_HPP_INCLUDED
+#define PLATFORM_LINUX_SIMULATED_CAN_MEDIA_HPP_INCLUDED
+
+#include "in_process_can_media_helpers.hpp"
+#include "platform/can_bus_simulator.hpp"
+#include "platform/posix/posix_executor_extension.hpp"
+#include "platform/posix/posix_platform_error.hpp"
+
+#include <canard.h>
+#include <cetl/pf17/cetlpf.hpp>
+#include <cetl/pf20/cetlpf.hpp>
+#include <libcyphal/executor.hpp>
+#include <libcyphal/transport/can/media.hpp>
+#include <libcyphal/transport/errors.hpp>
+#include <libcyphal/transport/media_payload.hpp>
+#include <libcyphal/types.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cerrno>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <sys/eventfd.h>
+#include <unistd.h>
+#include <utility>
+
+namespace platform
+{
+namespace Linux
+{
+
+/// Drives a `CanBusSimulator` in real time (by the executor clock), so that in-process nodes could be connected
+/// to it via `SimulatedCanMedia`, and observe realistic frame timing (arbitration delays, frame durations, etc.).
+///
+/// The bus advances the simulation on every push and on its own executor callback, which is scheduled at the next
+/// bus event. Readiness of every node is signalled via a pair of `eventfd`s (RX frames available and TX space
+/// available), so the nodes await them as any other file descriptors of the epoll executor.
+/// Note that the executor clock has microsecond resolution, so the frame timing is quantized accordingly.
+///
+class SimulatedCanBus final
+{
+public:
+    SimulatedCanBus(libcyphal::IExecutor& executor, CanBusSimulator& simulator)
+        : executor_{executor}
+        , simulator_{simulator}
+    {
+    }
+
+    ~SimulatedCanBus()
+    {
+        tick_callback_.reset();
+        for (auto& port : ports_)
+        {
+            if (port.rx_fd >= 0)
+            {
+                (void) ::close(port.rx_fd);
+            }
+            if (port.tx_fd >= 0)
+            {
+                (void) ::close(port.tx_fd);
+            }
+        }
+    }
+
+    SimulatedCanBus(const SimulatedCanBus&)                = delete;
+    SimulatedCanBus(SimulatedCanBus&&) noexcept            = delete;
+    SimulatedCanBus& operator=(const SimulatedCanBus&)     = delete;
+    SimulatedCanBus& operator=(SimulatedCanBus&&) noexcept = delete;
+
+    /// Attaches a new node to the simulated bus.
+    ///
+    /// @return Index of the node (to be passed to `SimulatedCanMedia`), or a negated `errno`.
+    ///
+    int attach()
+    {
+        const int node = simulator_.attach();
+        if (node < 0)
+        {
+            return -ENOSPC;
+        }
+        Port& port = ports_[static_cast<std::size_t>(node)];
+        port.rx_fd = ::eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+        port.tx_fd = ::eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+        if ((port.rx_fd < 0) || (port.tx_fd < 0))
+        {
+            return -errno;
+        }
+
+        if (!tick_callback_.has_value())
+        {
+            tick_callback_ = executor_.registerCallback([this](const auto& arg) {
+                //
+                simulator_.advance(toNs(arg.approx_now));
+                sync();
+            });
+        }
+        return node;
+    }
+
+    CanBusSimulator& simulator() noexcept
+    {
+        return simulator_;
+    }
+
+    int rxReadyFd(const std::size_t node) const noexcept
+    {
+        return ports_[node].rx_fd;  // NOLINT(*-constant-array-index)
+    }
+
+    int txReadyFd(const std::size_t node) const noexcept
+    {
+        return ports_[node].tx_fd;  // NOLINT(*-constant-array-index)
+    }
+
+    /// @return `false` if the TX queue of the node is full (`txReadyFd` will be signalled once there is space).
+    ///
+    bool push(const std::size_t node, const CanBusSimulator::Frame& frame)
+    {
+        const std::uint64_t now_ns = toNs(executor_.now());
+        simulator_.advance(now_ns);
+        if (!simulator_.push(node, now_ns, frame))
+        {
+            Port& port      = ports_[node];  // NOLINT(*-constant-array-index)
+            port.is_tx_full = true;
+            drain(port.tx_fd);
+            return false;
+        }
+        simulator_.advance(now_ns);  // Starts transmission right away if the bus is idle.
+        sync();
+        return true;
+    }
+
+    /// @return `false` if there are no received frames (`rxReadyFd` will be signalled once there are).
+    ///
+    bool pop(const std::size_t node, CanBusSimulator::Frame& frame, libcyphal::TimePoint& timestamp)
+    {
+        std::uint64_t timestamp_ns = 0;
+        if (!simulator_.pop(node, frame, timestamp_ns))
+        {
+            drain(rxReadyFd(node));
+            return false;
+        }
+        timestamp = libcyphal::TimePoint{std::chrono::duration_cast<libcyphal::Duration>(  //
+            std::chrono::nanoseconds{timestamp_ns})};
+        return true;
+    }
+
+private:
+    struct Port final
+    {
+        int  rx_fd{-1};
+        int  tx_fd{-1};
+        bool is_tx_full{false};
+    };
+
+    static std::uint64_t toNs(const libcyphal::TimePoint time_point) noexcept
+    {
+        const auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(time_point.time_since_epoch());
+        return static_cast<std::uint64_t>(ns.count());
+    }
+
+    static void signal(const int fd) noexcept
+    {
+        const std::uint64_t one = 1;
+        (void) ::write(fd, &one, sizeof(one));
+    }
+
+    static void drain(const int fd) noexcept
+    {
+        std::uint64_t counter = 0;
+        (void) ::read(fd, &counter, sizeof(counter));
+    }
+
+    /// Signals the nodes which became ready, and schedules the next bus event.
+    ///
+    void sync()
+    {
+        for (std::size_t node = 0; node < ports_.size(); ++node)
+        {
+            Port& port = ports_[node];  // NOLINT(*-constant-array-index)
+            if (port.rx_fd < 0)
+            {
+                break;
+            }
+            if (simulator_.rxPending(node) > 0)
+            {
+                signal(port.rx_fd);
+            }
+            if (port.is_tx_full && (simulator_.txFree(node) > 0))
+            {
+                port.is_tx_full = false;
+                signal(port.tx_fd);
+            }
+        }
+
+        const std::uint64_t next_ns = simulator_.nextEventNs();
+        if ((next_ns != CanBusSimulator::Never) && tick_callback_.has_value())
+        {
+            // Round up - the executor clock is coarser than the simulation one, and an early tick would be wasted.
+            const auto next_time = std::chrono::duration_cast<libcyphal::Duration>(
+                std::chrono::nanoseconds{next_ns} + libcyphal::Duration{1} - std::chrono::nanoseconds{1});
+            (void) tick_callback_.schedule(
+                libcyphal::IExecutor::Callback::Schedule::Once{libcyphal::TimePoint{next_time}});
+        }
+    }
+
+    // MARK: Data members:
+
+    libcyphal::IExecutor&                       executor_;
+    CanBusSimulator&                            simulator_;
+    std::array<Port, CanBusSimulator::MaxNodes> ports_{};
+    libcyphal::IExecutor::Callback::Any         tick_callback_;
+
+};  // SimulatedCanBus
+
+// MARK: -
+
+/// Implements the CAN media of a node attached to `SimulatedCanBus`.
+///
+/// Acceptance filters are applied in software on pop. RX timestamps are the ends of the frames on the simulated bus.
+///
+class SimulatedCanMedia final : public libcyphal::transport::can::IMedia
+{
+public:
+    /// @param node The node index returned by `SimulatedCanBus::attach`.
+    /// @param mtu  Either `CANARD_MTU_CAN_CLASSIC` or `CANARD_MTU_CAN_FD` (then frames are sent in the FD format).
+    ///
+    SimulatedCanMedia(libcyphal::IExecutor&       executor,
+                      SimulatedCanBus&            bus,
+                      const std::size_t           node,
+                      cetl::pmr::memory_resource& tx_mr,
+                      const std::size_t           mtu = CANARD_MTU_CAN_CLASSIC)
+        : executor_{executor}
+        , bus_{bus}
+        , node_{node}
+        , tx_mr_{tx_mr}
+        , mtu_{mtu}
+    {
+    }
+
+    ~SimulatedCanMedia() = default;
+
+    SimulatedCanMedia(const SimulatedCanMedia&)                = delete;
+    SimulatedCanMedia(SimulatedCanMedia&&) noexcept            = delete;
+    SimulatedCanMedia& operator=(const SimulatedCanMedia&)     = delete;
+    SimulatedCanMedia& operator=(SimulatedCanMedia&&) noexcept = delete;
+
+private:
+    using Filters = libcyphal::transport::can::Filters;
+    using Helpers = InProcessCanMediaHelpers;
+
+    // MARK: - IMedia
+
+    std::size_t getMtu() const noexcept override
+    {
+        return mtu_;
+    }
+
+    cetl::optional<libcyphal::transport::MediaFailure> setFilters(const Filters filters) noexcept override
+    {
+        filters_.set(filters);
+        return cetl::nullopt;
+    }
+
+    PushResult::Type push(const libcyphal::TimePoint /* deadline */,
+                          const libcyphal::transport::can::CanId can_id,
+                          libcyphal::transport::MediaPayload&    payload) noexcept override
+    {
+        const auto             data = payload.getSpan();
+        CanBusSimulator::Frame frame{};
+        frame.can_id = can_id;
+        frame.is_fd  = mtu_ > CANARD_MTU_CAN_CLASSIC;
+        frame.size   = static_cast<std::uint8_t>(std::min(data.size(), frame.data.size()));
+        (void) std::memcpy(frame.data.data(), data.data(), frame.size);
+        if (!bus_.push(node_, frame))
+        {
+            return PushResult::Success{false};  // Try again once there is space (see `registerPushCallback`).
+        }
+
+        // Payload is not needed anymore, so return memory asap.
+        payload.reset();
+        return PushResult::Success{true};
+    }
+
+    CETL_NODISCARD PopResult::Type pop(const cetl::span<cetl::byte> payload_buffer) noexcept override
+    {
+        CanBusSimulator::Frame frame{};
+        libcyphal::TimePoint   timestamp{};
+        while (bus_.pop(node_, frame, timestamp))
+        {
+            if (filters_.isAccepted(frame.can_id))
+            {
+                const std::size_t length = std::min<std::size_t>(frame.size, payload_buffer.size());
+                (void) std::memcpy(payload_buffer.data(), frame.data.data(), length);
+                return PopResult::Metadata{timestamp, frame.can_id, length};
+            }
+            // Rejected by the filters - the same as if it was never received, so try the next one.
+        }
+        return cetl::nullopt;
+    }
+
+    CETL_NODISCARD libcyphal::IExecutor::Callback::Any registerPushCallback(
+        libcyphal::IExecutor::Callback::Function&& function) override
+    {
+        using ReadableTrigger = posix::IPosixExecutorExtension::Trigger::Readable;
+        const ReadableTrigger trigger{bus_.txReadyFd(node_)};
+        return Helpers::registerAwaitableCallback(executor_, std::move(function), trigger);
+    }
+
+    CETL_NODISCARD libcyphal::IExecutor::Callback::Any registerPopCallback(
+        libcyphal::IExecutor::Callback::Function&& function) override
+    {
+        using ReadableTrigger = posix::IPosixExecutorExtension::Trigger::Readable;
+        const ReadableTrigger trigger{bus_.rxReadyFd(node_)};
+        return Helpers::registerAwaitableCallback(executor_, std::move(function), trigger);
+    }
+
+    cetl::pmr::memory_resource& getTxMemoryResource() override
+    {
+        return tx_mr_;
+    }
+
+    // MARK: Data members:
+
+    libcyphal::IExecutor&       executor_;
+    SimulatedCanBus&            bus_;
+    std::size_t                 node_;
+    cetl::pmr::memory_resource& tx_mr_;
+    std::size_t                 mtu_;
+    Helpers::SoftwareFilters    filters_;  // Accept everything until configured.
+
+};  // SimulatedCanMedia
+
+}  // namespace Linux
+}  // namespace platform
+
+#endif  // PLATFORM_LINUX_SIMULATED_CAN_MEDIA_HPP_INCLUDED
@@ -0,0 +1,349 @@
+// This software is distributed under the terms of the MIT License.
+// Copyright (C) OpenCyphal Development Team  <opencyphal.org>
+// Copyright Amazon.com Inc. or its affiliates.
+// SPDX-License-Identifier: MIT
+
+#ifndef PLATFORM_LINUX_SOCKETPAIR_CAN_MEDIA_HPP_INCLUDED
+#define PLATFORM_LINUX_SOCKETPAIR_CAN_MEDIA_HPP_INCLUDED
+
+#include "in_process_can_media_helpers.hpp"
+#include "platform/posix/posix_executor_extension.hpp"
+#include "platform/posix/posix_platform_error.hpp"
+
+#include <canard.h>
+#include <cetl/pf17/cetlpf.hpp>
+#include <cetl/pf20/cetlpf.hpp>
+#include <libcyphal/executor.hpp>
+#include <libcyphal/transport/can/media.hpp>
+#include <libcyphal/transport/errors.hpp>
+#include <libcyphal/transport/media_payload.hpp>
+#include <libcyphal/types.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <linux/can.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#include <utility>
+
+namespace platform
+{
+namespace Linux
+{
+
+/// Implements an unprivileged in-process CAN bus made of `AF_UNIX`/`SOCK_SEQPACKET` socket pairs -
+/// f.e. for reproducible multi-node benchmarks where `vcan` is not available (it requires root and kernel modules).
+///
+/// Each attached node gets its end of a socket pair (see `SocketpairCanMedia`); the other end stays at the bus,
+/// which relays every frame written by a node to all other nodes (there is no loopback to the sender).
+/// Frames are `struct canfd_frame` records, one per datagram. The relay is driven by the same executor
+/// as the nodes (via the awaitable readable-fd callbacks), so the frames flow in the order of the executor spins.
+/// A frame which doesn't fit into a receiver socket buffer is dropped for that receiver (and counted).
+///
+class SocketpairCanBus final
+{
+public:
+    static constexpr std::size_t MaxNodes = 8;
+
+    explicit SocketpairCanBus(libcyphal::IExecutor& executor)
+        : executor_{executor}
+    {
+    }
+
+    ~SocketpairCanBus()
+    {
+        for (auto& port : ports_)
+        {
+            port.callback.reset();
+            if (port.bus_fd >= 0)
+            {
+                (void) ::close(port.bus_fd);
+            }
+        }
+    }
+
+    SocketpairCanBus(const SocketpairCanBus&)                = delete;
+    SocketpairCanBus(SocketpairCanBus&&) noexcept            = delete;
+    SocketpairCanBus& operator=(const SocketpairCanBus&)     = delete;
+    SocketpairCanBus& operator=(SocketpairCanBus&&) noexcept = delete;
+
+    /// Attaches a new node to the bus.
+    ///
+    /// @return The node end of the socket pair (to be owned by `SocketpairCanMedia`), or a negated `errno`.
+    ///
+    int attach()
+    {
+        if (count_ >= MaxNodes)
+        {
+            return -ENOSPC;
+        }
+        std::array<int, 2> fds{};
+        if (::socketpair(AF_UNIX, SOCK_SEQPACKET | SOCK_NONBLOCK | SOCK_CLOEXEC, 0, fds.data()) != 0)
+        {
+            return -errno;
+        }
+
+        const std::size_t index = count_;
+        Port&             port  = ports_[index];  // NOLINT(*-constant-array-index)
+        port.bus_fd             = fds[1];
+        port.callback           = registerReadableCallback(fds[1], [this, index](const auto&) {
+            //
+            relayFrom(index);
+        });
+        if (!port.callback.has_value())
+        {
+            (void) ::close(fds[0]);
+            (void) ::close(fds[1]);
+            port.bus_fd = -1;
+            return -ENOTSUP;
+        }
+        ++count_;
+        return fds[0];
+    }
+
+    /// Number of frames relayed from a sender to (all) receivers.
+    std::uint64_t relayedFrames() const noexcept
+    {
+        return relayed_frames_;
+    }
+
+    /// Number of frame deliveries dropped because of a full receiver socket buffer.
+    std::uint64_t droppedFrames() const noexcept
+    {
+        return dropped_frames_;
+    }
+
+private:
+    struct Port final
+    {
+        int                                 bus_fd{-1};
+        libcyphal::IExecutor::Callback::Any callback;
+    };
+
+    CETL_NODISCARD libcyphal::IExecutor::Callback::Any registerReadableCallback(
+        const int                                  fd,
+        libcyphal::IExecutor::Callback::Function&& function)
+    {
+        using ReadableTrigger = posix::IPosixExecutorExtension::Trigger::Readable;
+        return InProcessCanMediaHelpers::registerAwaitableCallback(executor_, std::move(function), ReadableTrigger{fd});
+    }
+
+    void relayFrom(const std::size_t sender)
+    {
+        const int sender_fd = ports_[sender].bus_fd;  // NOLINT(*-constant-array-index)
+
+        ::canfd_frame frame{};
+        ssize_t       size = 0;
+        while ((size = ::recv(sender_fd, &frame, sizeof(frame), MSG_DONTWAIT)) > 0)
+        {
+            for (std::size_t index = 0; index < count_; ++index)
+            {
+                if (index == sender)
+                {
+                    continue;
+                }
+                const int receiver_fd = ports_[index].bus_fd;  // NOLINT(*-constant-array-index)
+                if (::send(receiver_fd, &frame, static_cast<std::size_t>(size), MSG_DONTWAIT | MSG_NOSIGNAL) != size)
+                {
+                    ++dropped_frames_;
+                }
+            }
+            ++relayed_frames_;
+        }
+    }
+
+    // MARK: Data members:
+
+    libcyphal::IExecutor&      executor_;
+    std::array<Port, MaxNodes> ports_{};
+    std::size_t                count_{0};
+    std::uint64_t              relayed_frames_{0};
+    std::uint64_t              dropped_frames_{0};
+
+};  // SocketpairCanBus
+
+// MARK: -
+
+/// Implements the CAN media on top of a node end of `SocketpairCanBus`.
+///
+/// The media owns two descriptors of the same socket (the second one is a `dup`), so that push and pop callbacks
+/// could be registered at the epoll executor separately (like `CanMedia` does with two SocketCAN sockets).
+/// Acceptance filters are applied in software on pop.
+///
+class SocketpairCanMedia final : public libcyphal::transport::can::IMedia
+{
+public:
+    /// @param node_fd The node end of the bus socket pair (see `SocketpairCanBus::attach`); the media takes ownership.
+    /// @param mtu     Either `CANARD_MTU_CAN_CLASSIC` or `CANARD_MTU_CAN_FD`.
+    ///
+    CETL_NODISCARD static cetl::variant<SocketpairCanMedia, libcyphal::transport::PlatformError> make(
+        libcyphal::IExecutor&       executor,
+        const int                   node_fd,
+        cetl::pmr::memory_resource& tx_mr,
+        const std::size_t           mtu = CANARD_MTU_CAN_CLASSIC)
+    {
+        if (node_fd < 0)
+        {
+            return libcyphal::transport::PlatformError{posix::PosixPlatformError{-node_fd}};
+        }
+        const int tx_fd = ::dup(node_fd);
+        if (tx_fd < 0)
+        {
+            const int error_code = errno;
+            (void) ::close(node_fd);
+            return libcyphal::transport::PlatformError{posix::PosixPlatformError{error_code}};
+        }
+        return SocketpairCanMedia{executor, node_fd, tx_fd, tx_mr, mtu};
+    }
+
+    ~SocketpairCanMedia()
+    {
+        if (rx_fd_ >= 0)
+        {
+            (void) ::close(rx_fd_);
+        }
+        if (tx_fd_ >= 0)
+        {
+            (void) ::close(tx_fd_);
+        }
+    }
+
+    SocketpairCanMedia(const SocketpairCanMedia&)                = delete;
+    SocketpairCanMedia& operator=(const SocketpairCanMedia&)     = delete;
+    SocketpairCanMedia* operator=(SocketpairCanMedia&&) noexcept = delete;
+
+    SocketpairCanMedia(SocketpairCanMedia&& other) noexcept
+        : executor_{other.executor_}
+        , rx_fd_{std::exchange(other.rx_fd_, -1)}
+        , tx_fd_{std::exchange(other.tx_fd_, -1)}
+        , tx_mr_{other.tx_mr_}
+        , mtu_{other.mtu_}
+        , filters_{other.filters_}
+    {
+    }
+
+private:
+    using Filters = libcyphal::transport::can::Filters;
+    using Helpers = InProcessCanMediaHelpers;
+
+    SocketpairCanMedia(libcyphal::IExecutor&       executor,
+                       const int                   rx_fd,
+                       const int                   tx_fd,
+                       cetl::pmr::memory_resource& tx_mr,
+                       const std::size_t           mtu)
+        : executor_{executor}
+        , rx_fd_{rx_fd}
+        , tx_fd_{tx_fd}
+        , tx_mr_{tx_mr}
+        , mtu_{mtu}
+    {
+    }
+
+    // MARK: - IMedia
+
+    std::size_t getMtu() const noexcept override
+    {
+        return mtu_;
+    }
+
+    cetl::optional<libcyphal::transport::MediaFailure> setFilters(const Filters filters) noexcept override
+    {
+        filters_.set(filters);
+        return cetl::nullopt;
+    }
+
+    PushResult::Type push(const libcyphal::TimePoint /* deadline */,
+                          const libcyphal::transport::can::CanId can_id,
+                          libcyphal::transport::MediaPayload&    payload) noexcept override
+    {
+        const auto    data = payload.getSpan();
+        ::canfd_frame frame{};
+        frame.can_id = (can_id & CAN_EFF_MASK) | CAN_EFF_FLAG;
+        frame.len    = static_cast<std::uint8_t>(std::min(data.size(), sizeof(frame.data)));
+        (void) std::memcpy(frame.data, data.data(), frame.len);
+
+        const std::size_t frame_size = (mtu_ > CANARD_MTU_CAN_CLASSIC) ? CANFD_MTU : CAN_MTU;
+        if (::send(tx_fd_, &frame, frame_size, MSG_DONTWAIT | MSG_NOSIGNAL) < 0)
+        {
+            const int error_code = errno;
+            if ((error_code == EAGAIN) || (error_code == EWOULDBLOCK) || (error_code == ENOBUFS))
+            {
+                return PushResult::Success{false};  // Try again once writable (see `registerPushCallback`).
+            }
+            return libcyphal::transport::PlatformError{posix::PosixPlatformError{error_code}};
+        }
+
+        // Payload is not needed anymore, so return memory asap.
+        payload.reset();
+        return PushResult::Success{true};
+    }
+
+    CETL_NODISCARD PopResult::Type pop(const cetl::span<cetl::byte> payload_buffer) noexcept override
+    {
+        ::canfd_frame frame{};
+        while (true)
+        {
+            const ssize_t size = ::recv(rx_fd_, &frame, sizeof(frame), MSG_DONTWAIT);
+            if (size < 0)
+            {
+                const int error_code = errno;
+                if ((error_code == EAGAIN) || (error_code == EWOULDBLOCK))
+                {
+                    return cetl::nullopt;
+                }
+                return libcyphal::transport::PlatformError{posix::PosixPlatformError{error_code}};
+            }
+            if (size == 0)
+            {
+                return cetl::nullopt;  // The bus is gone.
+            }
+
+            const std::uint32_t can_id = frame.can_id & CAN_EFF_MASK;
+            if (((frame.can_id & CAN_EFF_FLAG) != 0) && filters_.isAccepted(can_id))
+            {
+                const std::size_t length = std::min<std::size_t>(frame.len, payload_buffer.size());
+                (void) std::memcpy(payload_buffer.data(), frame.data, length);
+                return PopResult::Metadata{executor_.now(), can_id, length};
+            }
+            // Rejected by the filters - the same as if it was never received, so try the next one.
+        }
+    }
+
+    CETL_NODISCARD libcyphal::IExecutor::Callback::Any registerPushCallback(
+        libcyphal::IExecutor::Callback::Function&& function) override
+    {
+        using WritableTrigger = posix::IPosixExecutorExtension::Trigger::Writable;
+        return Helpers::registerAwaitableCallback(executor_, std::move(function), WritableTrigger{tx_fd_});
+    }
+
+    CETL_NODISCARD libcyphal::IExecutor::Callback::Any registerPopCallback(
+        libcyphal::IExecutor::Callback::Function&& function) override
+    {
+        using ReadableTrigger = posix::IPosixExecutorExtension::Trigger::Readable;
+        return Helpers::registerAwaitableCallback(executor_, std::move(function), ReadableTrigger{rx_fd_});
+    }
+
+    cetl::pmr::memory_resource& getTxMemoryResource() override
+    {
+        return tx_mr_;
+    }
+
+    // MARK: Data members:
+
+    libcyphal::IExecutor&       executor_;
+    int                         rx_fd_;
+    int                         tx_fd_;
+    cetl::pmr::memory_resource& tx_mr_;
+    std::size_t                 mtu_;
+    Helpers::SoftwareFilters    filters_;  // Accept everything until configured.
+
+};  // SocketpairCanMedia
+
+}  // namespace Linux
+}  // namespace platform
+
+#endif  // PLATFORM_LINUX_SOCKETPAIR_CAN_MEDIA_HPP_INCLUDED
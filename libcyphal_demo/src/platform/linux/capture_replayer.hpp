@@ -0,0 +1,265 @@
+// This software is distributed under the terms of the MIT License.
+// Copyright (C) OpenCyphal Development Team  <opencyphal.org>
+// Copyright Amazon.com Inc. or its affiliates.
+// SPDX-License-Identifier: MIT
+
+#ifndef PLATFORM_LINUX_CAPTURE_REPLAYER_HPP_INCLUDED
+#define PLATFORM_LINUX_CAPTURE_REPLAYER_HPP_INCLUDED
+
+#include "capture.h"
+#include "socketcan.h"
+#include "udp.h"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <poll.h>
+#include <time.h>
+#include <tuple>
+
+namespace platform
+{
+namespace Linux
+{
+
+/// Injects the traffic of a capture file (see `capture.h`) into the network, so that a node under test receives
+/// exactly what the captured node has received - with the original timing, or accelerated.
+///
+/// UDP datagrams are sent to their original multicast group and port via the given local interface,
+/// and CAN frames are sent to the CAN interfaces in the ascending order of the captured interface indexes:
+/// the bus with the lowest index goes to the first given CAN interface, and so on (modulo the number of them),
+/// so the buses are mapped the same way in every replay. Records which have no interface to go to are skipped.
+///
+/// The pacing is done with absolute sleeps against `CLOCK_MONOTONIC`, so the replay never drifts; if the replayer
+/// falls behind (f.e. the network is saturated), it catches up without sleeping, and reports the lag.
+///
+class CaptureReplayer final
+{
+public:
+    static constexpr std::size_t   MaxCanIfaces   = 4;
+    static constexpr std::size_t   MaxPayloadSize = CAPTURE_MAX_PAYLOAD_SIZE;
+    static constexpr std::uint64_t SendTimeoutUs  = 10000;  // 10 milliseconds
+
+    struct Stats
+    {
+        std::uint64_t udp_datagrams;
+        std::uint64_t can_frames;
+        std::uint64_t skipped;      ///< Records without a matching interface.
+        std::uint64_t send_errors;  ///< Including timeouts of the full socket buffers.
+        std::uint64_t max_lag_us;   ///< The worst lateness of a record relative to its (scaled) capture time.
+        std::uint64_t elapsed_us;
+    };
+
+    CaptureReplayer() = default;
+
+    ~CaptureReplayer()
+    {
+        ::udpTxClose(&udp_tx_);
+        for (std::size_t i = 0; i < can_ifaces_count_; ++i)
+        {
+            ::socketcanClose(can_fds_[i]);  // NOLINT(*-constant-array-index)
+        }
+    }
+
+    CaptureReplayer(const CaptureReplayer&)                = delete;
+    CaptureReplayer(CaptureReplayer&&) noexcept            = delete;
+    CaptureReplayer& operator=(const CaptureReplayer&)     = delete;
+    CaptureReplayer& operator=(CaptureReplayer&&) noexcept = delete;
+
+    /// Sets the local interface to send the UDP datagrams from (f.e. 0x7F000001 for the loopback).
+    ///
+    /// @return Zero on success, otherwise a negative error code.
+    ///
+    int setUdpIface(const std::uint32_t local_iface_address)
+    {
+        ::udpTxClose(&udp_tx_);
+        return ::udpTxInit(&udp_tx_, local_iface_address);
+    }
+
+    /// Adds the next CAN interface; the first one receives the frames captured on the bus with the lowest
+    /// interface index, and so on.
+    ///
+    /// @return Zero on success, otherwise a negative error code.
+    ///
+    int addCanIface(const char* const iface_name, const bool can_fd)
+    {
+        if (can_ifaces_count_ >= MaxCanIfaces)
+        {
+            return -ENOSPC;
+        }
+        const SocketCANFD fd = ::socketcanOpen(iface_name, can_fd);
+        if (fd < 0)
+        {
+            return fd;
+        }
+        can_fds_[can_ifaces_count_++] = fd;  // NOLINT(*-constant-array-index)
+        return 0;
+    }
+
+    /// Replays the whole capture file.
+    ///
+    /// @param speed Scale of the capture time: 1 is the original speed, 2 is twice as fast, and so on;
+    ///              zero (or negative) replays as fast as the network allows.
+    /// @param stop Optional flag to abort the replay from another thread.
+    /// @return Zero on success, otherwise a negative error code (of the capture reader).
+    ///
+    int replay(const char* const path, const double speed, Stats& stats, const std::atomic<bool>* const stop = nullptr)
+    {
+        stats = Stats{};
+
+        if (const int err = mapCanIfaces(path))
+        {
+            return err;
+        }
+        CaptureReader reader{};
+        if (const int err = ::captureReaderOpen(&reader, path))
+        {
+            return err;
+        }
+
+        const std::uint64_t started_us = nowUs();
+        CaptureRecord       record{};
+        int                 result = 0;
+        while ((stop == nullptr) || !stop->load(std::memory_order_relaxed))
+        {
+            result = ::captureReaderNext(&reader, &record, payload_.size(), payload_.data());
+            if (result <= 0)
+            {
+                break;
+            }
+
+            if (speed > 0.0)
+            {
+                const double        offset_us = static_cast<double>(record.timestamp_us) / speed;
+                const std::uint64_t target_us = started_us + static_cast<std::uint64_t>(offset_us);
+                const std::uint64_t now_us    = nowUs();
+                if (now_us < target_us)
+                {
+                    sleepUntilUs(target_us);
+                }
+                else
+                {
+                    stats.max_lag_us = std::max(stats.max_lag_us, now_us - target_us);
+                }
+            }
+
+            send(record, stats);
+        }
+        stats.elapsed_us = nowUs() - started_us;
+
+        ::captureReaderClose(&reader);
+        return (result < 0) ? result : 0;
+    }
+
+private:
+    using CanIfaceSlots = std::array<std::uint8_t, UINT8_MAX + 1U>;
+
+    static std::uint64_t nowUs() noexcept
+    {
+        struct timespec ts{};
+        (void) ::clock_gettime(CLOCK_MONOTONIC, &ts);
+        return (static_cast<std::uint64_t>(ts.tv_sec) * 1000000ULL) + (static_cast<std::uint64_t>(ts.tv_nsec) / 1000U);
+    }
+
+    static void sleepUntilUs(const std::uint64_t deadline_us) noexcept
+    {
+        struct timespec ts{};
+        ts.tv_sec  = static_cast<time_t>(deadline_us / 1000000ULL);
+        ts.tv_nsec = static_cast<long>((deadline_us % 1000000ULL) * 1000U);  // NOLINT(google-runtime-int)
+        while (::clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &ts, nullptr) == EINTR)
+        {
+        }
+    }
+
+    /// Reads through the capture to find all CAN interface indexes, and numbers them in the ascending order.
+    ///
+    int mapCanIfaces(const char* const path)
+    {
+        CaptureReader reader{};
+        if (const int err = ::captureReaderOpen(&reader, path))
+        {
+            return err;
+        }
+        std::array<bool, std::tuple_size<CanIfaceSlots>::value> is_seen{};
+        CaptureRecord                                          record{};
+        int                                                    result = 0;
+        while ((result = ::captureReaderNext(&reader, &record, 0, nullptr)) > 0)
+        {
+            is_seen[record.iface] = is_seen[record.iface] || (record.kind == CAPTURE_KIND_CAN);
+        }
+        ::captureReaderClose(&reader);
+
+        std::size_t ordinal = 0;
+        for (std::size_t i = 0; i < is_seen.size(); ++i)
+        {
+            can_iface_slots_[i] = static_cast<std::uint8_t>(ordinal);  // NOLINT(*-constant-array-index)
+            ordinal += is_seen[i] ? 1U : 0U;
+        }
+        return (result < 0) ? result : 0;
+    }
+
+    void send(const CaptureRecord& record, Stats& stats)
+    {
+        const std::size_t size = std::min<std::size_t>(record.size, payload_.size());
+        if (record.kind == CAPTURE_KIND_UDP)
+        {
+            if (udp_tx_.fd < 0)
+            {
+                ++stats.skipped;
+                return;
+            }
+            std::int16_t result = ::udpTxSend(&udp_tx_, record.id, record.port, 0, size, payload_.data());
+            if (result == 0)  // The socket buffer is full; give the receivers a chance to drain it.
+            {
+                struct pollfd pfd{udp_tx_.fd, POLLOUT, 0};
+                if (::poll(&pfd, 1, static_cast<int>(SendTimeoutUs / 1000U)) > 0)
+                {
+                    result = ::udpTxSend(&udp_tx_, record.id, record.port, 0, size, payload_.data());
+                }
+            }
+            if (result > 0)
+            {
+                ++stats.udp_datagrams;
+            }
+            else
+            {
+                ++stats.send_errors;
+            }
+            return;
+        }
+        if ((record.kind == CAPTURE_KIND_CAN) && (can_ifaces_count_ > 0))
+        {
+            CanardFrame frame{};
+            frame.extended_can_id  = record.id;
+            frame.payload.size     = size;
+            frame.payload.data     = payload_.data();
+            const std::size_t slot = can_iface_slots_[record.iface] % can_ifaces_count_;
+            const SocketCANFD fd   = can_fds_[slot];  // NOLINT(*-constant-array-index)
+            if (::socketcanPush(fd, &frame, SendTimeoutUs) > 0)
+            {
+                ++stats.can_frames;
+            }
+            else
+            {
+                ++stats.send_errors;
+            }
+            return;
+        }
+        ++stats.skipped;
+    }
+
+    UDPTxHandle                              udp_tx_{-1};
+    std::array<SocketCANFD, MaxCanIfaces>    can_fds_{};
+    std::size_t                              can_ifaces_count_{0};
+    CanIfaceSlots                            can_iface_slots_{};  ///< Indexed by the captured interface index.
+    std::array<std::uint8_t, MaxPayloadSize> payload_{};
+
+};  // CaptureReplayer
+
+}  // namespace Linux
+}  // namespace platform
+
+#endif  // PLATFORM_LINUX_CAPTURE_REPLAYER_HPP_INCLUDED
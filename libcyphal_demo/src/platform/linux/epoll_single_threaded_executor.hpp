@@ -7,8 +7,12 @@
 #ifndef PLATFORM_LINUX_EPOLL_SINGLE_THREADED_EXECUTOR_HPP_INCLUDED
 #define PLATFORM_LINUX_EPOLL_SINGLE_THREADED_EXECUTOR_HPP_INCLUDED
 
+#include "platform/linux/perf_counters.hpp"
+#include "platform/linux/tsc_clock.hpp"
 #include "platform/posix/posix_executor_extension.hpp"
 #include "platform/posix/posix_platform_error.hpp"
+#include "platform/tracer.hpp"
+#include "usdt.h"
 
 #include <cetl/pf17/cetlpf.hpp>
 #include <cetl/rtti.hpp>
@@ -28,6 +32,7 @@
 #include <limits>
 #include <sys/epoll.h>
 #include <thread>
+#include <time.h>
 #include <unistd.h>
 #include <utility>
 
@@ -38,6 +43,12 @@ namespace Linux
 
 /// @brief Defines Linux platform specific single-threaded executor based on `epoll` mechanism.
 ///
+/// Besides, the executor can account wall and thread CPU time of each registered callback (see `getTopCallbacks`).
+/// Each callback is wrapped at registration, and its original function is kept in one of the fixed accounting
+/// slots (so no extra memory is allocated). Callbacks registered beyond the slots capacity are just not accounted.
+/// The time is measured only while the accounting is enabled (see `setCallbackAccounting`), b/c the thread CPU
+/// clock is a real syscall (not vDSO) - so it's disabled by default, and the wrapper costs just an extra call.
+///
 class EpollSingleThreadedExecutor final : public libcyphal::platform::SingleThreadedExecutor,
                                           public posix::IPosixExecutorExtension
 {
@@ -63,6 +74,128 @@ public:
 
     using PollFailure = cetl::variant<libcyphal::transport::PlatformError, libcyphal::ArgumentError>;
 
+    /// Cumulative execution times of a single registered callback.
+    ///
+    struct CallbackStats final
+    {
+        const void*   origin;       ///< Return address into the code which has registered the callback.
+        int           fd;           ///< File descriptor of an awaitable callback, or -1.
+        std::uint64_t calls;        ///< Number of executions.
+        std::uint64_t wall_ns;      ///< Total wall time.
+        std::uint64_t cpu_ns;       ///< Total thread CPU time (excludes time when the thread is preempted).
+        std::uint64_t max_wall_ns;  ///< Longest single execution.
+
+        PerfCounters::Totals perf;  ///< Hardware events, if `PerfCounters` are open (counted independently of time).
+    };
+
+    static constexpr std::size_t MaxAccountedCallbacks = 64;
+
+    /// Maximum number of ready file descriptors taken by a single `pollAwaitableResourcesFor` call;
+    /// the rest stay ready, and are taken by the next call(s).
+    static constexpr int MaxEpollEvents = 16;
+
+    /// Switches the executor clock to the invariant TSC (see `TscClock`), if the CPU supports it.
+    /// The TSC clock is aligned to the default (`CLOCK_MONOTONIC` based) one, so the switch could be done at any time.
+    ///
+    /// @return `true` if the TSC clock is in use.
+    ///
+    bool useTscClock() noexcept
+    {
+        return tsc_clock_.calibrate();
+    }
+
+    /// Enables or disables measuring of the callbacks execution times (disabled by default).
+    /// Only the callbacks registered afterwards are moved into the accounting slots, so it should be enabled before
+    /// anything is registered. While both this and `PerfCounters` are disabled, callbacks are registered as is.
+    ///
+    void setCallbackAccounting(const bool is_enabled) noexcept
+    {
+        is_accounting_ = is_enabled;
+    }
+
+    bool isCallbackAccounting() const noexcept
+    {
+        return is_accounting_;
+    }
+
+    // MARK: - IExecutor
+
+    CETL_NODISCARD libcyphal::TimePoint now() const noexcept override
+    {
+        if (!tsc_clock_.isCalibrated())
+        {
+            return Base::now();
+        }
+        const std::chrono::nanoseconds ns{tsc_clock_.nowNs()};
+        return libcyphal::TimePoint{std::chrono::duration_cast<libcyphal::Duration>(ns)};
+    }
+
+    CETL_NODISCARD Callback::Any registerCallback(Callback::Function&& function) override
+    {
+        std::size_t   slot_index = NoSlot;
+        auto          accounted  = makeAccounted(std::move(function), __builtin_return_address(0), slot_index);
+        AwaitableNode new_cb_node{*this, std::move(accounted), slot_index};
+
+        insertCallbackNode(new_cb_node);
+        return {std::move(new_cb_node)};
+    }
+
+    /// Gets stats of the currently registered callbacks which have consumed the most of CPU time so far
+    /// (or which have any hardware events counted, if the time accounting is disabled).
+    ///
+    /// @return Number of the filled entries (in descending order of the CPU time).
+    ///
+    template <std::size_t N>
+    std::size_t getTopCallbacks(std::array<CallbackStats, N>& top) const noexcept
+    {
+        std::size_t count = 0;
+        for (const auto& slot : accounted_)
+        {
+            if (!slot.is_used || ((slot.stats.calls == 0) && (slot.stats.perf.calls == 0)))
+            {
+                continue;
+            }
+            // Insertion sort - the top is expected to be short.
+            std::size_t pos = count;
+            while ((pos > 0) && (top[pos - 1].cpu_ns < slot.stats.cpu_ns))
+            {
+                if (pos < N)
+                {
+                    top[pos] = top[pos - 1];
+                }
+                --pos;
+            }
+            if (pos < N)
+            {
+                top[pos] = slot.stats;
+                count += (count < N) ? 1 : 0;
+            }
+        }
+        return count;
+    }
+
+    /// Gets number of callbacks which were registered without accounting (b/c all slots were in use).
+    ///
+    std::size_t unaccountedCallbacks() const noexcept
+    {
+        return unaccounted_callbacks_;
+    }
+
+    /// Hides the base one just to trace the whole callbacks execution
+    /// (see `platform::Tracer`, `PerfCounters` and the `spin_once_*` USDT probes).
+    ///
+    CETL_NODISCARD SpinResult spinOnce()
+    {
+        PLATFORM_TRACE_SCOPE("spinOnce", 0);
+        PLATFORM_PERF_SCOPE("spinOnce");
+        USDT_PROBE0(spin_once_begin);
+
+        const auto result = Base::spinOnce();
+
+        USDT_PROBE1(spin_once_end, result.worst_lateness.count());  // microseconds
+        return result;
+    }
+
     cetl::optional<PollFailure> pollAwaitableResourcesFor(const cetl::optional<libcyphal::Duration> timeout) const
     {
         CETL_DEBUG_ASSERT((total_awaitables_ > 0) || timeout,
@@ -94,7 +227,13 @@ public:
         }
 
         std::array<epoll_event, MaxEpollEvents> evs{};
-        const int epoll_result = ::epoll_wait(epollfd_, evs.data(), evs.size(), clamped_timeout_ms);
+        int                                     epoll_result = 0;
+        {
+            PLATFORM_TRACE_SCOPE("epoll_wait", static_cast<std::uint64_t>(clamped_timeout_ms));
+            USDT_PROBE2(epoll_wait_begin, clamped_timeout_ms, total_awaitables_);
+            epoll_result = ::epoll_wait(epollfd_, evs.data(), evs.size(), clamped_timeout_ms);
+            USDT_PROBE1(epoll_wait_end, epoll_result);
+        }
         if (epoll_result < 0)
         {
             const auto err = errno;
@@ -112,6 +251,7 @@ public:
             const epoll_event& ev = evs[index];
             if (auto* const cb_interface = static_cast<AwaitableNode*>(ev.data.ptr))
             {
+                PLATFORM_TRACE_INSTANT("fd_ready", static_cast<std::uint64_t>(cb_interface->fd()));
                 cb_interface->schedule(Callback::Schedule::Once{now_time});
             }
         }
@@ -125,7 +265,9 @@ protected:
     CETL_NODISCARD Callback::Any registerAwaitableCallback(Callback::Function&&    function,
                                                            const Trigger::Variant& trigger) override
     {
-        AwaitableNode new_cb_node{*this, std::move(function)};
+        std::size_t   slot_index = NoSlot;
+        auto          accounted  = makeAccounted(std::move(function), __builtin_return_address(0), slot_index);
+        AwaitableNode new_cb_node{*this, std::move(accounted), slot_index};
 
         cetl::visit(  //
             cetl::make_overloaded(
@@ -138,6 +280,10 @@ protected:
                     new_cb_node.setup(writable.fd, EPOLLOUT);
                 }),
             trigger);
+        if (slot_index != NoSlot)
+        {
+            accounted_[slot_index].stats.fd = new_cb_node.fd();
+        }
 
         insertCallbackNode(new_cb_node);
         return {std::move(new_cb_node)};
@@ -166,15 +312,30 @@ private:
     using Base = SingleThreadedExecutor;
     using Self = EpollSingleThreadedExecutor;
 
+    static constexpr std::size_t NoSlot = std::numeric_limits<std::size_t>::max();
+
+    struct AccountedSlot final
+    {
+        Callback::Function function;
+        CallbackStats      stats;
+        bool               is_used;
+        bool               is_running;
+        bool               is_release_pending;  ///< The callback was released while being executed.
+    };
+
+    /// Node of both awaitable (with `setup` file descriptor) and plain callbacks, which also owns
+    /// the accounting slot of the callback (if any).
+    ///
     /// No Sonar cpp:S4963 b/c `AwaitableNode` supports move operation.
     ///
     class AwaitableNode final : public CallbackNode  // NOSONAR cpp:S4963
     {
     public:
-        AwaitableNode(Self& executor, Callback::Function&& function)
+        AwaitableNode(Self& executor, Callback::Function&& function, const std::size_t slot_index)
             : CallbackNode{executor, std::move(function)}
             , fd_{-1}
             , events_{0}
+            , slot_index_{slot_index}
         {
         }
 
@@ -185,12 +346,17 @@ private:
                 ::epoll_ctl(getExecutor().epollfd_, EPOLL_CTL_DEL, fd_, nullptr);
                 getExecutor().total_awaitables_--;
             }
+            if (slot_index_ != NoSlot)
+            {
+                getExecutor().releaseAccounted(slot_index_);
+            }
         }
 
         AwaitableNode(AwaitableNode&& other) noexcept
             : CallbackNode(std::move(other))
             , fd_{std::exchange(other.fd_, -1)}
             , events_{std::exchange(other.events_, 0)}
+            , slot_index_{std::exchange(other.slot_index_, NoSlot)}
         {
             if (fd_ >= 0)
             {
@@ -236,15 +402,106 @@ private:
 
         int           fd_;
         std::uint32_t events_;
+        std::size_t   slot_index_;
 
     };  // AwaitableNode
 
-    // MARK: - Data members:
+    /// Moves the function into a free accounting slot, and returns the wrapper which executes it from there.
+    /// If there is nothing to account, or no free slot, the original function is returned as is
+    /// (and `slot_index` stays `NoSlot`).
+    ///
+    Callback::Function makeAccounted(Callback::Function&& function,
+                                     const void* const    origin,
+                                     std::size_t&         slot_index)
+    {
+        if (!is_accounting_ && !PerfCounters::isOpen())
+        {
+            return std::move(function);
+        }
+        for (std::size_t index = 0; index < accounted_.size(); ++index)
+        {
+            AccountedSlot& slot = accounted_[index];  // NOLINT(*-constant-array-index)
+            if (!slot.is_used)
+            {
+                slot.function           = std::move(function);
+                slot.stats              = CallbackStats{origin, -1, 0, 0, 0, 0, {}};
+                slot.is_used            = true;
+                slot.is_running         = false;
+                slot.is_release_pending = false;
+                slot_index              = index;
+                return [this, index](const Callback::Arg& arg) {
+                    //
+                    executeAccounted(index, arg);
+                };
+            }
+        }
+        ++unaccounted_callbacks_;
+        return std::move(function);
+    }
 
-    static constexpr int MaxEpollEvents = 16;
+    void executeAccounted(const std::size_t slot_index, const Callback::Arg& arg)
+    {
+        AccountedSlot& slot = accounted_[slot_index];  // NOLINT(*-constant-array-index)
+        {
+            // The hardware events are counted per slot (so per registered callback), and outside of the time
+            // measurement, so that the counters reading doesn't add up to the measured time.
+            const PerfCounters::Scope perf_scope{slot.stats.perf};
+
+            // Captured once, so that switching the accounting from inside of a callback doesn't skew its stats.
+            const bool          is_accounting = is_accounting_;
+            const std::uint64_t wall_begin_ns = is_accounting ? clockNs(CLOCK_MONOTONIC) : 0;
+            const std::uint64_t cpu_begin_ns  = is_accounting ? clockNs(CLOCK_THREAD_CPUTIME_ID) : 0;
+
+            slot.is_running = true;
+            slot.function(arg);
+            slot.is_running = false;
+
+            if (is_accounting)
+            {
+                const std::uint64_t wall_ns = clockNs(CLOCK_MONOTONIC) - wall_begin_ns;
+
+                ++slot.stats.calls;
+                slot.stats.wall_ns += wall_ns;
+                slot.stats.cpu_ns += clockNs(CLOCK_THREAD_CPUTIME_ID) - cpu_begin_ns;
+                slot.stats.max_wall_ns = std::max(slot.stats.max_wall_ns, wall_ns);
+            }
+        }
+        if (slot.is_release_pending)
+        {
+            releaseAccounted(slot_index);
+        }
+    }
+
+    void releaseAccounted(const std::size_t slot_index) noexcept
+    {
+        AccountedSlot& slot = accounted_[slot_index];  // NOLINT(*-constant-array-index)
+
+        // The function can't be destroyed while it's still being executed (f.e. the callback resets its own handle).
+        if (slot.is_running)
+        {
+            slot.is_release_pending = true;
+            return;
+        }
+        slot.function = Callback::Function{};
+        slot.is_used  = false;
+    }
+
+    static std::uint64_t clockNs(const clockid_t clock_id) noexcept
+    {
+        ::timespec ts{};
+        (void) ::clock_gettime(clock_id, &ts);
+        return (static_cast<std::uint64_t>(ts.tv_sec) * 1000000000ULL) +  // NOLINT(*-magic-numbers)
+               static_cast<std::uint64_t>(ts.tv_nsec);
+    }
+
+    // MARK: - Data members:
 
-    int         epollfd_;
-    std::size_t total_awaitables_;
+    int                                              epollfd_;
+    std::size_t                                      total_awaitables_;
+    std::array<AccountedSlot, MaxAccountedCallbacks> accounted_{};
+    std::size_t                                      unaccounted_callbacks_{0};
+    bool                                             is_accounting_{false};
+    mutable TscClock                                 tsc_clock_;
 
 };  // LinuxSingleThreadedExecutor
 
@@ -0,0 +1,339 @@
+// This software is distributed under the terms of the MIT License.
+// Copyright (C) OpenCyphal Development Team  <opencyphal.org>
+// Copyright Amazon.com Inc. or its affiliates.
+// SPDX-License-Identifier: MIT
+
+#ifndef PLATFORM_LINUX_PERF_COUNTERS_HPP_INCLUDED
+#define PLATFORM_LINUX_PERF_COUNTERS_HPP_INCLUDED
+
+#include <array>
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <iomanip>
+#include <ios>
+#include <linux/perf_event.h>
+#include <ostream>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#define PLATFORM_PERF_CONCAT_(a, b) a##b
+#define PLATFORM_PERF_CONCAT(a, b) PLATFORM_PERF_CONCAT_(a, b)
+
+/// Counts the hardware events of the rest of the enclosing scope into the named site (see `PerfCounters`).
+/// The name must be a string literal; each use of the macro is a separate site, even if the name is the same.
+///
+#define PLATFORM_PERF_SCOPE(name)                                                                \
+    static platform::Linux::PerfCounters::Site PLATFORM_PERF_CONCAT(perf_site_, __LINE__)(name); \
+    const platform::Linux::PerfCounters::Scope PLATFORM_PERF_CONCAT(perf_scope_, __LINE__)(      \
+        PLATFORM_PERF_CONCAT(perf_site_, __LINE__))
+
+namespace platform
+{
+namespace Linux
+{
+
+/// Implements optional hardware performance counters (cycles, instructions, cache and branch misses),
+/// aggregated per named site of the code (f.e. `spinOnce` iteration, or a media callback).
+///
+/// The counters are a single `perf_event_open` group of the calling (main loop) thread, user space only,
+/// so they are read atomically by one `read` syscall at the beginning and at the end of each site scope.
+/// The counters are disabled until `open` succeeds; where they are not available (f.e. in containers,
+/// or with too restrictive `kernel.perf_event_paranoid`), all scopes are no-ops except for a single branch.
+///
+/// Counts of nested sites are inclusive (f.e. `spinOnce` includes the media callbacks executed by it).
+/// Not thread-safe - all sites are expected to be executed by the main loop thread.
+///
+/// If there are more events than hardware counters (f.e. with other `perf` users), the kernel multiplexes the group,
+/// so it counts only part of the time. Counts of such scopes are scaled by the enabled-to-running time ratio
+/// (same as `perf stat` does), and the scopes are reported as multiplexed; scopes during which the group has not
+/// been running at all can't be estimated, so they are only reported as multiplexed (not counted as calls).
+///
+class PerfCounters final
+{
+public:
+    enum Event : std::uint8_t
+    {
+        Cycles,
+        Instructions,
+        CacheMisses,
+        BranchMisses,
+
+        EventCount
+    };
+
+    using Values = std::array<std::uint64_t, EventCount>;
+
+    /// The values of the group, and the times it has been enabled and actually running (counting).
+    ///
+    struct Sample final
+    {
+        std::uint64_t time_enabled;
+        std::uint64_t time_running;
+        Values        values;
+    };
+
+    /// Accumulated counts of a site, or of any other piece of code measured by `Scope` (f.e. an executor callback).
+    ///
+    struct Totals final
+    {
+        std::uint64_t calls;
+        Values        values;
+        std::uint64_t scaled_calls;  ///< Subset of `calls` whose counts are scaled (due to multiplexing).
+        std::uint64_t unscheduled;   ///< Scopes not counted because the group was not running at all.
+
+        std::uint64_t perCall(const Event event) const noexcept
+        {
+            return (calls > 0) ? (values[event] / calls) : 0;  // NOLINT(*-constant-array-index)
+        }
+    };
+
+    /// Accumulates counts of a single site. Sites register themselves on construction (expected to be static).
+    ///
+    class Site final
+    {
+    public:
+        explicit Site(const char* const name) noexcept
+            : name_{name}
+            , next_{globals().sites}
+        {
+            globals().sites = this;
+        }
+
+        ~Site() = default;
+
+        Site(const Site&)                = delete;
+        Site(Site&&) noexcept            = delete;
+        Site& operator=(const Site&)     = delete;
+        Site& operator=(Site&&) noexcept = delete;
+
+    private:
+        friend class PerfCounters;
+
+        const char* name_;
+        Site*       next_;
+        Totals      totals_{};
+
+    };  // Site
+
+    class Scope final
+    {
+    public:
+        explicit Scope(Site& site) noexcept
+            : Scope{site.totals_}
+        {
+        }
+
+        explicit Scope(Totals& totals) noexcept
+            : totals_{globals().leader_fd >= 0 ? &totals : nullptr}
+        {
+            if (totals_ != nullptr)
+            {
+                is_valid_ = readAll(begin_);
+            }
+        }
+
+        ~Scope()
+        {
+            Sample end{};
+            if ((totals_ != nullptr) && is_valid_ && readAll(end))
+            {
+                const std::uint64_t enabled = end.time_enabled - begin_.time_enabled;
+                const std::uint64_t running = end.time_running - begin_.time_running;
+                if (running == 0)
+                {
+                    ++totals_->unscheduled;
+                    return;
+                }
+                ++totals_->calls;
+                if (running < enabled)
+                {
+                    ++totals_->scaled_calls;
+                }
+                for (std::size_t i = 0; i < EventCount; ++i)
+                {
+                    const std::uint64_t delta = end.values[i] - begin_.values[i];  // NOLINT(*-constant-array-index)
+                    totals_->values[i] += scale(delta, enabled, running);          // NOLINT(*-constant-array-index)
+                }
+            }
+        }
+
+        Scope(const Scope&)                = delete;
+        Scope(Scope&&) noexcept            = delete;
+        Scope& operator=(const Scope&)     = delete;
+        Scope& operator=(Scope&&) noexcept = delete;
+
+    private:
+        Totals* totals_;
+        bool    is_valid_{false};
+        Sample  begin_{};
+
+    };  // Scope
+
+    /// Opens and starts the counter group for the calling thread.
+    ///
+    /// @return Zero on success (or if already open), or `errno` of the failed `perf_event_open` -
+    ///         in such case counters stay disabled.
+    ///
+    static int open() noexcept
+    {
+        Globals& g = globals();
+        if (g.leader_fd >= 0)
+        {
+            return 0;
+        }
+
+        constexpr std::array<std::uint64_t, EventCount> configs{PERF_COUNT_HW_CPU_CYCLES,
+                                                                 PERF_COUNT_HW_INSTRUCTIONS,
+                                                                 PERF_COUNT_HW_CACHE_MISSES,
+                                                                 PERF_COUNT_HW_BRANCH_MISSES};
+        std::array<int, EventCount> fds{};
+        fds.fill(-1);
+        for (std::size_t i = 0; i < EventCount; ++i)
+        {
+            ::perf_event_attr attr{};
+            attr.size           = sizeof(attr);
+            attr.type           = PERF_TYPE_HARDWARE;
+            attr.config         = configs[i];  // NOLINT(*-constant-array-index)
+            attr.disabled       = (i == 0) ? 1 : 0;
+            attr.exclude_kernel = 1;
+            attr.exclude_hv     = 1;
+            attr.read_format    = PERF_FORMAT_GROUP | PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+
+            const long fd = ::syscall(__NR_perf_event_open, &attr, 0, -1, fds[0], PERF_FLAG_FD_CLOEXEC);
+            if (fd < 0)
+            {
+                const int err = errno;
+                closeAll(fds);
+                return err;
+            }
+            fds[i] = static_cast<int>(fd);  // NOLINT(*-constant-array-index)
+        }
+
+        (void) ::ioctl(fds[0], PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);   // NOLINT(*-vararg)
+        (void) ::ioctl(fds[0], PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);  // NOLINT(*-vararg)
+        g.fds       = fds;
+        g.leader_fd = fds[0];
+        return 0;
+    }
+
+    static void close() noexcept
+    {
+        Globals& g = globals();
+        closeAll(g.fds);
+        g.leader_fd = -1;
+    }
+
+    static bool isOpen() noexcept
+    {
+        return globals().leader_fd >= 0;
+    }
+
+    /// Prints per-site averages (per call) of all events, plus the instructions per cycle.
+    ///
+    static void printTo(std::ostream& out)
+    {
+        out << "Perf counters (per call):\n";
+        printHeaderTo(out, "site");
+        for (const Site* site = globals().sites; site != nullptr; site = site->next_)
+        {
+            printRowTo(out, site->name_, site->totals_);
+        }
+    }
+
+    static void printHeaderTo(std::ostream& out, const char* const name_title)
+    {
+        out << "  " << std::left << std::setw(20) << name_title << std::right << std::setw(10) << "calls"
+            << std::setw(12) << "cycles" << std::setw(12) << "instrs" << std::setw(8) << "ipc" << std::setw(12)
+            << "cache_miss" << std::setw(12) << "branch_miss" << std::setw(10) << "mux" << "\n";
+    }
+
+    /// Prints averages (per call) of the totals, in the columns of `printHeaderTo`. Nothing if never called.
+    /// The last column is the number of multiplexed scopes (scaled plus not counted), see the class description.
+    ///
+    static void printRowTo(std::ostream& out, const char* const name, const Totals& totals)
+    {
+        if ((totals.calls == 0) && (totals.unscheduled == 0))
+        {
+            return;
+        }
+        const double ipc = (totals.values[Cycles] > 0) ? (static_cast<double>(totals.values[Instructions]) /
+                                                          static_cast<double>(totals.values[Cycles]))
+                                                       : 0.0;
+
+        const std::ios_base::fmtflags flags     = out.flags();
+        const std::streamsize         precision = out.precision();
+        out << "  " << std::left << std::setw(20) << name << std::right << std::setw(10) << totals.calls
+            << std::setw(12) << totals.perCall(Cycles) << std::setw(12) << totals.perCall(Instructions)
+            << std::setw(8) << std::fixed << std::setprecision(2) << ipc << std::setw(12)
+            << totals.perCall(CacheMisses) << std::setw(12) << totals.perCall(BranchMisses) << std::setw(10)
+            << (totals.scaled_calls + totals.unscheduled) << "\n";
+        out.flags(flags);
+        out.precision(precision);
+    }
+
+private:
+    struct Globals final
+    {
+        int                         leader_fd{-1};
+        std::array<int, EventCount> fds{{-1, -1, -1, -1}};
+        Site*                       sites{nullptr};
+    };
+
+    /// See `PERF_FORMAT_GROUP` (with both `PERF_FORMAT_TOTAL_TIME_*`) layout of the `read` result.
+    struct GroupReadFormat final
+    {
+        std::uint64_t nr;
+        std::uint64_t time_enabled;
+        std::uint64_t time_running;
+        Values        values;
+    };
+
+    static Globals& globals() noexcept
+    {
+        static Globals instance;
+        return instance;
+    }
+
+    static bool readAll(Sample& sample) noexcept
+    {
+        GroupReadFormat data{};
+        if (::read(globals().leader_fd, &data, sizeof(data)) != static_cast<ssize_t>(sizeof(data)))
+        {
+            return false;
+        }
+        sample = {data.time_enabled, data.time_running, data.values};
+        return true;
+    }
+
+    /// Estimates the count over the whole enabled time from the count over the running time.
+    ///
+    static std::uint64_t scale(const std::uint64_t count, const std::uint64_t enabled, const std::uint64_t running)
+    {
+        if (running >= enabled)
+        {
+            return count;
+        }
+        return static_cast<std::uint64_t>(static_cast<double>(count) * static_cast<double>(enabled) /
+                                          static_cast<double>(running));
+    }
+
+    static void closeAll(std::array<int, EventCount>& fds) noexcept
+    {
+        for (auto& fd : fds)
+        {
+            if (fd >= 0)
+            {
+                (void) ::close(fd);
+                fd = -1;
+            }
+        }
+    }
+
+};  // PerfCounters
+
+}  // namespace Linux
+}  // namespace platform
+
+#endif  // PLATFORM_LINUX_PERF_COUNTERS_HPP_INCLUDED
@@ -0,0 +1,251 @@
+// This software is distributed under the terms of the MIT License.
+// Copyright (C) OpenCyphal Development Team  <opencyphal.org>
+// Copyright Amazon.com Inc. or its affiliates.
+// SPDX-License-Identifier: MIT
+
+#ifndef PLATFORM_LINUX_TSC_CLOCK_HPP_INCLUDED
+#define PLATFORM_LINUX_TSC_CLOCK_HPP_INCLUDED
+
+#include <cstdint>
+#include <time.h>
+
+#if defined(__x86_64__)
+#    include <cpuid.h>
+#    include <x86intrin.h>
+#endif
+
+namespace platform
+{
+namespace Linux
+{
+
+/// Implements a monotonic clock based on the invariant TSC (time stamp counter) of x86-64 CPUs.
+///
+/// Reading the TSC is cheaper than `clock_gettime(CLOCK_MONOTONIC)`, especially where the kernel clock source
+/// is not TSC itself (f.e. in some VMs), and the call falls back from vDSO to a real syscall.
+/// The clock is calibrated against `CLOCK_MONOTONIC`, and produces nanoseconds in its time base,
+/// so it could be freely mixed with kernel timestamps. Drift relative to `CLOCK_MONOTONIC` is corrected once per
+/// `ResyncPeriodNs` by slewing the rate (the clock is never stepped back), and the result is clamped
+/// to never go backwards (f.e. because of a residual TSC skew between CPUs).
+///
+/// Not thread-safe - expected to be used by the single-threaded executor only.
+///
+class TscClock final
+{
+public:
+    static constexpr std::uint64_t ResyncPeriodNs   = 1000000000ULL;  // 1 second
+    static constexpr std::uint64_t CalibrationNs    = 10000000ULL;    // 10 milliseconds
+    static constexpr std::int64_t  MaxSlewPpm       = 500;
+    static constexpr std::int64_t  MaxSlewableErrNs = 1000000;  // 1 millisecond; larger errors are stepped forward
+
+    /// Checks whether the CPU has the invariant TSC (runs at a constant rate regardless of power states).
+    ///
+    static bool isSupported() noexcept
+    {
+#if defined(__x86_64__)
+        unsigned int eax = 0;
+        unsigned int ebx = 0;
+        unsigned int ecx = 0;
+        unsigned int edx = 0;
+        if (__get_cpuid(0x80000007U, &eax, &ebx, &ecx, &edx) == 0)  // NOLINT(*-magic-numbers)
+        {
+            return false;
+        }
+        return (edx & (1U << 8U)) != 0;  // NOLINT(*-magic-numbers) "Invariant TSC" bit
+#else
+        return false;
+#endif
+    }
+
+    /// Measures the TSC rate against `CLOCK_MONOTONIC` (busy waits for about `CalibrationNs`).
+    ///
+    /// @return `true` if the clock is supported and calibrated (hence ready to use).
+    ///
+    bool calibrate() noexcept
+    {
+        is_calibrated_ = false;
+        if (!isSupported())
+        {
+            return false;
+        }
+
+        Anchor begin{};
+        Anchor end{};
+        if (!sampleAnchor(begin))
+        {
+            return false;
+        }
+        do
+        {
+            if (!sampleAnchor(end))
+            {
+                return false;
+            }
+        } while ((end.mono_ns - begin.mono_ns) < CalibrationNs);
+        if ((end.tsc <= begin.tsc) || (rateOf(begin, end) == 0))
+        {
+            return false;
+        }
+
+        mult_          = rateOf(begin, end);
+        base_          = end;
+        last_ns_       = end.mono_ns;
+        is_calibrated_ = true;
+        setSyncPoint(end);
+        return true;
+    }
+
+    bool isCalibrated() const noexcept
+    {
+        return is_calibrated_;
+    }
+
+    /// Gets current time in nanoseconds (in the `CLOCK_MONOTONIC` time base). Requires successful `calibrate`.
+    ///
+    std::uint64_t nowNs() noexcept
+    {
+        const std::uint64_t tsc = readTsc();
+        std::uint64_t       ns  = toNs(tsc);
+        if (tsc >= resync_at_tsc_)
+        {
+            ns = resync(ns);
+        }
+        last_ns_ = (ns > last_ns_) ? ns : last_ns_;
+        return last_ns_;
+    }
+
+    /// Gets the current TSC rate estimation, in nanoseconds per tick.
+    ///
+    double nsPerTick() const noexcept
+    {
+        return static_cast<double>(mult_) / static_cast<double>(1ULL << Shift);
+    }
+
+private:
+    static constexpr unsigned Shift = 32;
+
+    __extension__ using Wide = unsigned __int128;  // Intermediate products of the fixed point conversion.
+
+    struct Anchor final
+    {
+        std::uint64_t tsc;
+        std::uint64_t mono_ns;
+    };
+
+    static std::uint64_t readTsc() noexcept
+    {
+#if defined(__x86_64__)
+        return __rdtsc();
+#else
+        return 0;
+#endif
+    }
+
+    static std::uint64_t monotonicNs() noexcept
+    {
+        ::timespec ts{};
+        (void) ::clock_gettime(CLOCK_MONOTONIC, &ts);
+        return (static_cast<std::uint64_t>(ts.tv_sec) * 1000000000ULL) +  // NOLINT(*-magic-numbers)
+               static_cast<std::uint64_t>(ts.tv_nsec);
+    }
+
+    /// Takes a pair of simultaneous TSC and `CLOCK_MONOTONIC` readings. The kernel clock is read in between of
+    /// two TSC reads, and the tightest of a few attempts is taken (so that a preemption doesn't spoil the pair).
+    ///
+    static bool sampleAnchor(Anchor& anchor) noexcept
+    {
+        constexpr int Attempts = 5;
+
+        std::uint64_t best_window = ~0ULL;
+        for (int attempt = 0; attempt < Attempts; ++attempt)
+        {
+            const std::uint64_t before  = readTsc();
+            const std::uint64_t mono_ns = monotonicNs();
+            const std::uint64_t after   = readTsc();
+            if ((after > before) && ((after - before) < best_window))
+            {
+                best_window = after - before;
+                anchor      = {before + ((after - before) / 2U), mono_ns};
+            }
+        }
+        return best_window != ~0ULL;
+    }
+
+    /// Gets the rate (nanoseconds per tick, fixed point with `Shift` fractional bits) between two anchors.
+    ///
+    static std::uint64_t rateOf(const Anchor& from, const Anchor& to) noexcept
+    {
+        const Wide ns = static_cast<Wide>(to.mono_ns - from.mono_ns) << Shift;
+        return static_cast<std::uint64_t>(ns / (to.tsc - from.tsc));
+    }
+
+    std::uint64_t toNs(const std::uint64_t tsc) const noexcept
+    {
+        const std::uint64_t ticks = (tsc > base_.tsc) ? (tsc - base_.tsc) : 0U;
+        return base_.mono_ns + static_cast<std::uint64_t>((static_cast<Wide>(ticks) * mult_) >> Shift);
+    }
+
+    /// Re-anchors the clock at the given (current) estimation, and adjusts the rate so that the error against
+    /// `CLOCK_MONOTONIC` is slewed away during the next period.
+    ///
+    /// @return The (possibly stepped forward) current time.
+    ///
+    std::uint64_t resync(const std::uint64_t estimated_ns) noexcept
+    {
+        Anchor now{};
+        if (!sampleAnchor(now) || (now.tsc <= sync_.tsc) || (now.mono_ns <= sync_.mono_ns))
+        {
+            return estimated_ns;
+        }
+        const std::uint64_t current_ns = toNs(now.tsc);
+        const std::int64_t  error_ns   = static_cast<std::int64_t>(now.mono_ns - current_ns);
+        if ((error_ns > MaxSlewableErrNs) || (error_ns < -MaxSlewableErrNs))
+        {
+            // Too far off (f.e. after a suspend) - just recalibrate, but still never go backwards.
+            mult_ = rateOf(sync_, now);
+            base_ = {now.tsc, (now.mono_ns > last_ns_) ? now.mono_ns : last_ns_};
+            setSyncPoint(now);
+            return base_.mono_ns;
+        }
+
+        // The kernel rate over the last period, corrected to compensate the accumulated error over the next one.
+        const std::uint64_t kernel_mult = rateOf(sync_, now);
+        const std::int64_t  period_ns   = static_cast<std::int64_t>(now.mono_ns - sync_.mono_ns);
+        std::int64_t        slew_ppm    = (error_ns * 1000000) / period_ns;  // NOLINT(*-magic-numbers)
+        if (slew_ppm > MaxSlewPpm)
+        {
+            slew_ppm = MaxSlewPpm;
+        }
+        if (slew_ppm < -MaxSlewPpm)
+        {
+            slew_ppm = -MaxSlewPpm;
+        }
+
+        const auto slew = (static_cast<std::int64_t>(kernel_mult) * slew_ppm) / 1000000;  // NOLINT(*-magic-numbers)
+        mult_           = static_cast<std::uint64_t>(static_cast<std::int64_t>(kernel_mult) + slew);
+        base_           = {now.tsc, current_ns};
+        setSyncPoint(now);
+        return current_ns;
+    }
+
+    void setSyncPoint(const Anchor& anchor) noexcept
+    {
+        sync_          = anchor;
+        resync_at_tsc_ = anchor.tsc + ((ResyncPeriodNs << Shift) / mult_);
+    }
+
+    // MARK: Data members:
+
+    bool          is_calibrated_{false};
+    std::uint64_t mult_{0};     ///< Nanoseconds per tick (fixed point, see `Shift`).
+    Anchor        base_{0, 0};  ///< The conversion origin.
+    Anchor        sync_{0, 0};  ///< The last `CLOCK_MONOTONIC` sync point.
+    std::uint64_t resync_at_tsc_{0};
+    std::uint64_t last_ns_{0};
+
+};  // TscClock
+
+}  // namespace Linux
+}  // namespace platform
+
+#endif  // PLATFORM_LINUX_TSC_CLOCK_HPP_INCLUDED
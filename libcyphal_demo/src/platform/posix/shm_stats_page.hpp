@@ -0,0 +1,321 @@
+// This software is distributed under the terms of the MIT License.
+// Copyright (C) OpenCyphal Development Team  <opencyphal.org>
+// Copyright Amazon.com Inc. or its affiliates.
+// SPDX-License-Identifier: MIT
+
+#ifndef PLATFORM_POSIX_SHM_STATS_PAGE_HPP_INCLUDED
+#define PLATFORM_POSIX_SHM_STATS_PAGE_HPP_INCLUDED
+
+#include <array>
+#include <atomic>
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <utility>
+
+namespace platform
+{
+namespace posix
+{
+
+/// Defines binary layout of the statistics page shared between the node (writer) and external readers.
+///
+/// The page is a fixed table of named 64-bit counters protected by a sequence lock:
+/// the writer makes `sequence` odd while it updates values, and even again when it's done;
+/// a reader retries its snapshot if it observed an odd or changed sequence.
+/// All values are atomics (accessed with relaxed ordering) so that concurrent access is well-defined,
+/// and since they are lock-free they are also address-free - hence usable across processes.
+///
+struct StatsPage final
+{
+    static constexpr std::uint32_t MagicValue     = 0x54535943UL;  // "CYST" in little-endian
+    static constexpr std::uint32_t LayoutVersion  = 1;
+    static constexpr std::size_t   MaxCounters    = 64;
+    static constexpr std::size_t   MaxCounterName = 40;
+    static constexpr std::size_t   InvalidCounter = MaxCounters;
+
+    using CounterName = std::array<char, MaxCounterName>;
+
+    struct Counter final
+    {
+        CounterName                name;
+        std::atomic<std::uint64_t> value;
+    };
+
+    std::uint32_t                    magic;
+    std::uint32_t                    version;
+    std::atomic<std::uint32_t>       sequence;
+    std::atomic<std::uint32_t>       counters_count;
+    std::array<Counter, MaxCounters> counters;
+
+};  // StatsPage
+
+static_assert(ATOMIC_LLONG_LOCK_FREE == 2, "Cross-process atomics must be lock-free.");
+
+// MARK: -
+
+/// Defines the writer side of the statistics page.
+///
+/// The page is mapped from a POSIX shared memory object (see `shm_open`), so any number of external processes
+/// could watch the node internals without adding network traffic. Once the page is open, updates don't make
+/// any system calls - they are just a few plain memory stores, hence suitable for the executor loop.
+///
+/// The writer is optional: until `open` has succeeded all methods are no-ops.
+///
+class ShmStatsPageWriter final
+{
+public:
+    using CounterIndex = std::size_t;
+
+    ShmStatsPageWriter() = default;
+
+    ~ShmStatsPageWriter()
+    {
+        close();
+    }
+
+    ShmStatsPageWriter(const ShmStatsPageWriter&)                = delete;
+    ShmStatsPageWriter(ShmStatsPageWriter&&) noexcept            = delete;
+    ShmStatsPageWriter& operator=(const ShmStatsPageWriter&)     = delete;
+    ShmStatsPageWriter& operator=(ShmStatsPageWriter&&) noexcept = delete;
+
+    /// Creates (or reuses) the shared memory object with the given name, and maps it.
+    ///
+    /// @param name Name of the shared memory object, f.e. "/org.opencyphal.demos.libcyphal".
+    /// @return Zero on success, otherwise `errno` of the failed operation.
+    ///
+    int open(const char* const name)
+    {
+        close();
+
+        const int fd = ::shm_open(name, O_CREAT | O_RDWR, 0644);  // NOLINT(*-signed-bitwise)
+        if (fd < 0)
+        {
+            return errno;
+        }
+        if (::ftruncate(fd, sizeof(StatsPage)) != 0)
+        {
+            const int err = errno;
+            (void) ::close(fd);
+            return err;
+        }
+        void* const addr = ::mmap(nullptr, sizeof(StatsPage), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+        const int   err  = errno;
+        (void) ::close(fd);  // The mapping stays valid after the descriptor is closed.
+        if (addr == MAP_FAILED)  // NOLINT(*-cstyle-cast, *-pro-type-cstyle-cast)
+        {
+            return err;
+        }
+
+        (void) std::strncpy(name_.data(), name, name_.size() - 1);
+        page_ = static_cast<StatsPage*>(addr);
+
+        // Invalidate the layout first, so that readers won't interpret the page while we reset it.
+        page_->magic = 0;
+        page_->sequence.store(0, std::memory_order_relaxed);
+        page_->counters_count.store(0, std::memory_order_relaxed);
+        page_->version = StatsPage::LayoutVersion;
+        std::atomic_thread_fence(std::memory_order_release);
+        page_->magic = StatsPage::MagicValue;
+        return 0;
+    }
+
+    bool isOpen() const noexcept
+    {
+        return page_ != nullptr;
+    }
+
+    /// Appends a new named counter to the page.
+    ///
+    /// Counters are expected to be added once at startup (before the main loop).
+    /// Names longer than `StatsPage::MaxCounterName - 1` are truncated.
+    ///
+    /// @return Index of the counter, or `StatsPage::InvalidCounter` if the page is not open or is full.
+    ///
+    CounterIndex addCounter(const char* const name) noexcept
+    {
+        if ((page_ == nullptr) || (counters_count_ >= StatsPage::MaxCounters))
+        {
+            return StatsPage::InvalidCounter;
+        }
+
+        const CounterIndex index   = counters_count_++;
+        auto&              counter = page_->counters[index];  // NOLINT(*-constant-array-index)
+        beginUpdate();
+        counter.name.fill('\0');
+        (void) std::strncpy(counter.name.data(), name, counter.name.size() - 1);
+        counter.value.store(0, std::memory_order_relaxed);
+        page_->counters_count.store(static_cast<std::uint32_t>(counters_count_), std::memory_order_relaxed);
+        endUpdate();
+        return index;
+    }
+
+    /// Publishes a consistent batch of counter values.
+    ///
+    /// The `writer` is called with this object, and is expected to call `set` for the values to be updated.
+    ///
+    template <typename Writer>
+    void update(Writer&& writer) noexcept
+    {
+        if (page_ != nullptr)
+        {
+            beginUpdate();
+            std::forward<Writer>(writer)(*this);
+            endUpdate();
+        }
+    }
+
+    /// Sets value of the counter. Should be called only from within the `update` writer.
+    ///
+    void set(const CounterIndex index, const std::uint64_t value) noexcept
+    {
+        if (index < counters_count_)
+        {
+            page_->counters[index].value.store(value, std::memory_order_relaxed);  // NOLINT(*-constant-array-index)
+        }
+    }
+
+private:
+    void beginUpdate() noexcept
+    {
+        page_->sequence.store(++sequence_, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+    }
+
+    void endUpdate() noexcept
+    {
+        page_->sequence.store(++sequence_, std::memory_order_release);
+    }
+
+    void close() noexcept
+    {
+        if (page_ != nullptr)
+        {
+            page_->magic = 0;
+            (void) ::munmap(page_, sizeof(StatsPage));
+            (void) ::shm_unlink(name_.data());
+            page_ = nullptr;
+        }
+        counters_count_ = 0;
+        sequence_       = 0;
+    }
+
+    // MARK: Data members:
+
+    static constexpr std::size_t MaxNameLen = 64;
+
+    StatsPage*                   page_{nullptr};
+    std::size_t                  counters_count_{0};
+    std::uint32_t                sequence_{0};
+    std::array<char, MaxNameLen> name_{};
+
+};  // ShmStatsPageWriter
+
+// MARK: -
+
+/// Defines the reader side of the statistics page. In use by the external `stats_reader` tool.
+///
+class ShmStatsPageReader final
+{
+public:
+    struct Snapshot final
+    {
+        std::size_t                                                counters_count;
+        std::array<StatsPage::CounterName, StatsPage::MaxCounters> names;
+        std::array<std::uint64_t, StatsPage::MaxCounters>          values;
+    };
+
+    ShmStatsPageReader() = default;
+
+    ~ShmStatsPageReader()
+    {
+        if (page_ != nullptr)
+        {
+            (void) ::munmap(const_cast<StatsPage*>(page_), sizeof(StatsPage));  // NOLINT(*-const-cast)
+        }
+    }
+
+    ShmStatsPageReader(const ShmStatsPageReader&)                = delete;
+    ShmStatsPageReader(ShmStatsPageReader&&) noexcept            = delete;
+    ShmStatsPageReader& operator=(const ShmStatsPageReader&)     = delete;
+    ShmStatsPageReader& operator=(ShmStatsPageReader&&) noexcept = delete;
+
+    /// Maps existing shared memory object (read-only).
+    ///
+    /// @return Zero on success, otherwise `errno` of the failed operation.
+    ///
+    int open(const char* const name)
+    {
+        const int fd = ::shm_open(name, O_RDONLY, 0);
+        if (fd < 0)
+        {
+            return errno;
+        }
+        void* const addr = ::mmap(nullptr, sizeof(StatsPage), PROT_READ, MAP_SHARED, fd, 0);
+        const int   err  = errno;
+        (void) ::close(fd);
+        if (addr == MAP_FAILED)  // NOLINT(*-cstyle-cast, *-pro-type-cstyle-cast)
+        {
+            return err;
+        }
+        page_ = static_cast<const StatsPage*>(addr);
+        return 0;
+    }
+
+    /// Takes a consistent snapshot of the page.
+    ///
+    /// @return `false` if the page has no valid layout (yet), or a consistent snapshot couldn't be taken
+    ///         within the given number of attempts (the writer is updating too frequently).
+    ///
+    bool read(Snapshot& out, std::size_t max_attempts = 1000) const noexcept
+    {
+        if ((page_ == nullptr) || (page_->magic != StatsPage::MagicValue) ||
+            (page_->version != StatsPage::LayoutVersion))
+        {
+            return false;
+        }
+
+        while (max_attempts-- > 0)
+        {
+            const std::uint32_t seq_before = page_->sequence.load(std::memory_order_acquire);
+            if ((seq_before & 1U) != 0)
+            {
+                continue;  // The writer is in the middle of update.
+            }
+
+            const std::size_t count = page_->counters_count.load(std::memory_order_relaxed);
+            out.counters_count      = (count < StatsPage::MaxCounters) ? count : StatsPage::MaxCounters;
+            for (std::size_t i = 0; i < out.counters_count; ++i)
+            {
+                const auto& counter = page_->counters[i];  // NOLINT(*-constant-array-index)
+                std::memcpy(out.names[i].data(), counter.name.data(), counter.name.size());
+                out.values[i] = counter.value.load(std::memory_order_relaxed);
+            }
+
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if (seq_before == page_->sequence.load(std::memory_order_relaxed))
+            {
+                for (auto& name : out.names)
+                {
+                    name.back() = '\0';
+                }
+                return true;
+            }
+        }
+        return false;
+    }
+
+private:
+    const StatsPage* page_{nullptr};
+
+};  // ShmStatsPageReader
+
+}  // namespace posix
+}  // namespace platform
+
+#endif  // PLATFORM_POSIX_SHM_STATS_PAGE_HPP_INCLUDED
@@ -0,0 +1,312 @@
+// This software is distributed under the terms of the MIT License.
+// Copyright (C) OpenCyphal Development Team  <opencyphal.org>
+// Copyright Amazon.com Inc. or its affiliates.
+// SPDX-License-Identifier: MIT
+
+#ifndef PLATFORM_POSIX_FAULTY_UDP_MEDIA_HPP_INCLUDED
+#define PLATFORM_POSIX_FAULTY_UDP_MEDIA_HPP_INCLUDED
+
+#include "platform/fault_injector.hpp"
+
+#include <cetl/cetl.hpp>
+#include <cetl/pf17/cetlpf.hpp>
+#include <libcyphal/errors.hpp>
+#include <libcyphal/executor.hpp>
+#include <libcyphal/transport/errors.hpp>
+#include <libcyphal/transport/types.hpp>
+#include <libcyphal/transport/udp/media.hpp>
+#include <libcyphal/transport/udp/tx_rx_sockets.hpp>
+#include <libcyphal/types.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <utility>
+
+namespace platform
+{
+namespace posix
+{
+
+/// Decorates a UDP TX socket with the loss and TX-full faults of the given injector.
+///
+class FaultyUdpTxSocket final : public libcyphal::transport::udp::ITxSocket
+{
+public:
+    FaultyUdpTxSocket(libcyphal::UniquePtr<ITxSocket>&& inner, FaultInjector& injector)
+        : inner_{std::move(inner)}
+        , injector_{injector}
+    {
+        CETL_DEBUG_ASSERT(inner_ != nullptr, "");
+    }
+
+    ~FaultyUdpTxSocket() = default;
+
+    FaultyUdpTxSocket(const FaultyUdpTxSocket&)                = delete;
+    FaultyUdpTxSocket(FaultyUdpTxSocket&&) noexcept            = delete;
+    FaultyUdpTxSocket& operator=(const FaultyUdpTxSocket&)     = delete;
+    FaultyUdpTxSocket& operator=(FaultyUdpTxSocket&&) noexcept = delete;
+
+private:
+    // MARK: ITxSocket
+
+    SendResult::Type send(const libcyphal::TimePoint                   deadline,
+                          const libcyphal::transport::udp::IpEndpoint  multicast_endpoint,
+                          const std::uint8_t                           dscp,
+                          const libcyphal::transport::PayloadFragments payload_fragments) override
+    {
+        if (injector_.inject(FaultInjector::TxFull))
+        {
+            return SendResult::Success{false};
+        }
+        if (injector_.inject(FaultInjector::Loss))
+        {
+            return SendResult::Success{true};  // Pretend that the datagram has been sent.
+        }
+        return inner_->send(deadline, multicast_endpoint, dscp, payload_fragments);
+    }
+
+    CETL_NODISCARD libcyphal::IExecutor::Callback::Any registerCallback(
+        libcyphal::IExecutor::Callback::Function&& function) override
+    {
+        return inner_->registerCallback(std::move(function));
+    }
+
+    // MARK: Data members:
+
+    libcyphal::UniquePtr<ITxSocket> inner_;
+    FaultInjector&                  injector_;
+
+};  // FaultyUdpTxSocket
+
+// MARK: -
+
+/// Decorates a UDP RX socket with all kinds of faults of the given injector (except TX-full).
+///
+/// Held datagrams are released by invoking the receive callback of the transport on a timer of their release time.
+///
+class FaultyUdpRxSocket final : public libcyphal::transport::udp::IRxSocket
+{
+public:
+    FaultyUdpRxSocket(libcyphal::UniquePtr<IRxSocket>&& inner,
+                      libcyphal::IExecutor&             executor,
+                      cetl::pmr::memory_resource&       memory,
+                      FaultInjector&                    injector)
+        : inner_{std::move(inner)}
+        , executor_{executor}
+        , memory_{memory}
+        , injector_{injector}
+    {
+        CETL_DEBUG_ASSERT(inner_ != nullptr, "");
+    }
+
+    ~FaultyUdpRxSocket() = default;
+
+    FaultyUdpRxSocket(const FaultyUdpRxSocket&)                = delete;
+    FaultyUdpRxSocket(FaultyUdpRxSocket&&) noexcept            = delete;
+    FaultyUdpRxSocket& operator=(const FaultyUdpRxSocket&)     = delete;
+    FaultyUdpRxSocket& operator=(FaultyUdpRxSocket&&) noexcept = delete;
+
+private:
+    static constexpr std::size_t MaxHeldDatagrams = 8;
+
+    using Metadata = ReceiveResult::Metadata;
+
+    // MARK: IRxSocket
+
+    CETL_NODISCARD ReceiveResult::Type receive() override
+    {
+        auto result = receiveWithFaults();
+        scheduleRelease();
+        return result;
+    }
+
+    CETL_NODISCARD libcyphal::IExecutor::Callback::Any registerCallback(
+        libcyphal::IExecutor::Callback::Function&& function) override
+    {
+        // The same transport handler receives both the incoming and the released (held) datagrams.
+        receive_function_ = std::move(function);
+        release_callback_ = executor_.registerCallback([this](const auto& arg) { receive_function_(arg); });
+        return inner_->registerCallback([this](const auto& arg) { receive_function_(arg); });
+    }
+
+    // MARK: Privates:
+
+    ReceiveResult::Type receiveWithFaults()
+    {
+        const auto now = executor_.now();
+        if (auto held = held_datagrams_.takeDue(now))
+        {
+            held->timestamp = now;
+            return std::move(*held);
+        }
+
+        auto        result  = inner_->receive();
+        auto* const success = cetl::get_if<ReceiveResult::Success>(&result);
+        if ((success == nullptr) || !success->has_value())
+        {
+            return result;
+        }
+        held_datagrams_.onNextFrame(now);
+
+        Metadata& metadata = success->value();
+        if (injector_.inject(FaultInjector::Loss))
+        {
+            return cetl::nullopt;
+        }
+        if (injector_.inject(FaultInjector::Corrupt))
+        {
+            injector_.corrupt({metadata.payload_ptr.get(), metadata.payload_ptr.get_deleter().size()});
+        }
+
+        if (injector_.inject(FaultInjector::Duplicate))
+        {
+            if (auto copy = duplicate(metadata))
+            {
+                (void) held_datagrams_.hold(std::move(*copy), now, false);
+            }
+        }
+        else if (injector_.inject(FaultInjector::Reorder))
+        {
+            if (held_datagrams_.hold(std::move(metadata), now, true))
+            {
+                return cetl::nullopt;
+            }
+        }
+        else if (injector_.inject(FaultInjector::Delay))
+        {
+            if (held_datagrams_.hold(std::move(metadata), now + injector_.delay(), false))
+            {
+                return cetl::nullopt;
+            }
+        }
+        return result;
+    }
+
+    void scheduleRelease()
+    {
+        const auto release_at = held_datagrams_.nextReleaseAt();
+        if (release_at.has_value() && release_callback_.has_value())
+        {
+            (void) release_callback_.schedule(libcyphal::IExecutor::Callback::Schedule::Once{*release_at});
+        }
+    }
+
+    /// Makes a copy of the datagram (in the same memory as the original one is). Fails on out of memory.
+    ///
+    cetl::optional<Metadata> duplicate(const Metadata& metadata)
+    {
+        const std::size_t size = metadata.payload_ptr.get_deleter().size();
+        auto* const       copy = memory_.allocate(size);
+        if (nullptr == copy)
+        {
+            return cetl::nullopt;
+        }
+        (void) std::memcpy(copy, metadata.payload_ptr.get(), size);
+
+        return Metadata{metadata.timestamp,
+                        {static_cast<cetl::byte*>(copy), libcyphal::PmrRawBytesDeleter{size, &memory_}}};
+    }
+
+    // MARK: Data members:
+
+    libcyphal::UniquePtr<IRxSocket>            inner_;
+    libcyphal::IExecutor&                      executor_;
+    cetl::pmr::memory_resource&                memory_;
+    FaultInjector&                             injector_;
+    FaultHoldQueue<Metadata, MaxHeldDatagrams> held_datagrams_;
+    libcyphal::IExecutor::Callback::Function   receive_function_;
+    libcyphal::IExecutor::Callback::Any        release_callback_;
+
+};  // FaultyUdpRxSocket
+
+// MARK: -
+
+/// Decorates a UDP media, so that all its sockets inject the faults of the given injector.
+///
+/// Any `IMedia` could be decorated, so this is also usable with the test doubles of media.
+///
+class FaultyUdpMedia final : public libcyphal::transport::udp::IMedia
+{
+public:
+    FaultyUdpMedia(libcyphal::transport::udp::IMedia& inner,
+                   cetl::pmr::memory_resource&        general_mr,
+                   libcyphal::IExecutor&              executor,
+                   FaultInjector&                     injector)
+        : inner_{inner}
+        , general_mr_{general_mr}
+        , executor_{executor}
+        , injector_{injector}
+    {
+    }
+
+    ~FaultyUdpMedia() = default;
+
+    FaultyUdpMedia(const FaultyUdpMedia&)                = delete;
+    FaultyUdpMedia(FaultyUdpMedia&&) noexcept            = delete;
+    FaultyUdpMedia& operator=(const FaultyUdpMedia&)     = delete;
+    FaultyUdpMedia& operator=(FaultyUdpMedia&&) noexcept = delete;
+
+private:
+    using ITxSocket = libcyphal::transport::udp::ITxSocket;
+    using IRxSocket = libcyphal::transport::udp::IRxSocket;
+
+    // MARK: - IMedia
+
+    MakeTxSocketResult::Type makeTxSocket() override
+    {
+        auto  result = inner_.makeTxSocket();
+        auto* socket = cetl::get_if<MakeTxSocketResult::Success>(&result);
+        if (socket == nullptr)
+        {
+            return result;
+        }
+
+        auto tx_socket =
+            libcyphal::makeUniquePtr<ITxSocket, FaultyUdpTxSocket>(general_mr_, std::move(*socket), injector_);
+        if (tx_socket == nullptr)
+        {
+            return libcyphal::MemoryError{};
+        }
+        return tx_socket;
+    }
+
+    MakeRxSocketResult::Type makeRxSocket(const libcyphal::transport::udp::IpEndpoint& multicast_endpoint) override
+    {
+        auto  result = inner_.makeRxSocket(multicast_endpoint);
+        auto* socket = cetl::get_if<MakeRxSocketResult::Success>(&result);
+        if (socket == nullptr)
+        {
+            return result;
+        }
+
+        auto rx_socket = libcyphal::makeUniquePtr<IRxSocket, FaultyUdpRxSocket>(general_mr_,
+                                                                                std::move(*socket),
+                                                                                executor_,
+                                                                                general_mr_,
+                                                                                injector_);
+        if (rx_socket == nullptr)
+        {
+            return libcyphal::MemoryError{};
+        }
+        return rx_socket;
+    }
+
+    cetl::pmr::memory_resource& getTxMemoryResource() override
+    {
+        return inner_.getTxMemoryResource();
+    }
+
+    // MARK: Data members:
+
+    libcyphal::transport::udp::IMedia& inner_;
+    cetl::pmr::memory_resource&        general_mr_;
+    libcyphal::IExecutor&              executor_;
+    FaultInjector&                     injector_;
+
+};  // FaultyUdpMedia
+
+}  // namespace posix
+}  // namespace platform
+
+#endif  // PLATFORM_POSIX_FAULTY_UDP_MEDIA_HPP_INCLUDED
@@ -7,7 +7,12 @@
 #ifndef PLATFORM_POSIX_UDP_MEDIA_HPP_INCLUDED
 #define PLATFORM_POSIX_UDP_MEDIA_HPP_INCLUDED
 
+#include "faulty_udp_media.hpp"
+#include "platform/fault_injector.hpp"
+#include "platform/flight_recorder.hpp"
 #include "platform/string.hpp"
+#include "platform/tracking_memory_resource.hpp"
+#include "platform/tx_timestamp_tap.hpp"
 #include "udp_sockets.hpp"
 
 #include <cetl/pf17/cetlpf.hpp>
@@ -18,6 +23,7 @@
 
 #include <algorithm>
 #include <array>
+#include <chrono>
 #include <cstddef>
 
 namespace platform
@@ -31,11 +37,15 @@ public:
     UdpMedia(cetl::pmr::memory_resource& general_mr,
              libcyphal::IExecutor&       executor,
              const cetl::string_view     iface_address,
-             cetl::pmr::memory_resource& tx_mr)
+             cetl::pmr::memory_resource& tx_mr,
+             FlightRecorder&             flight_recorder,
+             TxTimestampTap&             tx_tap)
         : general_mr_{general_mr}
         , executor_{executor}
         , iface_address_{iface_address}
         , tx_mr_{tx_mr}
+        , flight_recorder_{flight_recorder}
+        , tx_tap_{tx_tap}
     {
     }
 
@@ -50,6 +60,9 @@ public:
         , executor_{other.executor_}
         , iface_address_{other.iface_address_}
         , tx_mr_{other.tx_mr_}
+        , flight_recorder_{other.flight_recorder_}
+        , tx_tap_{other.tx_tap_}
+        , rx_sockets_open_time_{other.rx_sockets_open_time_}
     {
     }
 
@@ -58,17 +71,28 @@ public:
         iface_address_ = iface_address;
     }
 
+    /// Gets total time spent opening RX sockets, which is dominated by the multicast group joins.
+    ///
+    std::chrono::steady_clock::duration rxSocketsOpenTime() const noexcept
+    {
+        return rx_sockets_open_time_;
+    }
+
 private:
     // MARK: - IMedia
 
     MakeTxSocketResult::Type makeTxSocket() override
     {
-        return UdpTxSocket::make(general_mr_, executor_, iface_address_.data());
+        return UdpTxSocket::make(general_mr_, executor_, iface_address_.data(), flight_recorder_, tx_tap_);
     }
 
     MakeRxSocketResult::Type makeRxSocket(const libcyphal::transport::udp::IpEndpoint& multicast_endpoint) override
     {
-        return UdpRxSocket::make(general_mr_, executor_, iface_address_.data(), multicast_endpoint);
+        const auto started_at = std::chrono::steady_clock::now();
+        auto       result =
+            UdpRxSocket::make(general_mr_, executor_, iface_address_.data(), multicast_endpoint, flight_recorder_);
+        rx_sockets_open_time_ += std::chrono::steady_clock::now() - started_at;
+        return result;
     }
 
     cetl::pmr::memory_resource& getTxMemoryResource() override
@@ -82,6 +106,10 @@ private:
     libcyphal::IExecutor&       executor_;
     String<64>                  iface_address_;
     cetl::pmr::memory_resource& tx_mr_;
+    FlightRecorder&             flight_recorder_;
+    TxTimestampTap&             tx_tap_;
+
+    std::chrono::steady_clock::duration rx_sockets_open_time_{};
 
 };  // UdpMedia
 
@@ -91,11 +119,18 @@ struct UdpMediaCollection
 {
     UdpMediaCollection(cetl::pmr::memory_resource& general_mr,
                        libcyphal::IExecutor&       executor,
-                       cetl::pmr::memory_resource& tx_mr)
-        : media_array_{{//
-                        {general_mr, executor, "", tx_mr},
-                        {general_mr, executor, "", tx_mr},
-                        {general_mr, executor, "", tx_mr}}}
+                       cetl::pmr::memory_resource& tx_mr,
+                       FlightRecorder&             flight_recorder,
+                       FaultInjector&              fault_injector,
+                       TxTimestampTap&             tx_tap)
+        : general_mr_{general_mr}
+        , executor_{executor}
+        , fault_injector_{fault_injector}
+        , tx_mrs_{{{tx_mr}, {tx_mr}, {tx_mr}}}
+        , media_array_{{//
+                        {general_mr, executor, "", tx_mrs_[0], flight_recorder, tx_tap},
+                        {general_mr, executor, "", tx_mrs_[1], flight_recorder, tx_tap},
+                        {general_mr, executor, "", tx_mrs_[2], flight_recorder, tx_tap}}}
     {
     }
 
@@ -119,9 +154,18 @@ struct UdpMediaCollection
         }
 
         media_ifaces_ = {};
+        for (std::size_t i = 0; i < MaxUdpMedia; i++)
+        {
+            faulty_media_array_[i].reset();  // NOLINT
+        }
         for (std::size_t i = 0; i < index; i++)
         {
             media_ifaces_[i] = &media_array_[i];  // NOLINT
+            if (fault_injector_.isEnabled())
+            {
+                faulty_media_array_[i].emplace(media_array_[i], general_mr_, executor_, fault_injector_);  // NOLINT
+                media_ifaces_[i] = &(faulty_media_array_[i].value());                                      // NOLINT
+            }
         }
     }
 
@@ -138,10 +182,35 @@ struct UdpMediaCollection
         });
     }
 
+    /// Gets total time spent opening RX sockets (which is dominated by the multicast group joins) of all media.
+    ///
+    std::chrono::microseconds rxSocketsOpenTime() const
+    {
+        std::chrono::steady_clock::duration total{};
+        for (const auto& media : media_array_)
+        {
+            total += media.rxSocketsOpenTime();
+        }
+        return std::chrono::duration_cast<std::chrono::microseconds>(total);
+    }
+
+    /// Gets TX memory diagnostics of the media at the given index. Number of allocated blocks is the depth
+    /// of the media TX queue, and the peak is its high-water mark.
+    ///
+    TrackingMemoryResource::Diagnostics queryTxDiagnostics(const std::size_t index) const
+    {
+        return tx_mrs_[index].queryDiagnostics();  // NOLINT
+    }
+
 private:
     static constexpr std::size_t MaxUdpMedia = 3;
 
+    cetl::pmr::memory_resource&                                 general_mr_;
+    libcyphal::IExecutor&                                       executor_;
+    FaultInjector&                                              fault_injector_;
+    std::array<TrackingMemoryResource, MaxUdpMedia>             tx_mrs_;
     std::array<UdpMedia, MaxUdpMedia>                           media_array_;
+    std::array<cetl::optional<FaultyUdpMedia>, MaxUdpMedia>     faulty_media_array_;
     std::array<libcyphal::transport::udp::IMedia*, MaxUdpMedia> media_ifaces_{};
 
 };  // UdpMediaCollection
@@ -7,9 +7,14 @@
 #ifndef PLATFORM_POSIX_UDP_SOCKETS_HPP_INCLUDED
 #define PLATFORM_POSIX_UDP_SOCKETS_HPP_INCLUDED
 
+#include "platform/flight_recorder.hpp"
+#include "platform/linux/perf_counters.hpp"
 #include "platform/posix/posix_executor_extension.hpp"
 #include "platform/posix/posix_platform_error.hpp"
+#include "platform/tracer.hpp"
+#include "platform/tx_timestamp_tap.hpp"
 #include "udp.h"
+#include "usdt.h"
 
 #include <cetl/cetl.hpp>
 #include <cetl/pf17/cetlpf.hpp>
@@ -39,7 +44,9 @@ public:
     CETL_NODISCARD static libcyphal::transport::udp::IMedia::MakeTxSocketResult::Type make(
         cetl::pmr::memory_resource& memory,
         libcyphal::IExecutor&       executor,
-        const char* const           iface_address)
+        const char* const           iface_address,
+        FlightRecorder&             flight_recorder,
+        TxTimestampTap&             tx_tap)
     {
         UDPTxHandle handle{-1};
         const auto  result = ::udpTxInit(&handle, ::udpParseIfaceAddress(iface_address));
@@ -48,7 +55,8 @@ public:
             return libcyphal::transport::PlatformError{PosixPlatformError{-result}};
         }
 
-        auto tx_socket = libcyphal::makeUniquePtr<ITxSocket, UdpTxSocket>(memory, executor, handle);
+        auto tx_socket =
+            libcyphal::makeUniquePtr<ITxSocket, UdpTxSocket>(memory, executor, handle, flight_recorder, tx_tap);
         if (tx_socket == nullptr)
         {
             ::udpTxClose(&handle);
@@ -58,9 +66,14 @@ public:
         return tx_socket;
     }
 
-    UdpTxSocket(libcyphal::IExecutor& executor, UDPTxHandle udp_handle)
+    UdpTxSocket(libcyphal::IExecutor& executor,
+                UDPTxHandle           udp_handle,
+                FlightRecorder&       flight_recorder,
+                TxTimestampTap&       tx_tap)
         : udp_handle_{udp_handle}
         , executor_{executor}
+        , flight_recorder_{flight_recorder}
+        , tx_tap_{tx_tap}
     {
         CETL_DEBUG_ASSERT(udp_handle_.fd >= 0, "");
     }
@@ -85,6 +98,8 @@ private:
     {
         CETL_DEBUG_ASSERT(udp_handle_.fd >= 0, "");
         CETL_DEBUG_ASSERT(payload_fragments.size() == 1, "");
+        PLATFORM_TRACE_SCOPE("udp.send", multicast_endpoint.udp_port);
+        PLATFORM_PERF_SCOPE("udp.send");
 
         const std::int16_t result = ::udpTxSend(&udp_handle_,
                                                 multicast_endpoint.ip_address,
@@ -92,10 +107,35 @@ private:
                                                 dscp,
                                                 payload_fragments[0].size(),
                                                 payload_fragments[0].data());
+        USDT_PROBE4(udp_tx_socket_send,
+                    udp_handle_.fd,
+                    multicast_endpoint.udp_port,
+                    payload_fragments[0].size(),
+                    result);
         if (result < 0)
         {
+            flight_recorder_.record(FlightRecorder::EventType::Error,
+                                    udp_handle_.fd,
+                                    multicast_endpoint.udp_port,
+                                    static_cast<std::uint32_t>(payload_fragments[0].size()),
+                                    -result);
             return libcyphal::transport::PlatformError{PosixPlatformError{-result}};
         }
+        if (result == 1)
+        {
+            flight_recorder_.record(FlightRecorder::EventType::UdpTx,
+                                    udp_handle_.fd,
+                                    multicast_endpoint.udp_port,
+                                    static_cast<std::uint32_t>(payload_fragments[0].size()));
+
+            // Cyphal/UDP message groups are 239.0.0.0/16 with the subject-ID in the lower 13 bits.
+            const std::uint32_t ip_address = multicast_endpoint.ip_address;
+            if ((ip_address & 0xFFFF0000UL) == 0xEF000000UL)  // NOLINT(*-magic-numbers)
+            {
+                const auto subject_id = static_cast<libcyphal::transport::PortId>(ip_address & 0x1FFFU);  // NOLINT
+                tx_tap_.onMessageTx(subject_id, executor_.now());
+            }
+        }
 
         return SendResult::Success{result == 1};
     }
@@ -119,6 +159,8 @@ private:
 
     UDPTxHandle           udp_handle_;
     libcyphal::IExecutor& executor_;
+    FlightRecorder&       flight_recorder_;
+    TxTimestampTap&       tx_tap_;
 
 };  // UdpTxSocket
 
@@ -131,7 +173,8 @@ public:
         cetl::pmr::memory_resource&                  memory,
         libcyphal::IExecutor&                        executor,
         const std::string&                           address,
-        const libcyphal::transport::udp::IpEndpoint& endpoint)
+        const libcyphal::transport::udp::IpEndpoint& endpoint,
+        FlightRecorder&                              flight_recorder)
     {
         UDPRxHandle handle{-1};
         const auto  result =
@@ -141,7 +184,8 @@ public:
             return libcyphal::transport::PlatformError{PosixPlatformError{-result}};
         }
 
-        auto rx_socket = libcyphal::makeUniquePtr<IRxSocket, UdpRxSocket>(memory, executor, handle, memory);
+        auto rx_socket =
+            libcyphal::makeUniquePtr<IRxSocket, UdpRxSocket>(memory, executor, handle, memory, flight_recorder);
         if (rx_socket == nullptr)
         {
             ::udpRxClose(&handle);
@@ -151,10 +195,14 @@ public:
         return rx_socket;
     }
 
-    UdpRxSocket(libcyphal::IExecutor& executor, UDPRxHandle udp_handle, cetl::pmr::memory_resource& memory)
+    UdpRxSocket(libcyphal::IExecutor&       executor,
+                UDPRxHandle                 udp_handle,
+                cetl::pmr::memory_resource& memory,
+                FlightRecorder&             flight_recorder)
         : udp_handle_{udp_handle}
         , executor_{executor}
         , memory_{memory}
+        , flight_recorder_{flight_recorder}
     {
         CETL_DEBUG_ASSERT(udp_handle_.fd >= 0, "");
     }
@@ -177,6 +225,8 @@ private:
     CETL_NODISCARD ReceiveResult::Type receive() override
     {
         CETL_DEBUG_ASSERT(udp_handle_.fd >= 0, "");
+        PLATFORM_TRACE_SCOPE("udp.receive", udp_handle_.fd);
+        PLATFORM_PERF_SCOPE("udp.receive");
 
         // Current Udpard api limitation is not allowing to pass bigger buffer than actual data size is.
         // Hence, we need temp buffer on stack, and then memory copying.
@@ -185,14 +235,20 @@ private:
         std::array<cetl::byte, BufferSize> buffer{};
         std::size_t                        inout_size = buffer.size();
         const std::int16_t                 result     = ::udpRxReceive(&udp_handle_, &inout_size, buffer.data());
+        USDT_PROBE3(udp_rx_socket_receive, udp_handle_.fd, (result > 0) ? inout_size : 0U, result);
         if (result < 0)
         {
+            flight_recorder_.record(FlightRecorder::EventType::Error, udp_handle_.fd, 0, 0, -result);
             return libcyphal::transport::PlatformError{PosixPlatformError{-result}};
         }
         if (result == 0)
         {
             return cetl::nullopt;
         }
+        flight_recorder_.record(FlightRecorder::EventType::UdpRx,
+                                udp_handle_.fd,
+                                0,
+                                static_cast<std::uint32_t>(inout_size));
         //
         auto* const allocated_buffer = memory_.allocate(inout_size);
         if (nullptr == allocated_buffer)
@@ -226,6 +282,7 @@ private:
     UDPRxHandle                 udp_handle_;
     libcyphal::IExecutor&       executor_;
     cetl::pmr::memory_resource& memory_;
+    FlightRecorder&             flight_recorder_;
 
 };  // UdpRxSocket
 
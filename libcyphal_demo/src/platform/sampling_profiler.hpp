@@ -0,0 +1,124 @@
+// This software is distributed under the terms of the MIT License.
+// Copyright (C) OpenCyphal Development Team  <opencyphal.org>
+// Copyright Amazon.com Inc. or its affiliates.
+// SPDX-License-Identifier: MIT
+
+#ifndef PLATFORM_SAMPLING_PROFILER_HPP_INCLUDED
+#define PLATFORM_SAMPLING_PROFILER_HPP_INCLUDED
+
+#include "sampler.h"
+
+#include <array>
+#include <cerrno>
+#include <csignal>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+
+namespace platform
+{
+
+/// Wraps the shared `SIGPROF` sampling profiler (see `shared/sampler/sampler.h`) for C++ call sites.
+///
+/// The profiler is started and stopped on demand; on stop, the captured stacks are written as folded stacks
+/// (ready for flame graphs). Besides the direct calls, the profiler could be toggled by `SIGUSR2` - the signal
+/// handler only raises a flag, and the main loop does the rest (see `takeToggleRequest`).
+///
+class SamplingProfiler final
+{
+public:
+    template <std::size_t Capacity>
+    explicit SamplingProfiler(std::array<SamplerStack, Capacity>& storage)
+    {
+        ::samplerInit(&sampler_, storage.data(), Capacity);
+    }
+
+    ~SamplingProfiler()
+    {
+        ::samplerStop(&sampler_);
+    }
+
+    SamplingProfiler(const SamplingProfiler&)                = delete;
+    SamplingProfiler(SamplingProfiler&&) noexcept            = delete;
+    SamplingProfiler& operator=(const SamplingProfiler&)     = delete;
+    SamplingProfiler& operator=(SamplingProfiler&&) noexcept = delete;
+
+    /// @return Zero on success, or a negated `errno`.
+    ///
+    std::int16_t start(const std::uint32_t rate_hz) noexcept
+    {
+        return ::samplerStart(&sampler_, rate_hz);
+    }
+
+    /// Stops sampling and writes the folded stacks to the given file.
+    ///
+    /// @return Zero on success, or a negated `errno`.
+    ///
+    std::int16_t stopAndWrite(const char* const path) noexcept
+    {
+        ::samplerStop(&sampler_);
+
+        std::FILE* const file = std::fopen(path, "w");
+        if (file == nullptr)
+        {
+            return static_cast<std::int16_t>(-errno);
+        }
+        const std::int16_t result = ::samplerWriteFolded(&sampler_, file);
+        (void) std::fclose(file);
+        return result;
+    }
+
+    bool isRunning() const noexcept
+    {
+        return sampler_.running;
+    }
+
+    std::size_t samples() const noexcept
+    {
+        return sampler_.count;
+    }
+
+    std::uint64_t dropped() const noexcept
+    {
+        return sampler_.dropped;
+    }
+
+    static void installSignalHandler() noexcept
+    {
+        struct sigaction action{};
+        action.sa_handler = &onToggleSignal;
+        (void) ::sigemptyset(&action.sa_mask);
+        (void) ::sigaction(SIGUSR2, &action, nullptr);
+    }
+
+    /// Gets (and clears) the toggle request flag raised by `SIGUSR2`. Expected to be polled by the main loop.
+    ///
+    static bool takeToggleRequest() noexcept
+    {
+        if (toggleRequested() == 0)
+        {
+            return false;
+        }
+        toggleRequested() = 0;
+        return true;
+    }
+
+private:
+    static volatile std::sig_atomic_t& toggleRequested() noexcept
+    {
+        static volatile std::sig_atomic_t flag = 0;
+        return flag;
+    }
+
+    static void onToggleSignal(const int) noexcept
+    {
+        toggleRequested() = 1;
+    }
+
+    ::Sampler sampler_{};
+
+};  // SamplingProfiler
+
+}  // namespace platform
+
+#endif  // PLATFORM_SAMPLING_PROFILER_HPP_INCLUDED
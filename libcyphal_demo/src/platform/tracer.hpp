@@ -0,0 +1,215 @@
+// This software is distributed under the terms of the MIT License.
+// Copyright (C) OpenCyphal Development Team  <opencyphal.org>
+// Copyright Amazon.com Inc. or its affiliates.
+// SPDX-License-Identifier: MIT
+
+#ifndef PLATFORM_TRACER_HPP_INCLUDED
+#define PLATFORM_TRACER_HPP_INCLUDED
+
+/// Tracing is enabled by the `ENABLE_TRACING` CMake option. When disabled, all `PLATFORM_TRACE_*` macros expand
+/// to nothing, and the `platform::Tracer` class is not even defined, so there is no runtime cost at all.
+///
+#ifndef PLATFORM_TRACING
+#    define PLATFORM_TRACING 0
+#endif
+
+#if PLATFORM_TRACING
+
+#    include <array>
+#    include <atomic>
+#    include <cerrno>
+#    include <chrono>
+#    include <cstddef>
+#    include <cstdint>
+#    include <cstdio>
+#    include <sys/syscall.h>
+#    include <unistd.h>
+
+#    define PLATFORM_TRACE_CONCAT_(a, b) a##b
+#    define PLATFORM_TRACE_CONCAT(a, b) PLATFORM_TRACE_CONCAT_(a, b)
+
+/// Traces the rest of the enclosing scope as a single slice. The name must be a string literal.
+#    define PLATFORM_TRACE_SCOPE(name, arg) \
+        const platform::Tracer::Scope PLATFORM_TRACE_CONCAT(trace_scope_, __LINE__)(name, arg)
+
+/// Traces a single point in time (f.e. a message publication). The name must be a string literal.
+#    define PLATFORM_TRACE_INSTANT(name, arg) platform::Tracer::instant(name, arg)
+
+namespace platform
+{
+
+/// Implements a low overhead recorder of the executor and media activity, exportable for timeline visualization.
+///
+/// Each thread records into its own fixed-size ring buffer (so no locking is needed on the hot path), and
+/// only the most recent events are kept. The buffers are exported in the Chrome JSON trace event format,
+/// which is loadable both by `chrome://tracing` and by the Perfetto UI (https://ui.perfetto.dev).
+///
+/// Export is expected to be done by the main thread, while all other tracing threads (if any) are still alive.
+///
+class Tracer final
+{
+public:
+    /// Records a "complete" slice on destruction, so there are never unbalanced begin/end events in the ring.
+    ///
+    class Scope final
+    {
+    public:
+        Scope(const char* const name, const std::uint64_t arg) noexcept
+            : name_{name}
+            , arg_{arg}
+            , begin_ns_{nowNs()}
+        {
+        }
+
+        ~Scope()
+        {
+            record(name_, 'X', begin_ns_, nowNs() - begin_ns_, arg_);
+        }
+
+        Scope(const Scope&)                = delete;
+        Scope(Scope&&) noexcept            = delete;
+        Scope& operator=(const Scope&)     = delete;
+        Scope& operator=(Scope&&) noexcept = delete;
+
+    private:
+        const char*   name_;
+        std::uint64_t arg_;
+        std::uint64_t begin_ns_;
+
+    };  // Scope
+
+    static void instant(const char* const name, const std::uint64_t arg) noexcept
+    {
+        record(name, 'i', nowNs(), 0, arg);
+    }
+
+    /// Writes events of all tracing threads to the given file (in the Chrome JSON format).
+    ///
+    /// @return Zero on success, or `errno` of the failed operation.
+    ///
+    static int exportChromeJson(const char* const path) noexcept
+    {
+        std::FILE* const file = std::fopen(path, "w");
+        if (file == nullptr)
+        {
+            return errno;
+        }
+
+        const long pid   = static_cast<long>(::getpid());
+        bool       first = true;
+        (void) std::fputs("{\"displayTimeUnit\":\"ns\",\"traceEvents\":[\n", file);
+
+        Registry&         registry = getRegistry();
+        const std::size_t count    = registry.count.load();
+        const std::size_t buffers  = (count < MaxThreads) ? count : MaxThreads;
+        for (std::size_t index = 0; index < buffers; ++index)
+        {
+            const Buffer* const buffer = registry.buffers[index];  // NOLINT(*-constant-array-index)
+            const std::uint64_t head   = buffer->head;
+            const std::uint64_t tail   = (head > Capacity) ? (head - Capacity) : 0;
+            for (std::uint64_t seq = tail; seq < head; ++seq)
+            {
+                const Event& event = buffer->events[seq % Capacity];  // NOLINT(*-constant-array-index)
+                (void) std::fprintf(file,
+                                    "%s{\"name\":\"%s\",\"ph\":\"%c\",\"ts\":%.3f,\"dur\":%.3f,\"pid\":%ld,"
+                                    "\"tid\":%ld,\"s\":\"t\",\"args\":{\"arg\":%llu}}",
+                                    first ? "" : ",\n",
+                                    event.name,
+                                    event.phase,
+                                    static_cast<double>(event.timestamp_ns) / 1e3,  // NOLINT(*-magic-numbers)
+                                    static_cast<double>(event.duration_ns) / 1e3,   // NOLINT(*-magic-numbers)
+                                    pid,
+                                    buffer->tid,
+                                    static_cast<unsigned long long>(event.arg));  // NOLINT(google-runtime-int)
+                first = false;
+            }
+        }
+        (void) std::fputs("\n]}\n", file);
+
+        const int err = (std::ferror(file) != 0) ? EIO : 0;
+        (void) std::fclose(file);
+        return err;
+    }
+
+private:
+    static constexpr std::size_t Capacity   = 8192;
+    static constexpr std::size_t MaxThreads = 8;
+
+    struct Event final
+    {
+        const char*   name;
+        std::uint64_t timestamp_ns;
+        std::uint64_t duration_ns;
+        std::uint64_t arg;
+        char          phase;
+    };
+
+    struct Buffer final
+    {
+        std::array<Event, Capacity> events;
+        std::uint64_t               head;
+        long                        tid;  // NOLINT(google-runtime-int)
+        bool                        is_registered;
+    };
+
+    struct Registry final
+    {
+        std::atomic<std::size_t>        count;
+        std::array<Buffer*, MaxThreads> buffers;
+    };
+
+    static Registry& getRegistry() noexcept
+    {
+        static Registry registry{};
+        return registry;
+    }
+
+    static std::uint64_t nowNs() noexcept
+    {
+        const auto now = std::chrono::steady_clock::now().time_since_epoch();
+        return static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(now).count());
+    }
+
+    static void record(const char* const   name,
+                       const char          phase,
+                       const std::uint64_t timestamp_ns,
+                       const std::uint64_t duration_ns,
+                       const std::uint64_t arg) noexcept
+    {
+        // Trivially constructible, so there is no hidden TLS initialization guard on the hot path.
+        static thread_local Buffer buffer;
+        if (!buffer.is_registered)
+        {
+            buffer.is_registered = true;
+            buffer.tid           = ::syscall(SYS_gettid);
+
+            // Threads beyond the registry capacity are still traced, but not exported.
+            Registry&         registry = getRegistry();
+            const std::size_t index    = registry.count.fetch_add(1);
+            if (index < MaxThreads)
+            {
+                registry.buffers[index] = &buffer;  // NOLINT(*-constant-array-index)
+            }
+        }
+
+        Event& event       = buffer.events[buffer.head % Capacity];  // NOLINT(*-constant-array-index)
+        event.name         = name;
+        event.timestamp_ns = timestamp_ns;
+        event.duration_ns  = duration_ns;
+        event.arg          = arg;
+        event.phase        = phase;
+        ++buffer.head;
+    }
+
+};  // Tracer
+
+}  // namespace platform
+
+#else  // PLATFORM_TRACING
+
+#    define PLATFORM_TRACE_SCOPE(name, arg)
+#    define PLATFORM_TRACE_INSTANT(name, arg)
+
+#endif  // PLATFORM_TRACING
+
+#endif  // PLATFORM_TRACER_HPP_INCLUDED
@@ -0,0 +1,101 @@
+// This software is distributed under the terms of the MIT License.
+// Copyright (C) OpenCyphal Development Team  <opencyphal.org>
+// Copyright Amazon.com Inc. or its affiliates.
+// SPDX-License-Identifier: MIT
+
+#ifndef PLATFORM_TRACKING_MEMORY_RESOURCE_HPP_INCLUDED
+#define PLATFORM_TRACKING_MEMORY_RESOURCE_HPP_INCLUDED
+
+#include <cetl/cetl.hpp>
+#include <cetl/pf17/cetlpf.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+
+namespace platform
+{
+
+/// Implements a C++17 PMR memory resource which forwards to an upstream one, and tracks outstanding allocations.
+///
+/// In use as a per-media view of the shared media block memory - every TX frame enqueued for a media holds
+/// exactly one block until it's sent, so number of outstanding allocations is the depth of the media TX queue,
+/// and its peak is the queue high-water mark.
+///
+class TrackingMemoryResource final : public cetl::pmr::memory_resource
+{
+public:
+    struct Diagnostics final
+    {
+        std::size_t   allocated;
+        std::size_t   peak_allocated;
+        std::uint64_t oom_count;
+
+    };  // Diagnostics
+
+    // Intentionally implicit - allows aggregate initialization of arrays of these (see media collections).
+    // NOLINTNEXTLINE(google-explicit-constructor,hicpp-explicit-conversions)
+    TrackingMemoryResource(cetl::pmr::memory_resource& upstream)
+        : upstream_{upstream}
+    {
+    }
+
+    ~TrackingMemoryResource() override = default;
+
+    TrackingMemoryResource(TrackingMemoryResource&&)                 = delete;
+    TrackingMemoryResource(const TrackingMemoryResource&)            = delete;
+    TrackingMemoryResource& operator=(TrackingMemoryResource&&)      = delete;
+    TrackingMemoryResource& operator=(const TrackingMemoryResource&) = delete;
+
+    Diagnostics queryDiagnostics() const noexcept
+    {
+        return {allocated_, peak_allocated_, oom_count_};
+    }
+
+protected:
+    // MARK: cetl::pmr::memory_resource
+
+    void* do_allocate(std::size_t size_bytes, std::size_t alignment) override  // NOLINT
+    {
+        void* const out = upstream_.allocate(size_bytes, alignment);
+        if (size_bytes > 0U)
+        {
+            if (out == nullptr)
+            {
+                oom_count_++;
+            }
+            else
+            {
+                allocated_++;
+                peak_allocated_ = std::max(peak_allocated_, allocated_);
+            }
+        }
+        return out;
+    }
+
+    void do_deallocate(void* ptr, std::size_t size_bytes, std::size_t alignment) override  // NOLINT
+    {
+        if ((ptr != nullptr) && (size_bytes > 0U))
+        {
+            CETL_DEBUG_ASSERT(allocated_ > 0U, "");
+            allocated_--;
+        }
+        upstream_.deallocate(ptr, size_bytes, alignment);
+    }
+
+    bool do_is_equal(const cetl::pmr::memory_resource& other) const noexcept override
+    {
+        return this == &other;
+    }
+
+private:
+    cetl::pmr::memory_resource& upstream_;
+    std::size_t                 allocated_{0U};
+    std::size_t                 peak_allocated_{0U};
+    std::uint64_t               oom_count_{0U};
+
+};  // TrackingMemoryResource
+
+}  // namespace platform
+
+#endif  // PLATFORM_TRACKING_MEMORY_RESOURCE_HPP_INCLUDED
@@ -0,0 +1,60 @@
+// This software is distributed under the terms of the MIT License.
+// Copyright (C) OpenCyphal Development Team  <opencyphal.org>
+// Copyright Amazon.com Inc. or its affiliates.
+// SPDX-License-Identifier: MIT
+
+#ifndef PLATFORM_TX_TIMESTAMP_TAP_HPP_INCLUDED
+#define PLATFORM_TX_TIMESTAMP_TAP_HPP_INCLUDED
+
+#include <cetl/pf17/cetlpf.hpp>
+#include <libcyphal/transport/types.hpp>
+#include <libcyphal/types.hpp>
+
+namespace platform
+{
+
+/// Captures the time when a frame of the watched subject has been handed over to the media socket
+/// (see `Linux::CanMedia::push` and `posix::UdpTxSocket::send`), so that a publisher could learn the actual
+/// transmission time of its message rather than the time it has been enqueued into the transport.
+///
+/// Only the first frame since the previous `take` is captured, so with redundant media the earliest one wins.
+///
+class TxTimestampTap final
+{
+public:
+    /// Starts watching the given subject (only one at a time), and forgets anything captured so far.
+    ///
+    void watch(const libcyphal::transport::PortId subject_id) noexcept
+    {
+        subject_id_ = subject_id;
+        captured_at_.reset();
+    }
+
+    /// Called by the media when a message frame has been accepted by the socket.
+    ///
+    void onMessageTx(const libcyphal::transport::PortId subject_id, const libcyphal::TimePoint tx_at) noexcept
+    {
+        if ((subject_id_ == subject_id) && !captured_at_.has_value())
+        {
+            captured_at_ = tx_at;
+        }
+    }
+
+    /// Takes the captured time (if any), so that the next frame of the subject could be captured.
+    ///
+    cetl::optional<libcyphal::TimePoint> take() noexcept
+    {
+        const auto captured_at = captured_at_;
+        captured_at_.reset();
+        return captured_at;
+    }
+
+private:
+    cetl::optional<libcyphal::transport::PortId> subject_id_;
+    cetl::optional<libcyphal::TimePoint>          captured_at_;
+
+};  // TxTimestampTap
+
+}  // namespace platform
+
+#endif  // PLATFORM_TX_TIMESTAMP_TAP_HPP_INCLUDED
@@ -0,0 +1,146 @@
+// This software is distributed under the terms of the MIT License.
+// Copyright (C) OpenCyphal Development Team  <opencyphal.org>
+// Copyright Amazon.com Inc. or its affiliates.
+// SPDX-License-Identifier: MIT
+
+#ifndef STARTUP_PROFILER_HPP_INCLUDED
+#define STARTUP_PROFILER_HPP_INCLUDED
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <iomanip>
+#include <ostream>
+
+/// Records monotonic timestamps of the node startup phases.
+///
+/// The origin is the profiler construction (expected to be the very first thing in `main`),
+/// and each `mark` records end of a phase. Marks beyond `MaxPhases` are ignored.
+/// Some work is spread over several phases (f.e. multicast joins happen on each session creation), so its total
+/// duration is `account`-ed separately, and reported as included into the phases.
+/// The profiler doesn't allocate, so it could be used before any memory resource is set up.
+///
+class StartupProfiler final
+{
+public:
+    static constexpr std::size_t MaxPhases    = 16;
+    static constexpr std::size_t MaxAccounted = 4;
+
+    using Clock = std::chrono::steady_clock;
+
+    /// Marks end of a phase on construction - to mark phases in between of member initializations.
+    ///
+    struct Mark final
+    {
+        Mark(StartupProfiler& profiler, const char* const phase) noexcept
+        {
+            profiler.mark(phase);
+        }
+    };
+
+    StartupProfiler()
+        : origin_{Clock::now()}
+    {
+    }
+
+    /// Records end of the phase. The `phase` string must have static storage duration.
+    ///
+    void mark(const char* const phase) noexcept
+    {
+        if (count_ < MaxPhases)
+        {
+            phases_[count_++] = {phase, Clock::now()};  // NOLINT(*-constant-array-index)
+        }
+    }
+
+    /// Records total duration of the work spread over several phases. The `phase` string must have static storage
+    /// duration. Repeated calls for the same phase replace the previous duration.
+    ///
+    void account(const char* const phase, const std::chrono::microseconds duration) noexcept
+    {
+        for (std::size_t i = 0; i < accounted_count_; ++i)
+        {
+            if (accounted_[i].name == phase)  // NOLINT(*-constant-array-index)
+            {
+                accounted_[i].duration = duration;  // NOLINT(*-constant-array-index)
+                return;
+            }
+        }
+        if (accounted_count_ < MaxAccounted)
+        {
+            accounted_[accounted_count_++] = {phase, duration};  // NOLINT(*-constant-array-index)
+        }
+    }
+
+    std::size_t count() const noexcept
+    {
+        return count_;
+    }
+
+    /// Gets offset of the phase end since the origin.
+    ///
+    std::chrono::microseconds offsetOf(const std::size_t index) const noexcept
+    {
+        return (index < count_) ? toMicroseconds(phases_[index].end - origin_)  // NOLINT(*-constant-array-index)
+                                : std::chrono::microseconds::zero();
+    }
+
+    /// Gets offset of the most recent phase end since the origin.
+    ///
+    std::chrono::microseconds total() const noexcept
+    {
+        return (count_ > 0) ? offsetOf(count_ - 1) : std::chrono::microseconds::zero();
+    }
+
+    void printTo(std::ostream& os) const
+    {
+        os << "Startup phases:\n";
+        std::chrono::microseconds prev{0};
+        for (std::size_t i = 0; i < count_; ++i)
+        {
+            const auto offset = offsetOf(i);
+            os << "  " << std::left << std::setw(MaxPhaseNameWidth) << phases_[i].name  // NOLINT
+               << std::right << std::setw(8) << (offset - prev).count() << "us"         // NOLINT
+               << "  (at " << offset.count() << "us)\n";
+            prev = offset;
+        }
+        for (std::size_t i = 0; i < accounted_count_; ++i)
+        {
+            os << "  " << std::left << std::setw(MaxPhaseNameWidth) << accounted_[i].name  // NOLINT
+               << std::right << std::setw(8) << accounted_[i].duration.count() << "us"    // NOLINT
+               << "  (included above)\n";
+        }
+    }
+
+private:
+    static constexpr int MaxPhaseNameWidth = 24;
+
+    struct Phase
+    {
+        const char*       name;
+        Clock::time_point end;
+    };
+
+    struct Accounted
+    {
+        const char*               name;
+        std::chrono::microseconds duration;
+    };
+
+    static std::chrono::microseconds toMicroseconds(const Clock::duration duration) noexcept
+    {
+        return std::chrono::duration_cast<std::chrono::microseconds>(duration);
+    }
+
+    // MARK: Data members:
+
+    Clock::time_point                   origin_;
+    std::size_t                         count_{0};
+    std::array<Phase, MaxPhases>        phases_{};
+    std::size_t                         accounted_count_{0};
+    std::array<Accounted, MaxAccounted> accounted_{};
+
+};  // StartupProfiler
+
+#endif  // STARTUP_PROFILER_HPP_INCLUDED
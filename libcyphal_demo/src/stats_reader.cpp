@@ -0,0 +1,67 @@
+// This software is distributed under the terms of the MIT License.
+// Copyright (C) OpenCyphal Development Team  <opencyphal.org>
+// Copyright Amazon.com Inc. or its affiliates.
+// SPDX-License-Identifier: MIT
+
+/// Prints the statistics page published by the demo node (see `demo.stats.shm` register).
+///
+/// Usage: stats_reader <shm_name> [period_ms]
+///
+/// With zero (default) period a single snapshot is printed; otherwise snapshots are printed periodically.
+/// The reader never writes to the page, so it doesn't affect the node.
+
+#include "platform/posix/shm_stats_page.hpp"
+
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <unistd.h>
+
+// NOLINTBEGIN(cppcoreguidelines-avoid-magic-numbers, readability-magic-numbers)
+
+int main(const int argc, char* const argv[])
+{
+    if (argc < 2)
+    {
+        std::cerr << "Usage: " << argv[0] << " <shm_name> [period_ms]\n";  // NOLINT
+        return 1;
+    }
+    const char* const   shm_name  = argv[1];                                              // NOLINT
+    const unsigned long period_ms = (argc > 2) ? std::strtoul(argv[2], nullptr, 10) : 0;  // NOLINT
+
+    platform::posix::ShmStatsPageReader reader;
+    if (const int err = reader.open(shm_name))
+    {
+        std::cerr << "❌ Failed to open '" << shm_name << "': " << std::strerror(err) << "\n";
+        return 2;
+    }
+
+    platform::posix::ShmStatsPageReader::Snapshot snapshot{};
+    do
+    {
+        if (!reader.read(snapshot))
+        {
+            std::cerr << "⚠️ No consistent snapshot (page is not initialized or is being reset).\n";
+        }
+        else
+        {
+            std::cout << "-----------\n";
+            for (std::size_t i = 0; i < snapshot.counters_count; ++i)
+            {
+                std::cout << "  " << snapshot.names[i].data() << "=" << snapshot.values[i] << "\n";  // NOLINT
+            }
+            std::cout << std::flush;
+        }
+
+        if (period_ms > 0)
+        {
+            (void) ::usleep(static_cast<useconds_t>(period_ms * 1000UL));
+        }
+
+    } while (period_ms > 0);
+
+    return 0;
+}
+
+// NOLINTEND(cppcoreguidelines-avoid-magic-numbers, readability-magic-numbers)
@@ -0,0 +1,330 @@
+// This software is distributed under the terms of the MIT License.
+// Copyright (C) OpenCyphal Development Team  <opencyphal.org>
+// Copyright Amazon.com Inc. or its affiliates.
+// SPDX-License-Identifier: MIT
+
+#ifndef TIME_SYNC_HPP_INCLUDED
+#define TIME_SYNC_HPP_INCLUDED
+
+#include "platform/tracer.hpp"
+#include "platform/tx_timestamp_tap.hpp"
+
+#include <cetl/pf17/cetlpf.hpp>
+#include <libcyphal/executor.hpp>
+#include <libcyphal/presentation/presentation.hpp>
+#include <libcyphal/presentation/publisher.hpp>
+#include <libcyphal/presentation/subscriber.hpp>
+#include <libcyphal/transport/msg_sessions.hpp>
+#include <libcyphal/transport/types.hpp>
+#include <libcyphal/types.hpp>
+
+#include <uavcan/time/Synchronization_1_0.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <limits>
+#include <utility>
+
+/// Implements the `uavcan.time.Synchronization` master.
+///
+/// Each published message carries the transmission timestamp of the previous one (see the DSDL definition),
+/// so the master has to be published periodically (at 1 Hz - on the heartbeat update). The timestamp is the
+/// executor monotonic time captured by the media when the message frame has been handed over to the socket
+/// (see `platform::TxTimestampTap`), so neither the transport TX queue nor the executor latency adds to the error.
+///
+class TimeSyncMaster final
+{
+public:
+    using Message   = uavcan::time::Synchronization_1_0;
+    using Publisher = libcyphal::presentation::Publisher<Message>;
+
+    static auto make(libcyphal::presentation::Presentation& presentation,
+                     libcyphal::IExecutor&                  executor,
+                     platform::TxTimestampTap&              tx_tap)
+        -> libcyphal::Expected<TimeSyncMaster, libcyphal::presentation::Presentation::MakeFailure>
+    {
+        auto maybe_pub = presentation.makePublisher<Message>(Message::_traits_::FixedPortId);
+        if (auto* const failure = cetl::get_if<libcyphal::presentation::Presentation::MakeFailure>(&maybe_pub))
+        {
+            return std::move(*failure);
+        }
+
+        tx_tap.watch(Message::_traits_::FixedPortId);
+        return TimeSyncMaster{presentation, executor, tx_tap, cetl::get<Publisher>(std::move(maybe_pub))};
+    }
+
+    /// Publishes the next synchronization message.
+    ///
+    void publish()
+    {
+        // Zero tells the slaves that there is no valid timestamp (f.e. the previous message was not sent).
+        const auto previous_tx_at = tx_tap_.take();
+
+        Message message{alloc_};
+        message.previous_transmission_timestamp_microsecond =
+            previous_tx_at.has_value() ? (toMicroseconds(*previous_tx_at) & MaxTimestampUs) : 0;
+
+        (void) publisher_.publish(executor_.now() + std::chrono::seconds{1}, message);
+        PLATFORM_TRACE_INSTANT("publish.time_sync", published_);
+        ++published_;
+    }
+
+    std::uint64_t published() const noexcept
+    {
+        return published_;
+    }
+
+private:
+    static constexpr std::uint64_t MaxTimestampUs = (1ULL << 56U) - 1U;  // `truncated uint56`
+
+    TimeSyncMaster(libcyphal::presentation::Presentation& presentation,
+                   libcyphal::IExecutor&                  executor,
+                   platform::TxTimestampTap&              tx_tap,
+                   Publisher&&                            publisher)
+        : alloc_{&presentation.memory()}
+        , executor_{executor}
+        , tx_tap_{tx_tap}
+        , publisher_{std::move(publisher)}
+    {
+    }
+
+    static std::uint64_t toMicroseconds(const libcyphal::TimePoint time_point)
+    {
+        const auto us = std::chrono::duration_cast<std::chrono::microseconds>(time_point.time_since_epoch());
+        return static_cast<std::uint64_t>(std::max<std::int64_t>(us.count(), 0));
+    }
+
+    // MARK: Data members:
+
+    Message::allocator_type   alloc_;
+    libcyphal::IExecutor&     executor_;
+    platform::TxTimestampTap& tx_tap_;
+    Publisher                 publisher_;
+    std::uint64_t             published_{0};
+
+};  // TimeSyncMaster
+
+// MARK: -
+
+/// Implements the `uavcan.time.Synchronization` slave.
+///
+/// The slave locks onto a single master (the first one heard; another master is accepted only after the current one
+/// has been silent for `MasterTimeoutSec`). A sample of the master-to-local clock offset is made of the RX timestamp of
+/// a message, and the master TX timestamp of it carried by the next message (with the consecutive transfer-ID,
+/// modulo the transfer-ID range of the transport - f.e. 32 on CAN).
+/// The RX timestamps come from the media, which use kernel timestamps where available (see `CanMedia::pop`).
+///
+/// The offset and the relative drift are disciplined with an alpha-beta filter. The residual of each sample
+/// against the prediction is the achieved offset error; the synchronization is considered converged once the error
+/// stays below `ConvergedErrorUs` for `ConvergedSamples` consecutive samples.
+///
+class TimeSyncSlave final
+{
+public:
+    using Message    = uavcan::time::Synchronization_1_0;
+    using Subscriber = libcyphal::presentation::Subscriber<Message>;
+
+    struct Metrics final
+    {
+        std::uint64_t samples;              ///< Number of offset samples taken.
+        std::int64_t  offset_us;            ///< Estimated master time minus local time.
+        std::int64_t  drift_ppb;            ///< Estimated master clock rate relative to the local one.
+        std::int64_t  last_error_us;        ///< Residual of the last sample.
+        std::int64_t  max_abs_error_us;     ///< Worst residual since the convergence, or zero.
+        std::int64_t  convergence_time_us;  ///< Time from the first sample to the convergence, or -1.
+        std::int64_t  master_node_id;       ///< Node-ID of the master, or -1.
+    };
+
+    static auto make(libcyphal::presentation::Presentation& presentation,
+                     const libcyphal::transport::TransferId transfer_id_modulo)
+        -> libcyphal::Expected<TimeSyncSlave, libcyphal::presentation::Presentation::MakeFailure>
+    {
+        auto maybe_sub = presentation.makeSubscriber<Message>(Message::_traits_::FixedPortId);
+        if (auto* const failure = cetl::get_if<libcyphal::presentation::Presentation::MakeFailure>(&maybe_sub))
+        {
+            return std::move(*failure);
+        }
+
+        return TimeSyncSlave{cetl::get<Subscriber>(std::move(maybe_sub)), transfer_id_modulo};
+    }
+
+    TimeSyncSlave(TimeSyncSlave&& other) noexcept
+        : subscriber_{std::move(other.subscriber_)}
+        , transfer_id_modulo_{other.transfer_id_modulo_}
+        , state_{other.state_}
+    {
+        // We have to set up receive callback again (b/c it captures its own `this` pointer),
+        setupOnReceiveCallback();
+    }
+
+    ~TimeSyncSlave() = default;
+
+    TimeSyncSlave(const TimeSyncSlave&)                = delete;
+    TimeSyncSlave& operator=(const TimeSyncSlave&)     = delete;
+    TimeSyncSlave& operator=(TimeSyncSlave&&) noexcept = delete;
+
+    /// Gets the synchronized (master) time corresponding to the given local time. Valid only after the first sample.
+    ///
+    libcyphal::TimePoint toMasterTime(const libcyphal::TimePoint local_time) const noexcept
+    {
+        const double elapsed_us = toMicroseconds(local_time - state_.last_sample_at);
+        return local_time + std::chrono::microseconds{static_cast<std::int64_t>(state_.offset_us +  //
+                                                                                 (state_.drift * elapsed_us))};
+    }
+
+    Metrics getMetrics() const noexcept
+    {
+        return {state_.samples,
+                static_cast<std::int64_t>(state_.offset_us),
+                static_cast<std::int64_t>(state_.drift * 1e9),  // NOLINT(*-magic-numbers)
+                state_.last_error_us,
+                state_.max_abs_error_us,
+                state_.convergence_time_us,
+                state_.master_node_id.has_value() ? static_cast<std::int64_t>(state_.master_node_id.value()) : -1};
+    }
+
+private:
+    static constexpr std::int64_t MasterTimeoutSec = 3;
+    static constexpr double       Alpha            = 0.5;   ///< Gain of the offset correction.
+    static constexpr double       Beta             = 0.05;  ///< Gain of the drift correction.
+    static constexpr std::int64_t ConvergedErrorUs = 100;
+    static constexpr std::uint8_t ConvergedSamples = 3;
+
+    struct State final
+    {
+        cetl::optional<libcyphal::transport::NodeId> master_node_id;
+        libcyphal::transport::TransferId             previous_transfer_id{0};
+        libcyphal::TimePoint                         previous_rx_at{};  ///< Zero if there is no previous message.
+        libcyphal::TimePoint                         first_sample_at{};
+        libcyphal::TimePoint                         last_sample_at{};
+        double                                       offset_us{0};
+        double                                       drift{0};
+        std::uint64_t                                samples{0};
+        std::int64_t                                 last_error_us{0};
+        std::int64_t                                 max_abs_error_us{0};
+        std::int64_t                                 convergence_time_us{-1};
+        std::uint8_t                                 good_samples{0};
+    };
+
+    TimeSyncSlave(Subscriber&& subscriber, const libcyphal::transport::TransferId transfer_id_modulo)
+        : subscriber_{std::move(subscriber)}
+        , transfer_id_modulo_{transfer_id_modulo}
+    {
+        setupOnReceiveCallback();
+    }
+
+    void setupOnReceiveCallback()
+    {
+        subscriber_.setOnReceiveCallback([this](const auto& arg) {
+            //
+            onMessage(arg.message, arg.metadata);
+        });
+    }
+
+    void onMessage(const Message& message, const libcyphal::transport::MessageRxMetadata& metadata)
+    {
+        PLATFORM_TRACE_SCOPE("time_sync.rx", state_.samples);
+
+        if (!metadata.publisher_node_id.has_value())
+        {
+            return;  // Anonymous masters are not allowed.
+        }
+        const auto master_node_id = metadata.publisher_node_id.value();
+        const auto rx_at          = metadata.rx_meta.timestamp;
+        const auto transfer_id    = metadata.rx_meta.base.transfer_id;
+
+        if (state_.master_node_id != master_node_id)
+        {
+            const bool is_master_lost = (rx_at - state_.previous_rx_at) > std::chrono::seconds{MasterTimeoutSec};
+            if (state_.master_node_id.has_value() && !is_master_lost)
+            {
+                return;  // Ignore other masters while the current one is alive.
+            }
+            state_                = State{};
+            state_.master_node_id = master_node_id;
+        }
+        else if (isNextTransferId(transfer_id) &&
+                 (state_.previous_rx_at != libcyphal::TimePoint{}) &&
+                 (message.previous_transmission_timestamp_microsecond > 0))
+        {
+            const auto previous_tx_us = static_cast<double>(message.previous_transmission_timestamp_microsecond);
+            onSample(previous_tx_us - toMicroseconds(state_.previous_rx_at.time_since_epoch()), state_.previous_rx_at);
+        }
+
+        state_.previous_transfer_id = transfer_id;
+        state_.previous_rx_at       = rx_at;
+    }
+
+    /// Zero or the maximum value of the modulo means that transfer-IDs use the whole 64-bit range (f.e. on UDP).
+    ///
+    bool isNextTransferId(const libcyphal::transport::TransferId transfer_id) const noexcept
+    {
+        const libcyphal::transport::TransferId next = state_.previous_transfer_id + 1U;
+        if ((transfer_id_modulo_ == 0) ||
+            (transfer_id_modulo_ == std::numeric_limits<libcyphal::transport::TransferId>::max()))
+        {
+            return transfer_id == next;
+        }
+        return transfer_id == (next % transfer_id_modulo_);
+    }
+
+    void onSample(const double offset_us, const libcyphal::TimePoint sampled_at)
+    {
+        if (state_.samples == 0)
+        {
+            state_.offset_us       = offset_us;
+            state_.first_sample_at = sampled_at;
+        }
+        else
+        {
+            const double elapsed_us = toMicroseconds(sampled_at - state_.last_sample_at);
+            const double predicted  = state_.offset_us + (state_.drift * elapsed_us);
+            const double error      = offset_us - predicted;
+
+            state_.offset_us = predicted + (Alpha * error);
+            if (elapsed_us > 0)
+            {
+                state_.drift += Beta * error / elapsed_us;
+            }
+            updateConvergence(static_cast<std::int64_t>(error), sampled_at);
+        }
+        state_.last_sample_at = sampled_at;
+        ++state_.samples;
+    }
+
+    void updateConvergence(const std::int64_t error_us, const libcyphal::TimePoint sampled_at)
+    {
+        const std::int64_t abs_error_us = std::abs(error_us);
+        state_.last_error_us            = error_us;
+
+        if (state_.convergence_time_us >= 0)
+        {
+            state_.max_abs_error_us = std::max(state_.max_abs_error_us, abs_error_us);
+            return;
+        }
+        state_.good_samples =
+            (abs_error_us < ConvergedErrorUs) ? static_cast<std::uint8_t>(state_.good_samples + 1U) : std::uint8_t{0};
+        if (state_.good_samples >= ConvergedSamples)
+        {
+            const double convergence_time_us = toMicroseconds(sampled_at - state_.first_sample_at);
+            state_.convergence_time_us       = static_cast<std::int64_t>(convergence_time_us);
+            state_.max_abs_error_us          = abs_error_us;
+        }
+    }
+
+    static double toMicroseconds(const libcyphal::Duration duration)
+    {
+        return static_cast<double>(std::chrono::duration_cast<std::chrono::microseconds>(duration).count());
+    }
+
+    // MARK: Data members:
+
+    Subscriber                       subscriber_;
+    libcyphal::transport::TransferId transfer_id_modulo_;
+    State                            state_;
+
+};  // TimeSyncSlave
+
+#endif  // TIME_SYNC_HPP_INCLUDED
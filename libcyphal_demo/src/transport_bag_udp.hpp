@@ -8,8 +8,14 @@
 #define TRANSPORT_BAG_UDP_HPP_INCLUDED
 
 #include "application.hpp"
+#include "platform/binlog.hpp"
 #include "platform/block_memory_resource.hpp"
 #include "platform/common_helpers.hpp"
+#include "platform/fault_injector.hpp"
+#include "platform/flight_recorder.hpp"
+#include "platform/tracking_memory_resource.hpp"
+#include "platform/tx_timestamp_tap.hpp"
+#include "startup_profiler.hpp"
 #include "platform/posix/udp/udp_media.hpp"
 
 #include <cetl/pf17/cetlpf.hpp>
@@ -19,6 +25,7 @@
 #include <libcyphal/transport/udp/udp_transport_impl.hpp>
 #include <libcyphal/types.hpp>
 
+#include <chrono>
 #include <cstddef>
 #include <iostream>
 #include <utility>
@@ -29,23 +36,35 @@ struct TransportBagUdp final
 {
     TransportBagUdp(cetl::pmr::memory_resource&    general_memory,
                     libcyphal::IExecutor&          executor,
-                    platform::BlockMemoryResource& media_block_mr)
+                    platform::BlockMemoryResource& media_block_mr,
+                    platform::BinLog&              log,
+                    platform::FlightRecorder&      flight_recorder,
+                    platform::FaultInjector&       fault_injector,
+                    platform::TxTimestampTap&      tx_tap)
         : general_mr_{general_memory}
         , executor_{executor}
         , media_block_mr_{media_block_mr}
-        , media_collection_{general_memory, executor, media_block_mr}
+        , log_{log}
+        , media_collection_{general_memory, executor, media_block_mr, flight_recorder, fault_injector, tx_tap}
     {
     }
 
-    libcyphal::transport::udp::IUdpTransport* create(const Application::IfaceParams& params)
+    /// Opens the media and creates the transport on top of them; the former is marked as a startup phase.
+    ///
+    libcyphal::transport::udp::IUdpTransport* create(const Application::IfaceParams& params,
+                                                     StartupProfiler&                startup_profiler)
     {
         if (params.udp_iface.value().empty())
         {
             return nullptr;
         }
 
+        const std::size_t tx_queue_capacity =
+            platform::CommonHelpers::validateTxQueueCapacity(params.tx_queue_capacity.value()[0]);
+
         media_collection_.parse(params.udp_iface.value());
-        auto maybe_udp_transport = makeTransport({general_mr_}, executor_, media_collection_.span(), TxQueueCapacity);
+        startup_profiler.mark("udp.media_open");
+        auto maybe_udp_transport = makeTransport({general_mr_}, executor_, media_collection_.span(), tx_queue_capacity);
         if (const auto* failure = cetl::get_if<libcyphal::transport::FactoryFailure>(&maybe_udp_transport))
         {
             std::cerr << "❌ Failed to create UDP transport (iface='"
@@ -58,26 +77,61 @@ struct TransportBagUdp final
         std::cout << "UDP Iface : '" << params.udp_iface.value().c_str() << "'\n";
         const std::size_t mtu = transport_->getProtocolParams().mtu_bytes;
         std::cout << "Iface MTU : " << mtu << "\n";
+        std::cout << "TX Queue  : " << tx_queue_capacity << "\n";
 
         // Udpard allocates memory for raw bytes block only, so there is no alignment requirement.
         constexpr std::size_t block_alignment = 1;
         const std::size_t     block_size      = mtu;
-        const std::size_t     pool_size       = media_collection_.count() * TxQueueCapacity * block_size;
+        const std::size_t     pool_size       = media_collection_.count() * tx_queue_capacity * block_size;
         media_block_mr_.setup(pool_size, block_size, block_alignment);
 
-        transport_->setTransientErrorHandler(platform::CommonHelpers::Udp::transientErrorReporter);
+        transport_->setTransientErrorHandler([this](auto& report_var) {
+            //
+            return platform::CommonHelpers::Udp::transientErrorReporter(report_var, transient_error_counters_, log_);
+        });
 
         return transport_.get();
     }
 
-private:
-    static constexpr std::size_t TxQueueCapacity = 16;
+    CETL_NODISCARD const platform::CommonHelpers::TransientErrorCounters& transientErrorCounters() const noexcept
+    {
+        return transient_error_counters_;
+    }
 
+    /// Logs how many transient errors were suppressed (as part of an error storm) since the previous summary.
+    ///
+    void summarizeTransientErrors() noexcept
+    {
+        transient_error_counters_.summarize(log_, &platform::CommonHelpers::Udp::describeErrorKind);
+    }
+
+    /// Gets total time spent on the multicast group joins (as a part of the RX socket opening) so far.
+    ///
+    CETL_NODISCARD std::chrono::microseconds multicastJoinsTime() const
+    {
+        return media_collection_.rxSocketsOpenTime();
+    }
+
+    CETL_NODISCARD std::size_t mediaCount() const
+    {
+        return media_collection_.count();
+    }
+
+    /// Gets TX queue diagnostics (current depth and high-water mark) of the media at the given index.
+    ///
+    CETL_NODISCARD platform::TrackingMemoryResource::Diagnostics queryTxQueueDiagnostics(const std::size_t index) const
+    {
+        return media_collection_.queryTxDiagnostics(index);
+    }
+
+private:
     cetl::pmr::memory_resource&                                    general_mr_;
     libcyphal::IExecutor&                                          executor_;
     platform::BlockMemoryResource&                                 media_block_mr_;
+    platform::BinLog&                                              log_;
     platform::posix::UdpMediaCollection                            media_collection_;
     libcyphal::UniquePtr<libcyphal::transport::udp::IUdpTransport> transport_;
+    platform::CommonHelpers::TransientErrorCounters                transient_error_counters_;
 
 };  // TransportBagUdp
 
@@ -0,0 +1,257 @@
+///                            ____                   ______            __          __
+///                           / __ `____  ___  ____  / ____/_  ______  / /_  ____  / /
+///                          / / / / __ `/ _ `/ __ `/ /   / / / / __ `/ __ `/ __ `/ /
+///                         / /_/ / /_/ /  __/ / / / /___/ /_/ / /_/ / / / / /_/ / /
+///                         `____/ .___/`___/_/ /_/`____/`__, / .___/_/ /_/`__,_/_/
+///                             /_/                     /____/_/
+///
+/// Measures the Nunavut-generated C (de)serialization of the types which the demos exchange most often:
+/// heartbeats, register access (string and array values), node info, UDRAL servo setpoint and readiness,
+/// and file reads. One JSON object per type is printed:
+///
+///     {"lang":"c","type":"uavcan.node.Heartbeat.1.0","bytes":7,
+///      "serialize":{"ns":..,"ns_per_byte":..},"deserialize":{"ns":..,"ns_per_byte":..}}
+///
+/// The format is the same as of the C++ counterpart (see libcyphal_demo/bench/bench_dsdl.cpp), so the generated code
+/// of both languages could be compared directly. Unlike C++, the C objects have fixed size, so there is no allocation.
+///
+/// This software is distributed under the terms of the MIT License.
+/// Copyright (C) OpenCyphal Development Team  <opencyphal.org>
+/// Copyright Amazon.com Inc. or its affiliates.
+/// SPDX-License-Identifier: MIT
+
+// For clock_gettime().
+#define _DEFAULT_SOURCE  // NOLINT(bugprone-reserved-identifier,cert-dcl37-c,cert-dcl51-cpp)
+
+#include <reg/udral/physics/dynamics/translation/Linear_0_1.h>
+#include <reg/udral/service/common/Readiness_0_1.h>
+#include <uavcan/_register/Access_1_0.h>
+#include <uavcan/file/Read_1_1.h>
+#include <uavcan/node/GetInfo_1_0.h>
+#include <uavcan/node/Heartbeat_1_0.h>
+
+// Standard library.
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#define KILO 1000LL
+#define MEGA (KILO * KILO)
+#define GIGA (KILO * MEGA)
+
+#define BUFFER_SIZE 1024U
+#define REPETITIONS 5U
+#define MIN_BATCH_NS (10 * MEGA)
+
+/// Runs the (de)serialization of the object the given number of times.
+typedef void (*BatchFunction)(const void* const obj, const size_t batch);
+
+static uint8_t g_buffer[BUFFER_SIZE];
+static size_t  g_size;
+
+/// Keeps the compiler from discarding the (de)serialization results.
+static inline void doNotOptimize(const void* const ptr)
+{
+    __asm__ volatile("" : : "g"(ptr) : "memory");  // NOLINT(hicpp-no-assembler)
+}
+
+/// Defines the batch functions of the type. The generated functions are called directly from the loop (rather than
+/// via a pointer per call), so that the compiler could inline them the same way as in the C++ benchmark.
+#define DEFINE_BATCHES(type)                                                                 \
+    static void serializeBatch_##type(const void* const obj, const size_t batch)             \
+    {                                                                                        \
+        for (size_t i = 0; i < batch; ++i)                                                   \
+        {                                                                                    \
+            size_t       size   = sizeof(g_buffer);                                          \
+            const int8_t result = type##_serialize_((const type*) obj, &g_buffer[0], &size); \
+            doNotOptimize(&result);                                                          \
+            doNotOptimize(&g_buffer[0]);                                                     \
+        }                                                                                    \
+    }                                                                                        \
+    static void deserializeBatch_##type(const void* const obj, const size_t batch)           \
+    {                                                                                        \
+        (void) obj;                                                                          \
+        for (size_t i = 0; i < batch; ++i)                                                   \
+        {                                                                                    \
+            type         out;                                                                \
+            size_t       size   = g_size;                                                    \
+            const int8_t result = type##_deserialize_(&out, &g_buffer[0], &size);            \
+            doNotOptimize(&result);                                                          \
+            doNotOptimize(&out);                                                             \
+        }                                                                                    \
+    }
+
+DEFINE_BATCHES(uavcan_node_Heartbeat_1_0)
+DEFINE_BATCHES(uavcan_register_Access_Request_1_0)
+DEFINE_BATCHES(uavcan_register_Access_Response_1_0)
+DEFINE_BATCHES(uavcan_node_GetInfo_Response_1_0)
+DEFINE_BATCHES(reg_udral_physics_dynamics_translation_Linear_0_1)
+DEFINE_BATCHES(reg_udral_service_common_Readiness_0_1)
+DEFINE_BATCHES(uavcan_file_Read_Request_1_1)
+DEFINE_BATCHES(uavcan_file_Read_Response_1_1)
+
+static int64_t getMonotonicNanoseconds(void)
+{
+    struct timespec ts;
+    if (clock_gettime(CLOCK_MONOTONIC, &ts) != 0)
+    {
+        abort();
+    }
+    return ((int64_t) ts.tv_sec * GIGA) + (int64_t) ts.tv_nsec;
+}
+
+/// Runs the batches which take at least MIN_BATCH_NS each, and returns the best time of one (de)serialization.
+static double measureNs(const BatchFunction function, const void* const obj)
+{
+    size_t batch = 1;
+    for (;;)
+    {
+        const int64_t started = getMonotonicNanoseconds();
+        function(obj, batch);
+        if ((getMonotonicNanoseconds() - started) >= MIN_BATCH_NS)
+        {
+            break;
+        }
+        batch *= 2U;
+    }
+    double best_ns = 0;
+    for (size_t repetition = 0; repetition < REPETITIONS; ++repetition)
+    {
+        const int64_t started = getMonotonicNanoseconds();
+        function(obj, batch);
+        const double ns = (double) (getMonotonicNanoseconds() - started) / (double) batch;
+        best_ns         = ((repetition == 0) || (ns < best_ns)) ? ns : best_ns;
+    }
+    return best_ns;
+}
+
+static void run(const char* const   type_name,
+                const void* const   obj,
+                const BatchFunction serialize_batch,
+                const BatchFunction deserialize_batch)
+{
+    const double serialize_ns   = measureNs(serialize_batch, obj);
+    const double deserialize_ns = measureNs(deserialize_batch, obj);
+    const double bytes          = (g_size > 0) ? (double) g_size : 1.0;
+    printf("{\"lang\":\"c\",\"type\":\"%s\",\"bytes\":%zu,"
+           "\"serialize\":{\"ns\":%.1f,\"ns_per_byte\":%.2f},"
+           "\"deserialize\":{\"ns\":%.1f,\"ns_per_byte\":%.2f}}\n",
+           type_name,
+           g_size,
+           serialize_ns,
+           serialize_ns / bytes,
+           deserialize_ns,
+           deserialize_ns / bytes);
+    (void) fflush(stdout);
+}
+
+/// Serializes the object once to obtain its size (needed for the deserialization), then measures the type.
+#define RUN(type, type_name, obj)                                                 \
+    do                                                                            \
+    {                                                                             \
+        g_size = sizeof(g_buffer);                                                \
+        if (type##_serialize_(&(obj), &g_buffer[0], &g_size) < 0)                 \
+        {                                                                         \
+            (void) fprintf(stderr, "Failed to serialize %s\n", type_name);        \
+            return 1;                                                             \
+        }                                                                         \
+        run(type_name, &(obj), &serializeBatch_##type, &deserializeBatch_##type); \
+    } while (false)
+
+static void fillText(const char* const text, size_t* const out_count, uint8_t* const out_elements)
+{
+    *out_count = strlen(text);
+    (void) memcpy(out_elements, text, *out_count);
+}
+
+#define DESCRIPTION "Servo of the left aileron, installed in the wing bay."
+
+int main(void)
+{
+    {
+        uavcan_node_Heartbeat_1_0 msg   = {0};
+        msg.uptime                      = 123456;
+        msg.health.value                = uavcan_node_Health_1_0_NOMINAL;
+        msg.mode.value                  = uavcan_node_Mode_1_0_OPERATIONAL;
+        msg.vendor_specific_status_code = 0x5A;
+        RUN(uavcan_node_Heartbeat_1_0, "uavcan.node.Heartbeat.1.0", msg);
+    }
+    {
+        uavcan_register_Access_Request_1_0 msg = {0};
+        fillText("uavcan.node.description", &msg.name.name.count, &msg.name.name.elements[0]);
+        uavcan_register_Value_1_0_select_string_(&msg.value);
+        fillText(DESCRIPTION, &msg.value._string.value.count, &msg.value._string.value.elements[0]);
+        RUN(uavcan_register_Access_Request_1_0, "uavcan.register.Access.1.0.Request/string", msg);
+    }
+    {
+        uavcan_register_Access_Response_1_0 msg = {0};
+        msg.timestamp.microsecond               = 123456789;
+        uavcan_register_Value_1_0_select_string_(&msg.value);
+        fillText(DESCRIPTION, &msg.value._string.value.count, &msg.value._string.value.elements[0]);
+        RUN(uavcan_register_Access_Response_1_0, "uavcan.register.Access.1.0.Response/string", msg);
+    }
+    {
+        uavcan_register_Access_Response_1_0 msg = {0};
+        uavcan_register_Value_1_0_select_natural16_(&msg.value);
+        msg.value.natural16.value.count = 64;
+        for (size_t i = 0; i < msg.value.natural16.value.count; ++i)
+        {
+            msg.value.natural16.value.elements[i] = (uint16_t) (i * 1000U);
+        }
+        RUN(uavcan_register_Access_Response_1_0, "uavcan.register.Access.1.0.Response/natural16[64]", msg);
+    }
+    {
+        uavcan_register_Access_Response_1_0 msg = {0};
+        uavcan_register_Value_1_0_select_real32_(&msg.value);
+        msg.value.real32.value.count = 64;
+        for (size_t i = 0; i < msg.value.real32.value.count; ++i)
+        {
+            msg.value.real32.value.elements[i] = (float) i * 0.25F;
+        }
+        RUN(uavcan_register_Access_Response_1_0, "uavcan.register.Access.1.0.Response/real32[64]", msg);
+    }
+    {
+        uavcan_node_GetInfo_Response_1_0 msg = {0};
+        msg.protocol_version.major           = 1;
+        msg.software_version.major           = 1;
+        msg.software_vcs_revision_id         = 0x0123456789ABCDEFULL;
+        (void) memset(&msg.unique_id[0], 0xA5, sizeof(msg.unique_id));
+        fillText("org.opencyphal.demos.libudpard", &msg.name.count, &msg.name.elements[0]);
+        msg.software_image_crc.count       = 1;
+        msg.software_image_crc.elements[0] = 0xFEDCBA9876543210ULL;
+        RUN(uavcan_node_GetInfo_Response_1_0, "uavcan.node.GetInfo.1.0.Response", msg);
+    }
+    {
+        reg_udral_physics_dynamics_translation_Linear_0_1 msg  = {0};
+        msg.kinematic.position.meter                           = 0.125F;
+        msg.kinematic.velocity.meter_per_second                = 1.5F;
+        msg.kinematic.acceleration.meter_per_second_per_second = -9.81F;
+        msg.force.newton                                       = 42.0F;
+        RUN(reg_udral_physics_dynamics_translation_Linear_0_1,
+            "reg.udral.physics.dynamics.translation.Linear.0.1",
+            msg);
+    }
+    {
+        reg_udral_service_common_Readiness_0_1 msg = {0};
+        msg.value                                  = reg_udral_service_common_Readiness_0_1_ENGAGED;
+        RUN(reg_udral_service_common_Readiness_0_1, "reg.udral.service.common.Readiness.0.1", msg);
+    }
+    {
+        uavcan_file_Read_Request_1_1 msg = {0};
+        msg.offset                       = 65536;
+        fillText("firmware/org.opencyphal.demos.libudpard.bin", &msg.path.path.count, &msg.path.path.elements[0]);
+        RUN(uavcan_file_Read_Request_1_1, "uavcan.file.Read.1.1.Request", msg);
+    }
+    {
+        uavcan_file_Read_Response_1_1 msg = {0};
+        msg.data.value.count              = 256;
+        for (size_t i = 0; i < msg.data.value.count; ++i)
+        {
+            msg.data.value.elements[i] = (uint8_t) i;
+        }
+        RUN(uavcan_file_Read_Response_1_1, "uavcan.file.Read.1.1.Response/256", msg);
+    }
+    return 0;
+}
@@ -0,0 +1,361 @@
+///                            ____                   ______            __          __
+///                           / __ `____  ___  ____  / ____/_  ______  / /_  ____  / /
+///                          / / / / __ `/ _ `/ __ `/ /   / / / / __ `/ __ `/ __ `/ /
+///                         / /_/ / /_/ /  __/ / / / /___/ /_/ / /_/ / / / / /_/ / /
+///                         `____/ .___/`___/_/ /_/`____/`__, / .___/_/ /_/`__,_/_/
+///                             /_/                     /____/_/
+///
+/// Measures how the boot-up load and the shutdown save of the persistent registers scale with the number of registers,
+/// along with the latency of a single key access. For every register count it prints one JSON object:
+///
+///     {"backend":"libudpard_demo.storage","registers":1000,"populate_us":..,"save_us":..,"load_us":..,
+///      "get_ns":{"p50":..,"p99":..,"max":..},"put_ns":{"p50":..,"p99":..,"max":..}}
+///
+/// There are two backends, built from this file as separate executables because both define the register API:
+///
+///     bench_storage                  - storage.c and the AVL-tree registry of this demo (see register.c), loaded
+///                                      and saved the same way as main.c does it;
+///     bench_storage_shared_register  - the file-per-register shared/register module used by the LibCanard demos
+///                                      (BENCH_SHARED_REGISTER), which has no registry, so populate_us is zero.
+///
+/// The storage lives in a fresh temporary directory (the working directory is changed to it) per register count.
+/// The file system cache is warm, so the results show the CPU and syscall cost rather than the media latency;
+/// pass a directory on the target file system as the argument to measure that instead (default is /tmp).
+///
+/// This software is distributed under the terms of the MIT License.
+/// Copyright (C) OpenCyphal Development Team  <opencyphal.org>
+/// Copyright Amazon.com Inc. or its affiliates.
+/// SPDX-License-Identifier: MIT
+
+// For mkdtemp() and clock_gettime(), and nftw().
+#define _DEFAULT_SOURCE    // NOLINT(bugprone-reserved-identifier,cert-dcl37-c,cert-dcl51-cpp)
+#define _XOPEN_SOURCE 500  // NOLINT(bugprone-reserved-identifier,cert-dcl37-c,cert-dcl51-cpp)
+
+#ifdef BENCH_SHARED_REGISTER
+#    include "register.h"
+#else
+#    include "../src/register.h"
+#    include "../src/storage.h"
+#endif
+#include "../src/xorshift.h"
+
+// Standard library.
+#include <assert.h>
+#include <ftw.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+#define KILO 1000LL
+#define MEGA (KILO * KILO)
+#define GIGA (KILO * MEGA)
+
+#define SAMPLES 1000U
+#define NAME_CAPACITY 32U
+
+static const size_t RegisterCounts[] = {10, 100, 1000, 10000};
+
+static int64_t getMonotonicNanoseconds(void)
+{
+    struct timespec ts;
+    if (clock_gettime(CLOCK_MONOTONIC, &ts) != 0)
+    {
+        abort();
+    }
+    return ((int64_t) ts.tv_sec * GIGA) + (int64_t) ts.tv_nsec;
+}
+
+static int compareInt64(const void* const a, const void* const b)
+{
+    const int64_t x = *(const int64_t*) a;
+    const int64_t y = *(const int64_t*) b;
+    return (x > y) - (x < y);
+}
+
+static void printQuantiles(const char* const name, int64_t* const samples, const size_t count)
+{
+    qsort(samples, count, sizeof(int64_t), &compareInt64);
+    printf("\"%s\":{\"p50\":%lld,\"p99\":%lld,\"max\":%lld}",
+           name,
+           (long long) samples[count / 2U],
+           (long long) samples[(count * 99U) / 100U],
+           (long long) samples[count - 1U]);
+}
+
+static int removeEntry(const char* const path, const struct stat* const sb, const int flag, struct FTW* const ftw)
+{
+    (void) sb;
+    (void) flag;
+    (void) ftw;
+    return remove(path);
+}
+
+static void makeValue(const size_t index, uavcan_register_Value_1_0* const out)
+{
+    uavcan_register_Value_1_0_select_natural16_(out);
+    out->natural16.value.count       = 1;
+    out->natural16.value.elements[0] = (uint16_t) index;
+}
+
+// -----------------------------------------------------  BACKENDS  ----------------------------------------------------
+
+#ifdef BENCH_SHARED_REGISTER
+
+static const char BackendName[] = "shared.register";
+
+struct Registry
+{
+    size_t count;
+};
+
+/// Same names as registerInit() of the other backend produces.
+static void makeName(const size_t index, char* const out)
+{
+    (void) snprintf(out, NAME_CAPACITY, "bench.reg.%05zu", index);
+}
+
+static void populate(struct Registry* const self, const size_t count)
+{
+    self->count = count;
+}
+
+static void save(struct Registry* const self)
+{
+    char name[NAME_CAPACITY];
+    for (size_t i = 0; i < self->count; ++i)
+    {
+        uavcan_register_Value_1_0 value = {0};
+        makeValue(i, &value);
+        makeName(i, &name[0]);
+        registerWrite(&name[0], &value);
+    }
+}
+
+/// The defaults have the same type and dimensionality as the stored values (as the LibCanard demos have them),
+/// but a different content, so that the loaded registers could be told apart.
+static size_t load(struct Registry* const self)
+{
+    char   name[NAME_CAPACITY];
+    size_t loaded = 0;
+    for (size_t i = 0; i < self->count; ++i)
+    {
+        uavcan_register_Value_1_0 value = {0};
+        makeValue(UINT16_MAX, &value);
+        makeName(i, &name[0]);
+        registerRead(&name[0], &value);
+        loaded += (value.natural16.value.elements[0] == (uint16_t) i) ? 1U : 0U;
+    }
+    return loaded;
+}
+
+static void get(struct Registry* const self, const size_t index)
+{
+    (void) self;
+    char name[NAME_CAPACITY];
+    makeName(index, &name[0]);
+    uavcan_register_Value_1_0 value = {0};
+    makeValue(UINT16_MAX, &value);
+    registerRead(&name[0], &value);
+}
+
+static void put(struct Registry* const self, const size_t index)
+{
+    (void) self;
+    char name[NAME_CAPACITY];
+    makeName(index, &name[0]);
+    uavcan_register_Value_1_0 value = {0};
+    makeValue(index, &value);
+    registerWrite(&name[0], &value);
+}
+
+static void destroy(struct Registry* const self)
+{
+    self->count = 0;
+}
+
+#else
+
+static const char BackendName[] = "libudpard_demo.storage";
+
+struct Registry
+{
+    struct Register* root;
+    struct Register* registers;
+    size_t           count;
+};
+
+/// Same as regLoad() of main.c.
+static void* regLoad(struct Register* const self, void* const context)
+{
+    uint8_t serialized[uavcan_register_Value_1_0_EXTENT_BYTES_];
+    size_t  sr_size = uavcan_register_Value_1_0_EXTENT_BYTES_;
+    if (self->persistent && (self->getter == NULL) && storageGet(self->name, &sr_size, &serialized[0]) &&
+        (uavcan_register_Value_1_0_deserialize_(&self->value, &serialized[0], &sr_size) >= 0))
+    {
+        ++(*(size_t*) context);
+    }
+    return NULL;
+}
+
+/// Same as regStore() of main.c.
+static void* regStore(struct Register* const self, void* const context)
+{
+    if (self->persistent && self->remote_mutable)
+    {
+        uint8_t    serialized[uavcan_register_Value_1_0_EXTENT_BYTES_];
+        size_t     sr_size = uavcan_register_Value_1_0_EXTENT_BYTES_;
+        const bool ok      = (uavcan_register_Value_1_0_serialize_(&self->value, serialized, &sr_size) >= 0) &&
+                        storagePut(self->name, sr_size, &serialized[0]);
+        if (!ok)
+        {
+            ++(*(size_t*) context);
+        }
+    }
+    return NULL;
+}
+
+static void populate(struct Registry* const self, const size_t count)
+{
+    self->root      = NULL;
+    self->count     = count;
+    self->registers = calloc(count, sizeof(struct Register));
+    if (self->registers == NULL)
+    {
+        abort();
+    }
+    char index_text[NAME_CAPACITY];
+    for (size_t i = 0; i < count; ++i)
+    {
+        struct Register* const reg = &self->registers[i];
+        (void) snprintf(&index_text[0], sizeof(index_text), "%05zu", i);
+        registerInit(reg, &self->root, (const char*[]){"bench", "reg", &index_text[0], NULL});
+        reg->persistent     = true;
+        reg->remote_mutable = true;
+        makeValue(i, &reg->value);
+    }
+}
+
+static void save(struct Registry* const self)
+{
+    size_t failures = 0;
+    (void) registerTraverse(self->root, &regStore, &failures);
+    assert(failures == 0);
+}
+
+static size_t load(struct Registry* const self)
+{
+    size_t loaded = 0;
+    (void) registerTraverse(self->root, &regLoad, &loaded);
+    return loaded;
+}
+
+static void get(struct Registry* const self, const size_t index)
+{
+    struct Register* const reg = &self->registers[index];
+    uint8_t                serialized[uavcan_register_Value_1_0_EXTENT_BYTES_];
+    size_t                 sr_size = sizeof(serialized);
+    if (storageGet(reg->name, &sr_size, &serialized[0]))
+    {
+        (void) uavcan_register_Value_1_0_deserialize_(&reg->value, &serialized[0], &sr_size);
+    }
+}
+
+static void put(struct Registry* const self, const size_t index)
+{
+    struct Register* const reg = &self->registers[index];
+    uint8_t                serialized[uavcan_register_Value_1_0_EXTENT_BYTES_];
+    size_t                 sr_size = sizeof(serialized);
+    if (uavcan_register_Value_1_0_serialize_(&reg->value, &serialized[0], &sr_size) >= 0)
+    {
+        (void) storagePut(reg->name, sr_size, &serialized[0]);
+    }
+}
+
+static void destroy(struct Registry* const self)
+{
+    free(self->registers);
+    self->registers = NULL;
+    self->root      = NULL;
+    self->count     = 0;
+}
+
+#endif
+
+// -----------------------------------------------------  BENCHMARK  ---------------------------------------------------
+
+static void runPoint(const size_t count)
+{
+    static int64_t get_samples[SAMPLES];
+    static int64_t put_samples[SAMPLES];
+
+    struct Registry registry = {0};
+    int64_t         started  = getMonotonicNanoseconds();
+    populate(&registry, count);
+    const int64_t populate_ns = getMonotonicNanoseconds() - started;
+
+    // The files are created here, as at the very first shutdown.
+    started = getMonotonicNanoseconds();
+    save(&registry);
+    const int64_t save_ns = getMonotonicNanoseconds() - started;
+
+    started               = getMonotonicNanoseconds();
+    const size_t  loaded  = load(&registry);
+    const int64_t load_ns = getMonotonicNanoseconds() - started;
+    if (loaded != count)
+    {
+        (void) fprintf(stderr, "Loaded %zu registers out of %zu\n", loaded, count);
+    }
+
+    for (size_t i = 0; i < SAMPLES; ++i)
+    {
+        const size_t index = (size_t) (nextRandom() % count);
+        started            = getMonotonicNanoseconds();
+        get(&registry, index);
+        get_samples[i] = getMonotonicNanoseconds() - started;
+    }
+    for (size_t i = 0; i < SAMPLES; ++i)
+    {
+        const size_t index = (size_t) (nextRandom() % count);
+        started            = getMonotonicNanoseconds();
+        put(&registry, index);
+        put_samples[i] = getMonotonicNanoseconds() - started;
+    }
+    destroy(&registry);
+
+    printf("{\"backend\":\"%s\",\"registers\":%zu,\"populate_us\":%lld,\"save_us\":%lld,\"load_us\":%lld,",
+           BackendName,
+           count,
+           (long long) (populate_ns / KILO),
+           (long long) (save_ns / KILO),
+           (long long) (load_ns / KILO));
+    printQuantiles("get_ns", &get_samples[0], SAMPLES);
+    printf(",");
+    printQuantiles("put_ns", &put_samples[0], SAMPLES);
+    printf("}\n");
+    (void) fflush(stdout);
+}
+
+int main(const int argc, const char* const argv[])
+{
+    const char* const parent = (argc > 1) ? argv[1] : "/tmp";
+    for (size_t i = 0; i < (sizeof(RegisterCounts) / sizeof(RegisterCounts[0])); ++i)
+    {
+        char root[256];
+        (void) snprintf(&root[0], sizeof(root), "%s/bench_storage_XXXXXX", parent);
+        if ((mkdtemp(&root[0]) == NULL) || (chdir(&root[0]) != 0))
+        {
+            perror("Failed to create the storage directory");
+            return 1;
+        }
+        runPoint(RegisterCounts[i]);
+        if ((chdir(parent) != 0) || (nftw(&root[0], &removeEntry, 16, FTW_DEPTH | FTW_PHYS) != 0))
+        {
+            perror("Failed to remove the storage directory");
+        }
+    }
+    return 0;
+}
@@ -28,8 +28,12 @@
 // For clock_gettime().
 #define _DEFAULT_SOURCE  // NOLINT(bugprone-reserved-identifier,cert-dcl37-c,cert-dcl51-cpp)
 
+#include "binlog.h"
+#include "capture.h"
+#include "port_stats.h"
 #include "register.h"
 #include "memory_block.h"
+#include "sampler.h"
 #include "storage.h"
 #include "udp.h"
 #include <udpard.h>
@@ -52,8 +56,10 @@
 #include <stdlib.h>
 #include <assert.h>
 #include <string.h>
+#include <ctype.h>
 #include <inttypes.h>
 #include <errno.h>
+#include <signal.h>
 #include <time.h>
 
 /// By default, only the local loopback interface is used.
@@ -79,11 +85,36 @@
 /// of memory to keep certain state associated with that node. This is the maximum number of nodes we can handle.
 #define RESOURCE_LIMIT_SESSIONS 1024
 
+/// The capacity of the asynchronous log ring (records); must be a power of two.
+#define LOG_CAPACITY 256
+/// How often the log drainer thread polls the ring when it is empty.
+#define LOG_DRAIN_PERIOD_USEC 10000U
+
+/// The sampling CPU profiler is toggled by SIGUSR2, or by the vendor-specific commands below (the same as in the
+/// LibCyphal demo); when stopped, it writes the folded stacks into SAMPLER_OUTPUT_FILE (see flamegraph.pl).
+#define SAMPLER_CAPACITY 8192U
+#define SAMPLER_RATE_HZ 1000U
+#define SAMPLER_OUTPUT_FILE "profile.folded"
+#define COMMAND_PROFILER_START 1001U
+#define COMMAND_PROFILER_STOP 1002U
+
 #define KILO 1000LL
 #define MEGA (KILO * KILO)
 
 typedef uint_least8_t byte_t;
 
+/// Messages emitted from the hot paths (transfer handlers, socket I/O) are not printed directly, because a slow
+/// terminal or pipe would stall the node. Instead, they are captured into this log, which is drained by a background
+/// thread, so the main loop never blocks on the output.
+static BinlogRecord  g_log_records[LOG_CAPACITY];  // NOLINT(cppcoreguidelines-avoid-non-const-global-variables)
+static Binlog        g_log;                        // NOLINT(cppcoreguidelines-avoid-non-const-global-variables)
+static BinlogDrainer g_log_drainer;                // NOLINT(cppcoreguidelines-avoid-non-const-global-variables)
+
+/// The profiler is owned by the main loop; the signal handler and the command handler only raise the requests.
+static SamplerStack          g_sampler_stacks[SAMPLER_CAPACITY];  // NOLINT(*-avoid-non-const-global-variables)
+static Sampler               g_sampler;                           // NOLINT(*-avoid-non-const-global-variables)
+static volatile sig_atomic_t g_sampler_toggle_requested = 0;      // NOLINT(*-avoid-non-const-global-variables)
+
 /// Per the LibUDPard design, there is a dedicated TX pipeline per local network iface.
 /// A single pipeline is used for all kinds of outgoing transfers: message publications, requests, and responses.
 struct TxPipeline
@@ -108,6 +139,7 @@ struct Publisher
     enum UdpardPriority priority;
     UdpardMicrosecond   tx_timeout_usec;
     UdpardTransferID    transfer_id;
+    PortStats           stats;  ///< Drops are transfers rejected by all ifaces; timeouts are expired TX frames.
 };
 
 /// There needs to be one instance of this type per subject the application wants to subscribe to.
@@ -123,6 +155,7 @@ struct Subscriber
     /// it can erase the payload pointers from the transfer object.
     SubscriberCallback handler;
     void*              user_reference;
+    PortStats          stats;  ///< Drops are transfers lost due to out of memory.
 };
 
 /// There needs to be one instance of this type per RPC service the application wants to serve.
@@ -143,6 +176,7 @@ struct RPCServer
     /// it can erase the payload pointers from the transfer object.
     RPCServerCallback handler;
     void*             user_reference;
+    PortStats         stats;  ///< Transfers are the accepted requests; drops and timeouts apply to the responses.
 };
 
 /// For more information about registers, please refer to "register.h" and the standard DSDL definition
@@ -162,6 +196,20 @@ struct SubscriberRegisterSet
 {
     struct PortRegisterSet base;
 };
+/// Diagnostic registers sys.info.port.(pub|sub|srv).PORT_NAME : natural64[6], see portStatsExport() for the layout.
+struct PortStatsRegisterSet
+{
+    struct Register pub_heartbeat;
+    struct Register pub_port_list;
+    struct Register pub_pnp_node_id_allocation;
+    struct Register pub_data;
+    struct Register sub_pnp_node_id_allocation;
+    struct Register sub_data;
+    struct Register srv_get_node_info;
+    struct Register srv_execute_command;
+    struct Register srv_register_list;
+    struct Register srv_register_access;
+};
 
 /// A set of registers specific to this application. Feel free to extend.
 struct ApplicationRegisters
@@ -171,8 +219,10 @@ struct ApplicationRegisters
     struct Register              udp_iface;         ///< uavcan.udp.iface           : string
     struct Register              udp_dscp;          ///< uavcan.udp.dscp            : natural8[8]
     struct Register              mem_info;          ///< A simple diagnostic register for viewing the memory usage.
+    struct Register              capture_file;      ///< demo.capture.file          : string
     struct PublisherRegisterSet  pub_data;
     struct SubscriberRegisterSet sub_data;
+    struct PortStatsRegisterSet  port_stats;
 };
 
 /// These different memory allocators are needed for LibUDPard.
@@ -200,6 +250,8 @@ struct Application
     /// These flags are raised in response to external requests.
     bool restart_required;
     bool factory_reset_required;
+    bool profiler_start_required;
+    bool profiler_stop_required;
 
     struct ApplicationMemory memory;
 
@@ -380,39 +432,57 @@ static void publish(const size_t             iface_count,
                     const size_t             payload_size,
                     const void* const        payload)
 {
-    const UdpardMicrosecond deadline = getMonotonicMicroseconds() + pub->tx_timeout_usec;
+    const UdpardMicrosecond now      = getMonotonicMicroseconds();
+    const UdpardMicrosecond deadline = now + pub->tx_timeout_usec;
+    bool                    accepted = false;
     for (size_t i = 0; i < iface_count; i++)
     {
-        (void) udpardTxPublish(&tx[i].udpard_tx,
-                               deadline,
-                               pub->priority,
-                               pub->subject_id,
-                               pub->transfer_id,
-                               (struct UdpardPayload){.size = payload_size, .data = payload},
-                               NULL);
+        accepted = (udpardTxPublish(&tx[i].udpard_tx,
+                                    deadline,
+                                    pub->priority,
+                                    pub->subject_id,
+                                    pub->transfer_id,
+                                    (struct UdpardPayload){.size = payload_size, .data = payload},
+                                    &pub->stats) > 0) ||
+                   accepted;
     }
     pub->transfer_id++;
+    if (accepted)
+    {
+        portStatsOnTransfer(&pub->stats, now);
+    }
+    else
+    {
+        portStatsOnDrop(&pub->stats);
+    }
 }
 
 /// A helper for transmitting an RPC-service response over all available redundant network interfaces.
 /// The original request transfer is needed to extract the response metadata such as the transfer-ID and client node-ID.
-static void respond(const size_t                      iface_count,
+static void respond(struct RPCServer* const           server,
+                    const size_t                      iface_count,
                     struct TxPipeline* const          tx,
                     struct UdpardRxRPCTransfer* const culprit,
                     const size_t                      payload_size,
                     const void* const                 payload)
 {
     const UdpardMicrosecond deadline = getMonotonicMicroseconds() + MEGA;
+    bool                    accepted = false;
     for (size_t i = 0; i < iface_count; i++)
     {
-        (void) udpardTxRespond(&tx[i].udpard_tx,
-                               deadline,
-                               culprit->base.priority,
-                               culprit->service_id,
-                               culprit->base.source_node_id,
-                               culprit->base.transfer_id,
-                               (struct UdpardPayload){.size = payload_size, .data = payload},
-                               NULL);
+        accepted = (udpardTxRespond(&tx[i].udpard_tx,
+                                    deadline,
+                                    culprit->base.priority,
+                                    culprit->service_id,
+                                    culprit->base.source_node_id,
+                                    culprit->base.transfer_id,
+                                    (struct UdpardPayload){.size = payload_size, .data = payload},
+                                    &server->stats) > 0) ||
+                   accepted;
+    }
+    if (!accepted)
+    {
+        portStatsOnDrop(&server->stats);
     }
 }
 
@@ -435,10 +505,10 @@ static void cbOnNodeIDAllocationData(struct Subscriber* const self, struct Udpar
             {
                 app->local_node_id                                 = obj.node_id.value;
                 app->reg.node_id.value.natural16.value.elements[0] = obj.node_id.value;
-                (void) fprintf(stderr,
-                               "Allocated NodeID %u by allocator %u\n",
-                               app->local_node_id,
-                               transfer->source_node_id);
+                (void) BINLOG(&g_log,
+                              "Allocated NodeID %u by allocator %u\n",
+                              app->local_node_id,
+                              transfer->source_node_id);
                 // Optionally we can unsubscribe to reduce memory utilization, as we no longer need this subject.
                 // Some high-integrity applications may not be able to do that, though.
                 self->handler = NULL;
@@ -457,7 +527,7 @@ static void cbOnNodeIDAllocationData(struct Subscriber* const self, struct Udpar
                                                                  &app->ifaces[0]);
                 if (rpc_start_res < 0)
                 {
-                    (void) fprintf(stderr, "RPC dispatcher start failed: %i\n", rpc_start_res);
+                    (void) BINLOG(&g_log, "RPC dispatcher start failed: %i\n", rpc_start_res);
                 }
             }  // Otherwise, it's a response destined to another node, or it's a malformed message.
         }  // Otherwise, the message is malformed.
@@ -466,10 +536,10 @@ static void cbOnNodeIDAllocationData(struct Subscriber* const self, struct Udpar
 
 static void cbOnMyData(struct Subscriber* const self, struct UdpardRxTransfer* const transfer)
 {
-    (void) fprintf(stderr,
-                   "Received my_data with transfer-ID %" PRIu64 " from node %u\n",
-                   transfer->transfer_id,
-                   transfer->source_node_id);
+    (void) BINLOG(&g_log,
+                  "Received my_data with transfer-ID %" PRIu64 " from node %u\n",
+                  transfer->transfer_id,
+                  transfer->source_node_id);
     uavcan_primitive_array_Real32_1_0 msg = {0};
     byte_t                            payload[uavcan_primitive_array_Real32_1_0_EXTENT_BYTES_];
     size_t                            payload_size = udpardGather(transfer->payload, sizeof(payload), &payload[0]);
@@ -500,12 +570,12 @@ static void cbOnMyData(struct Subscriber* const self, struct UdpardRxTransfer* c
         }
         else
         {
-            (void) fprintf(stderr, "Data publisher is not enabled\n");
+            (void) BINLOG(&g_log, "Data publisher is not enabled\n");
         }
     }
     else
     {
-        (void) fprintf(stderr, "Malformed uavcan.primitive.array.Real32.1.0\n");
+        (void) BINLOG(&g_log, "Malformed uavcan.primitive.array.Real32.1.0\n");
     }
 }
 
@@ -530,7 +600,7 @@ static void cbOnGetNodeInfoRequest(struct RPCServer* const           self,
     size_t  serialized_size = sizeof(serialized);
     if (uavcan_node_GetInfo_Response_1_0_serialize_(&resp, &serialized[0], &serialized_size) >= 0)
     {
-        respond(iface_count, tx, request_transfer, serialized_size, &serialized[0]);
+        respond(self, iface_count, tx, request_transfer, serialized_size, &serialized[0]);
     }
     else
     {
@@ -571,6 +641,18 @@ static void cbOnExecuteCommandRequest(struct RPCServer* const           self,
             resp.status                 = uavcan_node_ExecuteCommand_Response_1_1_STATUS_SUCCESS;
             break;
         }
+        case COMMAND_PROFILER_START:
+        {
+            app->profiler_start_required = true;  // Served by the main loop, see pollProfilerRequests().
+            resp.status                  = uavcan_node_ExecuteCommand_Response_1_1_STATUS_SUCCESS;
+            break;
+        }
+        case COMMAND_PROFILER_STOP:
+        {
+            app->profiler_stop_required = true;
+            resp.status                 = uavcan_node_ExecuteCommand_Response_1_1_STATUS_SUCCESS;
+            break;
+        }
 #ifdef EVIL           // This example is disabled as it is insecure; however, it may be useful for advanced diagnostics.
         case 0xE71L:  // NOLINT(readability-magic-numbers) Example of a custom command.
         {
@@ -594,7 +676,7 @@ static void cbOnExecuteCommandRequest(struct RPCServer* const           self,
         size_t resp_serialized_size = sizeof(resp_serialized);
         if (uavcan_node_ExecuteCommand_Response_1_1_serialize_(&resp, &resp_serialized[0], &resp_serialized_size) >= 0)
         {
-            respond(iface_count, tx, request_transfer, resp_serialized_size, &resp_serialized[0]);
+            respond(self, iface_count, tx, request_transfer, resp_serialized_size, &resp_serialized[0]);
         }
         else
         {
@@ -603,7 +685,7 @@ static void cbOnExecuteCommandRequest(struct RPCServer* const           self,
     }
     else
     {
-        (void) fprintf(stderr, "Malformed uavcan.node.ExecuteCommand.Request\n");
+        (void) BINLOG(&g_log, "Malformed uavcan.node.ExecuteCommand.Request\n");
     }
 }
 
@@ -629,7 +711,7 @@ static void cbOnRegisterListRequest(struct RPCServer* const           self,
         size_t resp_serialized_size = sizeof(resp_serialized);
         if (uavcan_register_List_Response_1_0_serialize_(&resp, &resp_serialized[0], &resp_serialized_size) >= 0)
         {
-            respond(iface_count, tx, request_transfer, resp_serialized_size, &resp_serialized[0]);
+            respond(self, iface_count, tx, request_transfer, resp_serialized_size, &resp_serialized[0]);
         }
         else
         {
@@ -638,7 +720,7 @@ static void cbOnRegisterListRequest(struct RPCServer* const           self,
     }
     else
     {
-        (void) fprintf(stderr, "Malformed uavcan.register.List.Request\n");
+        (void) BINLOG(&g_log, "Malformed uavcan.register.List.Request\n");
     }
 }
 
@@ -683,7 +765,7 @@ static void cbOnRegisterAccessRequest(struct RPCServer* const           self,
         size_t resp_serialized_size = sizeof(resp_serialized);
         if (uavcan_register_Access_Response_1_0_serialize_(&resp, &resp_serialized[0], &resp_serialized_size) >= 0)
         {
-            respond(iface_count, tx, request_transfer, resp_serialized_size, &resp_serialized[0]);
+            respond(self, iface_count, tx, request_transfer, resp_serialized_size, &resp_serialized[0]);
         }
         else
         {
@@ -692,7 +774,7 @@ static void cbOnRegisterAccessRequest(struct RPCServer* const           self,
     }
     else
     {
-        (void) fprintf(stderr, "Malformed uavcan.register.Access.Request\n");
+        (void) BINLOG(&g_log, "Malformed uavcan.register.Access.Request\n");
     }
 }
 
@@ -838,7 +920,12 @@ static void transmitPendingFrames(const UdpardMicrosecond  time_usec,
         {
             // Attempt transmission only if the frame is not yet timed out while waiting in the TX queue.
             // Otherwise, just drop it and move on to the next one.
-            if ((tqi->deadline_usec == 0) || (tqi->deadline_usec > time_usec))
+            const bool expired = (tqi->deadline_usec != 0) && (tqi->deadline_usec <= time_usec);
+            if (expired && (tqi->user_transfer_reference != NULL))
+            {
+                portStatsOnTimeout((PortStats*) tqi->user_transfer_reference);
+            }
+            if (!expired)
             {
                 const int16_t send_res = udpTxSend(&pipe->io,
                                                    tqi->destination.ip_address,
@@ -852,7 +939,7 @@ static void transmitPendingFrames(const UdpardMicrosecond  time_usec,
                 }
                 if (send_res < 0)
                 {
-                    (void) fprintf(stderr, "Iface #%zu send error: %i\n", i, errno);
+                    (void) BINLOG(&g_log, "Iface #%zu send error: %i\n", i, errno);
                 }
             }
             udpardTxFree(pipe->udpard_tx.memory, udpardTxPop(&pipe->udpard_tx, tqi));
@@ -888,6 +975,7 @@ static int16_t acceptDatagramForSubscription(const UdpardMicrosecond
         // (one example is the local loopback interface).
         if ((local_node_id == UDPARD_NODE_ID_UNSET) || (transfer.source_node_id != local_node_id))
         {
+            portStatsOnTransfer(&sub->stats, transfer.timestamp_usec);
             sub->handler(sub, &transfer);
         }
         udpardRxFragmentFree(transfer.payload,  // Free the payload after the transfer is handled.
@@ -902,6 +990,7 @@ static int16_t acceptDatagramForSubscription(const UdpardMicrosecond
         break;  // No transfer available yet.
     default:
         assert(rx_result == -UDPARD_ERROR_MEMORY);
+        portStatsOnDrop(&sub->stats);
         out = rx_result;
         break;
     }
@@ -930,15 +1019,16 @@ static int16_t acceptDatagramForRPC(const UdpardMicrosecond               timest
     {
     case 1:
     {
-        (void) fprintf(stderr,
-                       "RPC request on service %u from client %u with transfer-ID %" PRIu64 " via iface #%u\n",
-                       transfer.service_id,
-                       transfer.base.source_node_id,
-                       transfer.base.transfer_id,
-                       iface_index);
+        (void) BINLOG(&g_log,
+                      "RPC request on service %u from client %u with transfer-ID %" PRIu64 " via iface #%u\n",
+                      transfer.service_id,
+                      transfer.base.source_node_id,
+                      transfer.base.transfer_id,
+                      iface_index);
         assert(rpc_port != NULL);
         struct RPCServer* const server = (struct RPCServer*) rpc_port;
         assert(server->handler != NULL);
+        portStatsOnTransfer(&server->stats, transfer.base.timestamp_usec);
         server->handler(server, &transfer, iface_count, tx);
         udpardRxFragmentFree(transfer.base.payload,  // Free the payload after the transfer is handled.
                              memory->rx.fragment,
@@ -961,6 +1051,65 @@ static int16_t acceptDatagramForRPC(const UdpardMicrosecond               timest
 /// Blocks and processes pending frames from the RX sockets of all network interfaces and feeds them into the library;
 /// also pushes the frames from the TX queues into their respective sockets.
 /// Unblocks either when there is data to handle or when the deadline is reached. May unblock early.
+static void onProfilerToggleSignal(const int signum)
+{
+    (void) signum;
+    g_sampler_toggle_requested = 1;
+}
+
+/// Starts or stops the profiler unless it is already in the requested state; on stop, the profile is written out.
+/// The output is blocking, so this is only invoked from the main loop between the I/O polls.
+static void setProfilerRunning(const bool start)
+{
+    if (start == g_sampler.running)
+    {
+        return;
+    }
+    if (start)
+    {
+        const int16_t result = samplerStart(&g_sampler, SAMPLER_RATE_HZ);
+        (void) fprintf(stderr,
+                       "Profiler start @%uHz: %s (%i)\n",
+                       SAMPLER_RATE_HZ,
+                       (result == 0) ? "ok" : "failed",
+                       result);
+        return;
+    }
+    samplerStop(&g_sampler);
+    int16_t     result = (int16_t) -EIO;
+    FILE* const out    = fopen(SAMPLER_OUTPUT_FILE, "w");
+    if (out != NULL)
+    {
+        result = samplerWriteFolded(&g_sampler, out);
+        (void) fclose(out);
+    }
+    (void) fprintf(stderr,
+                   "Profiler stop: %zu samples (%" PRIu64 " dropped) -> '%s'%s\n",
+                   (size_t) g_sampler.count,
+                   (uint64_t) g_sampler.dropped,
+                   SAMPLER_OUTPUT_FILE,
+                   (result == 0) ? "" : " (failed)");
+}
+
+static void pollProfilerRequests(struct Application* const app)
+{
+    if (g_sampler_toggle_requested != 0)
+    {
+        g_sampler_toggle_requested = 0;
+        setProfilerRunning(!g_sampler.running);
+    }
+    if (app->profiler_start_required)
+    {
+        app->profiler_start_required = false;
+        setProfilerRunning(true);
+    }
+    if (app->profiler_stop_required)
+    {
+        app->profiler_stop_required = false;
+        setProfilerRunning(false);
+    }
+}
+
 static void doIO(const UdpardMicrosecond unblock_deadline, struct Application* const app)
 {
     // Try pushing pending TX frames ahead of time; this is non-blocking.
@@ -1014,7 +1163,8 @@ static void doIO(const UdpardMicrosecond unblock_deadline, struct Application* c
                                         &tx_await[0],
                                         rx_count,
                                         &rx_await[0]);
-    if (wait_result < 0)
+    // The wait is interrupted by the profiler signals (SIGPROF, SIGUSR2); nothing is marked ready then.
+    if ((wait_result < 0) && (wait_result != -EINTR))
     {
         abort();  // Unreachable.
     }
@@ -1037,7 +1187,7 @@ static void doIO(const UdpardMicrosecond unblock_deadline, struct Application* c
         };
         if (NULL == payload.data)
         {
-            (void) fprintf(stderr, "RX payload allocation failure: out of memory\n");
+            (void) BINLOG(&g_log, "RX payload allocation failure: out of memory\n");
             continue;
         }
         // Read the data from the socket into the buffer we just allocated.
@@ -1072,8 +1222,10 @@ static void doIO(const UdpardMicrosecond unblock_deadline, struct Application* c
                                                                           iface_index);
                 if (read_result < 0)
                 {
-                    (void)
-                        fprintf(stderr, "Iface #%u RX subscription processing error: %i\n", iface_index, read_result);
+                    (void) BINLOG(&g_log,
+                                  "Iface #%u RX subscription processing error: %i\n",
+                                  iface_index,
+                                  read_result);
                 }
             }
             else  // The subscription was disabled while processing other socket reads. Ignore it.
@@ -1094,7 +1246,7 @@ static void doIO(const UdpardMicrosecond unblock_deadline, struct Application* c
                                                              &app->tx_pipeline[0]);
             if (read_result < 0)
             {
-                (void) fprintf(stderr, "Iface #%u RX RPC processing error: %i\n", iface_index, read_result);
+                (void) BINLOG(&g_log, "Iface #%u RX RPC processing error: %i\n", iface_index, read_result);
             }
         }
     }
@@ -1129,6 +1281,18 @@ static uavcan_register_Value_1_0 getRegisterSysInfoMem(struct Register* const se
     return out;
 }
 
+/// Returns a register view exposing the transfer statistics of a port; see port_stats.h.
+static uavcan_register_Value_1_0 getRegisterSysInfoPort(struct Register* const self)
+{
+    const PortStats* const stats = self->user_reference;
+    assert(stats != NULL);
+    uavcan_register_Value_1_0 out = {0};
+    uavcan_register_Value_1_0_select_natural64_(&out);
+    portStatsExport(stats, &out.natural64.value.elements[0]);
+    out.natural64.value.count = PORT_STATS_EXPORT_SIZE;
+    return out;
+}
+
 /// A helper for registering registers of a given port.
 static void regInitPort(struct PortRegisterSet* const self,
                         struct Register** const       root,
@@ -1182,6 +1346,19 @@ static void regInitSubscriber(struct SubscriberRegisterSet* const self,
     regInitPort(&self->base, root, "sub", port_name, port_type);
 }
 
+/// A helper for registering the statistics register of a given port.
+static void regInitPortStats(struct Register* const  self,
+                             struct Register** const root,
+                             const char* const       prefix,
+                             const char* const       port_name,
+                             PortStats* const        stats)
+{
+    assert((self != NULL) && (root != NULL) && (prefix != NULL) && (port_name != NULL) && (stats != NULL));
+    registerInit(self, root, (const char*[]){"sys", "info", "port", prefix, port_name, NULL});
+    self->getter         = &getRegisterSysInfoPort;
+    self->user_reference = stats;
+}
+
 /// Initializes all registers with their default values.
 /// The next step after this is to load the values from the non-volatile storage,
 /// thus overriding the defaults with user-configured parameters.
@@ -1227,6 +1404,13 @@ static void initRegisters(struct ApplicationRegisters* const reg,
     reg->mem_info.getter         = &getRegisterSysInfoMem;
     reg->mem_info.user_reference = mem;
 
+    // An application-specific register with the path of the file to capture the received datagrams into.
+    // Empty (default) disables the capture; see capture.h.
+    registerInit(&reg->capture_file, root, (const char*[]){"demo", "capture", "file", NULL});
+    uavcan_register_Value_1_0_select_string_(&reg->capture_file.value);
+    reg->capture_file.persistent     = true;
+    reg->capture_file.remote_mutable = true;
+
     // Publisher port registers.
     regInitPublisher(&reg->pub_data, root, "my_data", uavcan_primitive_array_Real32_1_0_FULL_NAME_AND_VERSION_);
 
@@ -1234,6 +1418,35 @@ static void initRegisters(struct ApplicationRegisters* const reg,
     regInitSubscriber(&reg->sub_data, root, "my_data", uavcan_primitive_array_Real32_1_0_FULL_NAME_AND_VERSION_);
 }
 
+/// Initializes the per-port statistics registers. The statistics are stored in the port objects themselves,
+/// so the ports need not be initialized yet.
+static void initPortStatsRegisters(struct Application* const app)
+{
+    struct PortStatsRegisterSet* const reg  = &app->reg.port_stats;
+    struct Register** const            root = &app->reg_root;
+
+    regInitPortStats(&reg->pub_heartbeat, root, "pub", "heartbeat", &app->pub_heartbeat.stats);
+    regInitPortStats(&reg->pub_port_list, root, "pub", "port_list", &app->pub_port_list.stats);
+    regInitPortStats(&reg->pub_pnp_node_id_allocation,
+                     root,
+                     "pub",
+                     "pnp_node_id_allocation",
+                     &app->pub_pnp_node_id_allocation.stats);
+    regInitPortStats(&reg->pub_data, root, "pub", "my_data", &app->pub_data.stats);
+
+    regInitPortStats(&reg->sub_pnp_node_id_allocation,
+                     root,
+                     "sub",
+                     "pnp_node_id_allocation",
+                     &app->sub_pnp_node_id_allocation.stats);
+    regInitPortStats(&reg->sub_data, root, "sub", "my_data", &app->sub_data.stats);
+
+    regInitPortStats(&reg->srv_get_node_info, root, "srv", "get_node_info", &app->srv_get_node_info.stats);
+    regInitPortStats(&reg->srv_execute_command, root, "srv", "execute_command", &app->srv_execute_command.stats);
+    regInitPortStats(&reg->srv_register_list, root, "srv", "register_list", &app->srv_register_list.stats);
+    regInitPortStats(&reg->srv_register_access, root, "srv", "register_access", &app->srv_register_access.stats);
+}
+
 /// This is designed for use with registerTraverse.
 /// The context points to a size_t containing the number of registers loaded.
 static void* regLoad(struct Register* const self, void* const context)
@@ -1283,6 +1496,98 @@ static void* regReset(struct Register* const self, void* const context)
     return NULL;
 }
 
+/// Maps the register name to the environment variable name as documented in uavcan.register.Access;
+/// e.g., "uavcan.node.id" --> "UAVCAN__NODE__ID". The "uavcan." prefix is also accepted as "CYPHAL__"
+/// (the same variables are used by the LibCyphal demo), which takes precedence if both are set.
+/// Returns NULL if the variable is not set.
+static const char* getRegisterEnvironmentVariable(const char* const register_name)
+{
+    char   env_name[(uavcan_register_Name_1_0_name_ARRAY_CAPACITY_ * 2U) + 1U];
+    size_t len = 0;
+    for (const char* ch = register_name; (*ch != '\0') && (len < (sizeof(env_name) - 2U)); ch++)
+    {
+        if (*ch == '.')
+        {
+            env_name[len++] = '_';
+            env_name[len++] = '_';
+        }
+        else
+        {
+            env_name[len++] = (char) toupper((unsigned char) *ch);
+        }
+    }
+    env_name[len] = '\0';
+
+    static const char UavcanPrefix[] = "UAVCAN__";
+    static const char CyphalPrefix[] = "CYPHAL__";
+    if (strncmp(env_name, UavcanPrefix, sizeof(UavcanPrefix) - 1U) == 0)
+    {
+        char cyphal_name[sizeof(env_name)];
+        (void) memcpy(cyphal_name, env_name, len + 1U);
+        (void) memcpy(cyphal_name, CyphalPrefix, sizeof(CyphalPrefix) - 1U);
+        const char* const value = getenv(cyphal_name);
+        if (value != NULL)
+        {
+            return value;
+        }
+    }
+    return getenv(env_name);
+}
+
+/// This is designed for use with registerTraverse.
+/// Only the string and the scalar natural registers can be overridden, which covers the configuration registers
+/// of this application (the node-ID and the iface list, in particular).
+/// The context points to a size_t containing the number of registers overridden.
+static void* regOverrideFromEnvironmentVariables(struct Register* const self, void* const context)
+{
+    assert((self != NULL) && (context != NULL));
+    const char* const text = (self->getter == NULL) ? getRegisterEnvironmentVariable(self->name) : NULL;
+    if (text == NULL)
+    {
+        return NULL;
+    }
+    uavcan_register_Value_1_0* const value = &self->value;
+    if (uavcan_register_Value_1_0_is_string_(value))
+    {
+        const size_t len = nunavutChooseMin(strlen(text), uavcan_primitive_String_1_0_value_ARRAY_CAPACITY_);
+        (void) memcpy(&value->_string.value.elements[0], text, len);
+        value->_string.value.count = len;
+        ++(*(size_t*) context);
+        return NULL;
+    }
+    char* end = NULL;
+    errno     = 0;
+
+    const unsigned long long number = strtoull(text, &end, 0);  // NOLINT(google-runtime-int)
+    const bool               valid  = (errno == 0) && (end != text) && (*end == '\0');
+    if (valid && uavcan_register_Value_1_0_is_natural8_(value) && (value->natural8.value.count == 1) &&
+        (number <= UINT8_MAX))
+    {
+        value->natural8.value.elements[0] = (uint8_t) number;
+    }
+    else if (valid && uavcan_register_Value_1_0_is_natural16_(value) && (value->natural16.value.count == 1) &&
+             (number <= UINT16_MAX))
+    {
+        value->natural16.value.elements[0] = (uint16_t) number;
+    }
+    else if (valid && uavcan_register_Value_1_0_is_natural32_(value) && (value->natural32.value.count == 1) &&
+             (number <= UINT32_MAX))
+    {
+        value->natural32.value.elements[0] = (uint32_t) number;
+    }
+    else if (valid && uavcan_register_Value_1_0_is_natural64_(value) && (value->natural64.value.count == 1))
+    {
+        value->natural64.value.elements[0] = (uint64_t) number;
+    }
+    else
+    {
+        (void) fprintf(stderr, "Register '%s' cannot be overridden with '%s'\n", self->name, text);
+        return NULL;
+    }
+    ++(*(size_t*) context);
+    return NULL;
+}
+
 /// Parse the addresses of the available local network interfaces from the given string.
 /// In a deeply embedded system this may be replaced by some other networking APIs, like LwIP.
 /// Invalid interface addresses are ignored; i.e., this is a best-effort parser.
@@ -1325,6 +1630,13 @@ extern char** environ;  // NOLINT(cppcoreguidelines-avoid-non-const-global-varia
 
 int main(const int argc, char* const argv[])
 {
+    (void) binlogInit(&g_log, &g_log_records[0], LOG_CAPACITY, stderr);
+    if (binlogDrainerStart(&g_log_drainer, &g_log, LOG_DRAIN_PERIOD_USEC) != 0)
+    {
+        (void) fprintf(stderr, "Failed to start the log drainer thread\n");
+        return 1;
+    }
+
     // The block size values used here are derived from the sizes of the structs defined in LibUDPard and the MTU.
     // They may change when migrating between different versions of the library or when building the code for a
     // different platform, so it may be desirable to choose conservative values here (i.e. larger than necessary).
@@ -1360,12 +1672,16 @@ int main(const int argc, char* const argv[])
         .iface_count   = 0,
         .local_node_id = UDPARD_NODE_ID_UNSET,
     };
+    // The unique-ID is generated at the first launch and the PnP requests are randomized using rand(), so the seed
+    // has to differ between the nodes started at once from the same binary; otherwise, they would all collide.
+    srand((unsigned) (getMonotonicMicroseconds() ^ (uint64_t) getpid()));
     getUniqueID(&app.unique_id[0]);
 
     // The first thing to do during the application initialization is to load the register values from the non-volatile
     // configuration storage. Non-volatile configuration is essential for most Cyphal nodes because it contains
     // information on how to reach the network and how to publish/subscribe to the subjects of interest.
     initRegisters(&app.reg, &app.memory, &app.reg_root);
+    initPortStatsRegisters(&app);
     {
         size_t load_count = 0;
         (void) registerTraverse(app.reg_root, &regLoad, &load_count);
@@ -1374,9 +1690,12 @@ int main(const int argc, char* const argv[])
     // If we're running on a POSIX system, we can use the environment variables to override the loaded values.
     // There is a standard mapping between environment variable names and register names documented in the DSDL
     // definition of uavcan.register.Access; for example, "uavcan.node.id" --> "UAVCAN__NODE__ID".
-    // This simple feature is left as an exercise to the reader. It is meaningless in a deeply embedded system though.
-    //
-    //  registerTraverse(app.reg, &regOverrideFromEnvironmentVariables, NULL);
+    // It is meaningless in a deeply embedded system though.
+    {
+        size_t override_count = 0;
+        (void) registerTraverse(app.reg_root, &regOverrideFromEnvironmentVariables, &override_count);
+        (void) fprintf(stderr, "%zu registers overridden from the environment variables\n", override_count);
+    }
 
     // Parse the iface addresses given via the standard iface register.
     app.iface_count = parseNetworkIfaceAddresses(&app.reg.udp_iface.value._string, &app.ifaces[0]);
@@ -1520,6 +1839,26 @@ int main(const int argc, char* const argv[])
     }
     app.srv_register_access.user_reference = app.reg_root;  // Cannot add new registers after this.
 
+    // Start the capture of the received traffic if configured; the replay tool can feed it into another node later.
+    if (app.reg.capture_file.value._string.value.count > 0)
+    {
+        char capture_path[uavcan_primitive_String_1_0_value_ARRAY_CAPACITY_ + 1] = {0};
+        (void) memcpy(&capture_path[0],
+                      &app.reg.capture_file.value._string.value.elements[0],
+                      app.reg.capture_file.value._string.value.count);
+        const int capture_result = captureStart(&capture_path[0]);
+        (void) fprintf(stderr, "Capture into %s: %s\n", &capture_path[0], (capture_result == 0) ? "ok" : "failed");
+    }
+
+    samplerInit(&g_sampler, &g_sampler_stacks[0], SAMPLER_CAPACITY);
+    {
+        struct sigaction action = {0};
+        action.sa_handler       = &onProfilerToggleSignal;
+        action.sa_flags         = SA_RESTART;
+        (void) sigemptyset(&action.sa_mask);
+        (void) sigaction(SIGUSR2, &action, NULL);
+    }
+
     // RUN THE MAIN LOOP.
     (void) fprintf(stderr, "NODE STARTED\n");
     app.started_at                       = getMonotonicMicroseconds();
@@ -1539,9 +1878,13 @@ int main(const int argc, char* const argv[])
             next_01_hz_iter_at += (MEGA * 10);
             handle01HzLoop(&app, monotonic_time);
         }
+        pollProfilerRequests(&app);
         // Run socket I/O. It will block until network activity or until the specified deadline (may unblock sooner).
         doIO(next_1_hz_iter_at, &app);
     }
+    setProfilerRunning(false);
+    binlogDrainerStop(&g_log_drainer);
+    captureStop();
 
     // Save registers immediately before restarting the node.
     // We don't access the storage during normal operation of the node because access is slow and is impossible to
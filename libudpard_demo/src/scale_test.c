@@ -0,0 +1,1218 @@
+///                            ____                   ______            __          __
+///                           / __ `____  ___  ____  / ____/_  ______  / /_  ____  / /
+///                          / / / / __ `/ _ `/ __ `/ /   / / / / __ `/ __ `/ __ `/ /
+///                         / /_/ / /_/ /  __/ / / / /___/ /_/ / /_/ / / / / /_/ / /
+///                         `____/ .___/`___/_/ /_/`____/`__, / .___/_/ /_/`__,_/_/
+///                             /_/                     /____/_/
+///
+/// A multi-process scale test of the demo nodes on one Cyphal/UDP segment. For every requested node count it spawns
+/// that many demo processes (each in its own storage directory, which is also its working directory), and acts as
+/// the only other node on the segment:
+///
+///     - plug-and-play node-ID allocator (uavcan.pnp.NodeIDAllocationData.2.0), unless static node-IDs are requested;
+///     - heartbeat monitor, which measures the convergence (all nodes heartbeating) and the heartbeat period jitter;
+///     - register listing client, which lists all registers of every node with uavcan.register.List.1.0.
+///
+/// Meanwhile, it samples the CPU time and the memory of every node process from /proc, and counts the multicast
+/// group memberships of the iface in /proc/net/igmp. The usage is as follows:
+///
+///     scale_test [-i <iface>] [-s] [-d <seconds>] [-t <seconds>] <demo_binary> <node_count>...
+///
+///     -i  Local iface address of the segment (default 127.0.0.1).
+///     -s  Assign static node-IDs 1..N via CYPHAL__NODE__ID instead of PnP (the LibCyphal demo has no PnP client).
+///     -d  Duration of the steady state measurement (default 10).
+///     -t  Convergence timeout (default 60).
+///
+/// The demo binary receives its storage directory as the first argument and the iface via CYPHAL__UDP__IFACE,
+/// so both the LibUDPard and the LibCyphal (UDP) demos can be tested. One JSON object per node count is printed:
+///
+///     {"nodes":100,"spawn_ms":..,"converged_ms":..,"heartbeating":100,"exited":0,"id_conflicts":0,
+///      "pnp":{"requests":..,"unique_ids":100},"first_heartbeat_ms":{"p50":..,"p99":..,"max":..},
+///      "heartbeat":{"per_s":..,"jitter_us":{"p50":..,"p99":..,"max":..}},
+///      "cpu_pct":{"p50":..,"max":..,"total":..},"rss_kb":{"p50":..,"max":..,"total":..},
+///      "mcast":{"groups":..,"memberships":..},
+///      "register_list":{"nodes":..,"registers":..,"timeouts":..,"rtt_us":{"p50":..,"p99":..,"max":..}}}
+///
+/// Finally, the scaling report compares the smallest and the largest node count: for every metric it prints the
+/// exponent k of the growth as N^k, and flags the metrics which grow faster than expected (e.g., the total CPU time
+/// should be linear in N, so k around 2 means that every node does O(N) work, which is O(N^2) for the segment).
+///
+/// The system limits may need to be raised for hundreds of nodes (e.g., `ulimit -n`, and net.ipv4.igmp_max_memberships
+/// as every node joins several multicast groups on the same iface).
+///
+/// This software is distributed under the terms of the MIT License.
+/// Copyright (C) OpenCyphal Development Team  <opencyphal.org>
+/// Copyright Amazon.com Inc. or its affiliates.
+/// SPDX-License-Identifier: MIT
+
+// For mkdtemp(), realpath(), getopt(), nftw() and getifaddrs().
+#define _DEFAULT_SOURCE    // NOLINT(bugprone-reserved-identifier,cert-dcl37-c,cert-dcl51-cpp)
+#define _XOPEN_SOURCE 500  // NOLINT(bugprone-reserved-identifier,cert-dcl37-c,cert-dcl51-cpp)
+
+#include "udp.h"
+#include "memory_block.h"
+#include <udpard.h>
+
+#include <uavcan/node/Heartbeat_1_0.h>
+#include <uavcan/pnp/NodeIDAllocationData_2_0.h>
+#include <uavcan/_register/List_1_0.h>
+
+// Standard library.
+#include <stdio.h>
+#include <stdlib.h>
+#include <assert.h>
+#include <string.h>
+#include <inttypes.h>
+#include <errno.h>
+#include <math.h>
+#include <time.h>
+
+// POSIX.
+#include <arpa/inet.h>
+#include <fcntl.h>
+#include <ftw.h>
+#include <ifaddrs.h>
+#include <limits.h>
+#include <net/if.h>
+#include <signal.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#define KILO 1000LL
+#define MEGA (KILO * KILO)
+
+/// The node-ID of the harness itself; the allocated node-IDs start from 1.
+#define LOCAL_NODE_ID UDPARD_NODE_ID_MAX
+#define MAX_NODES 1000
+#define MAX_COUNTS 16
+#define MAX_REGISTERS_PER_NODE 1024
+#define RPC_TIMEOUT_USEC MEGA
+/// Time for the nodes to stop gracefully before they are killed.
+#define STOP_TIMEOUT_USEC (2 * MEGA)
+
+#define TX_QUEUE_SIZE 1000
+#define RX_BUFFER_SIZE 2000
+#define RX_PAYLOAD_BUFFERS 512
+/// Every node has a session for the heartbeat, and another one for the RPC responses.
+#define RX_SESSIONS ((MAX_NODES * 2) + 64)
+
+/// The histograms have one bucket per power of two microseconds.
+#define HISTOGRAM_BUCKETS 32
+
+typedef uint_least8_t byte_t;
+
+struct Histogram
+{
+    uint64_t buckets[HISTOGRAM_BUCKETS];
+};
+
+/// Parameters given on the command line.
+struct Options
+{
+    uint32_t          iface;
+    bool              static_node_ids;
+    UdpardMicrosecond steady_usec;
+    UdpardMicrosecond converge_timeout_usec;
+    char              binary[PATH_MAX];
+    size_t            count_count;
+    size_t            counts[MAX_COUNTS];
+};
+
+/// A spawned demo process.
+struct Process
+{
+    pid_t    pid;
+    bool     exited;
+    uint64_t cpu_ns;  ///< Sampled at the beginning of the steady state.
+};
+
+/// The state of a remote node-ID as seen on the bus.
+struct Peer
+{
+    UdpardMicrosecond first_heartbeat_at;  ///< Zero if not heartbeating.
+    UdpardMicrosecond last_heartbeat_at;
+    uint32_t          last_uptime;
+    uint64_t          heartbeats;
+    bool              conflict;  ///< The uptime went backwards, so there is more than one node with this node-ID.
+};
+
+struct Allocation
+{
+    byte_t       unique_id[uavcan_pnp_NodeIDAllocationData_2_0_unique_id_ARRAY_CAPACITY_];
+    UdpardNodeID node_id;
+};
+
+/// The results of one node count.
+struct Result
+{
+    size_t   nodes;
+    uint64_t spawn_usec;
+    uint64_t converged_usec;  ///< Zero if not converged.
+    size_t   heartbeating;
+    size_t   exited;
+    size_t   id_conflicts;
+
+    uint64_t pnp_requests;
+    size_t   pnp_unique_ids;
+
+    uint64_t first_heartbeat_ms[3];  ///< p50, p99, max.
+    double   heartbeats_per_s;
+    uint64_t jitter_us[3];
+
+    double   cpu_pct[3];  ///< p50, max, total.
+    uint64_t rss_kb[3];   ///< p50, max, total.
+
+    size_t mcast_groups;
+    size_t mcast_memberships;
+
+    size_t   listed_nodes;
+    uint64_t listed_registers;
+    uint64_t list_timeouts;
+    uint64_t list_rtt_us[3];
+};
+
+struct Subscriber
+{
+    struct UdpardRxSubscription subscription;
+    UDPRxHandle                 io;
+};
+
+/// The harness is a node on the segment with a single (non-redundant) iface.
+struct Harness
+{
+    struct UdpardRxMemoryResources rx_memory;
+    struct MemoryBlockAllocator*   rx_payload;
+    UdpardNodeID                   local_node_id;
+
+    struct UdpardTx udpard_tx;
+    UDPTxHandle     tx_io;
+
+    struct Subscriber            sub_heartbeat;
+    struct Subscriber            sub_pnp;
+    struct UdpardRxRPCDispatcher rpc_dispatcher;
+    struct UdpardRxRPCPort       rpc_list_response;
+    UDPRxHandle                  rpc_io;
+
+    UdpardTransferID pnp_transfer_id;
+    UdpardTransferID list_transfer_id;
+
+    struct Peer       peers[UDPARD_NODE_ID_MAX + 1];
+    struct Allocation allocations[MAX_NODES];
+    size_t            allocation_count;
+    UdpardNodeID      next_node_id;
+    uint64_t          pnp_requests;
+
+    /// Steady state statistics.
+    bool             measuring;
+    uint64_t         heartbeats;
+    struct Histogram jitter;
+
+    /// The pending register listing request.
+    struct
+    {
+        bool              pending;
+        UdpardNodeID      server;
+        uint16_t          index;
+        UdpardTransferID  transfer_id;
+        UdpardMicrosecond sent_at;
+        bool              response;  ///< Set by the response handler.
+        bool              last;      ///< The response has an empty name.
+    } list;
+    struct Histogram list_rtt;
+};
+
+static UdpardMicrosecond getMonotonicMicroseconds(void)
+{
+    struct timespec ts;
+    if (clock_gettime(CLOCK_MONOTONIC, &ts) != 0)
+    {
+        abort();
+    }
+    return (uint64_t) (ts.tv_sec * MEGA + ts.tv_nsec / KILO);
+}
+
+static void histogramAdd(struct Histogram* const self, const uint64_t value)
+{
+    size_t bucket = 0;
+    while (((value >> bucket) > 1U) && (bucket < (HISTOGRAM_BUCKETS - 1U)))
+    {
+        bucket++;
+    }
+    self->buckets[bucket]++;
+}
+
+/// Returns the upper bound of the bucket where the quantile falls.
+static uint64_t histogramQuantile(const struct Histogram* const self, const double q)
+{
+    uint64_t total = 0;
+    for (size_t i = 0; i < HISTOGRAM_BUCKETS; i++)
+    {
+        total += self->buckets[i];
+    }
+    if (total == 0)
+    {
+        return 0;
+    }
+    uint64_t rank = (uint64_t) (q * (double) total);
+    rank          = (rank < total) ? rank : (total - 1U);
+    uint64_t seen = 0;
+    for (size_t i = 0; i < HISTOGRAM_BUCKETS; i++)
+    {
+        seen += self->buckets[i];
+        if (seen > rank)
+        {
+            return (i == 0) ? 0 : (1ULL << i);
+        }
+    }
+    return 0;
+}
+
+static int compareUint64(const void* const a, const void* const b)
+{
+    const uint64_t x = *(const uint64_t*) a;
+    const uint64_t y = *(const uint64_t*) b;
+    return (x > y) - (x < y);
+}
+
+/// Sorts the values and stores the median, the 99th percentile, and the maximum.
+static void percentiles(uint64_t* const values, const size_t count, uint64_t out[3])
+{
+    out[0] = out[1] = out[2] = 0;
+    if (count > 0)
+    {
+        qsort(values, count, sizeof(uint64_t), &compareUint64);
+        out[0] = values[count / 2U];
+        out[1] = values[(count * 99U) / 100U];
+        out[2] = values[count - 1U];
+    }
+}
+
+// --------------------------------------------------------------------------------------------------------------------
+// PROCESSES
+// --------------------------------------------------------------------------------------------------------------------
+
+static int removeEntry(const char* const path, const struct stat* const sb, const int flag, struct FTW* const ftw)
+{
+    (void) sb;
+    (void) flag;
+    (void) ftw;
+    return remove(path);
+}
+
+static pid_t spawnNode(const struct Options* const options, const char* const root, const size_t index)
+{
+    char directory[PATH_MAX];
+    (void) snprintf(&directory[0], sizeof(directory), "%s/node%04zu", root, index);
+    if (mkdir(&directory[0], 0755) != 0)
+    {
+        return -1;
+    }
+    const pid_t child = fork();
+    if (child != 0)
+    {
+        return child;
+    }
+    // The storage of the LibUDPard demo is in the working directory, the LibCyphal demo receives it as an argument.
+    if (chdir(&directory[0]) != 0)
+    {
+        _exit(127);
+    }
+    char iface[INET_ADDRSTRLEN] = {0};
+    const struct in_addr address = {.s_addr = htonl(options->iface)};
+    (void) inet_ntop(AF_INET, &address, &iface[0], sizeof(iface));
+    (void) setenv("CYPHAL__UDP__IFACE", &iface[0], 1);
+    (void) setenv("CYPHAL__CAN__IFACE", "", 1);
+    (void) unsetenv("CYPHAL__DEMO__CAPTURE__FILE");
+    (void) unsetenv("CYPHAL__DEMO__STATS__SHM");
+    if (options->static_node_ids)
+    {
+        char node_id[8];
+        (void) snprintf(&node_id[0], sizeof(node_id), "%zu", index + 1U);
+        (void) setenv("CYPHAL__NODE__ID", &node_id[0], 1);
+    }
+    else
+    {
+        (void) unsetenv("CYPHAL__NODE__ID");
+    }
+    const int log_fd = open("node.log", O_WRONLY | O_CREAT | O_TRUNC, 0644);  // NOLINT(*-vararg)
+    if (log_fd >= 0)
+    {
+        (void) dup2(log_fd, STDOUT_FILENO);
+        (void) dup2(log_fd, STDERR_FILENO);
+        (void) close(log_fd);
+    }
+    (void) execl(options->binary, options->binary, &directory[0], (char*) NULL);  // NOLINT(*-vararg)
+    _exit(127);
+}
+
+/// Returns the number of the processes that have exited so far.
+static size_t reapNodes(struct Process* const processes, const size_t count)
+{
+    size_t exited = 0;
+    for (size_t i = 0; i < count; i++)
+    {
+        if ((!processes[i].exited) && (processes[i].pid > 0) && (waitpid(processes[i].pid, NULL, WNOHANG) > 0))
+        {
+            processes[i].exited = true;
+        }
+        exited += processes[i].exited ? 1U : 0U;
+    }
+    return exited;
+}
+
+static void stopNodes(struct Process* const processes, const size_t count)
+{
+    for (size_t i = 0; i < count; i++)
+    {
+        if ((!processes[i].exited) && (processes[i].pid > 0))
+        {
+            (void) kill(processes[i].pid, SIGTERM);
+        }
+    }
+    const UdpardMicrosecond deadline = getMonotonicMicroseconds() + STOP_TIMEOUT_USEC;
+    while ((reapNodes(processes, count) < count) && (getMonotonicMicroseconds() < deadline))
+    {
+        (void) usleep(10000);
+    }
+    for (size_t i = 0; i < count; i++)
+    {
+        if ((!processes[i].exited) && (processes[i].pid > 0))
+        {
+            (void) kill(processes[i].pid, SIGKILL);
+            (void) waitpid(processes[i].pid, NULL, 0);
+            processes[i].exited = true;
+        }
+    }
+}
+
+/// The on-CPU time in nanoseconds is the first field (much finer than the clock ticks of /proc/<pid>/stat).
+static uint64_t sampleCpuNs(const pid_t pid)
+{
+    uint64_t out = 0;
+    char     path[64];
+    (void) snprintf(&path[0], sizeof(path), "/proc/%d/schedstat", (int) pid);
+    FILE* const file = fopen(&path[0], "r");
+    if (file != NULL)
+    {
+        if (fscanf(file, "%" SCNu64, &out) != 1)
+        {
+            out = 0;
+        }
+        (void) fclose(file);
+    }
+    return out;
+}
+
+static uint64_t sampleRssKb(const pid_t pid)
+{
+    uint64_t out = 0;
+    char     path[64];
+    (void) snprintf(&path[0], sizeof(path), "/proc/%d/status", (int) pid);
+    FILE* const file = fopen(&path[0], "r");
+    if (file != NULL)
+    {
+        char line[256];
+        while (fgets(&line[0], sizeof(line), file) != NULL)
+        {
+            if (sscanf(&line[0], "VmRSS: %" SCNu64, &out) == 1)
+            {
+                break;
+            }
+        }
+        (void) fclose(file);
+    }
+    return out;
+}
+
+/// Counts the IPv4 multicast groups joined on the iface and the sockets subscribed to them (see /proc/net/igmp).
+static void sampleMulticast(const uint32_t iface, size_t* const out_groups, size_t* const out_memberships)
+{
+    *out_groups      = 0;
+    *out_memberships = 0;
+    char            device[IFNAMSIZ] = {0};
+    struct ifaddrs* addresses        = NULL;
+    if (getifaddrs(&addresses) == 0)
+    {
+        for (const struct ifaddrs* it = addresses; it != NULL; it = it->ifa_next)
+        {
+            if ((it->ifa_addr != NULL) && (it->ifa_addr->sa_family == AF_INET) &&
+                (ntohl(((const struct sockaddr_in*) (const void*) it->ifa_addr)->sin_addr.s_addr) == iface))
+            {
+                (void) strncpy(&device[0], it->ifa_name, sizeof(device) - 1U);
+                break;
+            }
+        }
+        freeifaddrs(addresses);
+    }
+    FILE* const file = fopen("/proc/net/igmp", "r");
+    if ((device[0] == '\0') || (file == NULL))
+    {
+        if (file != NULL)
+        {
+            (void) fclose(file);
+        }
+        return;
+    }
+    // The device lines are followed by the group lines of the device, which are indented with tabs.
+    char line[256];
+    bool selected = false;
+    while (fgets(&line[0], sizeof(line), file) != NULL)
+    {
+        unsigned index = 0;
+        char     name[IFNAMSIZ + 1];
+        unsigned group = 0;
+        unsigned users = 0;
+        if ((line[0] >= '0') && (line[0] <= '9') && (sscanf(&line[0], "%u %16s", &index, &name[0]) == 2))
+        {
+            selected = (strcmp(&name[0], &device[0]) == 0);
+        }
+        else if (selected && (line[0] == '\t') && (sscanf(&line[0], "%x %u", &group, &users) == 2))
+        {
+            (*out_groups)++;
+            *out_memberships += users;
+        }
+    }
+    (void) fclose(file);
+}
+
+// --------------------------------------------------------------------------------------------------------------------
+// NETWORKING
+// --------------------------------------------------------------------------------------------------------------------
+
+static void transmitPending(struct Harness* const self)
+{
+    const UdpardMicrosecond now = getMonotonicMicroseconds();
+    struct UdpardTxItem*    tqi = udpardTxPeek(&self->udpard_tx);
+    while (tqi != NULL)
+    {
+        if ((tqi->deadline_usec == 0) || (tqi->deadline_usec > now))
+        {
+            const int16_t send_res = udpTxSend(&self->tx_io,
+                                               tqi->destination.ip_address,
+                                               tqi->destination.udp_port,
+                                               tqi->dscp,
+                                               tqi->datagram_payload.size,
+                                               tqi->datagram_payload.data);
+            if (send_res == 0)
+            {
+                break;  // Socket no longer writable, stop sending for now to retry later.
+            }
+        }
+        udpardTxFree(self->udpard_tx.memory, udpardTxPop(&self->udpard_tx, tqi));
+        tqi = udpardTxPeek(&self->udpard_tx);
+    }
+}
+
+static void onHeartbeat(struct Harness* const self, const struct UdpardRxTransfer* const transfer)
+{
+    if (transfer->source_node_id > UDPARD_NODE_ID_MAX)
+    {
+        return;
+    }
+    byte_t                    payload[uavcan_node_Heartbeat_1_0_EXTENT_BYTES_];
+    size_t                    payload_size = udpardGather(transfer->payload, sizeof(payload), &payload[0]);
+    uavcan_node_Heartbeat_1_0 msg          = {0};
+    if (uavcan_node_Heartbeat_1_0_deserialize_(&msg, &payload[0], &payload_size) < 0)
+    {
+        return;
+    }
+    struct Peer* const peer = &self->peers[transfer->source_node_id];
+    if (peer->first_heartbeat_at == 0)
+    {
+        peer->first_heartbeat_at = transfer->timestamp_usec;
+    }
+    else
+    {
+        peer->conflict = peer->conflict || (msg.uptime < peer->last_uptime);
+        if (self->measuring)
+        {
+            const UdpardMicrosecond interval = transfer->timestamp_usec - peer->last_heartbeat_at;
+            histogramAdd(&self->jitter, (interval > (uint64_t) MEGA) ? (interval - MEGA) : (MEGA - interval));
+        }
+    }
+    peer->last_heartbeat_at = transfer->timestamp_usec;
+    peer->last_uptime       = msg.uptime;
+    peer->heartbeats++;
+    self->heartbeats += self->measuring ? 1U : 0U;
+}
+
+/// The same unique-ID always gets the same node-ID, as the Specification requires for the allocators.
+static void onAllocationRequest(struct Harness* const self, const struct UdpardRxTransfer* const transfer)
+{
+    if (transfer->source_node_id != UDPARD_NODE_ID_UNSET)
+    {
+        return;  // This is a response (possibly our own).
+    }
+    byte_t                              payload[uavcan_pnp_NodeIDAllocationData_2_0_EXTENT_BYTES_];
+    size_t                              payload_size = udpardGather(transfer->payload, sizeof(payload), &payload[0]);
+    uavcan_pnp_NodeIDAllocationData_2_0 msg          = {0};
+    if (uavcan_pnp_NodeIDAllocationData_2_0_deserialize_(&msg, &payload[0], &payload_size) < 0)
+    {
+        return;
+    }
+    self->pnp_requests++;
+    struct Allocation* allocation = NULL;
+    for (size_t i = 0; i < self->allocation_count; i++)
+    {
+        if (memcmp(&self->allocations[i].unique_id[0], &msg.unique_id[0], sizeof(msg.unique_id)) == 0)
+        {
+            allocation = &self->allocations[i];
+            break;
+        }
+    }
+    if ((allocation == NULL) && (self->allocation_count < MAX_NODES) && (self->next_node_id < LOCAL_NODE_ID))
+    {
+        allocation = &self->allocations[self->allocation_count++];
+        (void) memcpy(&allocation->unique_id[0], &msg.unique_id[0], sizeof(msg.unique_id));
+        allocation->node_id = self->next_node_id++;
+    }
+    if (allocation == NULL)
+    {
+        return;  // Out of node-IDs.
+    }
+    msg.node_id.value = allocation->node_id;
+    byte_t       serialized[uavcan_pnp_NodeIDAllocationData_2_0_SERIALIZATION_BUFFER_SIZE_BYTES_];
+    size_t       serialized_size = sizeof(serialized);
+    const int8_t err = uavcan_pnp_NodeIDAllocationData_2_0_serialize_(&msg, &serialized[0], &serialized_size);
+    assert(err >= 0);
+    if (err >= 0)
+    {
+        (void) udpardTxPublish(&self->udpard_tx,
+                               getMonotonicMicroseconds() + MEGA,
+                               UdpardPrioritySlow,
+                               uavcan_pnp_NodeIDAllocationData_2_0_FIXED_PORT_ID_,
+                               self->pnp_transfer_id++,
+                               (struct UdpardPayload){.size = serialized_size, .data = &serialized[0]},
+                               NULL);
+    }
+}
+
+static void onListResponse(struct Harness* const self, const struct UdpardRxRPCTransfer* const transfer)
+{
+    if ((!self->list.pending) || (transfer->base.source_node_id != self->list.server) ||
+        (transfer->base.transfer_id != self->list.transfer_id))
+    {
+        return;  // Late or unexpected.
+    }
+    byte_t                            payload[uavcan_register_List_Response_1_0_EXTENT_BYTES_];
+    size_t                            payload_size = udpardGather(transfer->base.payload, sizeof(payload), &payload[0]);
+    uavcan_register_List_Response_1_0 msg          = {0};
+    if (uavcan_register_List_Response_1_0_deserialize_(&msg, &payload[0], &payload_size) >= 0)
+    {
+        histogramAdd(&self->list_rtt, transfer->base.timestamp_usec - self->list.sent_at);
+        self->list.pending  = false;
+        self->list.response = true;
+        self->list.last     = (msg.name.name.count == 0);
+    }
+}
+
+static void sendListRequest(struct Harness* const self, const UdpardNodeID server, const uint16_t index)
+{
+    const uavcan_register_List_Request_1_0 msg = {.index = index};
+    byte_t       serialized[uavcan_register_List_Request_1_0_SERIALIZATION_BUFFER_SIZE_BYTES_];
+    size_t       serialized_size = sizeof(serialized);
+    const int8_t err = uavcan_register_List_Request_1_0_serialize_(&msg, &serialized[0], &serialized_size);
+    assert(err >= 0);
+    (void) err;
+    self->list.server      = server;
+    self->list.index       = index;
+    self->list.transfer_id = self->list_transfer_id++;
+    self->list.sent_at     = getMonotonicMicroseconds();
+    self->list.pending     = true;
+    self->list.response    = false;
+    (void) udpardTxRequest(&self->udpard_tx,
+                           self->list.sent_at + RPC_TIMEOUT_USEC,
+                           UdpardPriorityNominal,
+                           uavcan_register_List_1_0_FIXED_PORT_ID_,
+                           server,
+                           self->list.transfer_id,
+                           (struct UdpardPayload){.size = serialized_size, .data = &serialized[0]},
+                           NULL);
+}
+
+static void freePayload(struct Harness* const self, const struct UdpardFragment payload)
+{
+    udpardRxFragmentFree(payload,
+                         self->rx_memory.fragment,
+                         (struct UdpardMemoryDeleter){.user_reference = self->rx_memory.payload.user_reference,
+                                                      .deallocate     = self->rx_memory.payload.deallocate});
+}
+
+/// Processes the traffic until the deadline; the transfers are handled as they arrive. May return early.
+static void spin(struct Harness* const self, const UdpardMicrosecond deadline)
+{
+    transmitPending(self);
+    UDPTxAwaitable tx_await[1] = {{.handle = &self->tx_io}};
+    UDPRxAwaitable rx_await[3] = {
+        {.handle = &self->sub_heartbeat.io, .user_reference = &self->sub_heartbeat},
+        {.handle = &self->sub_pnp.io, .user_reference = &self->sub_pnp},
+        {.handle = &self->rpc_io, .user_reference = NULL},
+    };
+    const UdpardMicrosecond now = getMonotonicMicroseconds();
+    if (udpWait((deadline > now) ? (deadline - now) : 0,
+                (self->udpard_tx.queue_size > 0) ? 1U : 0U,
+                &tx_await[0],
+                sizeof(rx_await) / sizeof(rx_await[0]),
+                &rx_await[0]) < 0)
+    {
+        abort();  // Unreachable.
+    }
+    const UdpardMicrosecond ts_usec = getMonotonicMicroseconds();
+    for (size_t i = 0; i < (sizeof(rx_await) / sizeof(rx_await[0])); i++)
+    {
+        if (!rx_await[i].ready)
+        {
+            continue;
+        }
+        struct UdpardMutablePayload payload = {
+            .size = RX_BUFFER_SIZE,
+            .data = memoryBlockAllocate(self->rx_payload, RX_BUFFER_SIZE),
+        };
+        if (payload.data == NULL)
+        {
+            continue;  // Out of memory; the datagram will be read later.
+        }
+        if (udpRxReceive(rx_await[i].handle, &payload.size, payload.data) <= 0)
+        {
+            memoryBlockDeallocate(self->rx_payload, RX_BUFFER_SIZE, payload.data);
+            continue;
+        }
+        struct Subscriber* const sub = (struct Subscriber*) rx_await[i].user_reference;
+        if (sub != NULL)
+        {
+            struct UdpardRxTransfer transfer = {0};
+            if (udpardRxSubscriptionReceive(&sub->subscription, ts_usec, payload, 0, &transfer) == 1)
+            {
+                if (sub == &self->sub_heartbeat)
+                {
+                    onHeartbeat(self, &transfer);
+                }
+                else
+                {
+                    onAllocationRequest(self, &transfer);
+                }
+                freePayload(self, transfer.payload);
+            }
+        }
+        else
+        {
+            struct UdpardRxRPCTransfer transfer = {0};
+            struct UdpardRxRPCPort*    port     = NULL;
+            if (udpardRxRPCDispatcherReceive(&self->rpc_dispatcher, ts_usec, payload, 0, &port, &transfer) == 1)
+            {
+                onListResponse(self, &transfer);
+                freePayload(self, transfer.base.payload);
+            }
+        }
+    }
+    transmitPending(self);
+}
+
+static int16_t initSubscriber(struct Harness* const    self,
+                              struct Subscriber* const sub,
+                              const UdpardPortID       subject_id,
+                              const size_t             extent,
+                              const uint32_t           iface)
+{
+    int16_t res = (int16_t) udpardRxSubscriptionInit(&sub->subscription, subject_id, extent, self->rx_memory);
+    if (res >= 0)
+    {
+        res = udpRxInit(&sub->io,
+                        iface,
+                        sub->subscription.udp_ip_endpoint.ip_address,
+                        sub->subscription.udp_ip_endpoint.udp_port);
+    }
+    return res;
+}
+
+/// The harness is set up anew for every node count, so no state (e.g., the transfer-ID deduplication sessions)
+/// is carried over to the next node count, where the same node-IDs are used by the new processes.
+static bool initHarness(struct Harness* const                self,
+                        const struct Options* const          options,
+                        const struct UdpardTxMemoryResources tx_memory,
+                        const UdpardNodeID                   first_allocated_node_id)
+{
+    self->local_node_id = LOCAL_NODE_ID;
+    self->next_node_id  = first_allocated_node_id;
+    if ((0 != udpardTxInit(&self->udpard_tx, &self->local_node_id, TX_QUEUE_SIZE, tx_memory)) ||
+        (0 != udpTxInit(&self->tx_io, options->iface)))
+    {
+        (void) fprintf(stderr, "Failed to initialize the TX pipeline\n");
+        return false;
+    }
+    if ((initSubscriber(self,
+                        &self->sub_heartbeat,
+                        uavcan_node_Heartbeat_1_0_FIXED_PORT_ID_,
+                        uavcan_node_Heartbeat_1_0_EXTENT_BYTES_,
+                        options->iface) < 0) ||
+        (initSubscriber(self,
+                        &self->sub_pnp,
+                        uavcan_pnp_NodeIDAllocationData_2_0_FIXED_PORT_ID_,
+                        uavcan_pnp_NodeIDAllocationData_2_0_EXTENT_BYTES_,
+                        options->iface) < 0))
+    {
+        (void) fprintf(stderr, "Failed to initialize the subscriptions\n");
+        return false;
+    }
+    struct UdpardUDPIPEndpoint endpoint = {0};
+    if ((udpardRxRPCDispatcherInit(&self->rpc_dispatcher, self->rx_memory) != 0) ||
+        (udpardRxRPCDispatcherStart(&self->rpc_dispatcher, self->local_node_id, &endpoint) != 0) ||
+        (udpardRxRPCDispatcherListen(&self->rpc_dispatcher,
+                                     &self->rpc_list_response,
+                                     uavcan_register_List_1_0_FIXED_PORT_ID_,
+                                     false,
+                                     uavcan_register_List_Response_1_0_EXTENT_BYTES_) < 0) ||
+        (udpRxInit(&self->rpc_io, options->iface, endpoint.ip_address, endpoint.udp_port) < 0))
+    {
+        (void) fprintf(stderr, "Failed to initialize the RPC dispatcher\n");
+        return false;
+    }
+    return true;
+}
+
+static void deinitHarness(struct Harness* const self)
+{
+    (void) udpardRxRPCDispatcherCancel(&self->rpc_dispatcher, uavcan_register_List_1_0_FIXED_PORT_ID_, false);
+    udpRxClose(&self->rpc_io);
+    udpardRxSubscriptionFree(&self->sub_pnp.subscription);
+    udpRxClose(&self->sub_pnp.io);
+    udpardRxSubscriptionFree(&self->sub_heartbeat.subscription);
+    udpRxClose(&self->sub_heartbeat.io);
+    struct UdpardTxItem* tqi = udpardTxPeek(&self->udpard_tx);
+    while (tqi != NULL)
+    {
+        udpardTxFree(self->udpard_tx.memory, udpardTxPop(&self->udpard_tx, tqi));
+        tqi = udpardTxPeek(&self->udpard_tx);
+    }
+    udpTxClose(&self->tx_io);
+}
+
+// --------------------------------------------------------------------------------------------------------------------
+// SCENARIOS
+// --------------------------------------------------------------------------------------------------------------------
+
+static size_t countHeartbeating(const struct Harness* const self)
+{
+    size_t out = 0;
+    for (size_t i = 0; i <= UDPARD_NODE_ID_MAX; i++)
+    {
+        out += (self->peers[i].first_heartbeat_at != 0) ? 1U : 0U;
+    }
+    return out;
+}
+
+/// Waits until all nodes are heartbeating (with the PnP allocation served meanwhile), or until the timeout.
+static void runConvergence(struct Harness* const       self,
+                           const struct Options* const options,
+                           struct Process* const       processes,
+                           const UdpardMicrosecond     started_at,
+                           struct Result* const        result)
+{
+    const UdpardMicrosecond deadline     = started_at + options->converge_timeout_usec;
+    UdpardMicrosecond       next_poll_at = 0;
+    while (getMonotonicMicroseconds() < deadline)
+    {
+        const UdpardMicrosecond now = getMonotonicMicroseconds();
+        if (now >= next_poll_at)  // Scanning all node-IDs is not free, so it is done periodically.
+        {
+            next_poll_at         = now + (10 * KILO);
+            result->heartbeating = countHeartbeating(self);
+            result->exited       = reapNodes(processes, result->nodes);
+            if (result->heartbeating >= result->nodes)
+            {
+                result->converged_usec = now - started_at;
+                break;
+            }
+            if (result->exited >= result->nodes)
+            {
+                break;
+            }
+        }
+        spin(self, (next_poll_at < deadline) ? next_poll_at : deadline);
+    }
+
+    uint64_t values[MAX_NODES];
+    size_t   count = 0;
+    for (size_t i = 0; (i <= UDPARD_NODE_ID_MAX) && (count < MAX_NODES); i++)
+    {
+        if (self->peers[i].first_heartbeat_at != 0)
+        {
+            const UdpardMicrosecond at = self->peers[i].first_heartbeat_at;
+            values[count++]            = (at > started_at) ? ((at - started_at) / (uint64_t) KILO) : 0U;
+        }
+    }
+    percentiles(&values[0], count, result->first_heartbeat_ms);
+}
+
+/// Measures the heartbeat traffic and the per-node CPU time over the steady state duration.
+static void runSteadyState(struct Harness* const       self,
+                           const struct Options* const options,
+                           struct Process* const       processes,
+                           struct Result* const        result)
+{
+    for (size_t i = 0; i < result->nodes; i++)
+    {
+        processes[i].cpu_ns = sampleCpuNs(processes[i].pid);
+    }
+    self->measuring                   = true;
+    const UdpardMicrosecond started   = getMonotonicMicroseconds();
+    const UdpardMicrosecond deadline  = started + options->steady_usec;
+    bool                    mcast_done = false;
+    while (getMonotonicMicroseconds() < deadline)
+    {
+        spin(self, deadline);
+        if ((!mcast_done) && ((getMonotonicMicroseconds() - started) >= (options->steady_usec / 2U)))
+        {
+            mcast_done = true;
+            sampleMulticast(options->iface, &result->mcast_groups, &result->mcast_memberships);
+        }
+    }
+    self->measuring           = false;
+    const double elapsed_usec = (double) (getMonotonicMicroseconds() - started);
+
+    uint64_t cpu_ppm[MAX_NODES];  // Parts per million of one CPU, as percentiles() wants integers.
+    uint64_t rss_kb[MAX_NODES];
+    uint64_t cpu_total_ppm = 0;
+    uint64_t rss_total_kb  = 0;
+    for (size_t i = 0; i < result->nodes; i++)
+    {
+        const uint64_t cpu_ns = sampleCpuNs(processes[i].pid);
+        const uint64_t delta  = (cpu_ns > processes[i].cpu_ns) ? (cpu_ns - processes[i].cpu_ns) : 0U;
+        cpu_ppm[i]            = (uint64_t) (((double) delta / (double) KILO) * 1e6 / elapsed_usec);
+        rss_kb[i]             = sampleRssKb(processes[i].pid);
+        cpu_total_ppm += cpu_ppm[i];
+        rss_total_kb += rss_kb[i];
+    }
+    uint64_t cpu_stats[3];
+    percentiles(&cpu_ppm[0], result->nodes, cpu_stats);
+    percentiles(&rss_kb[0], result->nodes, result->rss_kb);
+    result->cpu_pct[0] = (double) cpu_stats[0] / 1e4;
+    result->cpu_pct[1] = (double) cpu_stats[2] / 1e4;
+    result->cpu_pct[2] = (double) cpu_total_ppm / 1e4;
+    result->rss_kb[1]  = result->rss_kb[2];  // The 99th percentile is replaced with the maximum.
+    result->rss_kb[2]  = rss_total_kb;
+
+    result->heartbeats_per_s = (double) self->heartbeats * 1e6 / elapsed_usec;
+    result->jitter_us[0]     = histogramQuantile(&self->jitter, 0.5);
+    result->jitter_us[1]     = histogramQuantile(&self->jitter, 0.99);
+    result->jitter_us[2]     = histogramQuantile(&self->jitter, 1.0);
+}
+
+/// Lists all registers of every heartbeating node, one request at a time, as a configuration tool would do it.
+static void runRegisterListing(struct Harness* const self, struct Result* const result)
+{
+    for (size_t node_id = 0; node_id < LOCAL_NODE_ID; node_id++)
+    {
+        if (self->peers[node_id].first_heartbeat_at == 0)
+        {
+            continue;
+        }
+        bool listed = false;
+        for (uint16_t index = 0; index < MAX_REGISTERS_PER_NODE; index++)
+        {
+            sendListRequest(self, (UdpardNodeID) node_id, index);
+            const UdpardMicrosecond deadline = self->list.sent_at + RPC_TIMEOUT_USEC;
+            while ((!self->list.response) && (getMonotonicMicroseconds() < deadline))
+            {
+                spin(self, deadline);
+            }
+            if (!self->list.response)
+            {
+                self->list.pending = false;
+                result->list_timeouts++;
+                break;
+            }
+            if (self->list.last)
+            {
+                listed = true;
+                break;
+            }
+            result->listed_registers++;
+        }
+        result->listed_nodes += listed ? 1U : 0U;
+    }
+    result->list_rtt_us[0] = histogramQuantile(&self->list_rtt, 0.5);
+    result->list_rtt_us[1] = histogramQuantile(&self->list_rtt, 0.99);
+    result->list_rtt_us[2] = histogramQuantile(&self->list_rtt, 1.0);
+}
+
+static bool runCount(struct Harness* const                self,
+                     const struct Options* const          options,
+                     const struct UdpardTxMemoryResources tx_memory,
+                     const size_t                         count,
+                     struct Result* const                 result)
+{
+    static struct Process processes[MAX_NODES];  // NOLINT(cppcoreguidelines-avoid-non-const-global-variables)
+    (void) memset(&processes[0], 0, sizeof(processes));
+    const struct UdpardRxMemoryResources rx_memory  = self->rx_memory;
+    struct MemoryBlockAllocator* const   rx_payload = self->rx_payload;
+    (void) memset(self, 0, sizeof(*self));
+    self->rx_memory  = rx_memory;
+    self->rx_payload = rx_payload;
+    (void) memset(result, 0, sizeof(*result));
+    result->nodes = count;
+
+    char root[] = "/tmp/scale_test.XXXXXX";
+    if (mkdtemp(&root[0]) == NULL)
+    {
+        (void) fprintf(stderr, "Cannot create the storage directory: %s\n", strerror(errno));
+        return false;
+    }
+    bool ok = initHarness(self, options, tx_memory, options->static_node_ids ? (UdpardNodeID) (count + 1U) : 1U);
+    if (ok)
+    {
+        // The memberships of the harness itself are not counted.
+        size_t baseline_groups      = 0;
+        size_t baseline_memberships = 0;
+        sampleMulticast(options->iface, &baseline_groups, &baseline_memberships);
+
+        const UdpardMicrosecond started_at = getMonotonicMicroseconds();
+        for (size_t i = 0; ok && (i < count); i++)
+        {
+            processes[i].pid = spawnNode(options, &root[0], i);
+            ok               = processes[i].pid > 0;
+            spin(self, 0);  // Keep serving the earlier nodes while spawning.
+        }
+        result->spawn_usec = getMonotonicMicroseconds() - started_at;
+        if (!ok)
+        {
+            (void) fprintf(stderr, "Cannot spawn the node processes: %s\n", strerror(errno));
+        }
+        else
+        {
+            (void) fprintf(stderr, "Spawned %zu nodes, waiting for them to converge...\n", count);
+            runConvergence(self, options, &processes[0], started_at, result);
+            (void) fprintf(stderr, "Measuring the steady state...\n");
+            runSteadyState(self, options, &processes[0], result);
+            result->mcast_groups -= (result->mcast_groups > baseline_groups) ? baseline_groups : result->mcast_groups;
+            result->mcast_memberships -= (result->mcast_memberships > baseline_memberships)
+                                             ? baseline_memberships
+                                             : result->mcast_memberships;
+            (void) fprintf(stderr, "Listing the registers...\n");
+            runRegisterListing(self, result);
+        }
+        result->heartbeating   = countHeartbeating(self);
+        result->exited         = reapNodes(&processes[0], count);
+        result->pnp_requests   = self->pnp_requests;
+        result->pnp_unique_ids = self->allocation_count;
+        for (size_t i = 0; i <= UDPARD_NODE_ID_MAX; i++)
+        {
+            result->id_conflicts += self->peers[i].conflict ? 1U : 0U;
+        }
+    }
+    stopNodes(&processes[0], count);
+    deinitHarness(self);
+    (void) nftw(&root[0], &removeEntry, 16, FTW_DEPTH | FTW_PHYS);
+    return ok;
+}
+
+// --------------------------------------------------------------------------------------------------------------------
+// REPORTING
+// --------------------------------------------------------------------------------------------------------------------
+
+static void printResult(const struct Result* const r)
+{
+    (void) printf("{\"nodes\":%zu,\"spawn_ms\":%" PRIu64 ",\"converged_ms\":%" PRIu64
+                  ",\"heartbeating\":%zu,\"exited\":%zu,\"id_conflicts\":%zu,"
+                  "\"pnp\":{\"requests\":%" PRIu64 ",\"unique_ids\":%zu},"
+                  "\"first_heartbeat_ms\":{\"p50\":%" PRIu64 ",\"p99\":%" PRIu64 ",\"max\":%" PRIu64 "},"
+                  "\"heartbeat\":{\"per_s\":%.1f,\"jitter_us\":{\"p50\":%" PRIu64 ",\"p99\":%" PRIu64
+                  ",\"max\":%" PRIu64 "}},",
+                  r->nodes,
+                  r->spawn_usec / (uint64_t) KILO,
+                  r->converged_usec / (uint64_t) KILO,
+                  r->heartbeating,
+                  r->exited,
+                  r->id_conflicts,
+                  r->pnp_requests,
+                  r->pnp_unique_ids,
+                  r->first_heartbeat_ms[0],
+                  r->first_heartbeat_ms[1],
+                  r->first_heartbeat_ms[2],
+                  r->heartbeats_per_s,
+                  r->jitter_us[0],
+                  r->jitter_us[1],
+                  r->jitter_us[2]);
+    (void) printf("\"cpu_pct\":{\"p50\":%.3f,\"max\":%.3f,\"total\":%.2f},"
+                  "\"rss_kb\":{\"p50\":%" PRIu64 ",\"max\":%" PRIu64 ",\"total\":%" PRIu64 "},"
+                  "\"mcast\":{\"groups\":%zu,\"memberships\":%zu},"
+                  "\"register_list\":{\"nodes\":%zu,\"registers\":%" PRIu64 ",\"timeouts\":%" PRIu64
+                  ",\"rtt_us\":{\"p50\":%" PRIu64 ",\"p99\":%" PRIu64 ",\"max\":%" PRIu64 "}}}\n",
+                  r->cpu_pct[0],
+                  r->cpu_pct[1],
+                  r->cpu_pct[2],
+                  r->rss_kb[0],
+                  r->rss_kb[1],
+                  r->rss_kb[2],
+                  r->mcast_groups,
+                  r->mcast_memberships,
+                  r->listed_nodes,
+                  r->listed_registers,
+                  r->list_timeouts,
+                  r->list_rtt_us[0],
+                  r->list_rtt_us[1],
+                  r->list_rtt_us[2]);
+    (void) fflush(stdout);
+}
+
+/// Prints the growth exponent k of the metric (as N^k) between the two results, and flags it if k exceeds
+/// the expected exponent by more than a half (so the noise of small values does not trigger it).
+static void printExponent(const char* const name,
+                          const double      expected,
+                          const double      first,
+                          const double      last,
+                          const double      n_ratio,
+                          const bool        is_last)
+{
+    if ((first > 0.0) && (last > 0.0))
+    {
+        const double exponent = log(last / first) / log(n_ratio);
+        (void) printf("\"%s\":{\"exponent\":%.2f,\"expected\":%.0f,\"superlinear\":%s}",
+                      name,
+                      exponent,
+                      expected,
+                      (exponent > (expected + 0.5)) ? "true" : "false");
+    }
+    else
+    {
+        (void) printf("\"%s\":null", name);
+    }
+    (void) printf(is_last ? "" : ",");
+}
+
+static void printScaling(const struct Result* const first, const struct Result* const last)
+{
+    const double n_ratio = (double) last->nodes / (double) first->nodes;
+    (void) printf("{\"scaling\":{\"from\":%zu,\"to\":%zu,", first->nodes, last->nodes);
+    printExponent("converged_ms", 0, (double) first->converged_usec, (double) last->converged_usec, n_ratio, false);
+    printExponent("pnp_requests", 1, (double) first->pnp_requests, (double) last->pnp_requests, n_ratio, false);
+    printExponent("heartbeats_per_s", 1, first->heartbeats_per_s, last->heartbeats_per_s, n_ratio, false);
+    printExponent("cpu_total", 1, first->cpu_pct[2], last->cpu_pct[2], n_ratio, false);
+    printExponent("cpu_per_node_max", 0, first->cpu_pct[1], last->cpu_pct[1], n_ratio, false);
+    printExponent("rss_total", 1, (double) first->rss_kb[2], (double) last->rss_kb[2], n_ratio, false);
+    printExponent("mcast_memberships",
+                  1,
+                  (double) first->mcast_memberships,
+                  (double) last->mcast_memberships,
+                  n_ratio,
+                  false);
+    printExponent("list_rtt_p99", 0, (double) first->list_rtt_us[1], (double) last->list_rtt_us[1], n_ratio, true);
+    (void) printf("}}\n");
+    (void) fflush(stdout);
+}
+
+// --------------------------------------------------------------------------------------------------------------------
+// MAIN
+// --------------------------------------------------------------------------------------------------------------------
+
+static bool parseOptions(const int argc, char* const argv[], struct Options* const out)
+{
+    out->iface                 = udpParseIfaceAddress("127.0.0.1");
+    out->steady_usec           = 10 * MEGA;
+    out->converge_timeout_usec = 60 * MEGA;
+    int option                 = 0;
+    while ((option = getopt(argc, argv, "i:sd:t:")) != -1)
+    {
+        switch (option)
+        {
+        case 'i':
+            out->iface = udpParseIfaceAddress(optarg);
+            break;
+        case 's':
+            out->static_node_ids = true;
+            break;
+        case 'd':
+            out->steady_usec = (UdpardMicrosecond) (strtod(optarg, NULL) * 1e6);
+            break;
+        case 't':
+            out->converge_timeout_usec = (UdpardMicrosecond) (strtod(optarg, NULL) * 1e6);
+            break;
+        default:
+            return false;
+        }
+    }
+    if ((out->iface == 0) || (out->steady_usec == 0) || ((argc - optind) < 2) ||
+        (realpath(argv[optind], &out->binary[0]) == NULL))
+    {
+        return false;
+    }
+    for (int i = optind + 1; (i < argc) && (out->count_count < MAX_COUNTS); i++)
+    {
+        const unsigned long count = strtoul(argv[i], NULL, 10);
+        if ((count == 0) || (count > MAX_NODES) || (out->static_node_ids && (count >= LOCAL_NODE_ID)))
+        {
+            (void) fprintf(stderr, "The node count shall be in [1, %d]\n", MAX_NODES);
+            return false;
+        }
+        out->counts[out->count_count++] = (size_t) count;
+    }
+    return true;
+}
+
+int main(const int argc, char* const argv[])
+{
+    static struct Options options;  // NOLINT(cppcoreguidelines-avoid-non-const-global-variables)
+    static struct Harness harness;  // NOLINT(cppcoreguidelines-avoid-non-const-global-variables)
+    static struct Result  results[MAX_COUNTS];  // NOLINT(cppcoreguidelines-avoid-non-const-global-variables)
+    if (!parseOptions(argc, argv, &options))
+    {
+        (void) fprintf(stderr,
+                       "Usage: %s [-i <iface>] [-s] [-d <seconds>] [-t <seconds>] <demo_binary> <node_count>...\n",
+                       argv[0]);
+        return 1;
+    }
+    (void) signal(SIGPIPE, SIG_IGN);  // NOLINT(cert-err33-c)
+
+    // The block sizes are as in the demo node (see main.c).
+    MEMORY_BLOCK_ALLOCATOR_DEFINE(mem_session, 384, RX_SESSIONS);
+    MEMORY_BLOCK_ALLOCATOR_DEFINE(mem_fragment, 88, TX_QUEUE_SIZE + RX_PAYLOAD_BUFFERS);
+    MEMORY_BLOCK_ALLOCATOR_DEFINE(mem_payload, 2048, TX_QUEUE_SIZE + RX_PAYLOAD_BUFFERS);
+    const struct UdpardTxMemoryResources tx_memory = {
+        .fragment = {.user_reference = &mem_fragment,
+                     .allocate       = &memoryBlockAllocate,
+                     .deallocate     = &memoryBlockDeallocate},
+        .payload  = {.user_reference = &mem_payload,
+                     .allocate       = &memoryBlockAllocate,
+                     .deallocate     = &memoryBlockDeallocate},
+    };
+    harness.rx_memory = (struct UdpardRxMemoryResources){
+        .session  = {.user_reference = &mem_session,
+                     .allocate       = &memoryBlockAllocate,
+                     .deallocate     = &memoryBlockDeallocate},
+        .fragment = {.user_reference = &mem_fragment,
+                     .allocate       = &memoryBlockAllocate,
+                     .deallocate     = &memoryBlockDeallocate},
+        .payload  = {.user_reference = &mem_payload, .deallocate = &memoryBlockDeallocate},
+    };
+    harness.rx_payload = &mem_payload;
+
+    int failed_counts = 0;
+    for (size_t i = 0; i < options.count_count; i++)
+    {
+        if (runCount(&harness, &options, tx_memory, options.counts[i], &results[i]))
+        {
+            printResult(&results[i]);
+        }
+        else
+        {
+            (void) fprintf(stderr, "Run failed (nodes=%zu).\n", options.counts[i]);
+            ++failed_counts;
+        }
+    }
+    // The first and the last of the successful runs are compared.
+    const struct Result* first = NULL;
+    const struct Result* last  = NULL;
+    for (size_t i = 0; i < options.count_count; i++)
+    {
+        if (results[i].nodes > 0)
+        {
+            first = (first == NULL) ? &results[i] : first;
+            last  = &results[i];
+        }
+    }
+    if ((first != NULL) && (last != NULL) && (last->nodes > first->nodes))
+    {
+        printScaling(first, last);
+    }
+    return (failed_counts == 0) ? 0 : 1;
+}
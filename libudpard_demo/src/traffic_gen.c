@@ -0,0 +1,803 @@
+///                            ____                   ______            __          __
+///                           / __ `____  ___  ____  / ____/_  ______  / /_  ____  / /
+///                          / / / / __ `/ _ `/ __ `/ /   / / / / __ `/ __ `/ __ `/ /
+///                         / /_/ / /_/ /  __/ / / / /___/ /_/ / /_/ / / / / /_/ / /
+///                         `____/ .___/`___/_/ /_/`____/`__, / .___/_/ /_/`__,_/_/
+///                             /_/                     /____/_/
+///
+/// A synthetic Cyphal/UDP traffic generator for load testing of nodes. It is driven by a scenario file which lists
+/// groups of message publications and service requests; each group may span a range of port-IDs (so hundreds of
+/// subjects are one line), with a fixed or random transfer size (so multi-frame transfers are easy to produce).
+/// The scenario syntax is as follows (one directive per line, '#' starts a comment):
+///
+///     node_id  <node-id>                  # The local node-ID of the generator (default 127).
+///     iface    <address> [<address> ...]  # Redundant ifaces (default 127.0.0.1).
+///     duration <seconds>                  # How long to run (default 10).
+///     spin_us  <microseconds>             # Busy-poll window before each due time (default 50).
+///     pub <subject-id>[-<last>] <priority> <rate-hz> <size>[-<max-size>]
+///     req <service-id>[-<last>] <priority> <rate-hz> <size>[-<max-size>] <server-node-id>
+///
+/// The priority is either a number or a name (e.g., "nominal"). The rate is per port, and the ports of a group are
+/// evenly phase-shifted to avoid synchronized bursts. For example, the following is a crude service flood under
+/// a background of 200 subjects:
+///
+///     pub 1000-1199 low  50   8-600
+///     req 430       fast 2000 32     42
+///
+/// Every transfer is scheduled at an absolute time. The generator sleeps with clock_nanosleep(TIMER_ABSTIME) until
+/// shortly before the due time and then busy-polls the clock, which combines low CPU usage with precise pacing.
+/// At the end it reports the requested versus achieved rates per group along with the send lateness distribution.
+/// If the generator can't keep up, the missed transfers are not sent in a burst later but counted as skipped.
+/// A transfer is achieved only once all its datagrams have been written into the socket of at least one iface;
+/// the transfers which expired in the TX queues (because the sockets couldn't keep up) are counted as dropped.
+///
+/// This software is distributed under the terms of the MIT License.
+/// Copyright (C) OpenCyphal Development Team  <opencyphal.org>
+/// Copyright Amazon.com Inc. or its affiliates.
+/// SPDX-License-Identifier: MIT
+
+// For clock_nanosleep().
+#define _DEFAULT_SOURCE  // NOLINT(bugprone-reserved-identifier,cert-dcl37-c,cert-dcl51-cpp)
+
+#include "udp.h"
+#include "memory_block.h"
+#include "xorshift.h"
+#include <udpard.h>
+
+// Standard library.
+#include <stdio.h>
+#include <stdlib.h>
+#include <assert.h>
+#include <string.h>
+#include <strings.h>
+#include <inttypes.h>
+#include <errno.h>
+#include <time.h>
+
+#define KILO 1000LL
+#define MEGA (KILO * KILO)
+#define GIGA (KILO * MEGA)
+
+/// The maximum number of UDP datagrams enqueued in the TX queue per iface at any given time.
+#define TX_QUEUE_SIZE 1000
+/// Limits of the scenario.
+#define MAX_GROUPS 64
+#define MAX_STREAMS 4096
+#define MAX_TRANSFER_SIZE 65536
+/// The lateness histogram has one bucket per power of two microseconds.
+#define LATENESS_BUCKETS 32
+
+/// A group of ports defined by one line of the scenario.
+struct Group
+{
+    bool                is_request;
+    UdpardPortID        first_port;
+    UdpardPortID        last_port;
+    enum UdpardPriority priority;
+    double              rate_hz;  ///< Per port.
+    size_t              min_size;
+    size_t              max_size;
+    UdpardNodeID        server_node_id;
+
+    // Statistics.
+    uint64_t transfers;  ///< Sent completely over at least one iface.
+    uint64_t datagrams;  ///< Written into the sockets (over all ifaces).
+    uint64_t bytes;      ///< Payload of the sent transfers.
+    uint64_t dropped;    ///< Rejected by the TX queues of all ifaces, or expired (or failed) in them before being sent.
+    uint64_t skipped;    ///< Not sent at all because the generator was running behind the schedule.
+    uint64_t lateness_usec_max;
+    uint64_t lateness_hist[LATENESS_BUCKETS];
+};
+
+/// One port of a group; streams are scheduled individually.
+struct Stream
+{
+    uint16_t         group_index;
+    UdpardPortID     port_id;
+    UdpardTransferID transfer_id;
+    uint64_t         period_ns;
+    uint64_t         due_ns;
+};
+
+struct Scenario
+{
+    UdpardNodeID local_node_id;
+    uint_fast8_t iface_count;
+    uint32_t     ifaces[UDPARD_NETWORK_INTERFACE_COUNT_MAX];
+    uint64_t     duration_ns;
+    uint64_t     spin_ns;
+    size_t       group_count;
+    struct Group groups[MAX_GROUPS];
+};
+
+/// Tracks one transfer while its datagrams are in the TX queues (it is the user reference of all its TX items),
+/// so that it is counted either as sent or as dropped once all its datagrams are out of the queues.
+struct TransferTrack
+{
+    struct Group*         group;
+    size_t                size;
+    uint64_t              due_ns;  ///< When the transfer was scheduled to be sent.
+    size_t                datagrams_left;
+    size_t                iface_datagrams_left[UDPARD_NETWORK_INTERFACE_COUNT_MAX];
+    bool                  iface_failed[UDPARD_NETWORK_INTERFACE_COUNT_MAX];  ///< A datagram expired or failed to send.
+    bool                  sent;                                              ///< Completely sent over some iface.
+    struct TransferTrack* next_free;
+};
+
+/// A tracked transfer holds at least one TX queue slot of some iface, so there can't be more of them than slots.
+struct TransferTrackPool
+{
+    struct TransferTrack  tracks[TX_QUEUE_SIZE * UDPARD_NETWORK_INTERFACE_COUNT_MAX];
+    struct TransferTrack* free_list;
+};
+
+struct TxPipeline
+{
+    struct UdpardTx udpard_tx;
+    UDPTxHandle     io;
+    uint64_t        send_errors;
+};
+
+/// The streams are kept in a binary min-heap ordered by the due time.
+struct Scheduler
+{
+    size_t        count;
+    struct Stream streams[MAX_STREAMS];
+    uint16_t      heap[MAX_STREAMS];
+};
+
+static uint64_t getMonotonicNanoseconds(void)
+{
+    struct timespec ts;
+    if (clock_gettime(CLOCK_MONOTONIC, &ts) != 0)
+    {
+        abort();
+    }
+    return (uint64_t) ts.tv_sec * (uint64_t) GIGA + (uint64_t) ts.tv_nsec;
+}
+
+// --------------------------------------------------------------------------------------------------------------------
+// SCENARIO PARSING
+// --------------------------------------------------------------------------------------------------------------------
+
+static bool parsePriority(const char* const text, enum UdpardPriority* const out)
+{
+    static const char* const Names[UDPARD_PRIORITY_MAX + 1] =
+        {"exceptional", "immediate", "fast", "high", "nominal", "low", "slow", "optional"};
+    for (size_t i = 0; i <= UDPARD_PRIORITY_MAX; i++)
+    {
+        if (strcasecmp(text, Names[i]) == 0)
+        {
+            *out = (enum UdpardPriority) i;
+            return true;
+        }
+    }
+    char* end = NULL;
+    const unsigned long value = strtoul(text, &end, 10);
+    if ((end != text) && (*end == '\0') && (value <= UDPARD_PRIORITY_MAX))
+    {
+        *out = (enum UdpardPriority) value;
+        return true;
+    }
+    return false;
+}
+
+/// Parses "<first>" or "<first>-<last>" into the range. Returns false if the text is not a valid range.
+static bool parseRange(const char* const text, unsigned long* const first, unsigned long* const last)
+{
+    char* end = NULL;
+    *first    = strtoul(text, &end, 10);
+    if (end == text)
+    {
+        return false;
+    }
+    *last = *first;
+    if (*end == '-')
+    {
+        const char* const second = end + 1;
+        *last                    = strtoul(second, &end, 10);
+        if (end == second)
+        {
+            return false;
+        }
+    }
+    return (*end == '\0') && (*first <= *last);
+}
+
+/// Parses one "pub" or "req" line (without the directive). Returns false if the line is malformed.
+static bool parseGroup(const bool is_request, char* const args, struct Group* const out)
+{
+    const char* const ports    = strtok(args, " \t\r\n");
+    const char* const priority = strtok(NULL, " \t\r\n");
+    const char* const rate     = strtok(NULL, " \t\r\n");
+    const char* const size     = strtok(NULL, " \t\r\n");
+    const char* const server   = is_request ? strtok(NULL, " \t\r\n") : NULL;
+    if ((ports == NULL) || (priority == NULL) || (rate == NULL) || (size == NULL) || (is_request && (server == NULL)))
+    {
+        return false;
+    }
+    memset(out, 0, sizeof(*out));
+    out->is_request = is_request;
+
+    unsigned long first = 0;
+    unsigned long last  = 0;
+    const unsigned long port_max = is_request ? UDPARD_SERVICE_ID_MAX : UDPARD_SUBJECT_ID_MAX;
+    if (!parseRange(ports, &first, &last) || (last > port_max))
+    {
+        return false;
+    }
+    out->first_port = (UdpardPortID) first;
+    out->last_port  = (UdpardPortID) last;
+
+    if (!parsePriority(priority, &out->priority))
+    {
+        return false;
+    }
+    char* end    = NULL;
+    out->rate_hz = strtod(rate, &end);
+    if ((end == rate) || (out->rate_hz <= 0.0) || (out->rate_hz > (double) GIGA))
+    {
+        return false;
+    }
+    if (!parseRange(size, &first, &last) || (last > MAX_TRANSFER_SIZE))
+    {
+        return false;
+    }
+    out->min_size = first;
+    out->max_size = last;
+
+    if (is_request)
+    {
+        const unsigned long server_node_id = strtoul(server, &end, 10);
+        if ((end == server) || (server_node_id > UDPARD_NODE_ID_MAX))
+        {
+            return false;
+        }
+        out->server_node_id = (UdpardNodeID) server_node_id;
+    }
+    return true;
+}
+
+/// Returns false if the scenario file can't be read or has a syntax error (which is reported to stderr).
+static bool loadScenario(const char* const path, struct Scenario* const out)
+{
+    FILE* const file = fopen(path, "r");
+    if (file == NULL)
+    {
+        (void) fprintf(stderr, "Cannot open the scenario %s: %s\n", path, strerror(errno));
+        return false;
+    }
+    out->local_node_id = 127;
+    out->iface_count   = 0;
+    out->duration_ns   = 10 * (uint64_t) GIGA;
+    out->spin_ns       = 50 * (uint64_t) KILO;
+    out->group_count   = 0;
+
+    bool     ok          = true;
+    unsigned line_number = 0;
+    char     line[1024];
+    while (ok && (fgets(line, sizeof(line), file) != NULL))
+    {
+        line_number++;
+        char* const comment = strchr(line, '#');
+        if (comment != NULL)
+        {
+            *comment = '\0';
+        }
+        char* const directive = strtok(line, " \t\r\n");
+        char* const args      = strtok(NULL, "");  // The rest of the line.
+        if (directive == NULL)
+        {
+            continue;  // Empty line.
+        }
+        if ((strcmp(directive, "pub") == 0) || (strcmp(directive, "req") == 0))
+        {
+            ok = (out->group_count < MAX_GROUPS) && (args != NULL) &&
+                 parseGroup(directive[0] == 'r', args, &out->groups[out->group_count]);
+            out->group_count += ok ? 1U : 0U;
+        }
+        else if (strcmp(directive, "iface") == 0)
+        {
+            for (const char* address = (args != NULL) ? strtok(args, " \t\r\n") : NULL;
+                 ok && (address != NULL);
+                 address = strtok(NULL, " \t\r\n"))
+            {
+                const uint32_t iface = udpParseIfaceAddress(address);
+                ok = (iface > 0) && (out->iface_count < UDPARD_NETWORK_INTERFACE_COUNT_MAX);
+                if (ok)
+                {
+                    out->ifaces[out->iface_count++] = iface;
+                }
+            }
+        }
+        else
+        {
+            char*               end   = NULL;
+            const char* const   value = (args != NULL) ? strtok(args, " \t\r\n") : NULL;
+            const unsigned long num   = (value != NULL) ? strtoul(value, &end, 10) : 0;
+            ok                        = (value != NULL) && (end != value) && (*end == '\0');
+            if (ok && (strcmp(directive, "node_id") == 0))
+            {
+                ok                 = num <= UDPARD_NODE_ID_MAX;
+                out->local_node_id = (UdpardNodeID) num;
+            }
+            else if (ok && (strcmp(directive, "duration") == 0))
+            {
+                out->duration_ns = num * (uint64_t) GIGA;
+            }
+            else if (ok && (strcmp(directive, "spin_us") == 0))
+            {
+                out->spin_ns = num * (uint64_t) KILO;
+            }
+            else
+            {
+                ok = false;
+            }
+        }
+    }
+    (void) fclose(file);
+    if (!ok)
+    {
+        (void) fprintf(stderr, "%s:%u: invalid directive\n", path, line_number);
+    }
+    if (out->iface_count == 0)
+    {
+        out->ifaces[out->iface_count++] = udpParseIfaceAddress("127.0.0.1");
+    }
+    return ok;
+}
+
+// --------------------------------------------------------------------------------------------------------------------
+// SCHEDULING
+// --------------------------------------------------------------------------------------------------------------------
+
+static bool isEarlier(const struct Scheduler* const self, const size_t a, const size_t b)
+{
+    return self->streams[self->heap[a]].due_ns < self->streams[self->heap[b]].due_ns;
+}
+
+static void swapHeap(struct Scheduler* const self, const size_t a, const size_t b)
+{
+    const uint16_t tmp = self->heap[a];
+    self->heap[a]      = self->heap[b];
+    self->heap[b]      = tmp;
+}
+
+/// Restores the heap property after the due time of the root stream has been moved forward.
+static void siftDown(struct Scheduler* const self)
+{
+    size_t index = 0;
+    while (true)
+    {
+        const size_t left     = (2U * index) + 1U;
+        const size_t right    = left + 1U;
+        size_t       earliest = index;
+        if ((left < self->count) && isEarlier(self, left, earliest))
+        {
+            earliest = left;
+        }
+        if ((right < self->count) && isEarlier(self, right, earliest))
+        {
+            earliest = right;
+        }
+        if (earliest == index)
+        {
+            break;
+        }
+        swapHeap(self, index, earliest);
+        index = earliest;
+    }
+}
+
+static void siftUp(struct Scheduler* const self, size_t index)
+{
+    while ((index > 0) && isEarlier(self, index, (index - 1U) / 2U))
+    {
+        swapHeap(self, index, (index - 1U) / 2U);
+        index = (index - 1U) / 2U;
+    }
+}
+
+/// Creates one stream per port of every group. Returns false if there are too many.
+static bool initScheduler(struct Scheduler* const self, const struct Scenario* const scenario, const uint64_t start_ns)
+{
+    self->count = 0;
+    for (size_t g = 0; g < scenario->group_count; g++)
+    {
+        const struct Group* const group      = &scenario->groups[g];
+        const size_t              port_count = (size_t) (group->last_port - group->first_port) + 1U;
+        const uint64_t            period_ns  = (uint64_t) ((double) GIGA / group->rate_hz);
+        for (size_t k = 0; k < port_count; k++)
+        {
+            if (self->count >= MAX_STREAMS)
+            {
+                (void) fprintf(stderr, "Too many ports in the scenario (max %d)\n", MAX_STREAMS);
+                return false;
+            }
+            struct Stream* const stream = &self->streams[self->count];
+            stream->group_index         = (uint16_t) g;
+            stream->port_id             = (UdpardPortID) (group->first_port + k);
+            stream->transfer_id         = 0;
+            stream->period_ns           = (period_ns > 0) ? period_ns : 1U;
+            stream->due_ns              = start_ns + ((period_ns * k) / port_count);  // Spread the phases.
+            self->heap[self->count]     = (uint16_t) self->count;
+            self->count++;
+            siftUp(self, self->count - 1U);
+        }
+    }
+    return true;
+}
+
+// --------------------------------------------------------------------------------------------------------------------
+// TRANSMISSION
+// --------------------------------------------------------------------------------------------------------------------
+
+static struct TransferTrackPool g_tracks;  // NOLINT(cppcoreguidelines-avoid-non-const-global-variables)
+
+static void initTransferTracks(void)
+{
+    g_tracks.free_list = NULL;
+    for (size_t i = 0; i < (sizeof(g_tracks.tracks) / sizeof(g_tracks.tracks[0])); i++)
+    {
+        g_tracks.tracks[i].next_free = g_tracks.free_list;
+        g_tracks.free_list           = &g_tracks.tracks[i];
+    }
+}
+
+static struct TransferTrack* takeTransferTrack(struct Group* const group, const size_t size, const uint64_t due_ns)
+{
+    struct TransferTrack* const track = g_tracks.free_list;
+    if (track != NULL)
+    {
+        g_tracks.free_list = track->next_free;
+        memset(track, 0, sizeof(*track));
+        track->group  = group;
+        track->size   = size;
+        track->due_ns = due_ns;
+    }
+    return track;
+}
+
+static void recordLateness(struct Group* const group, const uint64_t lateness_ns)
+{
+    const uint64_t usec   = lateness_ns / (uint64_t) KILO;
+    size_t         bucket = 0;
+    while (((1ULL << bucket) <= usec) && (bucket < (LATENESS_BUCKETS - 1U)))
+    {
+        bucket++;
+    }
+    group->lateness_hist[bucket]++;
+    group->lateness_usec_max = (usec > group->lateness_usec_max) ? usec : group->lateness_usec_max;
+}
+
+/// Counts the transfer as sent or dropped, and returns its track to the pool.
+static void finalizeTransferTrack(struct TransferTrack* const track)
+{
+    if (track->sent)
+    {
+        track->group->transfers++;
+        track->group->bytes += track->size;
+    }
+    else
+    {
+        track->group->dropped++;
+    }
+    track->next_free   = g_tracks.free_list;
+    g_tracks.free_list = track;
+}
+
+/// Accounts one datagram of the transfer leaving the TX queue of the iface, either written into the socket or not.
+static void onDatagramDone(struct TransferTrack* const track, const size_t iface_index, const bool is_sent)
+{
+    assert((track->datagrams_left > 0) && (track->iface_datagrams_left[iface_index] > 0));
+    track->group->datagrams += is_sent ? 1U : 0U;
+    track->iface_failed[iface_index] = track->iface_failed[iface_index] || !is_sent;
+    track->iface_datagrams_left[iface_index]--;
+    if ((track->iface_datagrams_left[iface_index] == 0) && !track->sent && !track->iface_failed[iface_index])
+    {
+        track->sent = true;
+        // The clock is sampled after the last datagram has been written, so the lateness includes the queuing.
+        recordLateness(track->group, getMonotonicNanoseconds() - track->due_ns);
+    }
+    track->datagrams_left--;
+    if (track->datagrams_left == 0)
+    {
+        finalizeTransferTrack(track);
+    }
+}
+
+/// Enqueues one transfer of the stream over all ifaces. It is counted in the group statistics only once it has left
+/// the TX queues (see `onDatagramDone`), except if it is rejected by all of them right away.
+static void emitTransfer(const struct Scenario* const scenario,
+                         struct TxPipeline* const     tx,
+                         struct Group* const          group,
+                         struct Stream* const         stream,
+                         const uint64_t               now_ns)
+{
+    static uint8_t payload[MAX_TRANSFER_SIZE];  // NOLINT(cppcoreguidelines-avoid-non-const-global-variables)
+
+    const size_t span = group->max_size - group->min_size;
+    const size_t size = group->min_size + ((span > 0) ? (size_t) (nextRandom() % (span + 1U)) : 0U);
+    for (size_t i = 0; i < size; i += sizeof(uint64_t))
+    {
+        const uint64_t random = nextRandom();
+        memcpy(&payload[i], &random, ((size - i) < sizeof(random)) ? (size - i) : sizeof(random));
+    }
+
+    struct TransferTrack* const track = takeTransferTrack(group, size, stream->due_ns);
+    if (track == NULL)
+    {
+        stream->transfer_id++;
+        group->dropped++;  // Can't happen unless the TX queues are full anyway.
+        return;
+    }
+
+    const UdpardMicrosecond    deadline = (now_ns / (uint64_t) KILO) + (uint64_t) MEGA;
+    const struct UdpardPayload data     = {.size = size, .data = &payload[0]};
+    for (size_t i = 0; i < scenario->iface_count; i++)
+    {
+        const int32_t result = group->is_request ? udpardTxRequest(&tx[i].udpard_tx,
+                                                                   deadline,
+                                                                   group->priority,
+                                                                   stream->port_id,
+                                                                   group->server_node_id,
+                                                                   stream->transfer_id,
+                                                                   data,
+                                                                   track)
+                                                 : udpardTxPublish(&tx[i].udpard_tx,
+                                                                   deadline,
+                                                                   group->priority,
+                                                                   stream->port_id,
+                                                                   stream->transfer_id,
+                                                                   data,
+                                                                   track);
+        if (result > 0)
+        {
+            track->iface_datagrams_left[i] = (size_t) result;
+            track->datagrams_left += (size_t) result;
+        }
+    }
+    stream->transfer_id++;
+    if (track->datagrams_left == 0)
+    {
+        finalizeTransferTrack(track);  // Rejected by all ifaces (full or out of memory).
+    }
+}
+
+/// Writes the pending datagrams into the sockets until they are not writable. Non-blocking.
+/// The expired datagrams are discarded, so that their transfers are counted as dropped
+/// (unless sent over another iface).
+/// Returns true if anything is still pending.
+static bool transmitPending(const size_t iface_count, struct TxPipeline* const tx, const UdpardMicrosecond now_usec)
+{
+    bool pending = false;
+    for (size_t i = 0; i < iface_count; i++)
+    {
+        struct TxPipeline* const pipe = &tx[i];
+        struct UdpardTxItem*     tqi  = udpardTxPeek(&pipe->udpard_tx);
+        while (tqi != NULL)
+        {
+            bool is_sent = false;
+            if ((tqi->deadline_usec == 0) || (tqi->deadline_usec > now_usec))
+            {
+                const int16_t send_res = udpTxSend(&pipe->io,
+                                                   tqi->destination.ip_address,
+                                                   tqi->destination.udp_port,
+                                                   tqi->dscp,
+                                                   tqi->datagram_payload.size,
+                                                   tqi->datagram_payload.data);
+                if (send_res == 0)
+                {
+                    pending = true;
+                    break;  // Socket no longer writable, stop sending for now to retry later.
+                }
+                pipe->send_errors += (send_res < 0) ? 1U : 0U;
+                is_sent = send_res > 0;
+            }
+            if (tqi->user_transfer_reference != NULL)
+            {
+                onDatagramDone((struct TransferTrack*) tqi->user_transfer_reference, i, is_sent);
+            }
+            udpardTxFree(pipe->udpard_tx.memory, udpardTxPop(&pipe->udpard_tx, tqi));
+            tqi = udpardTxPeek(&pipe->udpard_tx);
+        }
+    }
+    return pending;
+}
+
+/// Blocks until shortly before the due time: on the TX sockets if there is something pending for them,
+/// or with an absolute sleep otherwise. The remainder is busy-polled by the caller.
+static void waitUntil(const struct Scenario* const scenario,
+                      struct TxPipeline* const     tx,
+                      const bool                   tx_pending,
+                      const uint64_t               due_ns)
+{
+    const uint64_t now_ns = getMonotonicNanoseconds();
+    if ((due_ns <= now_ns) || ((due_ns - now_ns) <= scenario->spin_ns))
+    {
+        return;  // Spin.
+    }
+    const uint64_t wake_ns = due_ns - scenario->spin_ns;
+    if (tx_pending)
+    {
+        UDPTxAwaitable tx_await[UDPARD_NETWORK_INTERFACE_COUNT_MAX] = {0};
+        UDPRxAwaitable rx_await[1]                                  = {0};
+        for (size_t i = 0; i < scenario->iface_count; i++)
+        {
+            tx_await[i].handle = &tx[i].io;
+        }
+        (void) udpWait((wake_ns - now_ns) / (uint64_t) KILO, scenario->iface_count, &tx_await[0], 0, &rx_await[0]);
+    }
+    else
+    {
+        const struct timespec ts = {.tv_sec  = (time_t) (wake_ns / (uint64_t) GIGA),
+                                    .tv_nsec = (long) (wake_ns % (uint64_t) GIGA)};
+        (void) clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &ts, NULL);
+    }
+}
+
+// --------------------------------------------------------------------------------------------------------------------
+// REPORTING
+// --------------------------------------------------------------------------------------------------------------------
+
+/// Returns the upper bound of the histogram bucket where the given quantile falls (in microseconds).
+static uint64_t latenessQuantile(const struct Group* const group, const double q)
+{
+    uint64_t total = 0;
+    for (size_t i = 0; i < LATENESS_BUCKETS; i++)
+    {
+        total += group->lateness_hist[i];
+    }
+    const uint64_t target = (uint64_t) (q * (double) total);
+    uint64_t       seen   = 0;
+    for (size_t i = 0; i < LATENESS_BUCKETS; i++)
+    {
+        seen += group->lateness_hist[i];
+        if ((seen > target) || (seen == total))
+        {
+            const uint64_t bound = (1ULL << i) - 1U;
+            return (bound < group->lateness_usec_max) ? bound : group->lateness_usec_max;
+        }
+    }
+    return group->lateness_usec_max;
+}
+
+static void printReport(const struct Scenario* const scenario, const struct TxPipeline* const tx, const double elapsed)
+{
+    (void) printf("%-4s %-11s %4s %12s %12s %10s %10s %8s %8s %8s %8s %8s\n",
+                  "kind",
+                  "ports",
+                  "prio",
+                  "requested/s",
+                  "achieved/s",
+                  "dgrams/s",
+                  "kbyte/s",
+                  "dropped",
+                  "skipped",
+                  "late_p50",
+                  "late_p99",
+                  "late_max");
+    for (size_t g = 0; g < scenario->group_count; g++)
+    {
+        const struct Group* const group      = &scenario->groups[g];
+        const size_t              port_count = (size_t) (group->last_port - group->first_port) + 1U;
+        char                      ports[16];
+        (void) snprintf(ports, sizeof(ports), "%u-%u", (unsigned) group->first_port, (unsigned) group->last_port);
+        (void) printf("%-4s %-11s %4u %12.1f %12.1f %10.1f %10.1f %8" PRIu64 " %8" PRIu64 " %8" PRIu64 " %8" PRIu64
+                      " %8" PRIu64 "\n",
+                      group->is_request ? "req" : "pub",
+                      ports,
+                      (unsigned) group->priority,
+                      group->rate_hz * (double) port_count,
+                      (double) group->transfers / elapsed,
+                      (double) group->datagrams / elapsed,
+                      (double) group->bytes / elapsed / 1e3,
+                      group->dropped,
+                      group->skipped,
+                      latenessQuantile(group, 0.5),
+                      latenessQuantile(group, 0.99),
+                      group->lateness_usec_max);
+    }
+    for (size_t i = 0; i < scenario->iface_count; i++)
+    {
+        (void) printf("iface #%zu: %" PRIu64 " send errors\n", i, tx[i].send_errors);
+    }
+}
+
+// --------------------------------------------------------------------------------------------------------------------
+// MAIN
+// --------------------------------------------------------------------------------------------------------------------
+
+int main(const int argc, char* const argv[])
+{
+    static struct Scenario  scenario;   // NOLINT(cppcoreguidelines-avoid-non-const-global-variables)
+    static struct Scheduler scheduler;  // NOLINT(cppcoreguidelines-avoid-non-const-global-variables)
+    if ((argc < 2) || !loadScenario(argv[1], &scenario))
+    {
+        (void) fprintf(stderr, "Usage: %s <scenario-file>\n", argv[0]);
+        return 1;
+    }
+
+    // The block sizes are as in the demo node (see main.c); the TX queue items are the only users.
+    MEMORY_BLOCK_ALLOCATOR_DEFINE(mem_fragment, 88, TX_QUEUE_SIZE * UDPARD_NETWORK_INTERFACE_COUNT_MAX);
+    MEMORY_BLOCK_ALLOCATOR_DEFINE(mem_payload, 2048, TX_QUEUE_SIZE * UDPARD_NETWORK_INTERFACE_COUNT_MAX);
+    const struct UdpardTxMemoryResources tx_memory = {
+        .fragment = {.user_reference = &mem_fragment,
+                     .allocate       = &memoryBlockAllocate,
+                     .deallocate     = &memoryBlockDeallocate},
+        .payload  = {.user_reference = &mem_payload,
+                     .allocate       = &memoryBlockAllocate,
+                     .deallocate     = &memoryBlockDeallocate},
+    };
+
+    UdpardNodeID      local_node_id = scenario.local_node_id;
+    struct TxPipeline tx[UDPARD_NETWORK_INTERFACE_COUNT_MAX];
+    memset(&tx[0], 0, sizeof(tx));
+    initTransferTracks();
+    for (size_t i = 0; i < scenario.iface_count; i++)
+    {
+        if ((0 != udpardTxInit(&tx[i].udpard_tx, &local_node_id, TX_QUEUE_SIZE, tx_memory)) ||
+            (0 != udpTxInit(&tx[i].io, scenario.ifaces[i])))
+        {
+            (void) fprintf(stderr, "Failed to initialize TX pipeline for iface %zu\n", i);
+            return 1;
+        }
+    }
+
+    const uint64_t start_ns = getMonotonicNanoseconds();
+    const uint64_t end_ns   = start_ns + scenario.duration_ns;
+    if (!initScheduler(&scheduler, &scenario, start_ns))
+    {
+        return 1;
+    }
+    (void) fprintf(stderr,
+                   "Running %zu streams in %zu groups for %" PRIu64 " s...\n",
+                   scheduler.count,
+                   scenario.group_count,
+                   scenario.duration_ns / (uint64_t) GIGA);
+
+    bool tx_pending = false;
+    while (scheduler.count > 0)
+    {
+        const uint64_t now_ns = getMonotonicNanoseconds();
+        if (now_ns >= end_ns)
+        {
+            break;
+        }
+        struct Stream* const stream = &scheduler.streams[scheduler.heap[0]];
+        if (stream->due_ns > now_ns)
+        {
+            tx_pending = transmitPending(scenario.iface_count, &tx[0], now_ns / (uint64_t) KILO);
+            waitUntil(&scenario, &tx[0], tx_pending, (stream->due_ns < end_ns) ? stream->due_ns : end_ns);
+            continue;
+        }
+
+        struct Group* const group = &scenario.groups[stream->group_index];
+        emitTransfer(&scenario, &tx[0], group, stream, now_ns);
+        stream->due_ns += stream->period_ns;
+        if (stream->due_ns <= now_ns)  // Running behind by more than a period -- skip instead of bursting.
+        {
+            const uint64_t behind = ((now_ns - stream->due_ns) / stream->period_ns) + 1U;
+            group->skipped += behind;
+            stream->due_ns += behind * stream->period_ns;
+        }
+        siftDown(&scheduler);
+    }
+    const double elapsed = (double) (getMonotonicNanoseconds() - start_ns) / (double) GIGA;
+
+    // Let the queued datagrams out before reporting.
+    const uint64_t drain_deadline_ns = getMonotonicNanoseconds() + (uint64_t) GIGA;
+    while (transmitPending(scenario.iface_count, &tx[0], getMonotonicNanoseconds() / (uint64_t) KILO) &&
+           (getMonotonicNanoseconds() < drain_deadline_ns))
+    {
+        waitUntil(&scenario, &tx[0], true, drain_deadline_ns);
+    }
+    (void) transmitPending(scenario.iface_count, &tx[0], UINT64_MAX);  // Whatever is left now is expired (dropped).
+
+    printReport(&scenario, &tx[0], elapsed);
+    for (size_t i = 0; i < scenario.iface_count; i++)
+    {
+        udpTxClose(&tx[i].io);
+    }
+    return 0;
+}
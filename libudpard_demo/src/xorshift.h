@@ -0,0 +1,28 @@
+///                            ____                   ______            __          __
+///                           / __ `____  ___  ____  / ____/_  ______  / /_  ____  / /
+///                          / / / / __ `/ _ `/ __ `/ /   / / / / __ `/ __ `/ __ `/ /
+///                         / /_/ / /_/ /  __/ / / / /___/ /_/ / /_/ / / / / /_/ / /
+///                         `____/ .___/`___/_/ /_/`____/`__, / .___/_/ /_/`__,_/_/
+///                             /_/                     /____/_/
+///
+/// A header-only fast pseudo-random generator (xorshift64) for the traffic generator and the benchmarks.
+/// It is not suitable for anything that needs unpredictable numbers.
+///
+/// This software is distributed under the terms of the MIT License.
+/// Copyright (C) OpenCyphal Development Team  <opencyphal.org>
+/// Copyright Amazon.com Inc. or its affiliates.
+/// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include <stdint.h>
+
+/// Every translation unit has its own state with the same seed, so the sequence is the same on every run.
+static inline uint64_t nextRandom(void)
+{
+    static uint64_t state = 0x9E3779B97F4A7C15ULL;  // NOLINT(cppcoreguidelines-avoid-non-const-global-variables)
+    state ^= state << 13U;
+    state ^= state >> 7U;
+    state ^= state << 17U;
+    return state;
+}
@@ -0,0 +1,278 @@
+/// This software is distributed under the terms of the MIT License.
+/// Copyright (C) OpenCyphal Development Team  <opencyphal.org>
+/// Copyright Amazon.com Inc. or its affiliates.
+/// SPDX-License-Identifier: MIT
+
+// For clock_gettime(); shall precede all includes because binlog.h includes stdio.h.
+#ifndef _DEFAULT_SOURCE
+#    define _DEFAULT_SOURCE  // NOLINT(bugprone-reserved-identifier,cert-dcl37-c,cert-dcl51-cpp)
+#endif
+
+#include "binlog.h"
+
+#include <errno.h>
+#include <string.h>
+#include <time.h>
+#include <pthread.h>
+
+#define KILO 1000ULL
+#define MEGA (KILO * KILO)
+#define GIGA (KILO * MEGA)
+
+/// Enough for "%" + flags + width + "." + precision + "ll" + conversion.
+#define MAX_SPEC_LENGTH 32U
+
+static uint64_t getMonotonicNanoseconds(void)
+{
+    struct timespec ts;
+    (void) clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ((uint64_t) ts.tv_sec * GIGA) + (uint64_t) ts.tv_nsec;
+}
+
+/// Formats a single conversion specification (spec points at the '%') with the given argument.
+/// Returns the pointer to the character following the specification.
+static const char* formatConversion(FILE* const sink, const char* const spec, const BinlogArg* const arg)
+{
+    char   buf[MAX_SPEC_LENGTH] = {'%'};
+    size_t len                  = 1U;
+    // Copy the flags, the width, and the precision; drop the length modifiers.
+    const char* p = spec + 1;
+    while ((*p != '\0') && (strchr("-+ #0123456789.", *p) != NULL))
+    {
+        if (len < (MAX_SPEC_LENGTH - 4U))
+        {
+            buf[len++] = *p;
+        }
+        p++;
+    }
+    while ((*p != '\0') && (strchr("hlLjzt", *p) != NULL))
+    {
+        p++;
+    }
+    const char conv = *p;
+    if (conv == '\0')
+    {
+        (void) fputs(spec, sink);  // Truncated specification; print it verbatim.
+        return p;
+    }
+    if ((arg == NULL) && (conv != '%'))
+    {
+        (void) fwrite(spec, 1U, (size_t) (p - spec) + 1U, sink);  // Missing argument; print it verbatim.
+        return p + 1;
+    }
+    switch (conv)
+    {
+    case 'd':
+    case 'i':
+        buf[len++] = 'l';
+        buf[len++] = 'l';
+        buf[len++] = conv;
+        (void) fprintf(sink, buf, (long long) arg->i);  // NOLINT(clang-diagnostic-format-nonliteral)
+        break;
+    case 'u':
+    case 'o':
+    case 'x':
+    case 'X':
+        buf[len++] = 'l';
+        buf[len++] = 'l';
+        buf[len++] = conv;
+        (void) fprintf(sink, buf, (unsigned long long) arg->u);  // NOLINT(clang-diagnostic-format-nonliteral)
+        break;
+    case 'c':
+        buf[len++] = conv;
+        (void) fprintf(sink, buf, (int) arg->i);  // NOLINT(clang-diagnostic-format-nonliteral)
+        break;
+    case 'f':
+    case 'F':
+    case 'e':
+    case 'E':
+    case 'g':
+    case 'G':
+    case 'a':
+    case 'A':
+        buf[len++] = conv;
+        (void) fprintf(sink, buf, arg->f);  // NOLINT(clang-diagnostic-format-nonliteral)
+        break;
+    case 's':
+        buf[len++] = conv;
+        (void) fprintf(sink, buf, (arg->p != NULL) ? (const char*) arg->p : "(null)");  // NOLINT
+        break;
+    case 'p':
+        buf[len++] = conv;
+        (void) fprintf(sink, buf, arg->p);  // NOLINT(clang-diagnostic-format-nonliteral)
+        break;
+    case '%':
+        (void) fputc('%', sink);
+        break;
+    default:
+        (void) fwrite(spec, 1U, (size_t) (p - spec) + 1U, sink);  // Unsupported; print it verbatim.
+        break;
+    }
+    return p + 1;
+}
+
+static void formatRecord(FILE* const sink, const bool timestamp, const BinlogRecord* const rec)
+{
+    if (timestamp)
+    {
+        (void) fprintf(sink,
+                       "[%llu.%06llu] ",
+                       (unsigned long long) (rec->timestamp_ns / GIGA),
+                       (unsigned long long) ((rec->timestamp_ns % GIGA) / KILO));
+    }
+    size_t      arg_index = 0;
+    const char* p         = rec->format;
+    while (*p != '\0')
+    {
+        const char* const next = strchr(p, '%');
+        if (next == NULL)
+        {
+            (void) fputs(p, sink);
+            break;
+        }
+        (void) fwrite(p, 1U, (size_t) (next - p), sink);
+        if (next[1] == '%')
+        {
+            (void) fputc('%', sink);
+            p = next + 2;
+        }
+        else
+        {
+            const BinlogArg* const arg = (arg_index < rec->arg_count) ? &rec->args[arg_index] : NULL;
+            arg_index++;
+            p = formatConversion(sink, next, arg);
+        }
+    }
+}
+
+int binlogInit(Binlog* const self, BinlogRecord* const storage, const size_t capacity, FILE* const sink)
+{
+    int res = -EINVAL;
+    if ((self != NULL) && (storage != NULL) && (sink != NULL) && (capacity >= 2U) &&
+        ((capacity & (capacity - 1U)) == 0U))
+    {
+        (void) memset(self, 0, sizeof(*self));
+        self->records    = storage;
+        self->capacity   = capacity;
+        self->sink       = sink;
+        self->timestamps = true;
+        res              = 0;
+    }
+    return res;
+}
+
+bool binlogPush(Binlog* const self, const char* const format, const size_t arg_count, const BinlogArg* const args)
+{
+    if ((self == NULL) || (format == NULL) || (arg_count > BINLOG_MAX_ARGS) || ((arg_count > 0U) && (args == NULL)))
+    {
+        return false;
+    }
+    const size_t head = self->head;
+    if ((head - self->tail_cache) >= self->capacity)
+    {
+        self->tail_cache = __atomic_load_n(&self->tail, __ATOMIC_ACQUIRE);
+        if ((head - self->tail_cache) >= self->capacity)
+        {
+            __atomic_store_n(&self->dropped, self->dropped + 1U, __ATOMIC_RELAXED);
+            return false;
+        }
+    }
+    BinlogRecord* const rec = &self->records[head & (self->capacity - 1U)];
+    rec->timestamp_ns       = getMonotonicNanoseconds();
+    rec->format             = format;
+    rec->arg_count          = arg_count;
+    for (size_t i = 0; i < arg_count; i++)
+    {
+        rec->args[i] = args[i];
+    }
+    __atomic_store_n(&self->head, head + 1U, __ATOMIC_RELEASE);
+    return true;
+}
+
+size_t binlogDrain(Binlog* const self, const size_t max_records)
+{
+    size_t count = 0;
+    if (self == NULL)
+    {
+        return count;
+    }
+    const uint64_t dropped = __atomic_load_n(&self->dropped, __ATOMIC_RELAXED);
+    if (dropped != self->reported_dropped)
+    {
+        (void) fprintf(self->sink,
+                       "binlog: %llu records dropped (ring is full)\n",
+                       (unsigned long long) (dropped - self->reported_dropped));
+        self->reported_dropped = dropped;
+        count++;
+    }
+    size_t       tail = self->tail;
+    const size_t head = __atomic_load_n(&self->head, __ATOMIC_ACQUIRE);
+    while ((tail != head) && (count < max_records))
+    {
+        formatRecord(self->sink, self->timestamps, &self->records[tail & (self->capacity - 1U)]);
+        tail++;
+        count++;
+        __atomic_store_n(&self->tail, tail, __ATOMIC_RELEASE);
+    }
+    if (count > 0U)
+    {
+        (void) fflush(self->sink);
+    }
+    return count;
+}
+
+static void* drainerThread(void* const arg)
+{
+    BinlogDrainer* const  self   = (BinlogDrainer*) arg;
+    const struct timespec period = {.tv_sec  = (time_t) (self->period_usec / MEGA),
+                                    .tv_nsec = (long) ((self->period_usec % MEGA) * KILO)};
+    while (!__atomic_load_n(&self->stop, __ATOMIC_ACQUIRE))
+    {
+        if (binlogDrain(self->log, SIZE_MAX) == 0U)
+        {
+            (void) nanosleep(&period, NULL);
+        }
+    }
+    return NULL;
+}
+
+int binlogDrainerStart(BinlogDrainer* const self, Binlog* const log, const uint32_t period_usec)
+{
+    if ((self == NULL) || (log == NULL) || (period_usec == 0U))
+    {
+        return -EINVAL;
+    }
+    self->log         = log;
+    self->period_usec = period_usec;
+    self->stop        = false;
+    const int err     = pthread_create(&self->thread, NULL, &drainerThread, self);
+    if (err != 0)
+    {
+        self->log = NULL;
+    }
+    return -err;
+}
+
+void binlogDrainerStop(BinlogDrainer* const self)
+{
+    if ((self != NULL) && (self->log != NULL))
+    {
+        __atomic_store_n(&self->stop, true, __ATOMIC_RELEASE);
+        (void) pthread_join(self->thread, NULL);
+        (void) binlogDrain(self->log, SIZE_MAX);
+        self->log = NULL;
+    }
+}
+
+void binlogSetTimestamps(Binlog* const self, const bool enabled)
+{
+    if (self != NULL)
+    {
+        self->timestamps = enabled;
+    }
+}
+
+uint64_t binlogGetDropped(const Binlog* const self)
+{
+    return (self != NULL) ? __atomic_load_n(&self->dropped, __ATOMIC_RELAXED) : 0U;
+}
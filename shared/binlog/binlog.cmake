@@ -0,0 +1,15 @@
+# This software is distributed under the terms of the MIT License.
+# Copyright (C) OpenCyphal Development Team  <opencyphal.org>
+# Copyright Amazon.com Inc. or its affiliates.
+# SPDX-License-Identifier: MIT
+
+cmake_minimum_required(VERSION 3.20)
+
+# Define the asynchronous binary log library shared by the demos.
+add_library(
+        shared_binlog
+        ${CMAKE_CURRENT_LIST_DIR}/binlog.c
+)
+target_include_directories(shared_binlog PUBLIC ${CMAKE_CURRENT_LIST_DIR})
+find_package(Threads REQUIRED)
+target_link_libraries(shared_binlog PUBLIC Threads::Threads)
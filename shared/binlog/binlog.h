@@ -0,0 +1,206 @@
+///                            ____                   ______            __          __
+///                           / __ `____  ___  ____  / ____/_  ______  / /_  ____  / /
+///                          / / / / __ `/ _ `/ __ `/ /   / / / / __ `/ __ `/ __ `/ /
+///                         / /_/ / /_/ /  __/ / / / /___/ /_/ / /_/ / / / / /_/ / /
+///                         `____/ .___/`___/_/ /_/`____/`__, / .___/_/ /_/`__,_/_/
+///                             /_/                     /____/_/
+///
+/// This module implements a binary log with deferred formatting, intended for logging from hot paths
+/// (transfer handlers, control loops, transient error handlers) where a slow terminal or pipe must never
+/// stall the caller.
+///
+/// The producer only captures a timestamp, the pointer to the format string, and the raw argument values into
+/// a fixed-size lock-free ring; formatting and the actual output happen later, when the consumer drains the ring.
+/// The consumer is normally a background thread (see BinlogDrainer), so that the blocking output never delays the
+/// producer; a single-threaded application may drain a bounded number of records at idle instead. If the ring
+/// is full, the record is dropped and counted; the number of dropped records is reported by the consumer.
+///
+/// The ring is single-producer single-consumer: all logging shall be done from one thread, and draining from one
+/// (possibly another) thread.
+///
+/// Because formatting is deferred, the format string and any string arguments must have static storage duration
+/// (string literals). Supported conversions are those of printf() with the exception of '*' width/precision and
+/// '%n'; length modifiers in the format string are ignored because the argument types are captured at the call site.
+///
+/// This software is distributed under the terms of the MIT License.
+/// Copyright (C) OpenCyphal Development Team  <opencyphal.org>
+/// Copyright Amazon.com Inc. or its affiliates.
+/// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <pthread.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/// The maximum number of arguments per log record (in addition to the format string).
+#define BINLOG_MAX_ARGS 6
+
+/// Used to keep the producer and the consumer indexes in separate cache lines.
+#define BINLOG_CACHE_LINE_SIZE 64
+
+/// A raw argument value captured at the call site. Integers are sign- or zero-extended to 64 bits.
+typedef union
+{
+    int64_t     i;
+    uint64_t    u;
+    double      f;
+    const void* p;
+} BinlogArg;
+
+typedef struct
+{
+    uint64_t    timestamp_ns;  ///< CLOCK_MONOTONIC at the moment of logging.
+    const char* format;
+    size_t      arg_count;
+    BinlogArg   args[BINLOG_MAX_ARGS];
+} BinlogRecord;
+
+/// The fields are not to be accessed by the application directly.
+typedef struct
+{
+    BinlogRecord* records;
+    size_t        capacity;  ///< Always a power of two.
+    FILE*         sink;
+
+    bool          timestamps;  ///< Whether to prefix the output with timestamps; true by default.
+
+    // Modified by the producer only.
+    size_t   head;
+    size_t   tail_cache;  ///< The last seen consumer index, to avoid touching its cache line on every push.
+    uint64_t dropped;
+    uint8_t  padding_[BINLOG_CACHE_LINE_SIZE];
+
+    // Modified by the consumer only.
+    size_t   tail;
+    uint64_t reported_dropped;
+} Binlog;
+
+/// Initializes the log over the application-provided record storage.
+/// The capacity (number of records) shall be a power of two not less than 2.
+/// Returns 0 on success, or a negative error code (-EINVAL) if the arguments are invalid.
+int binlogInit(Binlog* const self, BinlogRecord* const storage, const size_t capacity, FILE* const sink);
+
+/// Appends a record to the log; invoked by the producer. Never blocks, and doesn't make system calls
+/// except for the vDSO-backed clock_gettime().
+/// The format and any string arguments must have static storage duration.
+/// Returns false if the record has been dropped because the ring is full (or too many arguments).
+bool binlogPush(Binlog* const self, const char* const format, const size_t arg_count, const BinlogArg* const args);
+
+/// Drains a log from a background thread. The fields are not to be accessed by the application directly.
+typedef struct
+{
+    Binlog*   log;
+    pthread_t thread;
+    uint32_t  period_usec;
+    bool      stop;
+} BinlogDrainer;
+
+/// Formats and writes up to max_records oldest records to the sink; invoked by the consumer.
+/// Returns the number of records written. The sink is flushed if anything has been written.
+size_t binlogDrain(Binlog* const self, const size_t max_records);
+
+/// Starts the thread which drains the log whenever there are records, polling it every period_usec when it is empty.
+/// While the drainer is running, the log shall not be drained by anyone else.
+/// Returns 0 on success, or a negative error code (e.g., -EINVAL, or the negated pthread_create() error).
+int binlogDrainerStart(BinlogDrainer* const self, Binlog* const log, const uint32_t period_usec);
+
+/// Stops and joins the drainer thread, then drains the remaining records from the calling thread.
+void binlogDrainerStop(BinlogDrainer* const self);
+
+/// Enables or disables the "[seconds.microseconds] " prefix of the output records (enabled by default).
+void binlogSetTimestamps(Binlog* const self, const bool enabled);
+
+/// Returns the number of records dropped so far because the ring was full.
+uint64_t binlogGetDropped(const Binlog* const self);
+
+// ----------------------------------------------------  ARGUMENTS  ----------------------------------------------------
+
+static inline BinlogArg binlogArgI(const int64_t value)
+{
+    BinlogArg out;
+    out.i = value;
+    return out;
+}
+static inline BinlogArg binlogArgU(const uint64_t value)
+{
+    BinlogArg out;
+    out.u = value;
+    return out;
+}
+static inline BinlogArg binlogArgF(const double value)
+{
+    BinlogArg out;
+    out.f = value;
+    return out;
+}
+static inline BinlogArg binlogArgF32(const float value)
+{
+    return binlogArgF((double) value);
+}
+static inline BinlogArg binlogArgP(const void* const value)
+{
+    BinlogArg out;
+    out.p = value;
+    return out;
+}
+
+#ifndef __cplusplus
+
+/// Captures an argument according to its static type. Pointers other than strings shall be cast to (const void*).
+#    define BINLOG_ARG(x)                \
+        _Generic((x),                    \
+            float: binlogArgF32,         \
+            double: binlogArgF,          \
+            char*: binlogArgP,           \
+            const char*: binlogArgP,     \
+            void*: binlogArgP,           \
+            const void*: binlogArgP,     \
+            signed char: binlogArgI,     \
+            short: binlogArgI,           \
+            int: binlogArgI,             \
+            long: binlogArgI,            \
+            long long: binlogArgI,       \
+            default: binlogArgU)(x)
+
+/// Usage: BINLOG(&log, "Iface #%u RX error: %i\n", iface_index, result);
+/// Up to BINLOG_MAX_ARGS arguments are supported. Evaluates to the result of binlogPush().
+#    define BINLOG(log, ...)                                                                                     \
+        BINLOG_PICK_(__VA_ARGS__, BINLOG_6_, BINLOG_5_, BINLOG_4_, BINLOG_3_, BINLOG_2_, BINLOG_1_, BINLOG_0_, ~) \
+        (log, __VA_ARGS__)
+
+#    define BINLOG_PICK_(_0, _1, _2, _3, _4, _5, _6, name, ...) name
+#    define BINLOG_0_(log, fmt) binlogPush((log), (fmt), 0U, NULL)
+#    define BINLOG_1_(log, fmt, a) binlogPush((log), (fmt), 1U, (const BinlogArg[]){BINLOG_ARG(a)})
+#    define BINLOG_2_(log, fmt, a, b) binlogPush((log), (fmt), 2U, (const BinlogArg[]){BINLOG_ARG(a), BINLOG_ARG(b)})
+#    define BINLOG_3_(log, fmt, a, b, c) \
+        binlogPush((log), (fmt), 3U, (const BinlogArg[]){BINLOG_ARG(a), BINLOG_ARG(b), BINLOG_ARG(c)})
+#    define BINLOG_4_(log, fmt, a, b, c, d) \
+        binlogPush((log), (fmt), 4U, (const BinlogArg[]){BINLOG_ARG(a), BINLOG_ARG(b), BINLOG_ARG(c), BINLOG_ARG(d)})
+#    define BINLOG_5_(log, fmt, a, b, c, d, e) \
+        binlogPush((log),                      \
+                   (fmt),                      \
+                   5U,                         \
+                   (const BinlogArg[]){BINLOG_ARG(a), BINLOG_ARG(b), BINLOG_ARG(c), BINLOG_ARG(d), BINLOG_ARG(e)})
+#    define BINLOG_6_(log, fmt, a, b, c, d, e, f)                                        \
+        binlogPush((log),                                                                \
+                   (fmt),                                                                \
+                   6U,                                                                   \
+                   (const BinlogArg[]){BINLOG_ARG(a),                                    \
+                                       BINLOG_ARG(b),                                    \
+                                       BINLOG_ARG(c),                                    \
+                                       BINLOG_ARG(d),                                    \
+                                       BINLOG_ARG(e),                                    \
+                                       BINLOG_ARG(f)})
+
+#endif  // __cplusplus
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,392 @@
+/// This software is distributed under the terms of the MIT License.
+/// Copyright (C) OpenCyphal Development Team  <opencyphal.org>
+/// Copyright Amazon.com Inc. or its affiliates.
+/// SPDX-License-Identifier: MIT
+
+// For clock_gettime(); shall precede all includes because capture.h includes stdio.h.
+#ifndef _DEFAULT_SOURCE
+#    define _DEFAULT_SOURCE  // NOLINT(bugprone-reserved-identifier,cert-dcl37-c,cert-dcl51-cpp)
+#endif
+
+#include "capture.h"
+
+#include <arpa/inet.h>
+#include <errno.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <time.h>
+
+#ifdef __linux__
+#    include <linux/can.h>
+#endif
+
+#define KILO 1000ULL
+#define MEGA (KILO * KILO)
+
+#define MAGIC 0x50435943UL  // "CYCP" in little-endian
+#define VERSION 1U
+#define HEADER_SIZE 16U
+#define RECORD_HEADER_SIZE 14U
+
+/// Large enough to make the write() calls rare even at the full CAN FD bus load.
+#define BUFFER_SIZE (64U * 1024U)
+
+/// The kind of a socket in the descriptor table (besides CAPTURE_KIND_*).
+#define DESCRIPTOR_UNKNOWN 0U
+#define DESCRIPTOR_REJECTED 0xFFU
+
+typedef struct
+{
+    uint8_t  kind;  ///< DESCRIPTOR_UNKNOWN, DESCRIPTOR_REJECTED or CAPTURE_KIND_*
+    uint8_t  iface;
+    uint16_t port;
+    uint32_t group;
+} Descriptor;
+
+/// The local address and port of a UDP TX socket.
+typedef struct
+{
+    int      fd;
+    uint32_t address;
+    uint16_t port;  ///< Zero if the entry is free (the bound sockets have nonzero ports).
+} Endpoint;
+
+typedef struct
+{
+    FILE*      file;
+    uint64_t   last_us;
+    uint64_t   records;
+    Descriptor descriptors[CAPTURE_MAX_DESCRIPTORS];  ///< Indexed by the file descriptor.
+    Endpoint   own_endpoints[CAPTURE_MAX_OWN_ENDPOINTS];
+    char       buffer[BUFFER_SIZE];
+} Capture;
+
+static Capture g_capture;
+
+static uint64_t getMonotonicMicroseconds(void)
+{
+    struct timespec ts;
+    (void) clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ((uint64_t) ts.tv_sec * MEGA) + ((uint64_t) ts.tv_nsec / KILO);
+}
+
+static uint64_t getRealtimeMicroseconds(void)
+{
+    struct timespec ts;
+    (void) clock_gettime(CLOCK_REALTIME, &ts);
+    return ((uint64_t) ts.tv_sec * MEGA) + ((uint64_t) ts.tv_nsec / KILO);
+}
+
+static uint8_t* serialize16(uint8_t* const ptr, const uint16_t value)
+{
+    ptr[0] = (uint8_t) (value & 0xFFU);
+    ptr[1] = (uint8_t) (value >> 8U);
+    return ptr + 2;
+}
+
+static uint8_t* serialize32(uint8_t* const ptr, const uint32_t value)
+{
+    return serialize16(serialize16(ptr, (uint16_t) (value & 0xFFFFU)), (uint16_t) (value >> 16U));
+}
+
+static uint8_t* serialize64(uint8_t* const ptr, const uint64_t value)
+{
+    return serialize32(serialize32(ptr, (uint32_t) (value & 0xFFFFFFFFU)), (uint32_t) (value >> 32U));
+}
+
+static uint16_t deserialize16(const uint8_t* const ptr)
+{
+    return (uint16_t) (ptr[0] | (uint16_t) (ptr[1] << 8U));
+}
+
+static uint32_t deserialize32(const uint8_t* const ptr)
+{
+    return deserialize16(ptr) | ((uint32_t) deserialize16(ptr + 2) << 16U);
+}
+
+static uint64_t deserialize64(const uint8_t* const ptr)
+{
+    return deserialize32(ptr) | ((uint64_t) deserialize32(ptr + 4) << 32U);
+}
+
+/// Returns NULL if the descriptor is out of the table range.
+static Descriptor* getDescriptor(const int fd)
+{
+    return ((fd >= 0) && ((unsigned) fd < CAPTURE_MAX_DESCRIPTORS)) ? &g_capture.descriptors[fd] : NULL;
+}
+
+static void writeRecord(const uint8_t  kind,
+                        const uint8_t  iface,
+                        const uint32_t id,
+                        const uint16_t port,
+                        const size_t   size,
+                        const void*    data)
+{
+    const uint64_t now_us   = getMonotonicMicroseconds();
+    const uint64_t delta_us = (g_capture.records > 0) ? (now_us - g_capture.last_us) : 0U;
+    g_capture.last_us       = now_us;
+
+    const uint16_t size16 = (size < CAPTURE_MAX_PAYLOAD_SIZE) ? (uint16_t) size : (uint16_t) CAPTURE_MAX_PAYLOAD_SIZE;
+
+    uint8_t  header[RECORD_HEADER_SIZE];
+    uint8_t* ptr = &header[0];
+    ptr          = serialize32(ptr, (delta_us < UINT32_MAX) ? (uint32_t) delta_us : UINT32_MAX);
+    ptr          = serialize32(ptr, id);
+    ptr          = serialize16(ptr, size16);
+    ptr          = serialize16(ptr, port);
+    *ptr++       = kind;
+    *ptr         = iface;
+    (void) fwrite(&header[0], 1U, sizeof(header), g_capture.file);
+    (void) fwrite(data, 1U, size16, g_capture.file);
+    g_capture.records++;
+}
+
+int captureStart(const char* const path)
+{
+    if (path == NULL)
+    {
+        return -EINVAL;
+    }
+    captureStop();
+
+    FILE* const file = fopen(path, "wb");
+    if (file == NULL)
+    {
+        return -errno;
+    }
+    (void) setvbuf(file, &g_capture.buffer[0], _IOFBF, sizeof(g_capture.buffer));
+
+    uint8_t  header[HEADER_SIZE];
+    uint8_t* ptr = &header[0];
+    ptr          = serialize32(ptr, MAGIC);
+    ptr          = serialize16(ptr, VERSION);
+    ptr          = serialize16(ptr, HEADER_SIZE);
+    (void) serialize64(ptr, getRealtimeMicroseconds());
+    if (fwrite(&header[0], 1U, sizeof(header), file) != sizeof(header))
+    {
+        const int err = errno;
+        (void) fclose(file);
+        return -err;
+    }
+
+    g_capture.file       = file;
+    g_capture.last_us    = 0;
+    g_capture.records    = 0;
+    (void) memset(&g_capture.descriptors[0], 0, sizeof(g_capture.descriptors));
+    return 0;
+}
+
+void captureStop(void)
+{
+    if (g_capture.file != NULL)
+    {
+        (void) fclose(g_capture.file);
+        g_capture.file = NULL;
+    }
+}
+
+bool captureIsActive(void)
+{
+    return g_capture.file != NULL;
+}
+
+uint64_t captureGetRecordCount(void)
+{
+    return g_capture.records;
+}
+
+void captureOnCanRx(const int fd, const uint32_t can_id, const size_t size, const void* const data)
+{
+    if (g_capture.file == NULL)
+    {
+        return;
+    }
+    Descriptor        uncached   = {0};
+    Descriptor* const cached     = getDescriptor(fd);
+    Descriptor* const descriptor = (cached != NULL) ? cached : &uncached;
+    if ((descriptor->kind != CAPTURE_KIND_CAN) && (descriptor->kind != DESCRIPTOR_REJECTED))
+    {
+        // The sockets are bound to their interface; see socketcanOpen().
+        descriptor->kind  = CAPTURE_KIND_CAN;
+        descriptor->iface = 0;
+#ifdef __linux__
+        struct sockaddr_can addr     = {0};
+        socklen_t           addr_len = sizeof(addr);
+        if ((getsockname(fd, (struct sockaddr*) &addr, &addr_len) == 0) && (addr.can_family == AF_CAN) &&
+            (addr.can_ifindex > 0))
+        {
+            if (addr.can_ifindex <= UINT8_MAX)
+            {
+                descriptor->iface = (uint8_t) addr.can_ifindex;
+            }
+            else
+            {
+                descriptor->kind = DESCRIPTOR_REJECTED;
+                (void) fprintf(stderr,
+                               "Capture: CAN interface index %d does not fit the record, its frames are skipped\n",
+                               addr.can_ifindex);
+            }
+        }
+#endif
+    }
+    if (descriptor->kind == DESCRIPTOR_REJECTED)
+    {
+        return;
+    }
+    writeRecord(CAPTURE_KIND_CAN, descriptor->iface, can_id, 0U, size, data);
+}
+
+void captureOnUdpRx(const int         fd,
+                    const uint32_t    source_address,
+                    const uint16_t    source_port,
+                    const size_t      size,
+                    const void* const data)
+{
+    if (g_capture.file == NULL)
+    {
+        return;
+    }
+    // Our own datagrams come back via the multicast loopback; they would be emitted by the node under test itself.
+    for (size_t i = 0; i < CAPTURE_MAX_OWN_ENDPOINTS; i++)
+    {
+        const Endpoint* const own = &g_capture.own_endpoints[i];
+        if ((own->port == source_port) && (own->port != 0U) && (own->address == source_address))
+        {
+            return;
+        }
+    }
+    Descriptor        uncached   = {0};
+    Descriptor* const cached     = getDescriptor(fd);
+    Descriptor* const descriptor = (cached != NULL) ? cached : &uncached;
+    if (descriptor->kind != CAPTURE_KIND_UDP)
+    {
+        // The RX sockets are bound to the multicast group address and the port; see udpRxInit().
+        struct sockaddr_in addr     = {0};
+        socklen_t          addr_len = sizeof(addr);
+        if ((getsockname(fd, (struct sockaddr*) &addr, &addr_len) == 0) && (addr.sin_family == AF_INET))
+        {
+            descriptor->kind  = CAPTURE_KIND_UDP;
+            descriptor->group = ntohl(addr.sin_addr.s_addr);
+            descriptor->port  = ntohs(addr.sin_port);
+        }
+    }
+    writeRecord(CAPTURE_KIND_UDP, 0U, descriptor->group, descriptor->port, size, data);
+}
+
+void captureOnUdpTxOpen(const int fd)
+{
+    struct sockaddr_in addr     = {0};
+    socklen_t          addr_len = sizeof(addr);
+    if ((getsockname(fd, (struct sockaddr*) &addr, &addr_len) == 0) && (addr.sin_family == AF_INET))
+    {
+        for (size_t i = 0; i < CAPTURE_MAX_OWN_ENDPOINTS; i++)
+        {
+            Endpoint* const own = &g_capture.own_endpoints[i];
+            if (own->port == 0U)
+            {
+                own->fd      = fd;
+                own->address = ntohl(addr.sin_addr.s_addr);
+                own->port    = ntohs(addr.sin_port);
+                break;
+            }
+        }
+    }
+}
+
+void captureForgetDescriptor(const int fd)
+{
+    Descriptor* const descriptor = getDescriptor(fd);
+    if (descriptor != NULL)
+    {
+        descriptor->kind = DESCRIPTOR_UNKNOWN;
+    }
+    for (size_t i = 0; i < CAPTURE_MAX_OWN_ENDPOINTS; i++)
+    {
+        Endpoint* const own = &g_capture.own_endpoints[i];
+        if ((own->port != 0U) && (own->fd == fd))
+        {
+            own->port = 0U;
+        }
+    }
+}
+
+// -----------------------------------------------------  READER  ------------------------------------------------------
+
+int captureReaderOpen(CaptureReader* const self, const char* const path)
+{
+    if ((self == NULL) || (path == NULL))
+    {
+        return -EINVAL;
+    }
+    self->file = fopen(path, "rb");
+    if (self->file == NULL)
+    {
+        return -errno;
+    }
+    uint8_t header[HEADER_SIZE];
+    if ((fread(&header[0], 1U, sizeof(header), self->file) != sizeof(header)) ||
+        (deserialize32(&header[0]) != MAGIC) || (deserialize16(&header[4]) != VERSION) ||
+        (deserialize16(&header[6]) < HEADER_SIZE) ||
+        (fseek(self->file, (long) deserialize16(&header[6]), SEEK_SET) != 0))
+    {
+        captureReaderClose(self);
+        return -EINVAL;
+    }
+    self->start_unix_us = deserialize64(&header[8]);
+    self->timestamp_us  = 0;
+    return 0;
+}
+
+int captureReaderNext(CaptureReader* const self,
+                      CaptureRecord* const out_record,
+                      const size_t         payload_capacity,
+                      void* const          out_payload)
+{
+    if ((self == NULL) || (self->file == NULL) || (out_record == NULL) ||
+        ((out_payload == NULL) && (payload_capacity > 0)))
+    {
+        return -EINVAL;
+    }
+    uint8_t      header[RECORD_HEADER_SIZE];
+    const size_t header_size = fread(&header[0], 1U, sizeof(header), self->file);
+    if (header_size == 0)
+    {
+        return 0;
+    }
+    if (header_size != sizeof(header))
+    {
+        return -EIO;
+    }
+    self->timestamp_us += deserialize32(&header[0]);
+    out_record->timestamp_us = self->timestamp_us;
+    out_record->id           = deserialize32(&header[4]);
+    out_record->size         = deserialize16(&header[8]);
+    out_record->port         = deserialize16(&header[10]);
+    out_record->kind         = header[12];
+    out_record->iface        = header[13];
+
+    const size_t copy_size = (out_record->size < payload_capacity) ? out_record->size : payload_capacity;
+    if ((copy_size > 0) && (fread(out_payload, 1U, copy_size, self->file) != copy_size))
+    {
+        return -EIO;
+    }
+    if ((copy_size < out_record->size) && (fseek(self->file, (long) (out_record->size - copy_size), SEEK_CUR) != 0))
+    {
+        return -EIO;
+    }
+    return 1;
+}
+
+uint64_t captureReaderGetStartTime(const CaptureReader* const self)
+{
+    return (self != NULL) ? self->start_unix_us : 0U;
+}
+
+void captureReaderClose(CaptureReader* const self)
+{
+    if ((self != NULL) && (self->file != NULL))
+    {
+        (void) fclose(self->file);
+        self->file = NULL;
+    }
+}
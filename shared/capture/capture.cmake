@@ -0,0 +1,15 @@
+# This software is distributed under the terms of the MIT License.
+# Copyright (C) OpenCyphal Development Team  <opencyphal.org>
+# Copyright Amazon.com Inc. or its affiliates.
+# SPDX-License-Identifier: MIT
+
+cmake_minimum_required(VERSION 3.20)
+
+# Define the RX traffic capture library; it is linked by the shared media, so it may be included more than once.
+if (NOT TARGET shared_capture)
+    add_library(
+            shared_capture
+            ${CMAKE_CURRENT_LIST_DIR}/capture.c
+    )
+    target_include_directories(shared_capture PUBLIC ${CMAKE_CURRENT_LIST_DIR})
+endif ()
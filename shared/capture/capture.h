@@ -0,0 +1,134 @@
+///                            ____                   ______            __          __
+///                           / __ `____  ___  ____  / ____/_  ______  / /_  ____  / /
+///                          / / / / __ `/ _ `/ __ `/ /   / / / / __ `/ __ `/ __ `/ /
+///                         / /_/ / /_/ /  __/ / / / /___/ /_/ / /_/ / / / / /_/ / /
+///                         `____/ .___/`___/_/ /_/`____/`__, / .___/_/ /_/`__,_/_/
+///                             /_/                     /____/_/
+///
+/// This module implements capturing of the raw received traffic (CAN frames and UDP datagrams) into a compact binary
+/// file, and reading it back. A capture taken from a real network can then be replayed into a node under test
+/// at the original or accelerated speed, which makes performance regressions reproducible with field traffic.
+///
+/// The capture is process-wide: the hooks are invoked by socketcanPop() and udpRxReceive() for every received
+/// frame or datagram, and they do nothing (one branch) until captureStart() is called. The records are written via
+/// a large stdio buffer, so a capture costs a memcpy per frame most of the time; nevertheless, the buffer is
+/// written to the file synchronously once full, so the capture file should reside on a fast local file system.
+/// The capture is not thread-safe; all hooks shall be invoked from the same thread.
+///
+/// The file layout (all values are little-endian):
+///
+///     header: magic "CYCP" (u32), version (u16), header size (u16), start time, Unix epoch in microseconds (u64)
+///     record: delta time since the previous record in microseconds (u32), CAN ID or UDP group address (u32),
+///             payload size (u16), UDP port or zero (u16), kind (u8), CAN interface index (u8), payload bytes.
+///
+/// The CAN interface index is the kernel index of the interface the socket is bound to (see if_nametoindex()),
+/// so it identifies the same bus in every capture taken on the host. The frames of an interface whose index
+/// does not fit the record are not captured (with a warning), as merging them with another bus would misattribute
+/// them on replay.
+///
+/// Only the traffic of the other nodes is captured, because the node under test emits its own traffic by itself
+/// on replay: the CAN frames looped back by the kernel are skipped by socketcanPop(), and the UDP datagrams
+/// looped back via the multicast loopback are recognized by their source endpoint (see captureOnUdpTxOpen()).
+///
+/// The record timestamps are taken from CLOCK_MONOTONIC at the moment the frame has been read from the socket.
+/// Gaps longer than 2^32 microseconds (~71 minutes) are truncated.
+///
+/// This software is distributed under the terms of the MIT License.
+/// Copyright (C) OpenCyphal Development Team  <opencyphal.org>
+/// Copyright Amazon.com Inc. or its affiliates.
+/// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define CAPTURE_KIND_CAN 1U
+#define CAPTURE_KIND_UDP 2U
+
+/// The maximum payload size of a record; larger payloads are truncated.
+#define CAPTURE_MAX_PAYLOAD_SIZE 0xFFFFU
+
+/// The number of distinct sockets the capture can cache the addresses of; extra sockets are queried per record.
+#define CAPTURE_MAX_DESCRIPTORS 256U
+
+/// The number of local UDP TX sockets whose looped back datagrams can be recognized; extra sockets are not tracked.
+#define CAPTURE_MAX_OWN_ENDPOINTS 16U
+
+typedef struct
+{
+    uint64_t timestamp_us;  ///< Since the first record of the capture.
+    uint32_t id;            ///< Extended CAN ID, or the destination multicast group address of the datagram.
+    uint16_t size;          ///< Payload size.
+    uint16_t port;          ///< Destination UDP port of the datagram; zero for CAN.
+    uint8_t  kind;          ///< CAPTURE_KIND_*
+    uint8_t  iface;         ///< Kernel interface index of the CAN socket (zero if unknown); zero for UDP.
+} CaptureRecord;
+
+/// Creates (truncates) the capture file and starts capturing. A capture in progress is stopped first.
+/// Returns 0 on success, or a negative error code.
+int captureStart(const char* const path);
+
+/// Flushes and closes the capture file. No effect if the capture is not started.
+void captureStop(void);
+
+/// Returns true if the capture is started.
+bool captureIsActive(void);
+
+/// Returns the number of records written since captureStart().
+uint64_t captureGetRecordCount(void);
+
+/// Hooks of the RX paths of the shared media; see socketcanPop() and udpRxReceive().
+/// The UDP destination is obtained from the socket itself (once per socket); the source is that of the datagram,
+/// and the datagrams sent from the local TX sockets are not captured.
+void captureOnCanRx(const int fd, const uint32_t can_id, const size_t size, const void* const data);
+void captureOnUdpRx(const int         fd,
+                    const uint32_t    source_address,
+                    const uint16_t    source_port,
+                    const size_t      size,
+                    const void* const data);
+
+/// Shall be invoked when a UDP TX socket is bound (see udpTxInit()), regardless of whether the capture is started,
+/// so that its datagrams looped back to the local RX sockets could be told apart from the traffic of other nodes.
+void captureOnUdpTxOpen(const int fd);
+
+/// Shall be invoked when the socket is closed, because the descriptor may be reused for another socket
+/// (see socketcanClose(), udpTxClose() and udpRxClose()).
+void captureForgetDescriptor(const int fd);
+
+// -----------------------------------------------------  READER  ------------------------------------------------------
+
+/// The fields are not to be accessed by the application directly.
+typedef struct
+{
+    FILE*    file;
+    uint64_t start_unix_us;
+    uint64_t timestamp_us;
+} CaptureReader;
+
+/// Opens the capture file and validates its header.
+/// Returns 0 on success, or a negative error code (-EINVAL if the file is not a capture).
+int captureReaderOpen(CaptureReader* const self, const char* const path);
+
+/// Reads the next record. The payload is truncated to payload_capacity bytes (out_record->size is not).
+/// Returns 1 on success, 0 at the end of the file, or a negative error code (-EIO if the file is truncated).
+int captureReaderNext(CaptureReader* const self,
+                      CaptureRecord* const out_record,
+                      const size_t         payload_capacity,
+                      void* const          out_payload);
+
+/// Returns the wall-clock time of the capture start, in microseconds since the Unix epoch.
+uint64_t captureReaderGetStartTime(const CaptureReader* const self);
+
+/// No effect if the reader is not open.
+void captureReaderClose(CaptureReader* const self);
+
+#ifdef __cplusplus
+}
+#endif
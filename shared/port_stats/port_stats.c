@@ -0,0 +1,76 @@
+/// This software is distributed under the terms of the MIT License.
+/// Copyright (C) OpenCyphal Development Team  <opencyphal.org>
+/// Copyright Amazon.com Inc. or its affiliates.
+/// SPDX-License-Identifier: MIT
+
+#include "port_stats.h"
+
+#include <string.h>
+
+/// The estimator gain is 1/(2^GAIN_SHIFT), see RFC 3550.
+#define GAIN_SHIFT 4U
+
+void portStatsInit(PortStats* const self)
+{
+    (void) memset(self, 0, sizeof(*self));
+}
+
+void portStatsOnTransfer(PortStats* const self, const uint64_t timestamp_usec)
+{
+    self->transfers++;
+    // A zero timestamp is the "no transfers yet" sentinel (see portStatsInit()), so there is no interval to measure.
+    if ((self->last_transfer_at_usec > 0U) && (timestamp_usec >= self->last_transfer_at_usec))
+    {
+        const uint64_t interval = timestamp_usec - self->last_transfer_at_usec;
+        if (interval > self->max_interval_usec)
+        {
+            self->max_interval_usec = interval;
+        }
+        // A zero mean is the "no intervals yet" sentinel: the estimator is seeded with the very first interval,
+        // as there is nothing to compare it with. A genuine zero interval (two transfers within the same microsecond)
+        // merely re-seeds the estimator, which is harmless.
+        if (self->mean_interval_x16 == 0U)
+        {
+            self->mean_interval_x16 = interval << GAIN_SHIFT;
+        }
+        else
+        {
+            const uint64_t mean      = self->mean_interval_x16 >> GAIN_SHIFT;
+            const uint64_t deviation = (interval > mean) ? (interval - mean) : (mean - interval);
+            // x += (sample - x) / 16, in the scaled domain: x16 += sample - x16 / 16.
+            self->jitter_x16        = self->jitter_x16 + deviation - (self->jitter_x16 >> GAIN_SHIFT);
+            self->mean_interval_x16 = self->mean_interval_x16 + interval - mean;
+        }
+    }
+    self->last_transfer_at_usec = timestamp_usec;
+}
+
+void portStatsOnDrop(PortStats* const self)
+{
+    self->drops++;
+}
+
+void portStatsOnTimeout(PortStats* const self)
+{
+    self->timeouts++;
+}
+
+uint64_t portStatsGetMeanIntervalUsec(const PortStats* const self)
+{
+    return self->mean_interval_x16 >> GAIN_SHIFT;
+}
+
+uint64_t portStatsGetJitterUsec(const PortStats* const self)
+{
+    return self->jitter_x16 >> GAIN_SHIFT;
+}
+
+void portStatsExport(const PortStats* const self, uint64_t out[PORT_STATS_EXPORT_SIZE])
+{
+    out[0] = self->transfers;
+    out[1] = self->drops;
+    out[2] = self->timeouts;
+    out[3] = portStatsGetMeanIntervalUsec(self);
+    out[4] = portStatsGetJitterUsec(self);
+    out[5] = self->max_interval_usec;
+}
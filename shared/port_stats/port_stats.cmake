@@ -0,0 +1,13 @@
+# This software is distributed under the terms of the MIT License.
+# Copyright (C) OpenCyphal Development Team  <opencyphal.org>
+# Copyright Amazon.com Inc. or its affiliates.
+# SPDX-License-Identifier: MIT
+
+cmake_minimum_required(VERSION 3.20)
+
+# Define the per-port transfer statistics library shared by the demos.
+add_library(
+        shared_port_stats
+        ${CMAKE_CURRENT_LIST_DIR}/port_stats.c
+)
+target_include_directories(shared_port_stats PUBLIC ${CMAKE_CURRENT_LIST_DIR})
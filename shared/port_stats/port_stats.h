@@ -0,0 +1,68 @@
+///                            ____                   ______            __          __
+///                           / __ `____  ___  ____  / ____/_  ______  / /_  ____  / /
+///                          / / / / __ `/ _ `/ __ `/ /   / / / / __ `/ __ `/ __ `/ /
+///                         / /_/ / /_/ /  __/ / / / /___/ /_/ / /_/ / / / / /_/ / /
+///                         `____/ .___/`___/_/ /_/`____/`__, / .___/_/ /_/`__,_/_/
+///                             /_/                     /____/_/
+///
+/// This module implements per-port (subject or service) transfer statistics: counters of the transfers, drops and
+/// timeouts, plus a streaming estimator of the transfer inter-arrival interval and its jitter.
+///
+/// The statistics are meant to be embedded into the port objects of the application (publishers, subscribers,
+/// RPC clients and servers), so the storage is preallocated and an update is O(1) without any lookups.
+///
+/// The jitter estimator is the one of RFC 3550 (section 6.4.1): the mean absolute deviation of the inter-arrival
+/// interval from its running mean, smoothed with the gain of 1/16. The running mean of the interval uses the same
+/// gain. Both are kept in the fixed point (scaled by 16) to avoid floating point on the hot path.
+///
+/// This software is distributed under the terms of the MIT License.
+/// Copyright (C) OpenCyphal Development Team  <opencyphal.org>
+/// Copyright Amazon.com Inc. or its affiliates.
+/// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/// The number of values produced by portStatsExport(); see it for the order.
+#define PORT_STATS_EXPORT_SIZE 6U
+
+/// The fields are not to be modified by the application directly.
+typedef struct
+{
+    uint64_t transfers;  ///< Transfers sent (or received) successfully.
+    uint64_t drops;      ///< Transfers that could not be sent (or were lost on reception), f.e. due to out of memory.
+    uint64_t timeouts;   ///< Frames expired in the TX queue (or requests which timed out waiting for a response).
+
+    uint64_t last_transfer_at_usec;  ///< Zero if there were no transfers yet.
+    uint64_t max_interval_usec;
+    uint64_t mean_interval_x16;  ///< Scaled by 16.
+    uint64_t jitter_x16;         ///< Scaled by 16.
+} PortStats;
+
+void portStatsInit(PortStats* const self);
+
+/// Counts a successful transfer at the given monotonic time, and updates the interval and jitter estimates.
+void portStatsOnTransfer(PortStats* const self, const uint64_t timestamp_usec);
+
+void portStatsOnDrop(PortStats* const self);
+void portStatsOnTimeout(PortStats* const self);
+
+/// The running mean of the interval between transfers, in microseconds; zero until there are two transfers.
+uint64_t portStatsGetMeanIntervalUsec(const PortStats* const self);
+
+/// The inter-arrival jitter estimate, in microseconds; zero until there are three transfers.
+uint64_t portStatsGetJitterUsec(const PortStats* const self);
+
+/// Exports the statistics as an array, in the following order:
+/// transfers, drops, timeouts, mean interval (us), jitter (us), max interval (us).
+/// This is convenient for exposing the statistics via registers as natural64 arrays.
+void portStatsExport(const PortStats* const self, uint64_t out[PORT_STATS_EXPORT_SIZE]);
+
+#ifdef __cplusplus
+}
+#endif
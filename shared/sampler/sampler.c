@@ -0,0 +1,288 @@
+/// This software is distributed under the terms of the MIT License.
+/// Copyright (C) OpenCyphal Development Team  <opencyphal.org>
+/// Copyright Amazon.com Inc. or its affiliates.
+/// SPDX-License-Identifier: MIT
+
+// This is needed to enable the necessary declarations in sys/ (REG_RIP, pthread_getattr_np, dladdr).
+#ifndef _GNU_SOURCE
+#    define _GNU_SOURCE
+#endif
+
+#include "sampler.h"
+
+#include <dlfcn.h>
+#include <errno.h>
+#include <pthread.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/time.h>
+#include <ucontext.h>
+
+#define MEGA 1000000UL
+
+#if defined(__x86_64__) || defined(__aarch64__)
+#    define SAMPLER_SUPPORTED true
+#else
+#    define SAMPLER_SUPPORTED false
+#endif
+
+/// The profiler the signal handler records into; there is at most one running at a time.
+static Sampler* volatile g_active = NULL;
+
+/// Extracts the program counter, frame pointer and stack pointer of the interrupted context.
+static bool getContextRegisters(const void* const context,
+                                uintptr_t* const  pc,
+                                uintptr_t* const  fp,
+                                uintptr_t* const  sp)
+{
+    const ucontext_t* const uc = (const ucontext_t*) context;
+#if defined(__x86_64__)
+    *pc = (uintptr_t) uc->uc_mcontext.gregs[REG_RIP];
+    *fp = (uintptr_t) uc->uc_mcontext.gregs[REG_RBP];
+    *sp = (uintptr_t) uc->uc_mcontext.gregs[REG_RSP];
+    return true;
+#elif defined(__aarch64__)
+    *pc = (uintptr_t) uc->uc_mcontext.pc;
+    *fp = (uintptr_t) uc->uc_mcontext.regs[29];  // NOLINT(*-magic-numbers) x29 is the frame pointer.
+    *sp = (uintptr_t) uc->uc_mcontext.sp;
+    return true;
+#else
+    (void) uc;
+    (void) pc;
+    (void) fp;
+    (void) sp;
+    return false;
+#endif
+}
+
+/// Async-signal-safe: only reads the stack of the interrupted thread, and writes the preallocated buffer.
+static void onProfilingSignal(const int sig, siginfo_t* const info, void* const context)
+{
+    (void) sig;
+    (void) info;
+    Sampler* const self = g_active;
+    if ((self == NULL) || !self->running)
+    {
+        return;
+    }
+    if (self->count >= self->capacity)
+    {
+        self->dropped++;
+        return;
+    }
+
+    uintptr_t pc = 0;
+    uintptr_t fp = 0;
+    uintptr_t sp = 0;
+    if (!getContextRegisters(context, &pc, &fp, &sp))
+    {
+        return;
+    }
+
+    SamplerStack* const stack = &self->stacks[self->count];
+    stack->pcs[0]             = pc;
+    stack->depth              = 1;
+
+    // Each frame starts with the saved frame pointer of the caller followed by the return address.
+    // The chain is followed only while it stays within the stack of the profiled thread and grows towards its base,
+    // so a broken chain (a frame built without the frame pointer) just truncates the sample.
+    const bool is_profiled_thread = (sp >= self->stack_lo) && (sp < self->stack_hi);
+    while (is_profiled_thread && (stack->depth < SAMPLER_MAX_DEPTH) && (fp >= sp) &&
+           (fp <= (self->stack_hi - (2U * sizeof(uintptr_t)))) && ((fp % sizeof(uintptr_t)) == 0U))
+    {
+        const uintptr_t* const frame = (const uintptr_t*) fp;
+        const uintptr_t        ret   = frame[1];
+        if (ret == 0U)
+        {
+            break;
+        }
+        stack->pcs[stack->depth++] = ret;
+        if (frame[0] <= fp)
+        {
+            break;
+        }
+        fp = frame[0];
+    }
+    self->count++;
+}
+
+static int compareStacks(const void* const a, const void* const b)
+{
+    const SamplerStack* const lhs = (const SamplerStack*) a;
+    const SamplerStack* const rhs = (const SamplerStack*) b;
+    if (lhs->depth != rhs->depth)
+    {
+        return (lhs->depth < rhs->depth) ? -1 : 1;
+    }
+    for (uint32_t i = 0; i < lhs->depth; i++)
+    {
+        if (lhs->pcs[i] != rhs->pcs[i])
+        {
+            return (lhs->pcs[i] < rhs->pcs[i]) ? -1 : 1;
+        }
+    }
+    return 0;
+}
+
+/// Replaces the addresses of the frames with the start addresses of their functions (where known),
+/// so that all samples of the same call path are aggregated regardless of the exact instruction.
+static void canonicalizeStack(SamplerStack* const stack)
+{
+    for (uint32_t i = 0; i < stack->depth; i++)
+    {
+        // A return address points past the call instruction, which might already belong to the next function.
+        const uintptr_t lookup = (i > 0U) ? (stack->pcs[i] - 1U) : stack->pcs[i];
+
+        Dl_info info;
+        (void) memset(&info, 0, sizeof(info));
+        const bool is_known = (dladdr((const void*) lookup, &info) != 0) && (info.dli_saddr != NULL);
+        stack->pcs[i]       = is_known ? (uintptr_t) info.dli_saddr : lookup;
+    }
+}
+
+static void writeFrame(FILE* const out, const uintptr_t lookup)
+{
+    Dl_info info;
+    (void) memset(&info, 0, sizeof(info));
+    if ((dladdr((const void*) lookup, &info) != 0) && (info.dli_sname != NULL))
+    {
+        (void) fputs(info.dli_sname, out);
+    }
+    else if (info.dli_fname != NULL)
+    {
+        const char* const slash = strrchr(info.dli_fname, '/');
+        (void) fprintf(out,
+                       "%s+0x%lx",
+                       (slash != NULL) ? (slash + 1) : info.dli_fname,
+                       (unsigned long) (lookup - (uintptr_t) info.dli_fbase));
+    }
+    else
+    {
+        (void) fprintf(out, "0x%lx", (unsigned long) lookup);
+    }
+}
+
+void samplerInit(Sampler* const self, SamplerStack* const storage, const size_t capacity)
+{
+    (void) memset(self, 0, sizeof(*self));
+    self->stacks   = storage;
+    self->capacity = capacity;
+}
+
+int16_t samplerStart(Sampler* const self, const uint32_t rate_hz)
+{
+    if ((self == NULL) || (self->stacks == NULL) || (rate_hz == 0U) || (rate_hz > MEGA))
+    {
+        return -EINVAL;
+    }
+    if (self->running || (g_active != NULL))
+    {
+        return -EBUSY;
+    }
+    if (!SAMPLER_SUPPORTED)
+    {
+        return -ENOTSUP;
+    }
+
+    // Unwinding is limited to the stack of the calling thread, so that a broken frame chain can't fault.
+    pthread_attr_t attr;
+    void*          stack_addr = NULL;
+    size_t         stack_size = 0;
+    if (pthread_getattr_np(pthread_self(), &attr) != 0)
+    {
+        return -EIO;
+    }
+    const int attr_err = pthread_attr_getstack(&attr, &stack_addr, &stack_size);
+    (void) pthread_attr_destroy(&attr);
+    if (attr_err != 0)
+    {
+        return (int16_t) -attr_err;
+    }
+    self->stack_lo = (uintptr_t) stack_addr;
+    self->stack_hi = self->stack_lo + stack_size;
+    self->count    = 0;
+    self->dropped  = 0;
+    self->running  = true;
+    g_active       = self;
+
+    struct sigaction action;
+    (void) memset(&action, 0, sizeof(action));
+    action.sa_sigaction = &onProfilingSignal;
+    action.sa_flags     = SA_SIGINFO | SA_RESTART;
+    (void) sigemptyset(&action.sa_mask);
+    if (sigaction(SIGPROF, &action, &self->previous_action) != 0)
+    {
+        const int err = errno;
+        self->running = false;
+        g_active      = NULL;
+        return (int16_t) -err;
+    }
+
+    const long             period_usec = (long) (MEGA / rate_hz);
+    const struct itimerval timer       = {.it_interval = {.tv_sec = 0, .tv_usec = period_usec},
+                                          .it_value    = {.tv_sec = 0, .tv_usec = period_usec}};
+    if (setitimer(ITIMER_PROF, &timer, NULL) != 0)
+    {
+        const int err = errno;
+        (void) sigaction(SIGPROF, &self->previous_action, NULL);
+        self->running = false;
+        g_active      = NULL;
+        return (int16_t) -err;
+    }
+    return 0;
+}
+
+void samplerStop(Sampler* const self)
+{
+    if ((self == NULL) || !self->running)
+    {
+        return;
+    }
+    const struct itimerval timer = {{0, 0}, {0, 0}};
+    (void) setitimer(ITIMER_PROF, &timer, NULL);
+
+    // A signal which is already pending is ignored by the handler once the profiler is not running.
+    self->running = false;
+    (void) sigaction(SIGPROF, &self->previous_action, NULL);
+    g_active = NULL;
+}
+
+int16_t samplerWriteFolded(Sampler* const self, FILE* const out)
+{
+    if ((self == NULL) || (out == NULL) || self->running)
+    {
+        return -EINVAL;
+    }
+
+    // Sorting brings identical stacks together, so they could be counted without any extra memory.
+    const size_t count = self->count;
+    for (size_t index = 0; index < count; index++)
+    {
+        canonicalizeStack(&self->stacks[index]);
+    }
+    qsort(self->stacks, count, sizeof(SamplerStack), &compareStacks);
+    size_t index = 0;
+    while (index < count)
+    {
+        const SamplerStack* const stack = &self->stacks[index];
+        size_t                    same  = 1;
+        while (((index + same) < count) && (compareStacks(stack, &self->stacks[index + same]) == 0))
+        {
+            same++;
+        }
+
+        // Folded stacks are written from the root to the leaf.
+        for (uint32_t i = stack->depth; i > 0U; i--)
+        {
+            writeFrame(out, stack->pcs[i - 1U]);
+            (void) fputc((i > 1U) ? ';' : ' ', out);
+        }
+        (void) fprintf(out, "%lu\n", (unsigned long) same);
+        index += same;
+    }
+    if (self->dropped > 0U)
+    {
+        (void) fprintf(out, "[dropped] %lu\n", (unsigned long) self->dropped);
+    }
+    return (ferror(out) != 0) ? (int16_t) -EIO : 0;
+}
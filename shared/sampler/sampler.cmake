@@ -0,0 +1,17 @@
+# This software is distributed under the terms of the MIT License.
+# Copyright (C) OpenCyphal Development Team  <opencyphal.org>
+# Copyright Amazon.com Inc. or its affiliates.
+# SPDX-License-Identifier: MIT
+
+cmake_minimum_required(VERSION 3.20)
+
+# Define the sampling CPU profiler library shared by the demos.
+# The profiled targets should be built with `-fno-omit-frame-pointer` and linked with `ENABLE_EXPORTS` (-rdynamic).
+find_package(Threads REQUIRED)
+add_library(
+        shared_sampler
+        ${CMAKE_CURRENT_LIST_DIR}/sampler.c
+)
+target_include_directories(shared_sampler PUBLIC ${CMAKE_CURRENT_LIST_DIR})
+target_compile_options(shared_sampler PRIVATE -fno-omit-frame-pointer)
+target_link_libraries(shared_sampler PRIVATE Threads::Threads ${CMAKE_DL_LIBS})
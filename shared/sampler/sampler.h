@@ -0,0 +1,82 @@
+///                            ____                   ______            __          __
+///                           / __ `____  ___  ____  / ____/_  ______  / /_  ____  / /
+///                          / / / / __ `/ _ `/ __ `/ /   / / / / __ `/ __ `/ __ `/ /
+///                         / /_/ / /_/ /  __/ / / / /___/ /_/ / /_/ / / / / /_/ / /
+///                         `____/ .___/`___/_/ /_/`____/`__, / .___/_/ /_/`__,_/_/
+///                             /_/                     /____/_/
+///
+/// This module implements a sampling CPU profiler for the environments where `perf` is not available.
+///
+/// An `ITIMER_PROF` interval timer delivers `SIGPROF` at the given rate of the consumed CPU time; the signal handler
+/// captures the interrupted program counter plus the return addresses found by walking the frame pointer chain,
+/// and stores them into a preallocated buffer (if the buffer is full, the sample is dropped and counted).
+/// When the profiler is stopped, the samples are aggregated and written as folded stacks
+/// (one `root;...;leaf count` line per unique stack), ready for `flamegraph.pl` or https://www.speedscope.app.
+///
+/// The unwinding is only as good as the frame pointers are, so the profiled code should be built with
+/// `-fno-omit-frame-pointer`. Frames are symbolized with `dladdr()`, so the executable should also be linked
+/// with `-rdynamic` (otherwise, its frames are written as `module+0xoffset`, to be resolved with `addr2line`).
+/// C++ symbols are written mangled; pipe the output through `c++filt` to demangle them.
+///
+/// Only one profiler could be running at a time. Only the thread which started the profiler is fully unwound;
+/// for other threads (if any) just the program counter is captured. Supported on x86-64 and AArch64 GNU/Linux.
+///
+/// This software is distributed under the terms of the MIT License.
+/// Copyright (C) OpenCyphal Development Team  <opencyphal.org>
+/// Copyright Amazon.com Inc. or its affiliates.
+/// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include <signal.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/// The maximum number of frames captured per sample (deeper stacks are truncated at the root side).
+#define SAMPLER_MAX_DEPTH 24U
+
+/// A single stack sample; `pcs[0]` is the leaf (the interrupted program counter).
+typedef struct
+{
+    uintptr_t pcs[SAMPLER_MAX_DEPTH];
+    uint32_t  depth;
+} SamplerStack;
+
+/// The fields are not to be modified by the application directly.
+typedef struct
+{
+    SamplerStack* stacks;
+    size_t        capacity;
+
+    volatile size_t   count;    ///< Samples captured so far.
+    volatile uint64_t dropped;  ///< Samples dropped because the buffer was full.
+
+    uintptr_t        stack_lo;  ///< Bounds of the stack of the profiled thread.
+    uintptr_t        stack_hi;
+    bool             running;
+    struct sigaction previous_action;
+} Sampler;
+
+/// The storage is owned by the application; it must outlive the profiler.
+void samplerInit(Sampler* const self, SamplerStack* const storage, const size_t capacity);
+
+/// Discards all captured samples, and starts sampling the calling thread at the given rate of CPU time.
+/// Returns zero on success, or a negated errno (f.e. -ENOTSUP if the platform is not supported).
+int16_t samplerStart(Sampler* const self, const uint32_t rate_hz);
+
+/// Stops sampling. Does nothing if the profiler is not running.
+void samplerStop(Sampler* const self);
+
+/// Writes the captured samples as folded stacks. The profiler must be stopped; the samples are reordered.
+/// Returns zero on success, or a negated errno.
+int16_t samplerWriteFolded(Sampler* const self, FILE* const out);
+
+#ifdef __cplusplus
+}
+#endif
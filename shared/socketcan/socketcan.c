@@ -10,6 +10,8 @@
 #endif
 
 #include "socketcan.h"
+#include "capture.h"
+#include "usdt.h"
 
 #ifdef __linux__
 #    include <linux/can.h>
@@ -134,6 +136,15 @@ SocketCANFD socketcanOpen(const char* const iface_name, const bool can_fd)
     return getNegatedErrno();
 }
 
+void socketcanClose(const SocketCANFD fd)
+{
+    if (fd >= 0)
+    {
+        captureForgetDescriptor(fd);
+        (void) close(fd);
+    }
+}
+
 int16_t socketcanPush(const SocketCANFD fd, const struct CanardFrame* const frame, const CanardMicrosecond timeout_usec)
 {
     if ((frame == NULL) || (frame->payload.data == NULL) || (frame->payload.size > UINT8_MAX))
@@ -163,6 +174,7 @@ int16_t socketcanPush(const SocketCANFD fd, const struct CanardFrame* const fram
             return getNegatedErrno();
         }
     }
+    USDT_PROBE4(socketcan_push, fd, frame->extended_can_id, frame->payload.size, poll_result);
     return poll_result;
 }
 
@@ -270,6 +282,11 @@ int16_t socketcanPop(const SocketCANFD         fd,
         out_frame->payload.size    = sockcan_frame.len;
         out_frame->payload.data    = payload_buffer;
         (void) memcpy(payload_buffer, &sockcan_frame.data[0], sockcan_frame.len);
+        if (!loopback_frame)  // Our own frames would be replayed by the node under test itself.
+        {
+            captureOnCanRx(fd, out_frame->extended_can_id, out_frame->payload.size, payload_buffer);
+        }
+        USDT_PROBE3(socketcan_pop, fd, out_frame->extended_can_id, out_frame->payload.size);
     }
     return poll_result;
 }
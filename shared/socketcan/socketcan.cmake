@@ -6,10 +6,13 @@
 
 cmake_minimum_required(VERSION 3.20)
 
+include(${CMAKE_CURRENT_LIST_DIR}/../usdt/usdt.cmake)
+include(${CMAKE_CURRENT_LIST_DIR}/../capture/capture.cmake)
+
 # Define the demo application build target and link it with the library.
 add_library(
         shared_socketcan
         ${CMAKE_CURRENT_LIST_DIR}/socketcan.c
 )
-target_link_libraries(shared_socketcan PUBLIC canard)
+target_link_libraries(shared_socketcan PUBLIC canard shared_usdt shared_capture)
 target_include_directories(shared_socketcan PUBLIC ${CMAKE_CURRENT_LIST_DIR})
@@ -44,10 +44,14 @@ typedef int SocketCANFD;
 
 /// Initialize a new non-blocking (sic!) SocketCAN socket and return its handle on success.
 /// On failure, a negated errno is returned.
-/// To discard the socket just call close() on it; no additional de-initialization activities are required.
+/// To discard the socket use socketcanClose().
 /// The argument can_fd enables support for CAN FD frames.
 SocketCANFD socketcanOpen(const char* const iface_name, const bool can_fd);
 
+/// Closes the socket; the capture (see capture.h) forgets the descriptor, as it may be reused for another socket.
+/// No effect if the descriptor is negative.
+void socketcanClose(const SocketCANFD fd);
+
 /// Enqueue a new extended CAN data frame for transmission.
 /// Block until the frame is enqueued or until the timeout is expired.
 /// Zero timeout makes the operation non-blocking.
@@ -5,6 +5,8 @@
 /// Author: Pavel Kirienko <pavel@opencyphal.org>
 
 #include "udp.h"
+#include "capture.h"
+#include "usdt.h"
 
 /// Enable SO_REUSEPORT.
 #ifndef _DEFAULT_SOURCE
@@ -54,6 +56,7 @@ int16_t udpTxInit(UDPTxHandle* const self, const uint32_t local_iface_address)
         if (ok)
         {
             res = 0;
+            captureOnUdpTxOpen(self->fd);
         }
         else
         {
@@ -99,6 +102,7 @@ int16_t udpTxSend(UDPTxHandle* const self,
         {
             res = (int16_t) -errno;
         }
+        USDT_PROBE4(udp_tx_send, self->fd, remote_port, payload_size, res);
     }
     return res;
 }
@@ -107,6 +111,7 @@ void udpTxClose(UDPTxHandle* const self)
 {
     if ((self != NULL) && (self->fd >= 0))
     {
+        captureForgetDescriptor(self->fd);
         (void) close(self->fd);
         self->fd = -1;
     }
@@ -168,11 +173,23 @@ int16_t udpRxReceive(UDPRxHandle* const self, size_t* const inout_payload_size,
     int16_t res = -EINVAL;
     if ((self != NULL) && (self->fd >= 0) && (inout_payload_size != NULL) && (out_payload != NULL))
     {
-        const ssize_t recv_result = recv(self->fd, out_payload, *inout_payload_size, MSG_DONTWAIT);
+        struct sockaddr_in source      = {0};
+        socklen_t          source_len  = sizeof(source);
+        const ssize_t      recv_result = recvfrom(self->fd,
+                                                  out_payload,
+                                                  *inout_payload_size,
+                                                  MSG_DONTWAIT,
+                                                  (struct sockaddr*) &source,
+                                                  &source_len);
         if (recv_result >= 0)
         {
             *inout_payload_size = (size_t) recv_result;
             res                 = 1;
+            captureOnUdpRx(self->fd,
+                           ntohl(source.sin_addr.s_addr),
+                           ntohs(source.sin_port),
+                           *inout_payload_size,
+                           out_payload);
         }
         else if ((errno == EAGAIN) || (errno == EWOULDBLOCK))
         {
@@ -182,6 +199,7 @@ int16_t udpRxReceive(UDPRxHandle* const self, size_t* const inout_payload_size,
         {
             res = (int16_t) -errno;
         }
+        USDT_PROBE3(udp_rx_receive, self->fd, (res > 0) ? *inout_payload_size : 0U, res);
     }
     return res;
 }
@@ -190,6 +208,7 @@ void udpRxClose(UDPRxHandle* const self)
 {
     if ((self != NULL) && (self->fd >= 0))
     {
+        captureForgetDescriptor(self->fd);
         (void) close(self->fd);
         self->fd = -1;
     }
@@ -6,9 +6,13 @@
 
 cmake_minimum_required(VERSION 3.20)
 
+include(${CMAKE_CURRENT_LIST_DIR}/../usdt/usdt.cmake)
+include(${CMAKE_CURRENT_LIST_DIR}/../capture/capture.cmake)
+
 # Define the demo application build target and link it with the library.
 add_library(
         shared_udp
         ${CMAKE_CURRENT_LIST_DIR}/udp.c
 )
 target_include_directories(shared_udp PUBLIC ${CMAKE_CURRENT_LIST_DIR})
+target_link_libraries(shared_udp PUBLIC shared_usdt shared_capture)
@@ -0,0 +1,20 @@
+# This software is distributed under the terms of the MIT License.
+# Copyright (C) OpenCyphal Development Team  <opencyphal.org>
+# Copyright Amazon.com Inc. or its affiliates.
+# SPDX-License-Identifier: MIT
+
+cmake_minimum_required(VERSION 3.20)
+
+# Define the header-only USDT probes library; probes are emitted only if <sys/sdt.h> is available.
+if (NOT TARGET shared_usdt)
+    include(CheckIncludeFile)
+    check_include_file("sys/sdt.h" HAVE_SYS_SDT_H)
+
+    add_library(shared_usdt INTERFACE)
+    target_include_directories(shared_usdt INTERFACE ${CMAKE_CURRENT_LIST_DIR})
+    if (HAVE_SYS_SDT_H)
+        target_compile_definitions(shared_usdt INTERFACE USDT_ENABLED=1)
+    else ()
+        message(STATUS "sys/sdt.h not found (install systemtap-sdt-dev) -- USDT probes are disabled.")
+    endif ()
+endif ()
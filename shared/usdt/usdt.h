@@ -0,0 +1,45 @@
+///                            ____                   ______            __          __
+///                           / __ `____  ___  ____  / ____/_  ______  / /_  ____  / /
+///                          / / / / __ `/ _ `/ __ `/ /   / / / / __ `/ __ `/ __ `/ /
+///                         / /_/ / /_/ /  __/ / / / /___/ /_/ / /_/ / / / / /_/ / /
+///                         `____/ .___/`___/_/ /_/`____/`__, / .___/_/ /_/`__,_/_/
+///                             /_/                     /____/_/
+///
+/// This module defines statically-defined tracing (USDT) probe points, compatible with SystemTap and bpftrace.
+///
+/// A probe compiles into a single NOP instruction plus an ELF note describing where its arguments are,
+/// so it costs virtually nothing unless a tracer is attached to it. All probes belong to the `opencyphal` provider;
+/// list them with `bpftrace -l 'usdt:/path/to/binary:opencyphal:*'`, and trace them f.e. with:
+///
+///     bpftrace -e 'usdt:./demo:opencyphal:socketcan_push { printf("%x %d\n", arg1, arg2); }'
+///
+/// Probe arguments must be integers or pointers. The probes are emitted only if `<sys/sdt.h>` is available
+/// at build time (`systemtap-sdt-dev` on Debian/Ubuntu, `systemtap-sdt-devel` on Fedora) -- see `usdt.cmake`;
+/// otherwise, all of them expand to nothing.
+///
+/// This software is distributed under the terms of the MIT License.
+/// Copyright (C) OpenCyphal Development Team  <opencyphal.org>
+/// Copyright Amazon.com Inc. or its affiliates.
+/// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#if defined(USDT_ENABLED) && USDT_ENABLED
+
+#    include <sys/sdt.h>
+
+#    define USDT_PROBE0(name) DTRACE_PROBE(opencyphal, name)
+#    define USDT_PROBE1(name, a) DTRACE_PROBE1(opencyphal, name, a)
+#    define USDT_PROBE2(name, a, b) DTRACE_PROBE2(opencyphal, name, a, b)
+#    define USDT_PROBE3(name, a, b, c) DTRACE_PROBE3(opencyphal, name, a, b, c)
+#    define USDT_PROBE4(name, a, b, c, d) DTRACE_PROBE4(opencyphal, name, a, b, c, d)
+
+#else
+
+#    define USDT_PROBE0(name) ((void) 0)
+#    define USDT_PROBE1(name, a) ((void) 0)
+#    define USDT_PROBE2(name, a, b) ((void) 0)
+#    define USDT_PROBE3(name, a, b, c) ((void) 0)
+#    define USDT_PROBE4(name, a, b, c, d) ((void) 0)
+
+#endif
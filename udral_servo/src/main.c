@@ -13,6 +13,8 @@
 /// Copyright (C) 2021 OpenCyphal <maintainers@opencyphal.org>
 /// Author: Pavel Kirienko <pavel@opencyphal.org>
 
+#include "binlog.h"
+#include "sampler.h"
 #include "socketcan.h"
 #include "register.h"
 #include <o1heap.h>
@@ -35,6 +37,9 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <assert.h>
+#include <errno.h>
+#include <inttypes.h>
+#include <signal.h>
 #include <time.h>
 #include <unistd.h>
 
@@ -44,6 +49,18 @@
 #define CAN_REDUNDANCY_FACTOR 1
 /// For CAN FD the queue can be smaller.
 #define CAN_TX_QUEUE_CAPACITY 100
+/// The capacity of the asynchronous log ring (records); must be a power of two.
+#define LOG_CAPACITY 64
+/// How often the log drainer thread polls the ring when it is empty.
+#define LOG_DRAIN_PERIOD_USEC 10000U
+
+/// The sampling CPU profiler is toggled by SIGUSR2, or by the vendor-specific commands below (the same as in the
+/// LibCyphal demo); when stopped, it writes the folded stacks into SAMPLER_OUTPUT_FILE (see flamegraph.pl).
+#define SAMPLER_CAPACITY 8192U
+#define SAMPLER_RATE_HZ 1000U
+#define SAMPLER_OUTPUT_FILE "profile.folded"
+#define COMMAND_PROFILER_START 1001U
+#define COMMAND_PROFILER_STOP 1002U
 
 /// We keep the state of the application here. Feel free to use static variables instead if desired.
 typedef struct State
@@ -111,6 +128,19 @@ typedef struct State
 /// This flag is raised when the node is requested to restart.
 static volatile bool g_restart_required = false;
 
+/// The fast loop status line is not printed directly because a slow terminal would disturb the loop timing.
+/// Instead, it is captured into this asynchronous log, which is drained by a background thread.
+static BinlogRecord  g_log_records[LOG_CAPACITY];
+static Binlog        g_log;
+static BinlogDrainer g_log_drainer;
+
+/// The profiler is owned by the main loop; the signal handler and the command handler only raise the requests.
+static SamplerStack          g_sampler_stacks[SAMPLER_CAPACITY];
+static Sampler               g_sampler;
+static volatile sig_atomic_t g_sampler_toggle_requested = 0;
+static volatile bool         g_profiler_start_required  = false;
+static volatile bool         g_profiler_stop_required   = false;
+
 /// A deeply embedded system should sample a microsecond-resolution non-overflowing 64-bit timer.
 /// Here is a simple non-blocking implementation as an example:
 /// https://github.com/PX4/sapog/blob/601f4580b71c3c4da65cc52237e62a/firmware/src/motor/realtime/motor_timer.c#L233-L274
@@ -223,16 +253,16 @@ static void handleFastLoop(State* const state, const CanardMicrosecond now_usec)
     // Apply control inputs if armed.
     if (state->servo.arming.armed)
     {
-        fprintf(stderr,
-                "\rp=%.3f m    v=%.3f m/s    a=%.3f (m/s)^2    F=%.3f N    \r",
-                (double) state->servo.position,
-                (double) state->servo.velocity,
-                (double) state->servo.acceleration,
-                (double) state->servo.force);
+        (void) BINLOG(&g_log,
+                      "\rp=%.3f m    v=%.3f m/s    a=%.3f (m/s)^2    F=%.3f N    \r",
+                      state->servo.position,
+                      state->servo.velocity,
+                      state->servo.acceleration,
+                      state->servo.force);
     }
     else
     {
-        fprintf(stderr, "\rDISARMED    \r");
+        (void) BINLOG(&g_log, "\rDISARMED    \r");
     }
 
     const bool     anonymous         = state->canard.node_id > CANARD_NODE_ID_MAX;
@@ -548,7 +578,7 @@ static void processMessagePlugAndPlayNodeIDAllocation(State* const
     getUniqueID(uid);
     if ((msg->node_id.value <= CANARD_NODE_ID_MAX) && (memcmp(uid, msg->unique_id, sizeof(uid)) == 0))
     {
-        printf("Got PnP node-ID allocation: %d\n", msg->node_id.value);
+        (void) BINLOG(&g_log, "Got PnP node-ID allocation: %u\n", msg->node_id.value);
         state->canard.node_id = (CanardNodeID) msg->node_id.value;
         // Store the value into the non-volatile storage.
         uavcan_register_Value_1_0 reg = {0};
@@ -576,7 +606,8 @@ static uavcan_node_ExecuteCommand_Response_1_1 processRequestExecuteCommand(
         memcpy(file_name, req->parameter.elements, req->parameter.count);
         file_name[req->parameter.count] = '\0';
         // TODO: invoke the bootloader with the specified file name. See https://github.com/Zubax/kocherga/
-        printf("Firmware update request; filename: '%s' \n", &file_name[0]);
+        // The file name is not logged, b/c the deferred formatting needs strings of static storage duration.
+        (void) BINLOG(&g_log, "Firmware update request; file name of %zu chars\n", strlen(&file_name[0]));
         resp.status = uavcan_node_ExecuteCommand_Response_1_1_STATUS_BAD_STATE;  // This is a stub.
         break;
     }
@@ -599,6 +630,18 @@ static uavcan_node_ExecuteCommand_Response_1_1 processRequestExecuteCommand(
         // In this demo, the registers are stored in files, so there is nothing to do.
         resp.status = uavcan_node_ExecuteCommand_Response_1_1_STATUS_SUCCESS;
         break;
+    }
+    case COMMAND_PROFILER_START:
+    {
+        g_profiler_start_required = true;  // Served by the main loop, see pollProfilerRequests().
+        resp.status               = uavcan_node_ExecuteCommand_Response_1_1_STATUS_SUCCESS;
+        break;
+    }
+    case COMMAND_PROFILER_STOP:
+    {
+        g_profiler_stop_required = true;
+        resp.status              = uavcan_node_ExecuteCommand_Response_1_1_STATUS_SUCCESS;
+        break;
     }
         // You can add vendor-specific commands here as well.
     default:
@@ -811,6 +854,65 @@ static void canardDeallocate(void* const user_reference, const size_t amount, vo
     o1heapFree(heap, pointer);
 }
 
+static void onProfilerToggleSignal(const int signum)
+{
+    (void) signum;
+    g_sampler_toggle_requested = 1;
+}
+
+/// Starts or stops the profiler unless it is already in the requested state; on stop, the profile is written out.
+/// The output is blocking, so this is only invoked from the main loop between the scheduled activities.
+static void setProfilerRunning(const bool start)
+{
+    if (start == g_sampler.running)
+    {
+        return;
+    }
+    if (start)
+    {
+        const int16_t result = samplerStart(&g_sampler, SAMPLER_RATE_HZ);
+        (void) fprintf(stderr,
+                       "Profiler start @%uHz: %s (%i)\n",
+                       SAMPLER_RATE_HZ,
+                       (result == 0) ? "ok" : "failed",
+                       result);
+        return;
+    }
+    samplerStop(&g_sampler);
+    int16_t     result = (int16_t) -EIO;
+    FILE* const out    = fopen(SAMPLER_OUTPUT_FILE, "w");
+    if (out != NULL)
+    {
+        result = samplerWriteFolded(&g_sampler, out);
+        (void) fclose(out);
+    }
+    (void) fprintf(stderr,
+                   "Profiler stop: %zu samples (%" PRIu64 " dropped) -> '%s'%s\n",
+                   (size_t) g_sampler.count,
+                   (uint64_t) g_sampler.dropped,
+                   SAMPLER_OUTPUT_FILE,
+                   (result == 0) ? "" : " (failed)");
+}
+
+static void pollProfilerRequests(void)
+{
+    if (g_sampler_toggle_requested != 0)
+    {
+        g_sampler_toggle_requested = 0;
+        setProfilerRunning(!g_sampler.running);
+    }
+    if (g_profiler_start_required)
+    {
+        g_profiler_start_required = false;
+        setProfilerRunning(true);
+    }
+    if (g_profiler_stop_required)
+    {
+        g_profiler_stop_required = false;
+        setProfilerRunning(false);
+    }
+}
+
 extern char** environ;
 
 int main(const int argc, char* const argv[])
@@ -821,6 +923,15 @@ int main(const int argc, char* const argv[])
 
     State state = {0};
 
+    (void) binlogInit(&g_log, &g_log_records[0], LOG_CAPACITY, stderr);
+    // The status line is overwritten in place, so timestamps would only clutter it.
+    binlogSetTimestamps(&g_log, false);
+    if (binlogDrainerStart(&g_log_drainer, &g_log, LOG_DRAIN_PERIOD_USEC) != 0)
+    {
+        (void) fprintf(stderr, "Failed to start the log drainer thread\n");
+        return 1;
+    }
+
     // A simple application like a servo node typically does not require more than 20 KiB of heap and 4 KiB of stack.
     // For the background and related theory refer to the following resources:
     // - https://github.com/OpenCyphal/libcanard/blob/master/README.md
@@ -1028,6 +1139,15 @@ int main(const int argc, char* const argv[])
         }
     }
 
+    samplerInit(&g_sampler, &g_sampler_stacks[0], SAMPLER_CAPACITY);
+    {
+        struct sigaction action = {0};
+        action.sa_handler       = &onProfilerToggleSignal;
+        action.sa_flags         = SA_RESTART;
+        (void) sigemptyset(&action.sa_mask);
+        (void) sigaction(SIGUSR2, &action, NULL);
+    }
+
     // Now the node is initialized and we're ready to roll.
     state.started_at                           = getMonotonicMicroseconds();
     const CanardMicrosecond fast_loop_period   = MEGA / 50;
@@ -1053,6 +1173,7 @@ int main(const int argc, char* const argv[])
             next_01_hz_iter_at += MEGA * 10;
             handle01HzLoop(&state, now_usec);
         }
+        pollProfilerRequests();
 
         // Manage CAN RX/TX per redundant interface.
         for (uint8_t ifidx = 0; ifidx < CAN_REDUNDANCY_FACTOR; ifidx++)
@@ -1070,9 +1191,11 @@ int main(const int argc, char* const argv[])
                                                              .payload         = {.size = tqi->frame.payload.size,
                                                                                  .data = tqi->frame.payload.data}};
                     const int16_t result = socketcanPush(sock[ifidx], &canard_frame, 0);  // Non-blocking write attempt.
-                    if (result == 0)
+                    // The queue is full, or the wait is interrupted by the profiler signals (SIGPROF, SIGUSR2);
+                    // we will try again on the next iteration.
+                    if ((result == 0) || (result == -EINTR))
                     {
-                        break;  // The queue is full, we will try again on the next iteration.
+                        break;
                     }
                     if (result < 0)
                     {
@@ -1093,7 +1216,8 @@ int main(const int argc, char* const argv[])
             struct CanardFrame frame                  = {0};
             uint8_t            buf[CANARD_MTU_CAN_FD] = {0};
             const int16_t      socketcan_result = socketcanPop(sock[ifidx], &frame, NULL, sizeof(buf), buf, 0, NULL);
-            if (socketcan_result == 0)  // The read operation has timed out with no frames, nothing to do here.
+            // The read operation has timed out with no frames (or was interrupted), nothing to do here.
+            if ((socketcan_result == 0) || (socketcan_result == -EINTR))
             {
                 break;
             }
@@ -1124,6 +1248,8 @@ int main(const int argc, char* const argv[])
             }
         }
     } while (!g_restart_required);
+    setProfilerRunning(false);
+    binlogDrainerStop(&g_log_drainer);
 
     // It is recommended to postpone restart until all frames are sent though.
     (void) argc;